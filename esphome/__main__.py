@@ -117,7 +117,7 @@ def get_port_type(port):
 def run_miniterm(config, port):
     import serial
 
-    from esphome import platformio_api
+    from esphome import binary_log, platformio_api
 
     if CONF_LOGGER not in config:
         _LOGGER.info("Logger is not enabled. Not starting UART logs.")
@@ -129,6 +129,7 @@ def run_miniterm(config, port):
     _LOGGER.info("Starting log output from %s with baud rate %s", port, baud_rate)
 
     backtrace_state = False
+    format_table = binary_log.load_format_table() or {}
     ser = serial.Serial()
     ser.baudrate = baud_rate
     ser.port = port
@@ -149,11 +150,13 @@ def run_miniterm(config, port):
                     except serial.SerialException:
                         _LOGGER.error("Serial port closed!")
                         return 0
-                    line = (
-                        raw.replace(b"\r", b"")
-                        .replace(b"\n", b"")
-                        .decode("utf8", "backslashreplace")
-                    )
+                    line = binary_log.decode_serial_line(raw, format_table)
+                    if line is None:
+                        line = (
+                            raw.replace(b"\r", b"")
+                            .replace(b"\n", b"")
+                            .decode("utf8", "backslashreplace")
+                        )
                     time_str = datetime.now().time().strftime("[%H:%M:%S]")
                     message = time_str + line
                     safe_print(message)
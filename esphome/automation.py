@@ -1,3 +1,5 @@
+import re
+
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.const import (
@@ -13,6 +15,8 @@ from esphome.const import (
     CONF_TYPE_ID,
     CONF_UPDATE_INTERVAL,
 )
+from esphome.core import CORE, LAMBDA_PROG
+from esphome.cpp_generator import MockObjClass
 from esphome.schema_extractors import SCHEMA_EXTRACT, schema_extractor
 from esphome.util import Registry
 
@@ -73,12 +77,12 @@ def validate_potentially_and_condition(value):
     return validate_condition(value)
 
 
-DelayAction = cg.esphome_ns.class_("DelayAction", Action, cg.Component)
+DelayAction = cg.esphome_ns.class_("DelayAction", Action)
 LambdaAction = cg.esphome_ns.class_("LambdaAction", Action)
 IfAction = cg.esphome_ns.class_("IfAction", Action)
 WhileAction = cg.esphome_ns.class_("WhileAction", Action)
 RepeatAction = cg.esphome_ns.class_("RepeatAction", Action)
-WaitUntilAction = cg.esphome_ns.class_("WaitUntilAction", Action, cg.Component)
+WaitUntilAction = cg.esphome_ns.class_("WaitUntilAction", Action)
 UpdateComponentAction = cg.esphome_ns.class_("UpdateComponentAction", Action)
 SuspendComponentAction = cg.esphome_ns.class_("SuspendComponentAction", Action)
 ResumeComponentAction = cg.esphome_ns.class_("ResumeComponentAction", Action)
@@ -181,7 +185,10 @@ async def xor_condition_to_code(config, condition_id, template_arg, args):
 @register_condition("lambda", LambdaCondition, cv.returning_lambda)
 async def lambda_condition_to_code(config, condition_id, template_arg, args):
     lambda_ = await cg.process_lambda(config, args, return_type=bool)
-    return cg.new_Pvariable(condition_id, template_arg, lambda_)
+    var = cg.new_Pvariable(condition_id, template_arg, lambda_)
+    for dependency in await lambda_dependencies(config, args) or []:
+        cg.add(var.add_dependency(dependency))
+    return var
 
 
 @register_condition(
@@ -212,7 +219,6 @@ async def for_condition_to_code(config, condition_id, template_arg, args):
 )
 async def delay_action_to_code(config, action_id, template_arg, args):
     var = cg.new_Pvariable(action_id, template_arg)
-    await cg.register_component(var, {})
     template_ = await cg.templatable(config, args, cg.uint32)
     cg.add(var.set_delay(template_))
     return var
@@ -299,7 +305,6 @@ async def wait_until_action_to_code(config, action_id, template_arg, args):
     if CONF_TIMEOUT in config:
         template_ = await cg.templatable(config[CONF_TIMEOUT], args, cg.uint32)
         cg.add(var.set_timeout_value(template_))
-    await cg.register_component(var, {})
     return var
 
 
@@ -398,6 +403,104 @@ async def build_automation(trigger, args, config):
     arg_types = [arg[0] for arg in args]
     templ = cg.TemplateArguments(*arg_types)
     obj = cg.new_Pvariable(config[CONF_AUTOMATION_ID], templ, trigger)
+    # Most triggers subscribe to a callback of their parent
+    cg.add_callbacks()
     actions = await build_action_list(config[CONF_THEN], templ, args)
     cg.add(obj.add_actions(actions))
     return obj
+
+
+# Entities calling their state callbacks whenever WATCHABLE_MEMBER may have changed
+WATCHABLE_ENTITIES = [
+    cg.esphome_ns.namespace("binary_sensor").class_("BinarySensor"),
+    cg.esphome_ns.namespace("number").class_("Number"),
+    cg.esphome_ns.namespace("select").class_("Select"),
+    cg.esphome_ns.namespace("sensor").class_("Sensor"),
+    cg.esphome_ns.namespace("switch_").class_("Switch"),
+    cg.esphome_ns.namespace("text_sensor").class_("TextSensor"),
+]
+WATCHABLE_MEMBER = re.compile(r"^(?:\.|->)\s*(?:state\b(?!\s*\()|has_state\s*\(\s*\))")
+# Names a lambda may use besides its parameters and locals, they read no other state
+PURE_LAMBDA_NAMES = {
+    *("auto", "bool", "const", "double", "else", "false", "float", "if", "int"),
+    *("long", "nullptr", "return", "static_cast", "true", "unsigned"),
+    *("int8_t", "int16_t", "int32_t", "uint8_t", "uint16_t", "uint32_t", "size_t"),
+    *("std", "optional", "nullopt", "string", "to_string", "NAN", "INFINITY"),
+    *("abs", "fabs", "fabsf", "min", "max", "clamp", "isnan", "isinf"),
+    *("round", "roundf", "floor", "floorf", "ceil", "ceilf", "sqrt", "sqrtf"),
+    *("pow", "powf", "exp", "log", "log10", "sin", "cos", "tan", "atan2"),
+}
+LAMBDA_LOCAL = re.compile(
+    r"\b(?:auto|bool|int|float|double|const)\s+&?\s*([a-zA-Z_][a-zA-Z0-9_]*)\s*="
+)
+LAMBDA_STRING = r'"(?:\\.|[^\\"])*"|\'(?:\\.|[^\\\'])*\''
+LAMBDA_LITERAL = re.compile(rf"{LAMBDA_STRING}|\b[0-9][a-zA-Z0-9_.]*")
+LAMBDA_MEMBER = re.compile(r"(?:\.|->)\s*[a-zA-Z_][a-zA-Z0-9_]*")
+# Entities evaluated from state callbacks, by ID, with the IDs they depend on
+KEY_LAMBDA_DEPENDENCIES = "lambda_dependencies"
+
+
+def _depends_on(graph, ids, target):
+    """Whether `target` is one of `ids` or reachable from them through `graph`."""
+    seen = set()
+    while ids:
+        id_ = ids.pop()
+        if id_ == target:
+            return True
+        if id_ not in seen:
+            seen.add(id_)
+            ids.extend(graph.get(id_, ()))
+    return False
+
+
+async def lambda_dependencies(value, parameters, owner=None):
+    """Find the entities read by a lambda, so it can be evaluated only after one of them
+    published a state instead of being polled.
+
+    :param value: The lambda.
+    :param parameters: The parameters of the lambda, list of tuples of type and name.
+    :param owner: The ID of the entity publishing the result of the lambda, if any.
+    :return: The variables of the entities, or None if the lambda may read anything
+      else, like the time or globals, or doesn't read any entity. Also None if the
+      lambda reads the owner, directly or through other lambdas evaluated this way, as
+      each evaluation would trigger the next one.
+    """
+    parts = value.parts
+    # id() in a string literal is split off too, the code around it can't be checked
+    stripped = re.sub(LAMBDA_STRING, " ", value.comment_remover(value.value))
+    if len(LAMBDA_PROG.findall(stripped)) != len(value.requires_ids):
+        return None
+    code = [parts[0]]
+    dependencies = {}
+    for i, id_ in enumerate(value.requires_ids):
+        full_id, var = await cg.get_variable_with_full_id(id_)
+        if not isinstance(full_id.type, MockObjClass) or not any(
+            full_id.type.inherits_from(entity) for entity in WATCHABLE_ENTITIES
+        ):
+            return None
+        rest = parts[i * 3 + 2] + parts[i * 3 + 3]
+        if (member := WATCHABLE_MEMBER.match(rest)) is None:
+            return None
+        code.append(rest[member.end() :])
+        dependencies.setdefault(str(full_id), var)
+    if not dependencies:
+        return None
+
+    # Only literals, parameters, locals and pure functions may remain
+    code = LAMBDA_LITERAL.sub(" ", " 0 ".join(code))
+    names = PURE_LAMBDA_NAMES | {name for _, name in parameters}
+    names |= set(LAMBDA_LOCAL.findall(code))
+    code = LAMBDA_MEMBER.sub(" ", code)
+    if any(
+        name not in names for name in re.findall(r"[a-zA-Z_][a-zA-Z0-9_]*", code)
+    ):
+        return None
+
+    if owner is not None:
+        graph = CORE.data.setdefault(KEY_LAMBDA_DEPENDENCIES, {})
+        if _depends_on(graph, list(dependencies), str(owner)):
+            return None
+        graph[str(owner)] = list(dependencies)
+    # Each dependency is added as a state callback of the entity
+    cg.add_callbacks(len(dependencies))
+    return list(dependencies.values())
@@ -0,0 +1,241 @@
+"""Host side support for the logger's binary log records.
+
+In binary mode the device does not run ``vsnprintf``. It sends the id of the
+format string together with the raw arguments, see
+``esphome/components/logger/log_record.h``. Format strings are collected from
+the C++ sources at compile time and stored in the build directory, where the
+log readers use them to reconstruct the text.
+"""
+
+from __future__ import annotations
+
+import base64
+import json
+import logging
+from pathlib import Path
+import re
+import struct
+from typing import Optional
+
+from esphome.core import CORE
+from esphome.helpers import write_file_if_changed
+
+_LOGGER = logging.getLogger(__name__)
+
+RECORD_MARKER = 0x1E
+TEXT_FORMAT_ID = 0
+FORMAT_TABLE_FILE = "log_formats.json"
+
+LOG_LEVEL_COLORS = [
+    "",  # NONE
+    "\033[1;31m",  # ERROR
+    "\033[0;33m",  # WARNING
+    "\033[0;32m",  # INFO
+    "\033[0;35m",  # CONFIG
+    "\033[0;36m",  # DEBUG
+    "\033[0;37m",  # VERBOSE
+    "\033[0;38m",  # VERY_VERBOSE
+]
+LOG_LEVEL_LETTERS = ["", "E", "W", "I", "C", "D", "V", "VV"]
+RESET_COLOR = "\033[0m"
+
+# A log macro whose format argument consists only of string literals. Formats
+# using PRIu32 and friends are skipped, their expansion is platform specific.
+LOG_CALL_RE = re.compile(
+    r"\bESP_LOG(?:E|W|I|CONFIG|D|V|VV)\s*\(\s*[^,()]+,\s*"
+    r'((?:"(?:[^"\\\n]|\\.)*"\s*)+)(?=[,)])'
+)
+STRING_LITERAL_RE = re.compile(r'"((?:[^"\\\n]|\\.)*)"')
+CONVERSION_RE = re.compile(
+    r"%(?P<flags>[-+ #0]*)(?P<width>\*|\d+)?(?:\.(?P<precision>\*|\d*))?"
+    r"(?P<length>hh|h|ll|l|z|j|t|L)?(?P<conv>[diouxXcfFeEgGaAspn%])"
+)
+SIMPLE_ESCAPES = {
+    "n": "\n",
+    "t": "\t",
+    "r": "\r",
+    "a": "\a",
+    "b": "\b",
+    "f": "\f",
+    "v": "\v",
+    "\\": "\\",
+    '"': '"',
+    "'": "'",
+    "?": "?",
+}
+ESCAPE_RE = re.compile(r"\\(x[0-9a-fA-F]+|[0-7]{1,3}|.)")
+
+
+def format_id(fmt: str) -> int:
+    """Return the format id of a format string, mirrors ``log_format_id()``."""
+    value = 2166136261
+    for byte in fmt.encode("utf8"):
+        value ^= byte
+        value = (value * 16777619) & 0xFFFFFFFF
+    return 1 if value == TEXT_FORMAT_ID else value
+
+
+def unescape_c_string(literal: str) -> str:
+    def replace(match: re.Match) -> str:
+        esc = match.group(1)
+        if esc[0] == "x":
+            return chr(int(esc[1:], 16))
+        if esc[0] in "01234567":
+            return chr(int(esc, 8))
+        return SIMPLE_ESCAPES.get(esc, esc)
+
+    return ESCAPE_RE.sub(replace, literal)
+
+
+def find_format_strings(source: str) -> list[str]:
+    """Return the format strings of all log calls in a C++ source."""
+    return [
+        "".join(
+            unescape_c_string(lit) for lit in STRING_LITERAL_RE.findall(m.group(1))
+        )
+        for m in LOG_CALL_RE.finditer(source)
+    ]
+
+
+def build_format_table(paths: list[Path]) -> dict[int, str]:
+    """Scan the given sources and map format ids to format strings.
+
+    Ids that collide between different format strings are left out, the
+    device sends those as text.
+    """
+    table: dict[int, str] = {}
+    collisions: set[int] = set()
+    for path in paths:
+        try:
+            source = path.read_text(encoding="utf8", errors="replace")
+        except OSError:
+            continue
+        for fmt in find_format_strings(source):
+            id_ = format_id(fmt)
+            if table.setdefault(id_, fmt) != fmt:
+                collisions.add(id_)
+    for id_ in collisions:
+        _LOGGER.debug("Log format id %08x is ambiguous, using text", id_)
+        del table[id_]
+    return table
+
+
+def write_format_table(table: dict[int, str]) -> None:
+    write_file_if_changed(
+        CORE.relative_build_path(FORMAT_TABLE_FILE),
+        json.dumps({f"{k:08x}": v for k, v in sorted(table.items())}, indent=0),
+    )
+
+
+def load_format_table() -> Optional[dict[int, str]]:
+    path = Path(CORE.relative_build_path(FORMAT_TABLE_FILE))
+    if not path.is_file():
+        return None
+    with open(path, encoding="utf8") as f:
+        return {int(k, 16): v for k, v in json.load(f).items()}
+
+
+class _Reader:
+    def __init__(self, data: bytes) -> None:
+        self.data = data
+        self.pos = 0
+
+    def byte(self) -> int:
+        if self.pos >= len(self.data):
+            raise ValueError("Truncated log record")
+        self.pos += 1
+        return self.data[self.pos - 1]
+
+    def varint(self) -> int:
+        result = 0
+        shift = 0
+        while True:
+            byte = self.byte()
+            result |= (byte & 0x7F) << shift
+            if byte < 0x80:
+                return result
+            shift += 7
+
+    def signed(self) -> int:
+        value = self.varint()
+        return (value >> 1) ^ -(value & 1)
+
+    def raw(self, length: int) -> bytes:
+        if self.pos + length > len(self.data):
+            raise ValueError("Truncated log record")
+        self.pos += length
+        return self.data[self.pos - length : self.pos]
+
+    def float(self) -> float:
+        return struct.unpack("<f", self.raw(4))[0]
+
+    def string(self) -> str:
+        return self.raw(self.varint()).decode("utf8", "backslashreplace")
+
+
+def _format_message(fmt: str, reader: _Reader) -> str:
+    def replace(match: re.Match) -> str:
+        conv = match.group("conv")
+        if conv == "%":
+            return "%"
+        width = match.group("width") or ""
+        if width == "*":
+            width = str(reader.signed())
+        precision = match.group("precision")
+        if precision == "*":
+            precision = str(reader.signed())
+        spec = "%" + match.group("flags") + width
+        if precision is not None:
+            spec += "." + precision
+        if conv in "di":
+            return (spec + "d") % reader.signed()
+        if conv in "uoxX":
+            return (spec + conv.replace("u", "d")) % reader.varint()
+        if conv == "c":
+            return (spec + "c") % chr(reader.varint())
+        if conv in "aA":
+            value = float.hex(reader.float())
+            return value.upper() if conv == "A" else value
+        if conv in "fFeEgG":
+            return (spec + conv) % reader.float()
+        if conv == "s":
+            return (spec + "s") % reader.string()
+        if conv == "p":
+            return f"0x{reader.varint():x}"
+        return ""  # %n
+
+    return CONVERSION_RE.sub(replace, fmt)
+
+
+def is_record(data: bytes) -> bool:
+    return len(data) > 0 and data[0] == RECORD_MARKER
+
+
+def decode_record(data: bytes, table: dict[int, str]) -> str:
+    """Reconstruct the log line the device would have printed for a record."""
+    reader = _Reader(data)
+    if reader.byte() != RECORD_MARKER:
+        raise ValueError("Not a binary log record")
+    level = min(reader.byte(), len(LOG_LEVEL_LETTERS) - 1)
+    id_ = struct.unpack("<I", reader.raw(4))[0]
+    line = reader.varint()
+    tag = reader.string()
+    if id_ == TEXT_FORMAT_ID:
+        message = reader.string()
+    elif id_ in table:
+        message = _format_message(table[id_], reader)
+    else:
+        message = f"<unknown log format {id_:08x}>"
+    color = LOG_LEVEL_COLORS[level]
+    letter = LOG_LEVEL_LETTERS[level]
+    return f"{color}[{letter}][{tag}:{line:03}]: {message.rstrip(chr(10))}{RESET_COLOR}"
+
+
+def decode_serial_line(line: bytes, table: dict[int, str]) -> Optional[str]:
+    """Decode a base64 encoded record as written to serial, None if ``line`` is text."""
+    if not is_record(line):
+        return None
+    try:
+        return decode_record(base64.b64decode(line[1:].strip()), table)
+    except ValueError as err:
+        return f"<invalid log record: {err}>"
@@ -41,8 +41,12 @@ from esphome.cpp_generator import (  # noqa: F401
     with_local_variable,
 )
 from esphome.cpp_helpers import (  # noqa: F401
+    add_callbacks,
+    add_entity_strings,
     build_registry_entry,
     build_registry_list,
+    callback_pool_size,
+    entity_string,
     extract_registry_entry_config,
     gpio_pin_expression,
     past_safe_mode,
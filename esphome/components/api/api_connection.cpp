@@ -189,7 +189,9 @@ void APIConnection::loop() {
 }
 
 std::string get_default_unique_id(const std::string &component_type, EntityBase *entity) {
-  return App.get_name() + component_type + entity->get_object_id();
+  std::string unique_id = App.get_name() + component_type;
+  unique_id += entity->get_object_id_ref();
+  return unique_id;
 }
 
 DisconnectResponse APIConnection::disconnect(const DisconnectRequest &msg) {
@@ -218,15 +220,15 @@ bool APIConnection::send_binary_sensor_state(binary_sensor::BinarySensor *binary
 }
 bool APIConnection::send_binary_sensor_info(binary_sensor::BinarySensor *binary_sensor) {
   ListEntitiesBinarySensorResponse msg;
-  msg.object_id = binary_sensor->get_object_id();
+  msg.object_id = binary_sensor->get_object_id_ref();
   msg.key = binary_sensor->get_object_id_hash();
   if (binary_sensor->has_own_name())
     msg.name = binary_sensor->get_name();
   msg.unique_id = get_default_unique_id("binary_sensor", binary_sensor);
-  msg.device_class = binary_sensor->get_device_class();
+  msg.device_class = binary_sensor->get_device_class_ref();
   msg.is_status_binary_sensor = binary_sensor->is_status_binary_sensor();
   msg.disabled_by_default = binary_sensor->is_disabled_by_default();
-  msg.icon = binary_sensor->get_icon();
+  msg.icon = binary_sensor->get_icon_ref();
   msg.entity_category = static_cast<enums::EntityCategory>(binary_sensor->get_entity_category());
   return this->send_list_entities_binary_sensor_response(msg);
 }
@@ -252,7 +254,7 @@ bool APIConnection::send_cover_info(cover::Cover *cover) {
   auto traits = cover->get_traits();
   ListEntitiesCoverResponse msg;
   msg.key = cover->get_object_id_hash();
-  msg.object_id = cover->get_object_id();
+  msg.object_id = cover->get_object_id_ref();
   if (cover->has_own_name())
     msg.name = cover->get_name();
   msg.unique_id = get_default_unique_id("cover", cover);
@@ -260,9 +262,9 @@ bool APIConnection::send_cover_info(cover::Cover *cover) {
   msg.supports_position = traits.get_supports_position();
   msg.supports_tilt = traits.get_supports_tilt();
   msg.supports_stop = traits.get_supports_stop();
-  msg.device_class = cover->get_device_class();
+  msg.device_class = cover->get_device_class_ref();
   msg.disabled_by_default = cover->is_disabled_by_default();
-  msg.icon = cover->get_icon();
+  msg.icon = cover->get_icon_ref();
   msg.entity_category = static_cast<enums::EntityCategory>(cover->get_entity_category());
   return this->send_list_entities_cover_response(msg);
 }
@@ -319,7 +321,7 @@ bool APIConnection::send_fan_info(fan::Fan *fan) {
   auto traits = fan->get_traits();
   ListEntitiesFanResponse msg;
   msg.key = fan->get_object_id_hash();
-  msg.object_id = fan->get_object_id();
+  msg.object_id = fan->get_object_id_ref();
   if (fan->has_own_name())
     msg.name = fan->get_name();
   msg.unique_id = get_default_unique_id("fan", fan);
@@ -330,7 +332,7 @@ bool APIConnection::send_fan_info(fan::Fan *fan) {
   for (auto const &preset : traits.supported_preset_modes())
     msg.supported_preset_modes.push_back(preset);
   msg.disabled_by_default = fan->is_disabled_by_default();
-  msg.icon = fan->get_icon();
+  msg.icon = fan->get_icon_ref();
   msg.entity_category = static_cast<enums::EntityCategory>(fan->get_entity_category());
   return this->send_list_entities_fan_response(msg);
 }
@@ -386,13 +388,13 @@ bool APIConnection::send_light_info(light::LightState *light) {
   auto traits = light->get_traits();
   ListEntitiesLightResponse msg;
   msg.key = light->get_object_id_hash();
-  msg.object_id = light->get_object_id();
+  msg.object_id = light->get_object_id_ref();
   if (light->has_own_name())
     msg.name = light->get_name();
   msg.unique_id = get_default_unique_id("light", light);
 
   msg.disabled_by_default = light->is_disabled_by_default();
-  msg.icon = light->get_icon();
+  msg.icon = light->get_icon_ref();
   msg.entity_category = static_cast<enums::EntityCategory>(light->get_entity_category());
 
   for (auto mode : traits.get_supported_color_modes())
@@ -468,17 +470,17 @@ bool APIConnection::send_sensor_state(sensor::Sensor *sensor, float state) {
 bool APIConnection::send_sensor_info(sensor::Sensor *sensor) {
   ListEntitiesSensorResponse msg;
   msg.key = sensor->get_object_id_hash();
-  msg.object_id = sensor->get_object_id();
+  msg.object_id = sensor->get_object_id_ref();
   if (sensor->has_own_name())
     msg.name = sensor->get_name();
   msg.unique_id = sensor->unique_id();
   if (msg.unique_id.empty())
     msg.unique_id = get_default_unique_id("sensor", sensor);
-  msg.icon = sensor->get_icon();
-  msg.unit_of_measurement = sensor->get_unit_of_measurement();
+  msg.icon = sensor->get_icon_ref();
+  msg.unit_of_measurement = sensor->get_unit_of_measurement_ref();
   msg.accuracy_decimals = sensor->get_accuracy_decimals();
   msg.force_update = sensor->get_force_update();
-  msg.device_class = sensor->get_device_class();
+  msg.device_class = sensor->get_device_class_ref();
   msg.state_class = static_cast<enums::SensorStateClass>(sensor->get_state_class());
   msg.disabled_by_default = sensor->is_disabled_by_default();
   msg.entity_category = static_cast<enums::EntityCategory>(sensor->get_entity_category());
@@ -499,15 +501,15 @@ bool APIConnection::send_switch_state(switch_::Switch *a_switch, bool state) {
 bool APIConnection::send_switch_info(switch_::Switch *a_switch) {
   ListEntitiesSwitchResponse msg;
   msg.key = a_switch->get_object_id_hash();
-  msg.object_id = a_switch->get_object_id();
+  msg.object_id = a_switch->get_object_id_ref();
   if (a_switch->has_own_name())
     msg.name = a_switch->get_name();
   msg.unique_id = get_default_unique_id("switch", a_switch);
-  msg.icon = a_switch->get_icon();
+  msg.icon = a_switch->get_icon_ref();
   msg.assumed_state = a_switch->assumed_state();
   msg.disabled_by_default = a_switch->is_disabled_by_default();
   msg.entity_category = static_cast<enums::EntityCategory>(a_switch->get_entity_category());
-  msg.device_class = a_switch->get_device_class();
+  msg.device_class = a_switch->get_device_class_ref();
   return this->send_list_entities_switch_response(msg);
 }
 void APIConnection::switch_command(const SwitchCommandRequest &msg) {
@@ -537,15 +539,15 @@ bool APIConnection::send_text_sensor_state(text_sensor::TextSensor *text_sensor,
 bool APIConnection::send_text_sensor_info(text_sensor::TextSensor *text_sensor) {
   ListEntitiesTextSensorResponse msg;
   msg.key = text_sensor->get_object_id_hash();
-  msg.object_id = text_sensor->get_object_id();
+  msg.object_id = text_sensor->get_object_id_ref();
   msg.name = text_sensor->get_name();
   msg.unique_id = text_sensor->unique_id();
   if (msg.unique_id.empty())
     msg.unique_id = get_default_unique_id("text_sensor", text_sensor);
-  msg.icon = text_sensor->get_icon();
+  msg.icon = text_sensor->get_icon_ref();
   msg.disabled_by_default = text_sensor->is_disabled_by_default();
   msg.entity_category = static_cast<enums::EntityCategory>(text_sensor->get_entity_category());
-  msg.device_class = text_sensor->get_device_class();
+  msg.device_class = text_sensor->get_device_class_ref();
   return this->send_list_entities_text_sensor_response(msg);
 }
 #endif
@@ -589,13 +591,13 @@ bool APIConnection::send_climate_info(climate::Climate *climate) {
   auto traits = climate->get_traits();
   ListEntitiesClimateResponse msg;
   msg.key = climate->get_object_id_hash();
-  msg.object_id = climate->get_object_id();
+  msg.object_id = climate->get_object_id_ref();
   if (climate->has_own_name())
     msg.name = climate->get_name();
   msg.unique_id = get_default_unique_id("climate", climate);
 
   msg.disabled_by_default = climate->is_disabled_by_default();
-  msg.icon = climate->get_icon();
+  msg.icon = climate->get_icon_ref();
   msg.entity_category = static_cast<enums::EntityCategory>(climate->get_entity_category());
 
   msg.supports_current_temperature = traits.get_supports_current_temperature();
@@ -672,16 +674,16 @@ bool APIConnection::send_number_state(number::Number *number, float state) {
 bool APIConnection::send_number_info(number::Number *number) {
   ListEntitiesNumberResponse msg;
   msg.key = number->get_object_id_hash();
-  msg.object_id = number->get_object_id();
+  msg.object_id = number->get_object_id_ref();
   if (number->has_own_name())
     msg.name = number->get_name();
   msg.unique_id = get_default_unique_id("number", number);
-  msg.icon = number->get_icon();
+  msg.icon = number->get_icon_ref();
   msg.disabled_by_default = number->is_disabled_by_default();
   msg.entity_category = static_cast<enums::EntityCategory>(number->get_entity_category());
-  msg.unit_of_measurement = number->traits.get_unit_of_measurement();
+  msg.unit_of_measurement = number->traits.get_unit_of_measurement_ref();
   msg.mode = static_cast<enums::NumberMode>(number->traits.get_mode());
-  msg.device_class = number->traits.get_device_class();
+  msg.device_class = number->traits.get_device_class_ref();
 
   msg.min_value = number->traits.get_min_value();
   msg.max_value = number->traits.get_max_value();
@@ -716,11 +718,11 @@ bool APIConnection::send_date_state(datetime::DateEntity *date) {
 bool APIConnection::send_date_info(datetime::DateEntity *date) {
   ListEntitiesDateResponse msg;
   msg.key = date->get_object_id_hash();
-  msg.object_id = date->get_object_id();
+  msg.object_id = date->get_object_id_ref();
   if (date->has_own_name())
     msg.name = date->get_name();
   msg.unique_id = get_default_unique_id("date", date);
-  msg.icon = date->get_icon();
+  msg.icon = date->get_icon_ref();
   msg.disabled_by_default = date->is_disabled_by_default();
   msg.entity_category = static_cast<enums::EntityCategory>(date->get_entity_category());
 
@@ -753,11 +755,11 @@ bool APIConnection::send_time_state(datetime::TimeEntity *time) {
 bool APIConnection::send_time_info(datetime::TimeEntity *time) {
   ListEntitiesTimeResponse msg;
   msg.key = time->get_object_id_hash();
-  msg.object_id = time->get_object_id();
+  msg.object_id = time->get_object_id_ref();
   if (time->has_own_name())
     msg.name = time->get_name();
   msg.unique_id = get_default_unique_id("time", time);
-  msg.icon = time->get_icon();
+  msg.icon = time->get_icon_ref();
   msg.disabled_by_default = time->is_disabled_by_default();
   msg.entity_category = static_cast<enums::EntityCategory>(time->get_entity_category());
 
@@ -791,11 +793,11 @@ bool APIConnection::send_datetime_state(datetime::DateTimeEntity *datetime) {
 bool APIConnection::send_datetime_info(datetime::DateTimeEntity *datetime) {
   ListEntitiesDateTimeResponse msg;
   msg.key = datetime->get_object_id_hash();
-  msg.object_id = datetime->get_object_id();
+  msg.object_id = datetime->get_object_id_ref();
   if (datetime->has_own_name())
     msg.name = datetime->get_name();
   msg.unique_id = get_default_unique_id("datetime", datetime);
-  msg.icon = datetime->get_icon();
+  msg.icon = datetime->get_icon_ref();
   msg.disabled_by_default = datetime->is_disabled_by_default();
   msg.entity_category = static_cast<enums::EntityCategory>(datetime->get_entity_category());
 
@@ -826,9 +828,9 @@ bool APIConnection::send_text_state(text::Text *text, std::string state) {
 bool APIConnection::send_text_info(text::Text *text) {
   ListEntitiesTextResponse msg;
   msg.key = text->get_object_id_hash();
-  msg.object_id = text->get_object_id();
+  msg.object_id = text->get_object_id_ref();
   msg.name = text->get_name();
-  msg.icon = text->get_icon();
+  msg.icon = text->get_icon_ref();
   msg.disabled_by_default = text->is_disabled_by_default();
   msg.entity_category = static_cast<enums::EntityCategory>(text->get_entity_category());
   msg.mode = static_cast<enums::TextMode>(text->traits.get_mode());
@@ -864,11 +866,11 @@ bool APIConnection::send_select_state(select::Select *select, std::string state)
 bool APIConnection::send_select_info(select::Select *select) {
   ListEntitiesSelectResponse msg;
   msg.key = select->get_object_id_hash();
-  msg.object_id = select->get_object_id();
+  msg.object_id = select->get_object_id_ref();
   if (select->has_own_name())
     msg.name = select->get_name();
   msg.unique_id = get_default_unique_id("select", select);
-  msg.icon = select->get_icon();
+  msg.icon = select->get_icon_ref();
   msg.disabled_by_default = select->is_disabled_by_default();
   msg.entity_category = static_cast<enums::EntityCategory>(select->get_entity_category());
 
@@ -892,14 +894,14 @@ void APIConnection::select_command(const SelectCommandRequest &msg) {
 bool APIConnection::send_button_info(button::Button *button) {
   ListEntitiesButtonResponse msg;
   msg.key = button->get_object_id_hash();
-  msg.object_id = button->get_object_id();
+  msg.object_id = button->get_object_id_ref();
   if (button->has_own_name())
     msg.name = button->get_name();
   msg.unique_id = get_default_unique_id("button", button);
-  msg.icon = button->get_icon();
+  msg.icon = button->get_icon_ref();
   msg.disabled_by_default = button->is_disabled_by_default();
   msg.entity_category = static_cast<enums::EntityCategory>(button->get_entity_category());
-  msg.device_class = button->get_device_class();
+  msg.device_class = button->get_device_class_ref();
   return this->send_list_entities_button_response(msg);
 }
 void APIConnection::button_command(const ButtonCommandRequest &msg) {
@@ -924,11 +926,11 @@ bool APIConnection::send_lock_state(lock::Lock *a_lock, lock::LockState state) {
 bool APIConnection::send_lock_info(lock::Lock *a_lock) {
   ListEntitiesLockResponse msg;
   msg.key = a_lock->get_object_id_hash();
-  msg.object_id = a_lock->get_object_id();
+  msg.object_id = a_lock->get_object_id_ref();
   if (a_lock->has_own_name())
     msg.name = a_lock->get_name();
   msg.unique_id = get_default_unique_id("lock", a_lock);
-  msg.icon = a_lock->get_icon();
+  msg.icon = a_lock->get_icon_ref();
   msg.assumed_state = a_lock->traits.get_assumed_state();
   msg.disabled_by_default = a_lock->is_disabled_by_default();
   msg.entity_category = static_cast<enums::EntityCategory>(a_lock->get_entity_category());
@@ -970,14 +972,14 @@ bool APIConnection::send_valve_info(valve::Valve *valve) {
   auto traits = valve->get_traits();
   ListEntitiesValveResponse msg;
   msg.key = valve->get_object_id_hash();
-  msg.object_id = valve->get_object_id();
+  msg.object_id = valve->get_object_id_ref();
   if (valve->has_own_name())
     msg.name = valve->get_name();
   msg.unique_id = get_default_unique_id("valve", valve);
-  msg.icon = valve->get_icon();
+  msg.icon = valve->get_icon_ref();
   msg.disabled_by_default = valve->is_disabled_by_default();
   msg.entity_category = static_cast<enums::EntityCategory>(valve->get_entity_category());
-  msg.device_class = valve->get_device_class();
+  msg.device_class = valve->get_device_class_ref();
   msg.assumed_state = traits.get_is_assumed_state();
   msg.supports_position = traits.get_supports_position();
   msg.supports_stop = traits.get_supports_stop();
@@ -1016,11 +1018,11 @@ bool APIConnection::send_media_player_state(media_player::MediaPlayer *media_pla
 bool APIConnection::send_media_player_info(media_player::MediaPlayer *media_player) {
   ListEntitiesMediaPlayerResponse msg;
   msg.key = media_player->get_object_id_hash();
-  msg.object_id = media_player->get_object_id();
+  msg.object_id = media_player->get_object_id_ref();
   if (media_player->has_own_name())
     msg.name = media_player->get_name();
   msg.unique_id = get_default_unique_id("media_player", media_player);
-  msg.icon = media_player->get_icon();
+  msg.icon = media_player->get_icon_ref();
   msg.disabled_by_default = media_player->is_disabled_by_default();
   msg.entity_category = static_cast<enums::EntityCategory>(media_player->get_entity_category());
 
@@ -1074,12 +1076,12 @@ void APIConnection::send_camera_state(std::shared_ptr<esp32_camera::CameraImage>
 bool APIConnection::send_camera_info(esp32_camera::ESP32Camera *camera) {
   ListEntitiesCameraResponse msg;
   msg.key = camera->get_object_id_hash();
-  msg.object_id = camera->get_object_id();
+  msg.object_id = camera->get_object_id_ref();
   if (camera->has_own_name())
     msg.name = camera->get_name();
   msg.unique_id = get_default_unique_id("camera", camera);
   msg.disabled_by_default = camera->is_disabled_by_default();
-  msg.icon = camera->get_icon();
+  msg.icon = camera->get_icon_ref();
   msg.entity_category = static_cast<enums::EntityCategory>(camera->get_entity_category());
   return this->send_list_entities_camera_response(msg);
 }
@@ -1276,10 +1278,10 @@ bool APIConnection::send_alarm_control_panel_state(alarm_control_panel::AlarmCon
 bool APIConnection::send_alarm_control_panel_info(alarm_control_panel::AlarmControlPanel *a_alarm_control_panel) {
   ListEntitiesAlarmControlPanelResponse msg;
   msg.key = a_alarm_control_panel->get_object_id_hash();
-  msg.object_id = a_alarm_control_panel->get_object_id();
+  msg.object_id = a_alarm_control_panel->get_object_id_ref();
   msg.name = a_alarm_control_panel->get_name();
   msg.unique_id = get_default_unique_id("alarm_control_panel", a_alarm_control_panel);
-  msg.icon = a_alarm_control_panel->get_icon();
+  msg.icon = a_alarm_control_panel->get_icon_ref();
   msg.disabled_by_default = a_alarm_control_panel->is_disabled_by_default();
   msg.entity_category = static_cast<enums::EntityCategory>(a_alarm_control_panel->get_entity_category());
   msg.supported_features = a_alarm_control_panel->get_supported_features();
@@ -1331,14 +1333,14 @@ bool APIConnection::send_event(event::Event *event, std::string event_type) {
 bool APIConnection::send_event_info(event::Event *event) {
   ListEntitiesEventResponse msg;
   msg.key = event->get_object_id_hash();
-  msg.object_id = event->get_object_id();
+  msg.object_id = event->get_object_id_ref();
   if (event->has_own_name())
     msg.name = event->get_name();
   msg.unique_id = get_default_unique_id("event", event);
-  msg.icon = event->get_icon();
+  msg.icon = event->get_icon_ref();
   msg.disabled_by_default = event->is_disabled_by_default();
   msg.entity_category = static_cast<enums::EntityCategory>(event->get_entity_category());
-  msg.device_class = event->get_device_class();
+  msg.device_class = event->get_device_class_ref();
   for (const auto &event_type : event->get_event_types())
     msg.event_types.push_back(event_type);
   return this->send_list_entities_event_response(msg);
@@ -1371,14 +1373,14 @@ bool APIConnection::send_update_state(update::UpdateEntity *update) {
 bool APIConnection::send_update_info(update::UpdateEntity *update) {
   ListEntitiesUpdateResponse msg;
   msg.key = update->get_object_id_hash();
-  msg.object_id = update->get_object_id();
+  msg.object_id = update->get_object_id_ref();
   if (update->has_own_name())
     msg.name = update->get_name();
   msg.unique_id = get_default_unique_id("update", update);
-  msg.icon = update->get_icon();
+  msg.icon = update->get_icon_ref();
   msg.disabled_by_default = update->is_disabled_by_default();
   msg.entity_category = static_cast<enums::EntityCategory>(update->get_entity_category());
-  msg.device_class = update->get_device_class();
+  msg.device_class = update->get_device_class_ref();
   return this->send_list_entities_update_response(msg);
 }
 void APIConnection::update_command(const UpdateCommandRequest &msg) {
@@ -69,12 +69,21 @@ void APIServer::setup() {
 
 #ifdef USE_LOGGER
   if (logger::global_logger != nullptr) {
-    logger::global_logger->add_on_log_callback([this](int level, const char *tag, const char *message) {
-      for (auto &c : this->clients_) {
-        if (!c->remove_)
-          c->send_log_message(level, tag, message);
-      }
-    });
+    // Home Assistant and other API clients expect text, so binary records stay on serial
+    logger::global_logger->add_on_log_callback(
+        [this](int level, const char *tag, const char *message) {
+          for (auto &c : this->clients_) {
+            if (!c->remove_)
+              c->send_log_message(level, tag, message);
+          }
+        },
+        [this](int level) {
+          for (auto &c : this->clients_) {
+            if (!c->remove_ && c->log_subscription_ >= level)
+              return true;
+          }
+          return false;
+        });
   }
 #endif
 
@@ -489,7 +489,7 @@ async def setup_binary_sensor_core_(var, config):
     await setup_entity(var, config)
 
     if (device_class := config.get(CONF_DEVICE_CLASS)) is not None:
-        cg.add(var.set_device_class(device_class))
+        cg.add(var.set_device_class(cg.entity_string(device_class)))
     if publish_initial_state := config.get(CONF_PUBLISH_INITIAL_STATE):
         cg.add(var.set_publish_initial_state(publish_initial_state))
     if inverted := config.get(CONF_INVERTED):
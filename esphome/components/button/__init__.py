@@ -91,7 +91,7 @@ async def setup_button_core_(var, config):
         await automation.build_automation(trigger, [], conf)
 
     if device_class := config.get(CONF_DEVICE_CLASS):
-        cg.add(var.set_device_class(device_class))
+        cg.add(var.set_device_class(cg.entity_string(device_class)))
 
     if mqtt_id := config.get(CONF_MQTT_ID):
         mqtt_ = cg.new_Pvariable(mqtt_id, var)
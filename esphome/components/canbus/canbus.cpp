@@ -1,6 +1,8 @@
 #include "canbus.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace canbus {
 
@@ -55,39 +57,79 @@ void Canbus::add_trigger(CanbusTrigger *trigger) {
   } else {
     ESP_LOGVV(TAG, "add trigger for std canid=0x%03" PRIx32, trigger->can_id_);
   }
-  this->triggers_.push_back(trigger);
+  trigger->index_ = this->trigger_count_++;
+  const uint32_t full_mask = trigger->use_extended_id_ ? 0x1FFFFFFF : 0x7FF;
+  if ((trigger->can_id_mask_ & full_mask) != full_mask) {
+    this->masked_triggers_.push_back(trigger);
+    return;
+  }
+  // Insert after the triggers with the same id to keep them in the order they were added
+  auto it = std::upper_bound(this->triggers_.begin(), this->triggers_.end(), trigger->key_(),
+                             [](uint32_t key, const CanbusTrigger *other) { return key < other->key_(); });
+  this->triggers_.insert(it, trigger);
 };
 
+std::vector<CanFilter> Canbus::get_filters_() const {
+  std::vector<CanFilter> filters;
+  filters.reserve(this->triggers_.size() + this->masked_triggers_.size());
+  for (auto *trigger : this->triggers_)
+    filters.push_back({trigger->can_id_, trigger->can_id_mask_, trigger->use_extended_id_});
+  for (auto *trigger : this->masked_triggers_)
+    filters.push_back({trigger->can_id_, trigger->can_id_mask_, trigger->use_extended_id_});
+  return filters;
+}
+
 void Canbus::loop() {
-  struct CanFrame can_message;
-  // read all messages until queue is empty
-  int message_counter = 0;
-  while (this->read_message(&can_message) == canbus::ERROR_OK) {
-    message_counter++;
-    if (can_message.use_extended_id) {
-      ESP_LOGD(TAG, "received can message (#%d) extended can_id=0x%" PRIx32 " size=%d", message_counter,
-               can_message.can_id, can_message.can_data_length_code);
-    } else {
-      ESP_LOGD(TAG, "received can message (#%d) std can_id=0x%" PRIx32 " size=%d", message_counter, can_message.can_id,
-               can_message.can_data_length_code);
+  for (size_t dispatched = 0; dispatched < MAX_FRAMES_PER_LOOP; dispatched++) {
+    // Empty the few receive buffers of the controller before running any trigger, so they don't overflow while the
+    // triggers of earlier frames run
+    while (this->rx_count_ < RX_QUEUE_SIZE &&
+           this->read_message(&this->rx_queue_[(this->rx_head_ + this->rx_count_) % RX_QUEUE_SIZE]) ==
+               canbus::ERROR_OK) {
+      this->rx_count_++;
     }
+    if (this->rx_count_ == 0)
+      break;
 
-    std::vector<uint8_t> data;
+    this->dispatch_(this->rx_queue_[this->rx_head_]);
+    this->rx_head_ = (this->rx_head_ + 1) % RX_QUEUE_SIZE;
+    this->rx_count_--;
+  }
+}
+
+void Canbus::dispatch_(const CanFrame &frame) {
+  if (frame.use_extended_id) {
+    ESP_LOGV(TAG, "received can message extended can_id=0x%" PRIx32 " size=%d", frame.can_id,
+             frame.can_data_length_code);
+  } else {
+    ESP_LOGV(TAG, "received can message std can_id=0x%" PRIx32 " size=%d", frame.can_id, frame.can_data_length_code);
+  }
 
-    // show data received
-    for (int i = 0; i < can_message.can_data_length_code; i++) {
-      ESP_LOGV(TAG, "  can_message.data[%d]=%02x", i, can_message.data[i]);
-      data.push_back(can_message.data[i]);
+  // The payload is only copied for frames that fire a trigger, into a buffer kept between frames
+  bool data_valid = false;
+  auto fire = [this, &frame, &data_valid](CanbusTrigger *trigger) {
+    if (!trigger->matches_(frame))
+      return;
+    if (!data_valid) {
+      this->data_.assign(frame.data, frame.data + frame.can_data_length_code);
+      data_valid = true;
     }
+    trigger->trigger(this->data_, frame.can_id, frame.remote_transmission_request);
+  };
 
-    // fire all triggers
-    for (auto *trigger : this->triggers_) {
-      if ((trigger->can_id_ == (can_message.can_id & trigger->can_id_mask_)) &&
-          (trigger->use_extended_id_ == can_message.use_extended_id) &&
-          (!trigger->remote_transmission_request_.has_value() ||
-           trigger->remote_transmission_request_.value() == can_message.remote_transmission_request)) {
-        trigger->trigger(data, can_message.can_id, can_message.remote_transmission_request);
-      }
+  const uint32_t key = frame.can_id | (frame.use_extended_id ? 0x80000000 : 0);
+  auto it = std::lower_bound(this->triggers_.begin(), this->triggers_.end(), key,
+                             [](const CanbusTrigger *trigger, uint32_t key) { return trigger->key_() < key; });
+  auto end = it;
+  while (end != this->triggers_.end() && (*end)->key_() == key)
+    end++;
+  // Both lists are in configuration order, merge them so the triggers fire in the order they were configured
+  auto masked = this->masked_triggers_.begin();
+  while (it != end || masked != this->masked_triggers_.end()) {
+    if (masked == this->masked_triggers_.end() || (it != end && (*it)->index_ < (*masked)->index_)) {
+      fire(*it++);
+    } else {
+      fire(*masked++);
     }
   }
 }
@@ -4,7 +4,9 @@
 #include "esphome/core/component.h"
 #include "esphome/core/optional.h"
 
+#include <array>
 #include <cinttypes>
+#include <functional>
 #include <vector>
 
 namespace esphome {
@@ -62,6 +64,24 @@ struct CanFrame {
   uint8_t data[CAN_MAX_DATA_LENGTH] __attribute__((aligned(8)));
 };
 
+/// Frames a receive filter lets through: those whose id matches can_id on all bits set in can_id_mask.
+struct CanFilter {
+  uint32_t can_id;
+  uint32_t can_id_mask;
+  bool use_extended_id;
+
+  /// Widen this filter so it also lets through the frames `other` lets through, both must use the same id type.
+  void merge(const CanFilter &other) {
+    this->can_id_mask &= other.can_id_mask & ~(this->can_id ^ other.can_id);
+    this->can_id &= this->can_id_mask;
+  }
+};
+
+/// Number of received frames buffered between the controller and the triggers.
+static const size_t RX_QUEUE_SIZE = 32;
+/// Most frames dispatched per loop, so a saturated bus doesn't starve the other components.
+static const size_t MAX_FRAMES_PER_LOOP = 64;
+
 class Canbus : public Component {
  public:
   Canbus(){};
@@ -84,11 +104,25 @@ class Canbus : public Component {
 
  protected:
   template<typename... Ts> friend class CanbusSendAction;
+  /// The filters the controller may apply to received frames, one per trigger. Only complete once the triggers are
+  /// registered, which is the case from setup_internal() on.
+  std::vector<CanFilter> get_filters_() const;
+  void dispatch_(const CanFrame &frame);
+
+  /// Triggers matching a single id, sorted by id type and id to be found by binary search.
   std::vector<CanbusTrigger *> triggers_{};
+  /// Triggers matching a range of ids, checked one by one.
+  std::vector<CanbusTrigger *> masked_triggers_{};
+  uint16_t trigger_count_{0};
+  std::vector<uint8_t> data_{};  ///< payload handed to the triggers, reused between frames
+  std::array<CanFrame, RX_QUEUE_SIZE> rx_queue_{};
+  size_t rx_head_{0};
+  size_t rx_count_{0};
   uint32_t can_id_;
   bool use_extended_id_;
   CanSpeed bit_rate_;
 
+  /// Set up the controller, dropping frames not matching any of get_filters_() in hardware where possible.
   virtual bool setup_internal();
   virtual Error send_message(struct CanFrame *frame);
   virtual Error read_message(struct CanFrame *frame);
@@ -140,20 +174,30 @@ class CanbusTrigger : public Trigger<std::vector<uint8_t>, uint32_t, bool>, publ
  public:
   explicit CanbusTrigger(Canbus *parent, const std::uint32_t can_id, const std::uint32_t can_id_mask,
                          const bool use_extended_id)
-      : parent_(parent), can_id_(can_id), can_id_mask_(can_id_mask), use_extended_id_(use_extended_id){};
+      : parent_(parent), can_id_(can_id), can_id_mask_(can_id_mask), use_extended_id_(use_extended_id) {
+    // Register right away so the parent knows all triggers when it sets up the hardware filters
+    this->parent_->add_trigger(this);
+  };
 
   void set_remote_transmission_request(bool remote_transmission_request) {
     this->remote_transmission_request_ = remote_transmission_request;
   }
 
-  void setup() override { this->parent_->add_trigger(this); }
-
  protected:
+  bool matches_(const CanFrame &frame) const {
+    return this->can_id_ == (frame.can_id & this->can_id_mask_) && this->use_extended_id_ == frame.use_extended_id &&
+           (!this->remote_transmission_request_.has_value() ||
+            this->remote_transmission_request_.value() == frame.remote_transmission_request);
+  }
+  /// Key the exact id triggers are sorted by.
+  uint32_t key_() const { return this->can_id_ | (this->use_extended_id_ ? 0x80000000 : 0); }
+
   Canbus *parent_;
   uint32_t can_id_;
   uint32_t can_id_mask_;
   bool use_extended_id_;
   optional<bool> remote_transmission_request_{};
+  uint16_t index_{0};  ///< position in the configuration, triggers matching the same frame fire in this order
 };
 
 }  // namespace canbus
@@ -106,11 +106,11 @@ void CoolixClimate::transmit_state() {
 }
 
 bool CoolixClimate::on_coolix(climate::Climate *parent, remote_base::RemoteReceiveData data) {
-  auto decoded = remote_base::CoolixProtocol().decode(data);
-  if (!decoded.has_value())
+  const auto *decoded = remote_base::decode_once<remote_base::CoolixProtocol>(data);
+  if (decoded == nullptr)
     return false;
   // Decoded remote state y 3 bytes long code.
-  uint32_t remote_state = (*decoded).second;
+  uint32_t remote_state = decoded->second;
   ESP_LOGV(TAG, "Decoded 0x%06" PRIX32, remote_state);
   if ((remote_state & 0xFF0000) != 0xB20000)
     return false;
@@ -128,7 +128,7 @@ async def setup_cover_core_(var, config):
     await setup_entity(var, config)
 
     if (device_class := config.get(CONF_DEVICE_CLASS)) is not None:
-        cg.add(var.set_device_class(device_class))
+        cg.add(var.set_device_class(cg.entity_string(device_class)))
 
     for conf in config.get(CONF_ON_OPEN, []):
         trigger = cg.new_Pvariable(conf[CONF_TRIGGER_ID], var)
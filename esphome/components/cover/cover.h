@@ -145,7 +145,9 @@ class Cover : public EntityBase, public EntityBase_DeviceClass {
   ESPDEPRECATED("stop() is deprecated, use make_call().set_command_stop().perform() instead.", "2021.9")
   void stop();
 
-  void add_on_state_callback(std::function<void()> &&f);
+  template<typename F> void add_on_state_callback(F &&callback) {
+    this->state_callback_.add(std::forward<F>(callback));
+  }
 
   /** Publish the current state of the cover.
    *
@@ -7,7 +7,6 @@ namespace dallas_temp {
 static const char *const TAG = "dallas.temp.sensor";
 
 static const uint8_t DALLAS_MODEL_DS18S20 = 0x10;
-static const uint8_t DALLAS_COMMAND_START_CONVERSION = 0x44;
 static const uint8_t DALLAS_COMMAND_READ_SCRATCH_PAD = 0xBE;
 static const uint8_t DALLAS_COMMAND_WRITE_SCRATCH_PAD = 0x4E;
 static const uint8_t DALLAS_COMMAND_COPY_SCRATCH_PAD = 0x48;
@@ -42,9 +41,12 @@ void DallasTemperatureSensor::update() {
 
   this->status_clear_warning();
 
-  this->send_command_(DALLAS_COMMAND_START_CONVERSION);
-
-  this->set_timeout(this->get_address_name(), this->millis_to_wait_for_conversion_(), [this] {
+  this->bus_->request_conversion(this->millis_to_wait_for_conversion_(), [this](bool success) {
+    if (!success) {
+      this->status_set_warning("bus reset failed");
+      this->publish_state(NAN);
+      return;
+    }
     if (!this->read_scratch_pad_() || !this->check_scratch_pad_()) {
       this->publish_state(NAN);
       return;
@@ -28,6 +28,14 @@ void DebugComponent::dump_config() {
 #if defined(USE_ESP8266) && USE_ARDUINO_VERSION_CODE >= VERSION_CODE(2, 5, 2)
   LOG_SENSOR("  ", "Heap fragmentation", this->fragmentation_sensor_);
 #endif  // defined(USE_ESP8266) && USE_ARDUINO_VERSION_CODE >= VERSION_CODE(2, 5, 2)
+#ifdef USE_MQTT
+  LOG_SENSOR("  ", "MQTT discovery published", this->mqtt_discovery_published_sensor_);
+  LOG_SENSOR("  ", "MQTT discovery skipped", this->mqtt_discovery_skipped_sensor_);
+  LOG_SENSOR("  ", "MQTT discovery pending", this->mqtt_discovery_pending_sensor_);
+#endif  // USE_MQTT
+#ifdef USE_I2C
+  LOG_SENSOR("  ", "I2C bus utilization", this->i2c_utilization_sensor_);
+#endif  // USE_I2C
 #endif  // USE_SENSOR
 
   std::string device_info;
@@ -83,6 +91,21 @@ void DebugComponent::update() {
     this->max_loop_time_ = 0;
   }
 
+#ifdef USE_MQTT
+  if (mqtt::global_mqtt_client != nullptr) {
+    if (this->mqtt_discovery_published_sensor_ != nullptr)
+      this->mqtt_discovery_published_sensor_->publish_state(mqtt::global_mqtt_client->get_discovery_published());
+    if (this->mqtt_discovery_skipped_sensor_ != nullptr)
+      this->mqtt_discovery_skipped_sensor_->publish_state(mqtt::global_mqtt_client->get_discovery_skipped());
+    if (this->mqtt_discovery_pending_sensor_ != nullptr)
+      this->mqtt_discovery_pending_sensor_->publish_state(mqtt::global_mqtt_client->get_discovery_pending());
+  }
+#endif  // USE_MQTT
+#ifdef USE_I2C
+  // Fraction of the time since the previous update the bus was transferring
+  if (this->i2c_utilization_sensor_ != nullptr)
+    this->i2c_utilization_sensor_->publish_state(this->i2c_bus_->get_utilization() * 100.0f);
+#endif  // USE_I2C
 #endif  // USE_SENSOR
   update_platform_();
 }
@@ -11,6 +11,12 @@
 #ifdef USE_TEXT_SENSOR
 #include "esphome/components/text_sensor/text_sensor.h"
 #endif
+#ifdef USE_MQTT
+#include "esphome/components/mqtt/mqtt_client.h"
+#endif
+#ifdef USE_I2C
+#include "esphome/components/i2c/i2c_bus.h"
+#endif
 
 namespace esphome {
 namespace debug {
@@ -36,6 +42,17 @@ class DebugComponent : public PollingComponent {
 #ifdef USE_ESP32
   void set_psram_sensor(sensor::Sensor *psram_sensor) { this->psram_sensor_ = psram_sensor; }
 #endif  // USE_ESP32
+#ifdef USE_MQTT
+  void set_mqtt_discovery_published_sensor(sensor::Sensor *sensor) { this->mqtt_discovery_published_sensor_ = sensor; }
+  void set_mqtt_discovery_skipped_sensor(sensor::Sensor *sensor) { this->mqtt_discovery_skipped_sensor_ = sensor; }
+  void set_mqtt_discovery_pending_sensor(sensor::Sensor *sensor) { this->mqtt_discovery_pending_sensor_ = sensor; }
+#endif  // USE_MQTT
+#ifdef USE_I2C
+  void set_i2c_utilization_sensor(i2c::I2CBus *bus, sensor::Sensor *sensor) {
+    this->i2c_bus_ = bus;
+    this->i2c_utilization_sensor_ = sensor;
+  }
+#endif  // USE_I2C
 #endif  // USE_SENSOR
  protected:
   uint32_t free_heap_{};
@@ -53,6 +70,15 @@ class DebugComponent : public PollingComponent {
 #ifdef USE_ESP32
   sensor::Sensor *psram_sensor_{nullptr};
 #endif  // USE_ESP32
+#ifdef USE_MQTT
+  sensor::Sensor *mqtt_discovery_published_sensor_{nullptr};
+  sensor::Sensor *mqtt_discovery_skipped_sensor_{nullptr};
+  sensor::Sensor *mqtt_discovery_pending_sensor_{nullptr};
+#endif  // USE_MQTT
+#ifdef USE_I2C
+  i2c::I2CBus *i2c_bus_{nullptr};
+  sensor::Sensor *i2c_utilization_sensor_{nullptr};
+#endif  // USE_I2C
 #endif  // USE_SENSOR
 
 #ifdef USE_TEXT_SENSOR
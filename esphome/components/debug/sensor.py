@@ -1,8 +1,9 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome.components import sensor
+from esphome.components import i2c, sensor
 from esphome.const import (
     CONF_FREE,
+    CONF_I2C_ID,
     CONF_FRAGMENTATION,
     CONF_BLOCK,
     CONF_LOOP_TIME,
@@ -18,6 +19,19 @@ from . import CONF_DEBUG_ID, DebugComponent
 DEPENDENCIES = ["debug"]
 
 CONF_PSRAM = "psram"
+CONF_MQTT_DISCOVERY_PUBLISHED = "mqtt_discovery_published"
+CONF_MQTT_DISCOVERY_SKIPPED = "mqtt_discovery_skipped"
+CONF_MQTT_DISCOVERY_PENDING = "mqtt_discovery_pending"
+CONF_I2C_UTILIZATION = "i2c_utilization"
+
+MQTT_DISCOVERY_SCHEMA = cv.All(
+    cv.requires_component("mqtt"),
+    sensor.sensor_schema(
+        icon=ICON_COUNTER,
+        accuracy_decimals=0,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    ),
+)
 
 CONFIG_SCHEMA = {
     cv.GenerateID(CONF_DEBUG_ID): cv.use_id(DebugComponent),
@@ -59,6 +73,18 @@ CONFIG_SCHEMA = {
             entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
         ),
     ),
+    cv.Optional(CONF_MQTT_DISCOVERY_PUBLISHED): MQTT_DISCOVERY_SCHEMA,
+    cv.Optional(CONF_MQTT_DISCOVERY_SKIPPED): MQTT_DISCOVERY_SCHEMA,
+    cv.Optional(CONF_MQTT_DISCOVERY_PENDING): MQTT_DISCOVERY_SCHEMA,
+    cv.Optional(CONF_I2C_UTILIZATION): cv.All(
+        cv.requires_component("i2c"),
+        sensor.sensor_schema(
+            unit_of_measurement=UNIT_PERCENT,
+            icon=ICON_TIMER,
+            accuracy_decimals=1,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ).extend({cv.GenerateID(CONF_I2C_ID): cv.use_id(i2c.I2CBus)}),
+    ),
 }
 
 
@@ -84,3 +110,20 @@ async def to_code(config):
     if psram_conf := config.get(CONF_PSRAM):
         sens = await sensor.new_sensor(psram_conf)
         cg.add(debug_component.set_psram_sensor(sens))
+
+    if published_conf := config.get(CONF_MQTT_DISCOVERY_PUBLISHED):
+        sens = await sensor.new_sensor(published_conf)
+        cg.add(debug_component.set_mqtt_discovery_published_sensor(sens))
+
+    if skipped_conf := config.get(CONF_MQTT_DISCOVERY_SKIPPED):
+        sens = await sensor.new_sensor(skipped_conf)
+        cg.add(debug_component.set_mqtt_discovery_skipped_sensor(sens))
+
+    if pending_conf := config.get(CONF_MQTT_DISCOVERY_PENDING):
+        sens = await sensor.new_sensor(pending_conf)
+        cg.add(debug_component.set_mqtt_discovery_pending_sensor(sens))
+
+    if i2c_conf := config.get(CONF_I2C_UTILIZATION):
+        sens = await sensor.new_sensor(i2c_conf)
+        bus = await cg.get_variable(i2c_conf[CONF_I2C_ID])
+        cg.add(debug_component.set_i2c_utilization_sensor(bus, sens))
@@ -4,6 +4,10 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/log.h"
 #include <nvs_flash.h>
+#ifdef USE_PREFERENCES_LOG
+#include "esphome/components/preferences/log_preferences.h"
+#include <esp_partition.h>
+#endif
 #include <cstring>
 #include <cinttypes>
 #include <vector>
@@ -184,7 +188,42 @@ class ESP32Preferences : public ESPPreferences {
   }
 };
 
+#ifdef USE_PREFERENCES_LOG
+class ESP32LogFlash : public preferences::LogFlash {
+ public:
+  explicit ESP32LogFlash(const esp_partition_t *partition) : partition_(partition) {}
+  size_t get_sector_size() const override { return SECTOR_SIZE; }
+  size_t get_sector_count() const override { return this->partition_->size / SECTOR_SIZE; }
+  bool read(size_t offset, void *data, size_t len) override {
+    return esp_partition_read(this->partition_, offset, data, len) == ESP_OK;
+  }
+  bool write(size_t offset, const void *data, size_t len) override {
+    return esp_partition_write(this->partition_, offset, data, len) == ESP_OK;
+  }
+  bool erase(size_t sector) override {
+    return esp_partition_erase_range(this->partition_, sector * SECTOR_SIZE, SECTOR_SIZE) == ESP_OK;
+  }
+
+ protected:
+  static const size_t SECTOR_SIZE = 4096;
+  const esp_partition_t *partition_;
+};
+#endif
+
 void setup_preferences() {
+#ifdef USE_PREFERENCES_LOG
+  // Without the partition the preferences stay in NVS, IntervalSyncer::dump_config() tells about it
+  const esp_partition_t *partition =
+      esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, "prefs");
+  if (partition != nullptr) {
+    auto *log_prefs = new preferences::LogPreferences(new ESP32LogFlash(partition));  // NOLINT
+    if (log_prefs->setup()) {
+      preferences::global_log_preferences = log_prefs;
+      global_preferences = log_prefs;
+      return;
+    }
+  }
+#endif
   auto *prefs = new ESP32Preferences();  // NOLINT(cppcoreguidelines-owning-memory)
   prefs->open();
   global_preferences = prefs;
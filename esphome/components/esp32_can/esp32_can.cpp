@@ -4,6 +4,8 @@
 
 #include <driver/twai.h>
 
+#include <algorithm>
+
 // WORKAROUND, because CAN_IO_UNUSED is just defined as (-1) in this version
 // of the framework which does not work with -fpermissive
 #undef CAN_IO_UNUSED
@@ -77,6 +79,23 @@ bool ESP32Can::setup_internal() {
   }
 
   twai_filter_config_t f_config = TWAI_FILTER_CONFIG_ACCEPT_ALL();
+  // The single acceptance filter is applied to standard and extended frames alike, so it can only be narrowed when
+  // all triggers use the same id type. The acceptance mask has a bit set for every bit to ignore.
+  const std::vector<canbus::CanFilter> filters = this->get_filters_();
+  if (!filters.empty() && std::all_of(filters.begin(), filters.end(), [&filters](const canbus::CanFilter &filter) {
+        return filter.use_extended_id == filters[0].use_extended_id;
+      })) {
+    canbus::CanFilter filter = filters[0];
+    for (const auto &other : filters)
+      filter.merge(other);
+    const int shift = filter.use_extended_id ? 3 : 21;
+    const uint32_t id_mask = filter.use_extended_id ? 0x1FFFFFFF : 0x7FF;
+    f_config.acceptance_code = (filter.can_id & id_mask) << shift;
+    f_config.acceptance_mask = ~((filter.can_id_mask & id_mask) << shift);
+    f_config.single_filter = true;
+    ESP_LOGV(TAG, "acceptance code=0x%08" PRIx32 " mask=0x%08" PRIx32, f_config.acceptance_code,
+             f_config.acceptance_mask);
+  }
   twai_timing_config_t t_config;
 
   if (!get_bitrate(this->bit_rate_, &t_config)) {
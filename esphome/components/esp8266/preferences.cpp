@@ -12,7 +12,7 @@ extern "C" {
 #include "preferences.h"
 
 #include <cstring>
-#include <vector>
+#include <memory>
 
 namespace esphome {
 namespace esp8266 {
@@ -115,6 +115,30 @@ static bool load_from_rtc(size_t offset, uint32_t *data, size_t len) {
   return true;
 }
 
+/// Zeroed words for a preference and its CRC, on the stack unless the preference is unusually large.
+class PreferenceBuffer {
+ public:
+  explicit PreferenceBuffer(size_t size) : size_(size) {
+    if (size > STACK_WORDS) {
+      this->heap_.reset(new uint32_t[size]);  // NOLINT(cppcoreguidelines-owning-memory)
+      this->data_ = this->heap_.get();
+    }
+    memset(this->data_, 0, size * sizeof(uint32_t));
+  }
+  uint32_t *data() { return this->data_; }
+  size_t size() const { return this->size_; }
+  uint32_t *begin() { return this->data_; }
+  uint32_t *end() { return this->data_ + this->size_; }
+  uint32_t &operator[](size_t index) { return this->data_[index]; }
+
+ protected:
+  static const size_t STACK_WORDS = 16;
+  uint32_t stack_[STACK_WORDS];
+  std::unique_ptr<uint32_t[]> heap_;
+  uint32_t *data_{stack_};
+  size_t size_;
+};
+
 class ESP8266PreferenceBackend : public ESPPreferenceBackend {
  public:
   size_t offset = 0;
@@ -126,8 +150,7 @@ class ESP8266PreferenceBackend : public ESPPreferenceBackend {
     if ((len + 3) / 4 != length_words) {
       return false;
     }
-    std::vector<uint32_t> buffer;
-    buffer.resize(length_words + 1);
+    PreferenceBuffer buffer(length_words + 1);
     memcpy(buffer.data(), data, len);
     buffer[buffer.size() - 1] = calculate_crc(buffer.begin(), buffer.end() - 1, type);
 
@@ -141,8 +164,7 @@ class ESP8266PreferenceBackend : public ESPPreferenceBackend {
     if ((len + 3) / 4 != length_words) {
       return false;
     }
-    std::vector<uint32_t> buffer;
-    buffer.resize(length_words + 1);
+    PreferenceBuffer buffer(length_words + 1);
     bool ret;
     if (in_flash) {
       ret = load_from_flash(offset, buffer.data(), buffer.size());
@@ -91,7 +91,7 @@ async def setup_event_core_(var, config, *, event_types: list[str]):
     cg.add(var.set_event_types(event_types))
 
     if (device_class := config.get(CONF_DEVICE_CLASS)) is not None:
-        cg.add(var.set_device_class(device_class))
+        cg.add(var.set_device_class(cg.entity_string(device_class)))
 
     if mqtt_id := config.get(CONF_MQTT_ID):
         mqtt_ = cg.new_Pvariable(mqtt_id, var)
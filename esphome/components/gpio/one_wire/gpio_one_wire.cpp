@@ -13,7 +13,19 @@ void GPIOOneWireBus::setup() {
   // clear bus with 480µs high, otherwise initial reset in search might fail
   this->t_pin_->pin_mode(gpio::FLAG_INPUT | gpio::FLAG_PULLUP);
   delayMicroseconds(480);
-  this->search();
+  // use the devices found during the previous boot right away, and confirm them once everything is set up
+  if (this->load_devices_(fnv1_hash("gpio_one_wire_" + to_string(this->t_pin_->get_pin())))) {
+    this->defer([this]() {
+      if (this->validate_devices_())
+        return;
+      ESP_LOGW(TAG, "Devices on the bus changed since the previous boot, searching again");
+      this->search();
+      this->save_devices_();
+    });
+  } else {
+    this->search();
+    this->save_devices_();
+  }
 }
 
 void GPIOOneWireBus::dump_config() {
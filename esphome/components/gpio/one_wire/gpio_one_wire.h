@@ -11,6 +11,7 @@ class GPIOOneWireBus : public one_wire::OneWireBus, public Component {
  public:
   void setup() override;
   void dump_config() override;
+  void loop() override { this->process_conversions_(); }
   float get_setup_priority() const override { return setup_priority::BUS; }
 
   void set_pin(InternalGPIOPin *pin) {
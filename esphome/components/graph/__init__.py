@@ -62,6 +62,7 @@ VALUE_POSITION_TYPE = {
 }
 
 CONF_CONTINUOUS = "continuous"
+CONF_SHOW_MIN_MAX = "show_min_max"
 
 GRAPH_TRACE_SCHEMA = cv.Schema(
     {
@@ -72,6 +73,7 @@ GRAPH_TRACE_SCHEMA = cv.Schema(
         cv.Optional(CONF_LINE_TYPE): cv.enum(LINE_TYPE, upper=True),
         cv.Optional(CONF_COLOR): cv.use_id(color.ColorStruct),
         cv.Optional(CONF_CONTINUOUS): cv.boolean,
+        cv.Optional(CONF_SHOW_MIN_MAX): cv.boolean,
     }
 )
 
@@ -190,6 +192,8 @@ async def to_code(config):
             cg.add(tr.set_line_color(c))
         if CONF_CONTINUOUS in trace:
             cg.add(tr.set_continuous(trace[CONF_CONTINUOUS]))
+        if CONF_SHOW_MIN_MAX in trace:
+            cg.add(tr.set_show_min_max(trace[CONF_SHOW_MIN_MAX]))
         cg.add(var.add_trace(tr))
     # Add legend
     if CONF_LEGEND in config:
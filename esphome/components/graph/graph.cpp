@@ -15,43 +15,90 @@ using namespace display;
 static const char *const TAG = "graph";
 static const char *const TAGL = "graphlegend";
 
-void HistoryData::init(int length) {
+void HistoryData::init(int length, bool min_max) {
   this->length_ = length;
   this->samples_.resize(length, NAN);
+  if (min_max)
+    this->ranges_.resize(length, Range{NAN, NAN});
   this->last_sample_ = millis();
 }
 
+static void extend_range(float *min, float *max, float value_min, float value_max) {
+  if (std::isnan(value_min))
+    return;
+  if (std::isnan(*min) || value_min < *min)
+    *min = value_min;
+  if (std::isnan(*max) || value_max > *max)
+    *max = value_max;
+}
+
 void HistoryData::take_sample(float data) {
   uint32_t tm = millis();
   uint32_t dt = tm - last_sample_;
   last_sample_ = tm;
 
+  if (!std::isnan(data)) {
+    extend_range(&this->open_min_, &this->open_max_, data, data);
+    this->open_sum_ += data;
+    this->open_count_++;
+  }
+
   // Step data based on time
   this->period_ += dt;
+  bool first = true;
   while (this->period_ >= this->update_time_) {
-    this->samples_[this->count_] = data;
+    if (first && this->open_count_ > 0) {
+      this->write_column_(this->open_sum_ / this->open_count_, this->open_min_, this->open_max_);
+    } else {
+      // Columns skipped since the previous sample
+      this->write_column_(data, data, data);
+    }
+    first = false;
+    this->open_min_ = NAN;
+    this->open_max_ = NAN;
+    this->open_sum_ = 0;
+    this->open_count_ = 0;
     this->period_ -= this->update_time_;
-    this->count_ = (this->count_ + 1) % this->length_;
     ESP_LOGV(TAG, "Updating trace with value: %f", data);
   }
-  if (!std::isnan(data)) {
-    // Recalc recent max/min
-    this->recent_min_ = data;
-    this->recent_max_ = data;
+  this->update_recent_();
+}
+
+void HistoryData::write_column_(float avg, float min, float max) {
+  const int written = this->count_;
+  const Range old = this->column_range_(written);
+  this->samples_[written] = avg;
+  if (!this->ranges_.empty())
+    this->ranges_[written] = Range{min, max};
+  this->count_ = (this->count_ + 1) % this->length_;
+
+  const Range range = this->column_range_(written);
+  Range &all = this->columns_range_;
+  if (!std::isnan(old.min) && (old.min <= all.min || old.max >= all.max)) {
+    // The column held the minimum or maximum of all columns, which may be gone now
+    all = Range{NAN, NAN};
     for (int i = 0; i < this->length_; i++) {
-      if (!std::isnan(this->samples_[i])) {
-        if (this->recent_max_ < this->samples_[i])
-          this->recent_max_ = this->samples_[i];
-        if (this->recent_min_ > this->samples_[i])
-          this->recent_min_ = this->samples_[i];
-      }
+      const Range column = this->column_range_(i);
+      extend_range(&all.min, &all.max, column.min, column.max);
     }
+  } else {
+    extend_range(&all.min, &all.max, range.min, range.max);
+  }
+}
+
+void HistoryData::update_recent_() {
+  float min = this->columns_range_.min;
+  float max = this->columns_range_.max;
+  extend_range(&min, &max, this->open_min_, this->open_max_);
+  if (!std::isnan(min)) {
+    this->recent_min_ = min;
+    this->recent_max_ = max;
   }
 }
 
 void GraphTrace::init(Graph *g) {
   ESP_LOGI(TAG, "Init trace for sensor %s", this->get_name().c_str());
-  this->data_.init(g->get_width());
+  this->data_.init(g->get_width(), this->show_min_max_);
   sensor_->add_on_state_callback([this](float state) { this->data_.take_sample(state); });
   this->data_.set_update_time_ms(g->get_duration() * 1000 / g->get_width());
 }
@@ -162,50 +209,69 @@ void Graph::draw(Display *buff, uint16_t x_offset, uint16_t y_offset, Color colo
 
   /// Draw traces
   ESP_LOGV(TAG, "Updating graph. ymin %f, ymax %f", ymin, ymax);
+  const int y_end = y_offset + this->height_;
   for (auto *trace : traces_) {
     Color c = trace->get_line_color();
     int16_t thick = trace->get_line_thickness();
+    if (thick <= 0)
+      continue;
+    const HistoryData &data = trace->data_;
+    const uint8_t line_type = trace->get_line_type();
+    const int pattern_length = thick * LineType::PATTERN_LENGTH;
     bool continuous = trace->get_continuous();
     bool has_prev = false;
     bool prev_b = false;
-    int16_t prev_y = 0;
+    int16_t prev_top = 0;
+    int16_t prev_bottom = 0;
+    // Vertical runs of pixels, clipped to the graph
+    auto draw_span = [buff, c, y_offset, y_end](int16_t x, int top, int bottom) {
+      top = std::max<int>(top, y_offset);
+      bottom = std::min(bottom, y_end - 1);
+      if (top <= bottom)
+        buff->vertical_line(x, top, bottom - top + 1, c);
+    };
+    auto to_y = [this, ymin, yrange, thick, y_offset](float value) -> int16_t {
+      float v = (value - ymin) / yrange;
+      return (int16_t) roundf((this->height_ - 1) * (1.0 - v)) - thick / 2 + y_offset;
+    };
+    // Walk the columns from the newest one without taking the modulo for every one
+    const bool min_max = !data.ranges_.empty();
+    int column = data.index_(0);
+    int pattern_pos = 0;
     for (uint32_t i = 0; i < this->width_; i++) {
-      float v = (trace->get_tracedata()->get_value(i) - ymin) / yrange;
-      if (!std::isnan(v) && (thick > 0)) {
-        int16_t x = this->width_ - 1 - i + x_offset;
-        uint8_t bit = 1 << ((i % (thick * LineType::PATTERN_LENGTH)) / thick);
-        bool b = (trace->get_line_type() & bit) == bit;
-        if (b) {
-          int16_t y = (int16_t) roundf((this->height_ - 1) * (1.0 - v)) - thick / 2 + y_offset;
-          auto draw_pixel_at = [&buff, c, y_offset, this](int16_t x, int16_t y) {
-            if (y >= y_offset && y < y_offset + this->height_)
-              buff->draw_pixel_at(x, y, c);
-          };
-          if (!continuous || !has_prev || !prev_b || (abs(y - prev_y) <= thick)) {
-            for (int16_t t = 0; t < thick; t++) {
-              draw_pixel_at(x, y + t);
-            }
-          } else {
-            int16_t mid_y = (y + prev_y + thick) / 2;
-            if (y > prev_y) {
-              for (int16_t t = prev_y + thick; t <= mid_y; t++)
-                draw_pixel_at(x + 1, t);
-              for (int16_t t = mid_y + 1; t < y + thick; t++)
-                draw_pixel_at(x, t);
-            } else {
-              for (int16_t t = prev_y - 1; t >= mid_y; t--)
-                draw_pixel_at(x + 1, t);
-              for (int16_t t = mid_y - 1; t >= y; t--)
-                draw_pixel_at(x, t);
-            }
-          }
-          prev_y = y;
-        }
-        prev_b = b;
-        has_prev = true;
-      } else {
+      const float avg = data.samples_[column];
+      const HistoryData::Range sample = min_max ? data.ranges_[column] : HistoryData::Range{avg, avg};
+      column = column == 0 ? data.length_ - 1 : column - 1;
+      const int pos = pattern_pos;
+      pattern_pos = pattern_pos + 1 == pattern_length ? 0 : pattern_pos + 1;
+      if (std::isnan(avg) || std::isnan((avg - ymin) / yrange)) {
         has_prev = false;
+        continue;
+      }
+      int16_t x = this->width_ - 1 - i + x_offset;
+      uint8_t bit = 1 << (pos / thick);
+      bool b = (line_type & bit) == bit;
+      if (b) {
+        // The column covers all samples taken during its period
+        const int16_t top = to_y(sample.max);
+        const int16_t bottom = to_y(sample.min) + thick - 1;
+        if (!continuous || !has_prev || !prev_b || (top <= prev_bottom + 1 && bottom + 1 >= prev_top)) {
+          draw_span(x, top, bottom);
+        } else if (top > prev_bottom) {
+          // Connect to the previous column, the upper half of the step is drawn there
+          int16_t mid_y = (top + prev_bottom + 1) / 2;
+          draw_span(x + 1, prev_bottom + 1, mid_y);
+          draw_span(x, mid_y + 1, bottom);
+        } else {
+          int16_t mid_y = (bottom + 1 + prev_top) / 2;
+          draw_span(x + 1, mid_y, prev_top - 1);
+          draw_span(x, top, mid_y - 1);
+        }
+        prev_top = top;
+        prev_bottom = bottom;
       }
+      prev_b = b;
+      has_prev = true;
     }
   }
 }
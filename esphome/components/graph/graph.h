@@ -83,18 +83,40 @@ class GraphLegend {
   friend Graph;
 };
 
+/** Samples of a trace, one column per pixel.
+ *
+ * Every column keeps the average of the samples taken during its period, and their minimum and maximum if they are
+ * drawn. The range of all columns is kept up to date as columns are written, so it is only rescanned when the column
+ * that is overwritten held its minimum or maximum.
+ */
 class HistoryData {
  public:
-  void init(int length);
-  ~HistoryData();
+  void init(int length, bool min_max = false);
   void set_update_time_ms(uint32_t update_time_ms) { update_time_ = update_time_ms; }
   void take_sample(float data);
   int get_length() const { return length_; }
-  float get_value(int idx) const { return samples_[(count_ + length_ - 1 - idx) % length_]; }
+  /// Average of the samples of a column, idx 0 is the newest one
+  float get_value(int idx) const { return samples_[this->index_(idx)]; }
+  /// Minimum of the samples of a column, its average if only averages are kept
+  float get_min(int idx) const { return ranges_.empty() ? this->get_value(idx) : ranges_[this->index_(idx)].min; }
+  /// Maximum of the samples of a column, its average if only averages are kept
+  float get_max(int idx) const { return ranges_.empty() ? this->get_value(idx) : ranges_[this->index_(idx)].max; }
   float get_recent_max() const { return recent_max_; }
   float get_recent_min() const { return recent_min_; }
 
  protected:
+  struct Range {
+    float min;
+    float max;
+  };
+
+  int index_(int idx) const { return (count_ + length_ - 1 - idx) % length_; }
+  Range column_range_(int index) const {
+    return ranges_.empty() ? Range{samples_[index], samples_[index]} : ranges_[index];
+  }
+  void write_column_(float avg, float min, float max);
+  void update_recent_();
+
   uint32_t last_sample_;
   uint32_t period_{0};       /// in ms
   uint32_t update_time_{0};  /// in ms
@@ -103,6 +125,17 @@ class HistoryData {
   float recent_min_{NAN};
   float recent_max_{NAN};
   std::vector<float> samples_;
+  /// Minimum and maximum of every column, empty unless they are drawn
+  std::vector<Range> ranges_;
+  /// Range of all columns
+  Range columns_range_{NAN, NAN};
+  // Samples of the column that is not written yet
+  float open_min_{NAN};
+  float open_max_{NAN};
+  float open_sum_{0};
+  uint32_t open_count_{0};
+
+  friend Graph;
 };
 
 class GraphTrace {
@@ -118,6 +151,9 @@ class GraphTrace {
   void set_line_color(Color val) { this->line_color_ = val; }
   bool get_continuous() { return this->continuous_; }
   void set_continuous(bool continuous) { this->continuous_ = continuous; }
+  /// Draw the minimum to maximum of the samples of every column instead of their average, which takes three times the
+  /// memory per column.
+  void set_show_min_max(bool show_min_max) { this->show_min_max_ = show_min_max; }
   std::string get_name() { return name_; }
   const HistoryData *get_tracedata() { return &data_; }
 
@@ -128,6 +164,7 @@ class GraphTrace {
   enum LineType line_type_ { LINE_TYPE_SOLID };
   Color line_color_{COLOR_ON};
   bool continuous_{false};
+  bool show_min_max_{false};
   HistoryData data_;
 
   friend Graph;
@@ -86,13 +86,28 @@ void HMC5883LComponent::dump_config() {
 }
 float HMC5883LComponent::get_setup_priority() const { return setup_priority::DATA; }
 void HMC5883LComponent::update() {
-  uint16_t raw_x, raw_y, raw_z;
-  if (!this->read_byte_16(HMC5883L_REGISTER_DATA_X_MSB, &raw_x) ||
-      !this->read_byte_16(HMC5883L_REGISTER_DATA_Y_MSB, &raw_y) ||
-      !this->read_byte_16(HMC5883L_REGISTER_DATA_Z_MSB, &raw_z)) {
+  // The register pointer increments while reading, so the bus reads all three axes in one transfer
+  this->read_failed_ = false;
+  auto on_read = [this](i2c::ErrorCode err) { this->read_failed_ |= err != i2c::ERROR_OK; };
+  this->read_register_async(HMC5883L_REGISTER_DATA_X_MSB, this->raw_data_, 2, on_read, true);
+  this->read_register_async(HMC5883L_REGISTER_DATA_Z_MSB, this->raw_data_ + 2, 2, on_read, true);
+  this->read_register_async(
+      HMC5883L_REGISTER_DATA_Y_MSB, this->raw_data_ + 4, 2,
+      [this, on_read](i2c::ErrorCode err) {
+        on_read(err);
+        this->publish_data_();
+      },
+      true);
+}
+
+void HMC5883LComponent::publish_data_() {
+  if (this->read_failed_) {
     this->status_set_warning();
     return;
   }
+  const uint16_t raw_x = encode_uint16(this->raw_data_[0], this->raw_data_[1]);
+  const uint16_t raw_z = encode_uint16(this->raw_data_[2], this->raw_data_[3]);
+  const uint16_t raw_y = encode_uint16(this->raw_data_[4], this->raw_data_[5]);
 
   float mg_per_bit;
   switch (this->range_) {
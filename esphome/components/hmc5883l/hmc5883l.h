@@ -51,6 +51,9 @@ class HMC5883LComponent : public PollingComponent, public i2c::I2CDevice {
   void set_heading_sensor(sensor::Sensor *heading_sensor) { heading_sensor_ = heading_sensor; }
 
  protected:
+  /// Convert and publish raw_data_ once the queued reads of update() completed.
+  void publish_data_();
+
   HMC5883LOversampling oversampling_{HMC5883L_OVERSAMPLING_1};
   HMC5883LDatarate datarate_{HMC5883L_DATARATE_15_0_HZ};
   HMC5883LRange range_{HMC5883L_RANGE_130_UT};
@@ -64,6 +67,9 @@ class HMC5883LComponent : public PollingComponent, public i2c::I2CDevice {
     ID_REGISTERS,
   } error_code_;
   HighFrequencyLoopRequester high_freq_;
+  /// Data registers X, Z and Y, most significant byte first, filled by the bus.
+  uint8_t raw_data_[6];
+  bool read_failed_{false};
 };
 
 }  // namespace hmc5883l
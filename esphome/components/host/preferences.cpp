@@ -4,6 +4,19 @@
 #include <fstream>
 #include "preferences.h"
 #include "esphome/core/application.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef USE_PREFERENCES_LOG
+#include "esphome/components/preferences/log_preferences.h"
+#endif
 
 namespace esphome {
 namespace host {
@@ -11,9 +24,62 @@ namespace fs = std::filesystem;
 
 static const char *const TAG = "host.preferences";
 
+static const uint32_t FILE_MAGIC = 0x50E5F11E;
+static const uint32_t FILE_VERSION = 1;
+static const uint8_t RECORD_VALUE = 1;
+/// Ends a batch of records, the key holds the CRC of the records of the batch.
+static const uint8_t RECORD_COMMIT = 2;
+static const size_t MIN_FILE_SIZE = 16384;
+/// The file is rewritten once it is larger than this and than twice the size of the current records.
+static const size_t MIN_REWRITE_SIZE = 65536;
+
+struct FileHeader {
+  uint32_t magic;
+  uint32_t version;
+};
+
+// The space after the last batch is zeroed, a type of 0 ends the records
+struct RecordHeader {
+  uint32_t key;
+  uint16_t len;
+  uint8_t type;
+  uint8_t reserved;
+};
+
+static size_t record_size(size_t len) { return (sizeof(RecordHeader) + len + 3) & ~size_t(3); }
+
+/// Writes a record to `dest`, which must hold record_size(len) bytes, and returns its size.
+static size_t write_record(uint8_t *dest, uint32_t key, uint8_t type, const uint8_t *data, size_t len) {
+  RecordHeader header{key, (uint16_t) len, type, 0};
+  const size_t size = record_size(len);
+  memcpy(dest, &header, sizeof(header));
+  if (len != 0)
+    memcpy(dest + sizeof(header), data, len);
+  memset(dest + sizeof(header) + len, 0, size - sizeof(header) - len);
+  return size;
+}
+
+static uint32_t crc32(const uint8_t *data, size_t len) {
+  uint32_t crc = 0xFFFFFFFF;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; bit++)
+      crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+  }
+  return ~crc;
+}
+
+static size_t file_size_for(size_t used) {
+  size_t size = MIN_FILE_SIZE;
+  while (size < used * 2)
+    size *= 2;
+  return size;
+}
+
 void HostPreferences::setup_() {
   if (this->setup_complete_)
     return;
+  this->setup_complete_ = true;
   this->filename_.append(getenv("HOME"));
   this->filename_.append("/.esphome");
   this->filename_.append("/prefs");
@@ -21,44 +87,295 @@ void HostPreferences::setup_() {
   this->filename_.append("/");
   this->filename_.append(App.get_name());
   this->filename_.append(".prefs");
-  FILE *fp = fopen(this->filename_.c_str(), "rb");
-  if (fp != nullptr) {
-    while (!feof((fp))) {
-      uint32_t key;
-      uint8_t len;
-      if (fread(&key, sizeof(key), 1, fp) != 1)
-        break;
-      if (fread(&len, sizeof(len), 1, fp) != 1)
-        break;
-      uint8_t data[len];
-      if (fread(data, sizeof(uint8_t), len, fp) != len)
-        break;
-      std::vector vec(data, data + len);
-      this->data[key] = vec;
+
+  int fd = open(this->filename_.c_str(), O_RDWR);
+  struct stat st;
+  if (fd >= 0 && (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(FileHeader))) {
+    close(fd);
+    fd = -1;
+  }
+  if (fd >= 0 && this->open_map_(fd, st.st_size)) {
+    FileHeader header;
+    memcpy(&header, this->map_, sizeof(header));
+    if (header.magic == FILE_MAGIC && header.version == FILE_VERSION && this->replay_())
+      return;
+    // Files written before the log was introduced are converted, the values go to the new file right away
+    if (header.magic != FILE_MAGIC)
+      this->load_legacy_();
+  }
+  if (!this->rewrite_()) {
+    ESP_LOGE(TAG, "Can't create %s: %s", this->filename_.c_str(), strerror(errno));
+    // Without a valid log, sync() must not append to whatever is mapped; the values stay in memory
+    this->unmap_();
+  }
+}
+
+void HostPreferences::load_legacy_() {
+  size_t offset = 0;
+  while (offset + sizeof(uint32_t) + 1 <= this->map_size_) {
+    uint32_t key;
+    memcpy(&key, this->map_ + offset, sizeof(key));
+    const uint8_t len = this->map_[offset + sizeof(key)];
+    offset += sizeof(key) + 1;
+    if (offset + len > this->map_size_)
+      break;
+    auto &value = this->values_[key];
+    if (!value.dirty)
+      this->dirty_keys_.push_back(key);
+    value = Value{std::vector<uint8_t>(this->map_ + offset, this->map_ + offset + len), true};
+    offset += len;
+  }
+  ESP_LOGI(TAG, "Converted %u preferences from the previous file format", (unsigned) this->values_.size());
+}
+
+bool HostPreferences::replay_() {
+  std::vector<std::pair<uint32_t, Location>> batch;
+  size_t offset = sizeof(FileHeader);
+  this->end_ = offset;
+  while (offset + sizeof(RecordHeader) <= this->map_size_) {
+    RecordHeader header;
+    memcpy(&header, this->map_ + offset, sizeof(header));
+    const size_t size = record_size(header.len);
+    if (offset + size > this->map_size_)
+      break;
+    if (header.type == RECORD_VALUE) {
+      batch.emplace_back(header.key, Location{offset + sizeof(header), header.len});
+    } else if (header.type == RECORD_COMMIT && header.key == crc32(this->map_ + this->end_, offset - this->end_)) {
+      for (auto &it : batch) {
+        auto existing = this->index_.find(it.first);
+        if (existing != this->index_.end())
+          this->live_bytes_ -= record_size(existing->second.len);
+        this->live_bytes_ += record_size(it.second.len);
+        this->index_[it.first] = it.second;
+      }
+      batch.clear();
+      this->end_ = offset + size;
+    } else {
+      break;
     }
-    fclose(fp);
+    offset += size;
   }
-  this->setup_complete_ = true;
+
+  // Clear what an interrupted sync() left behind, so it can't be taken for records later
+  const uint8_t *tail = this->map_ + this->end_;
+  const size_t tail_size = this->map_size_ - this->end_;
+  if (tail_size != 0 && (tail[0] != 0 || memcmp(tail, tail + 1, tail_size - 1) != 0)) {
+    ESP_LOGW(TAG, "Discarding an incomplete sync");
+    memset(this->map_ + this->end_, 0, tail_size);
+    if (msync(this->map_, this->map_size_, MS_SYNC) != 0)
+      return false;
+  }
+  ESP_LOGD(TAG, "Loaded %u preferences, %u of %u bytes used", (unsigned) this->index_.size(), (unsigned) this->end_,
+           (unsigned) this->map_size_);
+  return true;
+}
+
+bool HostPreferences::open_map_(int fd, size_t size) {
+  void *map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (map == MAP_FAILED) {
+    close(fd);
+    return false;
+  }
+  this->fd_ = fd;
+  this->map_ = static_cast<uint8_t *>(map);
+  this->map_size_ = size;
+  return true;
+}
+
+void HostPreferences::unmap_() {
+  if (this->map_ != nullptr)
+    munmap(this->map_, this->map_size_);
+  if (this->fd_ >= 0)
+    close(this->fd_);
+  this->map_ = nullptr;
+  this->map_size_ = 0;
+  this->fd_ = -1;
+}
+
+bool HostPreferences::reserve_(size_t size) {
+  if (size <= this->map_size_)
+    return true;
+  const size_t new_size = file_size_for(size);
+  // The offsets in the index stay valid, the file is only extended
+  munmap(this->map_, this->map_size_);
+  const bool extended = ftruncate(this->fd_, new_size) == 0;
+  const size_t map_size = extended ? new_size : this->map_size_;
+  void *map = mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, this->fd_, 0);
+  if (map == MAP_FAILED) {
+    this->map_ = nullptr;
+    this->map_size_ = 0;
+    return false;
+  }
+  this->map_ = static_cast<uint8_t *>(map);
+  this->map_size_ = map_size;
+  return extended;
+}
+
+bool HostPreferences::rewrite_() {
+  std::vector<uint8_t> content(sizeof(FileHeader));
+  const FileHeader file_header{FILE_MAGIC, FILE_VERSION};
+  memcpy(content.data(), &file_header, sizeof(file_header));
+  std::unordered_map<uint32_t, Location> index;
+  index.reserve(this->index_.size() + this->dirty_keys_.size());
+  auto add = [&](uint32_t key, const uint8_t *data, size_t len) {
+    const size_t offset = content.size();
+    content.resize(offset + record_size(len));
+    write_record(content.data() + offset, key, RECORD_VALUE, data, len);
+    index[key] = Location{offset + sizeof(RecordHeader), (uint16_t) len};
+  };
+  for (auto &it : this->index_) {
+    auto value = this->values_.find(it.first);
+    if (value == this->values_.end() || !value->second.dirty)
+      add(it.first, this->map_ + it.second.offset, it.second.len);
+  }
+  for (uint32_t key : this->dirty_keys_) {
+    auto &value = this->values_[key];
+    if (value.dirty && index.count(key) == 0)
+      add(key, value.data.data(), value.data.size());
+  }
+  const size_t live_bytes = content.size() - sizeof(FileHeader);
+  const size_t commit = content.size();
+  content.resize(commit + record_size(0));
+  write_record(content.data() + commit, crc32(content.data() + sizeof(FileHeader), live_bytes), RECORD_COMMIT,
+               nullptr, 0);
+
+  // Written next to the current file and renamed over it, so there is always one complete file
+  const std::string temp = this->filename_ + ".tmp";
+  const size_t size = file_size_for(content.size());
+  int fd = open(temp.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+    return false;
+  if (write(fd, content.data(), content.size()) != (ssize_t) content.size() || ftruncate(fd, size) != 0 ||
+      fsync(fd) != 0 || rename(temp.c_str(), this->filename_.c_str()) != 0) {
+    close(fd);
+    unlink(temp.c_str());
+    return false;
+  }
+  this->unmap_();
+  if (!this->open_map_(fd, size))
+    return false;
+  this->index_ = std::move(index);
+  this->end_ = content.size();
+  this->live_bytes_ = live_bytes;
+  for (uint32_t key : this->dirty_keys_)
+    this->values_[key].dirty = false;
+  this->dirty_keys_.clear();
+  return true;
+}
+
+const uint8_t *HostPreferences::find_stored_(uint32_t key, size_t len) const {
+  auto it = this->index_.find(key);
+  if (this->map_ == nullptr || it == this->index_.end() || it->second.len != len)
+    return nullptr;
+  return this->map_ + it->second.offset;
+}
+
+bool HostPreferences::save(uint32_t key, const uint8_t *data, size_t len) {
+  if (len > UINT16_MAX)
+    return false;
+  this->setup_();
+  auto &value = this->values_[key];
+  const uint8_t *stored = this->find_stored_(key, len);
+  if (stored != nullptr && memcmp(stored, data, len) == 0) {
+    // Back to the value in the file, nothing to write
+    if (value.dirty) {
+      value.dirty = false;
+      this->dirty_keys_.erase(std::find(this->dirty_keys_.begin(), this->dirty_keys_.end(), key));
+    }
+    value.data.assign(data, data + len);
+    return true;
+  }
+  if (!value.dirty)
+    this->dirty_keys_.push_back(key);
+  value.dirty = true;
+  value.data.assign(data, data + len);
+  return true;
+}
+
+bool HostPreferences::load(uint32_t key, uint8_t *data, size_t len) {
+  if (len > UINT16_MAX)
+    return false;
+  this->setup_();
+  auto value = this->values_.find(key);
+  if (value != this->values_.end() && value->second.dirty) {
+    if (value->second.data.size() != len)
+      return false;
+    memcpy(data, value->second.data.data(), len);
+    return true;
+  }
+  const uint8_t *stored = this->find_stored_(key, len);
+  if (stored == nullptr)
+    return false;
+  memcpy(data, stored, len);
+  return true;
 }
 
 bool HostPreferences::sync() {
   this->setup_();
-  FILE *fp = fopen(this->filename_.c_str(), "wb");
-  std::map<uint32_t, std::vector<uint8_t>>::iterator it;
+  if (this->dirty_keys_.empty())
+    return true;
+  if (this->map_ == nullptr)
+    return false;
 
-  for (it = this->data.begin(); it != this->data.end(); ++it) {
-    fwrite(&it->first, sizeof(uint32_t), 1, fp);
-    uint8_t len = it->second.size();
-    fwrite(&len, sizeof(len), 1, fp);
-    fwrite(it->second.data(), sizeof(uint8_t), it->second.size(), fp);
+  size_t size = record_size(0);
+  for (uint32_t key : this->dirty_keys_) {
+    const auto &value = this->values_[key];
+    if (value.dirty)
+      size += record_size(value.data.size());
+  }
+  if (!this->reserve_(this->end_ + size)) {
+    ESP_LOGE(TAG, "Can't extend %s: %s", this->filename_.c_str(), strerror(errno));
+    return false;
   }
-  fclose(fp);
+
+  const size_t start = this->end_;
+  size_t offset = start;
+  for (uint32_t key : this->dirty_keys_) {
+    auto &value = this->values_[key];
+    if (!value.dirty)
+      continue;
+    offset += write_record(this->map_ + offset, key, RECORD_VALUE, value.data.data(), value.data.size());
+  }
+  write_record(this->map_ + offset, crc32(this->map_ + start, offset - start), RECORD_COMMIT, nullptr, 0);
+  const size_t end = offset + record_size(0);
+
+  // One flush for the whole batch, the CRC in the commit marker tells if all of it made it to the disk
+  const size_t page = sysconf(_SC_PAGESIZE);
+  const size_t flush_start = start & ~(page - 1);
+  if (msync(this->map_ + flush_start, end - flush_start, MS_SYNC) != 0) {
+    ESP_LOGE(TAG, "Can't write %s: %s", this->filename_.c_str(), strerror(errno));
+    memset(this->map_ + start, 0, end - start);
+    return false;
+  }
+
+  offset = start;
+  for (uint32_t key : this->dirty_keys_) {
+    auto &value = this->values_[key];
+    if (!value.dirty)
+      continue;
+    auto existing = this->index_.find(key);
+    if (existing != this->index_.end())
+      this->live_bytes_ -= record_size(existing->second.len);
+    this->live_bytes_ += record_size(value.data.size());
+    this->index_[key] = Location{offset + sizeof(RecordHeader), (uint16_t) value.data.size()};
+    offset += record_size(value.data.size());
+    value.dirty = false;
+  }
+  this->dirty_keys_.clear();
+  this->end_ = end;
+
+  if (this->end_ > MIN_REWRITE_SIZE && this->end_ > 2 * (sizeof(FileHeader) + this->live_bytes_ + record_size(0)) &&
+      !this->rewrite_())
+    ESP_LOGW(TAG, "Can't compact %s: %s", this->filename_.c_str(), strerror(errno));
   return true;
 }
 
 bool HostPreferences::reset() {
-  host_preferences->data.clear();
-  return true;
+  this->setup_();
+  this->index_.clear();
+  this->values_.clear();
+  this->dirty_keys_.clear();
+  return this->rewrite_();
 }
 
 ESPPreferenceObject HostPreferences::make_preference(size_t length, uint32_t type, bool in_flash) {
@@ -66,10 +383,62 @@ ESPPreferenceObject HostPreferences::make_preference(size_t length, uint32_t typ
   return ESPPreferenceObject(backend);
 };
 
+#ifdef USE_PREFERENCES_LOG
+/// A file standing in for a flash partition, so the log-structured preferences can run on the host.
+class HostLogFlash : public preferences::LogFlash {
+ public:
+  size_t get_sector_size() const override { return 4096; }
+  size_t get_sector_count() const override { return 16; }
+  bool read(size_t offset, void *data, size_t len) override {
+    return this->open_() && pread(this->fd_, data, len, offset) == (ssize_t) len;
+  }
+  bool write(size_t offset, const void *data, size_t len) override {
+    return this->open_() && pwrite(this->fd_, data, len, offset) == (ssize_t) len;
+  }
+  bool erase(size_t sector) override {
+    std::vector<uint8_t> erased(this->get_sector_size(), 0xFF);
+    return this->write(sector * erased.size(), erased.data(), erased.size());
+  }
+
+ protected:
+  // Opened on first use, the name of the file is only known once the application is set up
+  bool open_() {
+    if (this->fd_ >= 0)
+      return true;
+    std::string filename = getenv("HOME");
+    filename.append("/.esphome/prefs");
+    fs::create_directories(filename);
+    filename.append("/");
+    filename.append(App.get_name());
+    filename.append(".log");
+    this->fd_ = open(filename.c_str(), O_RDWR | O_CREAT, 0644);
+    if (this->fd_ < 0)
+      return false;
+    // A new file reads as erased flash
+    struct stat st;
+    const size_t size = this->get_sector_size() * this->get_sector_count();
+    if (fstat(this->fd_, &st) == 0 && (size_t) st.st_size < size) {
+      std::vector<uint8_t> erased(size - st.st_size, 0xFF);
+      if (pwrite(this->fd_, erased.data(), erased.size(), st.st_size) != (ssize_t) erased.size())
+        return false;
+    }
+    return true;
+  }
+
+  int fd_{-1};
+};
+#endif
+
 void setup_preferences() {
+#ifdef USE_PREFERENCES_LOG
+  auto *pref = new preferences::LogPreferences(new HostLogFlash());  // NOLINT(cppcoreguidelines-owning-memory)
+  preferences::global_log_preferences = pref;
+  global_preferences = pref;
+#else
   auto *pref = new HostPreferences();  // NOLINT(cppcoreguidelines-owning-memory)
   host_preferences = pref;
   global_preferences = pref;
+#endif
 }
 
 bool HostPreferenceBackend::save(const uint8_t *data, size_t len) {
@@ -3,7 +3,10 @@
 #ifdef USE_HOST
 
 #include "esphome/core/preferences.h"
-#include <map>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace esphome {
 namespace host {
@@ -19,6 +22,14 @@ class HostPreferenceBackend : public ESPPreferenceBackend {
   uint32_t key_{};
 };
 
+/** Preferences in a file that is appended to, mapped into memory.
+ *
+ * sync() appends a record for every value that changed since the previous sync() followed by a commit marker
+ * holding a CRC of the batch, and flushes the batch to disk at once. On setup only batches with a valid commit
+ * marker are replayed into an index of the newest record of every key, so a sync() that is interrupted leaves all
+ * keys of its batch with their old values. Loads copy straight from the mapping. Once most of the file is taken by
+ * outdated records, the current ones are written to a new file that replaces it.
+ */
 class HostPreferences : public ESPPreferences {
  public:
   bool sync() override;
@@ -29,33 +40,39 @@ class HostPreferences : public ESPPreferences {
     return make_preference(length, type, false);
   }
 
-  bool save(uint32_t key, const uint8_t *data, size_t len) {
-    if (len > 255)
-      return false;
-    this->setup_();
-    std::vector vec(data, data + len);
-    this->data[key] = vec;
-    return true;
-  }
-
-  bool load(uint32_t key, uint8_t *data, size_t len) {
-    if (len > 255)
-      return false;
-    this->setup_();
-    if (this->data.count(key) == 0)
-      return false;
-    auto vec = this->data[key];
-    if (vec.size() != len)
-      return false;
-    memcpy(data, vec.data(), len);
-    return true;
-  }
+  bool save(uint32_t key, const uint8_t *data, size_t len);
+  bool load(uint32_t key, uint8_t *data, size_t len);
 
  protected:
+  struct Location {
+    size_t offset;  ///< of the value in the file
+    uint16_t len;
+  };
+  struct Value {
+    std::vector<uint8_t> data;
+    bool dirty{false};  ///< differs from the value in the file
+  };
+
   void setup_();
+  void load_legacy_();
+  bool replay_();
+  bool open_map_(int fd, size_t size);
+  void unmap_();
+  bool reserve_(size_t size);
+  bool rewrite_();
+  const uint8_t *find_stored_(uint32_t key, size_t len) const;
+
   bool setup_complete_{};
   std::string filename_{};
-  std::map<uint32_t, std::vector<uint8_t>> data{};
+  int fd_{-1};
+  uint8_t *map_{nullptr};
+  size_t map_size_{0};    ///< size of the mapping and of the file
+  size_t end_{0};         ///< end of the last committed batch of records
+  size_t live_bytes_{0};  ///< size of the newest record of every key
+  std::unordered_map<uint32_t, Location> index_{};
+  /// Every value saved since boot, their buffers are reused by later saves.
+  std::unordered_map<uint32_t, Value> values_{};
+  std::vector<uint32_t> dirty_keys_{};  ///< keys of values_ to write on the next sync()
 };
 void setup_preferences();
 extern HostPreferences *host_preferences;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
@@ -15,6 +15,7 @@ from esphome.const import (
     CONF_I2C_ID,
     PLATFORM_ESP32,
     PLATFORM_ESP8266,
+    PLATFORM_HOST,
     PLATFORM_RP2040,
 )
 from esphome.core import coroutine_with_priority, CORE
@@ -24,15 +25,20 @@ i2c_ns = cg.esphome_ns.namespace("i2c")
 I2CBus = i2c_ns.class_("I2CBus")
 ArduinoI2CBus = i2c_ns.class_("ArduinoI2CBus", I2CBus, cg.Component)
 IDFI2CBus = i2c_ns.class_("IDFI2CBus", I2CBus, cg.Component)
+MockI2CBus = i2c_ns.class_("MockI2CBus", I2CBus, cg.Component)
 I2CDevice = i2c_ns.class_("I2CDevice")
 
 
 CONF_SDA_PULLUP_ENABLED = "sda_pullup_enabled"
 CONF_SCL_PULLUP_ENABLED = "scl_pullup_enabled"
+CONF_MOCK_DEVICES = "mock_devices"
+CONF_REGISTERS = "registers"
 MULTI_CONF = True
 
 
 def _bus_declare_type(value):
+    if CORE.is_host:
+        return cv.declare_id(MockI2CBus)(value)
     if CORE.using_arduino:
         return cv.declare_id(ArduinoI2CBus)(value)
     if CORE.using_esp_idf:
@@ -49,11 +55,15 @@ CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
             cv.GenerateID(): _bus_declare_type,
-            cv.Optional(CONF_SDA, default="SDA"): pin_with_input_and_output_support,
+            cv.SplitDefault(
+                CONF_SDA, esp8266="SDA", esp32="SDA", rp2040="SDA"
+            ): pin_with_input_and_output_support,
             cv.SplitDefault(CONF_SDA_PULLUP_ENABLED, esp32_idf=True): cv.All(
                 cv.only_with_esp_idf, cv.boolean
             ),
-            cv.Optional(CONF_SCL, default="SCL"): pin_with_input_and_output_support,
+            cv.SplitDefault(
+                CONF_SCL, esp8266="SCL", esp32="SCL", rp2040="SCL"
+            ): pin_with_input_and_output_support,
             cv.SplitDefault(CONF_SCL_PULLUP_ENABLED, esp32_idf=True): cv.All(
                 cv.only_with_esp_idf, cv.boolean
             ),
@@ -62,18 +72,40 @@ CONFIG_SCHEMA = cv.All(
             ),
             cv.Optional(CONF_TIMEOUT): cv.positive_time_period,
             cv.Optional(CONF_SCAN, default=True): cv.boolean,
+            cv.Optional(CONF_MOCK_DEVICES): cv.All(
+                cv.only_on(PLATFORM_HOST),
+                cv.ensure_list(
+                    cv.Schema(
+                        {
+                            cv.Required(CONF_ADDRESS): cv.i2c_address,
+                            cv.Optional(CONF_REGISTERS, default={}): cv.Schema(
+                                {cv.hex_uint8_t: cv.hex_uint8_t}
+                            ),
+                        }
+                    )
+                ),
+            ),
         }
     ).extend(cv.COMPONENT_SCHEMA),
-    cv.only_on([PLATFORM_ESP32, PLATFORM_ESP8266, PLATFORM_RP2040]),
+    cv.only_on([PLATFORM_ESP32, PLATFORM_ESP8266, PLATFORM_RP2040, PLATFORM_HOST]),
 )
 
 
 @coroutine_with_priority(1.0)
 async def to_code(config):
     cg.add_global(i2c_ns.using)
+    cg.add_define("USE_I2C")
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
 
+    cg.add(var.set_scan(config[CONF_SCAN]))
+    if CORE.is_host:
+        for device in config.get(CONF_MOCK_DEVICES, []):
+            cg.add(var.add_device(device[CONF_ADDRESS]))
+            for register, value in device[CONF_REGISTERS].items():
+                cg.add(var.set_register(device[CONF_ADDRESS], register, value))
+        return
+
     cg.add(var.set_sda_pin(config[CONF_SDA]))
     if CONF_SDA_PULLUP_ENABLED in config:
         cg.add(var.set_sda_pullup_enabled(config[CONF_SDA_PULLUP_ENABLED]))
@@ -82,7 +114,6 @@ async def to_code(config):
         cg.add(var.set_scl_pullup_enabled(config[CONF_SCL_PULLUP_ENABLED]))
 
     cg.add(var.set_frequency(int(config[CONF_FREQUENCY])))
-    cg.add(var.set_scan(config[CONF_SCAN]))
     if CONF_TIMEOUT in config:
         cg.add(var.set_timeout(int(config[CONF_TIMEOUT].total_microseconds)))
     if CORE.using_arduino:
@@ -22,6 +22,37 @@ ErrorCode I2CDevice::read_register16(uint16_t a_register, uint8_t *data, size_t
   return bus_->read(address_, data, len);
 }
 
+void I2CDevice::read_async(uint8_t *data, size_t len, std::function<void(ErrorCode)> &&callback) {
+  I2CTransaction transaction;
+  transaction.address = this->address_;
+  transaction.read = {data, len};
+  transaction.callback = std::move(callback);
+  this->bus_->submit(std::move(transaction));
+}
+
+void I2CDevice::read_register_async(uint8_t a_register, uint8_t *data, size_t len,
+                                    std::function<void(ErrorCode)> &&callback, bool auto_increment) {
+  I2CTransaction transaction;
+  transaction.address = this->address_;
+  transaction.header[0] = a_register;
+  transaction.header_len = 1;
+  transaction.read = {data, len};
+  transaction.auto_increment = auto_increment;
+  transaction.callback = std::move(callback);
+  this->bus_->submit(std::move(transaction));
+}
+
+void I2CDevice::write_register_async(uint8_t a_register, const uint8_t *data, size_t len,
+                                     std::function<void(ErrorCode)> &&callback) {
+  I2CTransaction transaction;
+  transaction.address = this->address_;
+  transaction.header[0] = a_register;
+  transaction.header_len = 1;
+  transaction.write = {data, len};
+  transaction.callback = std::move(callback);
+  this->bus_->submit(std::move(transaction));
+}
+
 ErrorCode I2CDevice::write_register(uint8_t a_register, const uint8_t *data, size_t len, bool stop) {
   WriteBuffer buffers[2];
   buffers[0].data = &a_register;
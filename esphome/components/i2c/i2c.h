@@ -4,6 +4,7 @@
 #include "esphome/core/helpers.h"
 #include "esphome/core/optional.h"
 #include <array>
+#include <functional>
 #include <vector>
 
 namespace esphome {
@@ -203,6 +204,30 @@ class I2CDevice {
   /// @return an i2c::ErrorCode
   ErrorCode write_register16(uint16_t a_register, const uint8_t *data, size_t len, bool stop = true);
 
+  /// @brief queues a read of an array of bytes from the device without selecting a register, see I2CBus::submit()
+  /// @param data pointer to an array to store the bytes, must stay valid until the callback is called
+  /// @param len length of the buffer = number of bytes to read
+  /// @param callback called with the i2c::ErrorCode once the read completed
+  void read_async(uint8_t *data, size_t len, std::function<void(ErrorCode)> &&callback);
+
+  /// @brief queues a read of an array of bytes from a specific register in the I²C device, see I2CBus::submit()
+  /// @param a_register an 8 bits internal address of the I²C register to read from
+  /// @param data pointer to an array to store the bytes, must stay valid until the callback is called
+  /// @param len length of the buffer = number of bytes to read
+  /// @param callback called with the i2c::ErrorCode once the read completed
+  /// @param auto_increment true if the device increments the register address while reading, which allows the bus
+  /// to merge this read with queued reads of the following registers
+  void read_register_async(uint8_t a_register, uint8_t *data, size_t len, std::function<void(ErrorCode)> &&callback,
+                           bool auto_increment = false);
+
+  /// @brief queues a write of an array of bytes to a specific register in the I²C device, see I2CBus::submit()
+  /// @param a_register the internal address of the register to write to
+  /// @param data pointer to the bytes to write, must stay valid until the callback is called
+  /// @param len length of the buffer = number of bytes to write
+  /// @param callback called with the i2c::ErrorCode once the write completed, may be empty
+  void write_register_async(uint8_t a_register, const uint8_t *data, size_t len,
+                            std::function<void(ErrorCode)> &&callback = nullptr);
+
   ///
   /// Compat APIs
   /// All methods below have been added for compatibility reasons. They do not bring any functionality and therefore on
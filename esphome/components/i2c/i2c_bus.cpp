@@ -0,0 +1,81 @@
+#include "i2c_bus.h"
+
+#include <algorithm>
+
+namespace esphome {
+namespace i2c {
+
+/// Most reads merged into a single transfer by process_queue_().
+static const size_t MAX_MERGED_READS = 8;
+
+float I2CBus::get_utilization() {
+  const uint32_t now = micros();
+  const uint32_t elapsed = now - this->utilization_start_;
+  // A worker task may add to the busy time concurrently
+  const uint32_t busy_us = this->busy_us_.exchange(0);
+  this->utilization_start_ = now;
+  return elapsed == 0 ? 0.0f : std::min(1.0f, float(busy_us) / float(elapsed));
+}
+
+void I2CBus::process_queue_() {
+  if (this->queue_.empty())
+    return;
+  // Callbacks may submit new transactions, those are executed on the next call
+  this->running_.swap(this->queue_);
+  this->execute_(this->running_);
+  for (auto &transaction : this->running_) {
+    if (transaction.callback)
+      transaction.callback(transaction.result);
+  }
+  this->running_.clear();
+}
+
+void I2CBus::execute_(std::vector<I2CTransaction> &transactions) {
+  size_t i = 0;
+  while (i < transactions.size()) {
+    const I2CTransaction &first = transactions[i];
+    ReadBuffer reads[MAX_MERGED_READS];
+    size_t read_count = 0;
+    if (first.read.len != 0)
+      reads[read_count++] = first.read;
+
+    // Merge reads of the registers following the ones read by the previous transaction
+    size_t end = i + 1;
+    if (first.auto_increment && first.header_len == 1 && first.write.len == 0 && first.read.len != 0) {
+      size_t next_register = first.header[0] + first.read.len;
+      while (end < transactions.size() && read_count < MAX_MERGED_READS) {
+        const I2CTransaction &next = transactions[end];
+        if (!next.auto_increment || next.address != first.address || next.header_len != 1 || next.write.len != 0 ||
+            next.read.len == 0 || next.header[0] != next_register)
+          break;
+        reads[read_count++] = next.read;
+        next_register += next.read.len;
+        end++;
+      }
+    }
+
+    WriteBuffer writes[2];
+    size_t write_count = 0;
+    if (first.header_len != 0)
+      writes[write_count++] = {first.header.data(), first.header_len};
+    if (first.write.len != 0)
+      writes[write_count++] = first.write;
+
+    const ErrorCode err = this->transfer_(first.address, writes, write_count, reads, read_count);
+    for (; i < end; i++)
+      transactions[i].result = err;
+  }
+}
+
+ErrorCode I2CBus::transfer_(uint8_t address, WriteBuffer *writes, size_t write_count, ReadBuffer *reads,
+                            size_t read_count) {
+  if (write_count != 0 || read_count == 0) {
+    const ErrorCode err = this->writev(address, writes, write_count, read_count == 0);
+    if (err != ERROR_OK || read_count == 0)
+      return err;
+  }
+  return this->readv(address, reads, read_count);
+}
+
+}  // namespace i2c
+}  // namespace esphome
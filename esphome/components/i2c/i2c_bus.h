@@ -1,9 +1,14 @@
 #pragma once
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <cstddef>
+#include <functional>
 #include <utility>
 #include <vector>
 
+#include "esphome/core/hal.h"
+
 namespace esphome {
 namespace i2c {
 
@@ -32,6 +37,21 @@ struct WriteBuffer {
   size_t len;           ///< length of the buffer
 };
 
+/// @brief the I2CTransaction structure describes a transfer queued with I2CBus::submit(). The bus writes `header`
+/// followed by `write`, then reads into `read` after a repeated start. Each part may be empty.
+struct I2CTransaction {
+  uint8_t address{0};               ///< address of the I²C component on the i2c bus
+  std::array<uint8_t, 2> header{};  ///< usually the register address, copied so the caller does not need to keep it
+  uint8_t header_len{0};            ///< number of bytes used in header
+  WriteBuffer write{nullptr, 0};    ///< bytes to write after the header, must stay valid until the callback
+  ReadBuffer read{nullptr, 0};      ///< buffer for the bytes to read, must stay valid until the callback
+  /// The device increments its register address while reading, so this read may be merged with queued reads of the
+  /// following registers into a single transfer.
+  bool auto_increment{false};
+  std::function<void(ErrorCode)> callback{};  ///< called from the main loop with the result of the transfer
+  ErrorCode result{ERROR_OK};                 ///< set by the bus once the transfer was executed
+};
+
 /// @brief This Class provides the methods to read and write bytes from an I2CBus.
 /// @note The I2CBus virtual class follows a *Factory design pattern* that provides all the interfaces methods required
 /// by clients while deferring the actual implementation of these methods to a subclasses. I2C-bus specification and
@@ -91,7 +111,54 @@ class I2CBus {
   /// @details This is a pure virtual method that must be implemented in the subclass.
   virtual ErrorCode writev(uint8_t address, WriteBuffer *buffers, size_t count, bool stop) = 0;
 
+  /// @brief Queues a transaction instead of blocking until it is done. The queued transactions are executed back to
+  /// back, by a worker task on buses that have one or from the loop of the bus otherwise. Reads of consecutive
+  /// registers of the same device are merged into one transfer.
+  /// @param transaction the transaction, its callback is called from the main loop once it completed
+  virtual void submit(I2CTransaction &&transaction) { this->queue_.push_back(std::move(transaction)); }
+
+  /// @brief Keeps queued transactions off the bus until the matching release(), so that a sequence of synchronous
+  /// calls is not interleaved with them. Calls may nest, only call from the main loop.
+  virtual void hold() {}
+  /// @brief Ends a hold()
+  virtual void release() {}
+
+  /// @brief Returns the fraction of time the bus was busy transferring since the previous call
+  /// @return the utilization between 0 and 1
+  float get_utilization();
+
  protected:
+  /// @brief Adds the time until it goes out of scope to the busy time of the bus, used by the bus implementations
+  /// around every transfer.
+  class BusyTimer {
+   public:
+    explicit BusyTimer(I2CBus *bus) : bus_(bus), start_(micros()) {}
+    ~BusyTimer() { this->bus_->busy_us_.fetch_add(micros() - this->start_); }
+
+   protected:
+    I2CBus *bus_;
+    uint32_t start_;
+  };
+
+  /// @brief Executes the queued transactions and calls their callbacks, to be called from the loop of buses without
+  /// a worker task
+  void process_queue_();
+
+  /// @brief Executes `transactions` in order, merging reads where possible, and stores the result in each of them.
+  /// Does not call the callbacks.
+  void execute_(std::vector<I2CTransaction> &transactions);
+
+  /// @brief Writes `writes` and reads into `reads` after a repeated start as one transfer. The default
+  /// implementation uses writev() and readv(), buses that can do better override it.
+  /// @param address address of the I²C component on the i2c bus
+  /// @param writes pointer to an array of WriteBuffer
+  /// @param write_count number of WriteBuffer to write
+  /// @param reads pointer to an array of ReadBuffer
+  /// @param read_count number of ReadBuffer to read
+  /// @return an i2c::ErrorCode
+  virtual ErrorCode transfer_(uint8_t address, WriteBuffer *writes, size_t write_count, ReadBuffer *reads,
+                              size_t read_count);
+
   /// @brief Scans the I2C bus for devices. Devices presence is kept in an array of std::pair
   /// that contains the address and the corresponding bool presence flag.
   void i2c_scan_() {
@@ -106,6 +173,10 @@ class I2CBus {
   }
   std::vector<std::pair<uint8_t, bool>> scan_results_;  ///< array containing scan results
   bool scan_{false};                                    ///< Should we scan ? Can be set in the yaml
+  std::vector<I2CTransaction> queue_;                   ///< transactions waiting to be executed
+  std::vector<I2CTransaction> running_;                 ///< transactions being executed
+  std::atomic<uint32_t> busy_us_{0};                    ///< time spent transferring since utilization_start_
+  uint32_t utilization_start_{0};                       ///< start of the utilization measurement
 };
 
 }  // namespace i2c
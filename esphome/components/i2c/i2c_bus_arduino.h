@@ -19,6 +19,7 @@ class ArduinoI2CBus : public I2CBus, public Component {
  public:
   void setup() override;
   void dump_config() override;
+  void loop() override { this->process_queue_(); }
   ErrorCode readv(uint8_t address, ReadBuffer *buffers, size_t cnt) override;
   ErrorCode writev(uint8_t address, WriteBuffer *buffers, size_t cnt, bool stop) override;
   float get_setup_priority() const override { return setup_priority::BUS; }
@@ -70,6 +70,90 @@ void IDFI2CBus::setup() {
     ESP_LOGV(TAG, "Scanning i2c bus for active devices...");
     this->i2c_scan_();
   }
+
+  if (xTaskCreate(IDFI2CBus::worker_task, "i2c_worker", 3072, this, 5, &this->worker_task_handle_) != pdPASS) {
+    // Without the task, the queue is executed from loop()
+    ESP_LOGW(TAG, "Could not create worker task, executing queued transactions from the main loop");
+    this->worker_task_handle_ = nullptr;
+    return;
+  }
+  // Transactions submitted before setup
+  xTaskNotifyGive(this->worker_task_handle_);
+}
+
+void IDFI2CBus::loop() {
+  // A write without stop is followed by its read within the same component, never across loops. A hold left open by
+  // a write that was not followed would stall the worker task.
+  if (this->open_) {
+    this->open_ = false;
+    this->release();
+  }
+  if (this->worker_task_handle_ == nullptr) {
+    this->process_queue_();
+    return;
+  }
+  {
+    LockGuard guard(this->queue_lock_);
+    if (this->done_.empty())
+      return;
+    this->completed_.swap(this->done_);
+  }
+  for (auto &transaction : this->completed_) {
+    if (transaction.callback)
+      transaction.callback(transaction.result);
+  }
+  this->completed_.clear();
+}
+
+void IDFI2CBus::submit(I2CTransaction &&transaction) {
+  if (this->worker_task_handle_ == nullptr) {
+    I2CBus::submit(std::move(transaction));
+    return;
+  }
+  {
+    LockGuard guard(this->queue_lock_);
+    this->queue_.push_back(std::move(transaction));
+  }
+  xTaskNotifyGive(this->worker_task_handle_);
+}
+
+void IDFI2CBus::worker_task(void *param) {
+  auto *bus = static_cast<IDFI2CBus *>(param);
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    while (true) {
+      {
+        LockGuard guard(bus->queue_lock_);
+        if (bus->queue_.empty())
+          break;
+        bus->running_.swap(bus->queue_);
+      }
+      // Takes bus_lock_ for every transfer, so synchronous calls from the main loop wait for one transfer at most
+      bus->execute_(bus->running_);
+      LockGuard guard(bus->queue_lock_);
+      for (auto &transaction : bus->running_)
+        bus->done_.push_back(std::move(transaction));
+      bus->running_.clear();
+    }
+  }
+}
+
+void IDFI2CBus::hold() {
+  if (this->hold_depth_++ == 0)
+    this->bus_lock_.lock();
+}
+
+void IDFI2CBus::release() {
+  if (--this->hold_depth_ == 0)
+    this->bus_lock_.unlock();
+}
+
+void IDFI2CBus::finish_(bool stop) {
+  if (this->open_)
+    this->release();
+  this->open_ = !stop;
+  if (stop)
+    this->release();
 }
 void IDFI2CBus::dump_config() {
   ESP_LOGCONFIG(TAG, "I2C Bus:");
@@ -107,6 +191,20 @@ void IDFI2CBus::dump_config() {
 }
 
 ErrorCode IDFI2CBus::readv(uint8_t address, ReadBuffer *buffers, size_t cnt) {
+  this->hold();
+  const ErrorCode err = this->readv_(address, buffers, cnt);
+  this->finish_(true);
+  return err;
+}
+ErrorCode IDFI2CBus::writev(uint8_t address, WriteBuffer *buffers, size_t cnt, bool stop) {
+  this->hold();
+  const ErrorCode err = this->writev_(address, buffers, cnt, stop);
+  this->finish_(stop);
+  return err;
+}
+
+ErrorCode IDFI2CBus::readv_(uint8_t address, ReadBuffer *buffers, size_t cnt) {
+  BusyTimer busy(this);
   // logging is only enabled with vv level, if warnings are shown the caller
   // should log them
   if (!initialized_) {
@@ -175,7 +273,8 @@ ErrorCode IDFI2CBus::readv(uint8_t address, ReadBuffer *buffers, size_t cnt) {
 
   return ERROR_OK;
 }
-ErrorCode IDFI2CBus::writev(uint8_t address, WriteBuffer *buffers, size_t cnt, bool stop) {
+ErrorCode IDFI2CBus::writev_(uint8_t address, WriteBuffer *buffers, size_t cnt, bool stop) {
+  BusyTimer busy(this);
   // logging is only enabled with vv level, if warnings are shown the caller
   // should log them
   if (!initialized_) {
@@ -245,6 +344,61 @@ ErrorCode IDFI2CBus::writev(uint8_t address, WriteBuffer *buffers, size_t cnt, b
   return ERROR_OK;
 }
 
+ErrorCode IDFI2CBus::transfer_(uint8_t address, WriteBuffer *writes, size_t write_count, ReadBuffer *reads,
+                               size_t read_count) {
+  // Called by the worker task, or from loop() without one
+  LockGuard guard(this->bus_lock_);
+  if (read_count == 0)
+    return this->writev_(address, writes, write_count, true);
+  if (write_count == 0)
+    return this->readv_(address, reads, read_count);
+  BusyTimer busy(this);
+  if (!initialized_) {
+    ESP_LOGVV(TAG, "i2c bus not initialized!");
+    return ERROR_NOT_INITIALIZED;
+  }
+
+  // Write and read with a repeated start in a single command link, saving a round trip through the driver
+  i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+  esp_err_t err = i2c_master_start(cmd);
+  if (err == ESP_OK)
+    err = i2c_master_write_byte(cmd, (address << 1) | I2C_MASTER_WRITE, true);
+  for (size_t i = 0; err == ESP_OK && i < write_count; i++) {
+    if (writes[i].len != 0)
+      err = i2c_master_write(cmd, writes[i].data, writes[i].len, true);
+  }
+  if (err == ESP_OK)
+    err = i2c_master_start(cmd);
+  if (err == ESP_OK)
+    err = i2c_master_write_byte(cmd, (address << 1) | I2C_MASTER_READ, true);
+  for (size_t i = 0; err == ESP_OK && i < read_count; i++) {
+    if (reads[i].len == 0)
+      continue;
+    const i2c_ack_type_t ack = i == read_count - 1 ? I2C_MASTER_LAST_NACK : I2C_MASTER_ACK;
+    err = i2c_master_read(cmd, reads[i].data, reads[i].len, ack);
+  }
+  if (err == ESP_OK)
+    err = i2c_master_stop(cmd);
+  if (err != ESP_OK) {
+    ESP_LOGVV(TAG, "Transfer with %02X failed to build: %s", address, esp_err_to_name(err));
+    i2c_cmd_link_delete(cmd);
+    return ERROR_UNKNOWN;
+  }
+  err = i2c_master_cmd_begin(port_, cmd, 20 / portTICK_PERIOD_MS);
+  i2c_cmd_link_delete(cmd);
+  if (err == ESP_FAIL) {
+    ESP_LOGVV(TAG, "Transfer with %02X failed: not acked", address);
+    return ERROR_NOT_ACKNOWLEDGED;
+  } else if (err == ESP_ERR_TIMEOUT) {
+    ESP_LOGVV(TAG, "Transfer with %02X failed: timeout", address);
+    return ERROR_TIMEOUT;
+  } else if (err != ESP_OK) {
+    ESP_LOGVV(TAG, "Transfer with %02X failed: %s", address, esp_err_to_name(err));
+    return ERROR_UNKNOWN;
+  }
+  return ERROR_OK;
+}
+
 /// Perform I2C bus recovery, see:
 /// https://www.nxp.com/docs/en/user-guide/UM10204.pdf
 /// https://www.analog.com/media/en/technical-documentation/application-notes/54305147357414AN686_0.pdf
@@ -4,7 +4,10 @@
 
 #include "i2c_bus.h"
 #include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
 #include <driver/i2c.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 
 namespace esphome {
 namespace i2c {
@@ -19,8 +22,12 @@ class IDFI2CBus : public I2CBus, public Component {
  public:
   void setup() override;
   void dump_config() override;
+  void loop() override;
   ErrorCode readv(uint8_t address, ReadBuffer *buffers, size_t cnt) override;
   ErrorCode writev(uint8_t address, WriteBuffer *buffers, size_t cnt, bool stop) override;
+  void submit(I2CTransaction &&transaction) override;
+  void hold() override;
+  void release() override;
   float get_setup_priority() const override { return setup_priority::BUS; }
 
   void set_scan(bool scan) { scan_ = scan; }
@@ -36,6 +43,27 @@ class IDFI2CBus : public I2CBus, public Component {
   RecoveryCode recovery_result_;
 
  protected:
+  ErrorCode transfer_(uint8_t address, WriteBuffer *writes, size_t write_count, ReadBuffer *reads,
+                      size_t read_count) override;
+  ErrorCode readv_(uint8_t address, ReadBuffer *buffers, size_t cnt);
+  ErrorCode writev_(uint8_t address, WriteBuffer *buffers, size_t cnt, bool stop);
+  /// Ends the hold() of a synchronous transfer, keeping the bus if it ended without a stop
+  void finish_(bool stop);
+
+  /// Executes the queued transactions, see submit()
+  static void worker_task(void *param);
+  TaskHandle_t worker_task_handle_{nullptr};
+  /// Held by the worker task during a transfer, and by the main loop from hold() to release()
+  Mutex bus_lock_;
+  /// Protects queue_ and done_, which are shared with the worker task
+  Mutex queue_lock_;
+  /// Transactions executed by the worker task, their callbacks are called from loop()
+  std::vector<I2CTransaction> done_;
+  std::vector<I2CTransaction> completed_;
+  uint8_t hold_depth_{0};
+  /// The last synchronous write ended without a stop, the bus stays held until a transfer ends with one
+  bool open_{false};
+
   i2c_port_t port_;
   uint8_t sda_pin_;
   bool sda_pullup_enabled_;
@@ -0,0 +1,74 @@
+#ifdef USE_HOST
+
+#include "i2c_bus_mock.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace i2c {
+
+static const char *const TAG = "i2c.mock";
+
+void MockI2CBus::setup() {
+  if (this->scan_) {
+    ESP_LOGV(TAG, "Scanning i2c bus for active devices...");
+    this->i2c_scan_();
+  }
+}
+
+void MockI2CBus::dump_config() {
+  ESP_LOGCONFIG(TAG, "I2C Bus (mock):");
+  for (const auto &device : this->devices_)
+    ESP_LOGCONFIG(TAG, "  Device at address 0x%02X", device.first);
+  if (this->scan_) {
+    ESP_LOGI(TAG, "Results from i2c bus scan:");
+    if (scan_results_.empty()) {
+      ESP_LOGI(TAG, "Found no i2c devices!");
+    } else {
+      for (const auto &s : scan_results_)
+        ESP_LOGI(TAG, "Found i2c device at address 0x%02X", s.first);
+    }
+  }
+}
+
+uint8_t MockI2CBus::get_register(uint8_t address, uint8_t a_register) const {
+  auto it = this->devices_.find(address);
+  return it == this->devices_.end() ? 0 : it->second.registers[a_register];
+}
+
+ErrorCode MockI2CBus::readv(uint8_t address, ReadBuffer *buffers, size_t cnt) {
+  BusyTimer busy(this);
+  auto it = this->devices_.find(address);
+  if (it == this->devices_.end())
+    return ERROR_NOT_ACKNOWLEDGED;
+  Device &device = it->second;
+  for (size_t i = 0; i < cnt; i++) {
+    for (size_t j = 0; j < buffers[i].len; j++)
+      buffers[i].data[j] = device.registers[device.pointer++];
+  }
+  return ERROR_OK;
+}
+
+ErrorCode MockI2CBus::writev(uint8_t address, WriteBuffer *buffers, size_t cnt, bool stop) {
+  BusyTimer busy(this);
+  auto it = this->devices_.find(address);
+  if (it == this->devices_.end())
+    return ERROR_NOT_ACKNOWLEDGED;
+  Device &device = it->second;
+  bool first = true;
+  for (size_t i = 0; i < cnt; i++) {
+    for (size_t j = 0; j < buffers[i].len; j++) {
+      if (first) {
+        device.pointer = buffers[i].data[j];
+        first = false;
+      } else {
+        device.registers[device.pointer++] = buffers[i].data[j];
+      }
+    }
+  }
+  return ERROR_OK;
+}
+
+}  // namespace i2c
+}  // namespace esphome
+
+#endif  // USE_HOST
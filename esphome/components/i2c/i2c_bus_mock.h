@@ -0,0 +1,48 @@
+#pragma once
+
+#ifdef USE_HOST
+
+#include "i2c_bus.h"
+#include "esphome/core/component.h"
+#include <array>
+#include <map>
+
+namespace esphome {
+namespace i2c {
+
+/// @brief I2C bus for the host platform that simulates register based devices in memory. The first byte written to
+/// a device selects its register pointer, every following byte read or written accesses the register at the pointer
+/// and increments it. Addresses without a device do not acknowledge.
+class MockI2CBus : public I2CBus, public Component {
+ public:
+  void setup() override;
+  void dump_config() override;
+  void loop() override { this->process_queue_(); }
+  ErrorCode readv(uint8_t address, ReadBuffer *buffers, size_t cnt) override;
+  ErrorCode writev(uint8_t address, WriteBuffer *buffers, size_t cnt, bool stop) override;
+  float get_setup_priority() const override { return setup_priority::BUS; }
+
+  void set_scan(bool scan) { scan_ = scan; }
+
+  /// @brief Adds a device with all registers set to 0
+  void add_device(uint8_t address) { this->devices_[address]; }
+  /// @brief Sets a register of a device, adding the device if needed
+  void set_register(uint8_t address, uint8_t a_register, uint8_t value) {
+    this->devices_[address].registers[a_register] = value;
+  }
+  /// @brief Returns a register of a device, 0 if there is no such device
+  uint8_t get_register(uint8_t address, uint8_t a_register) const;
+
+ protected:
+  struct Device {
+    std::array<uint8_t, 256> registers{};
+    uint8_t pointer{0};
+  };
+
+  std::map<uint8_t, Device> devices_;
+};
+
+}  // namespace i2c
+}  // namespace esphome
+
+#endif  // USE_HOST
@@ -204,7 +204,7 @@ void I2SAudioMicrophone::loop() {
       this->start_();
       break;
     case microphone::STATE_RUNNING:
-      if (this->data_callbacks_.size() > 0) {
+      if (!this->data_callbacks_.empty()) {
         this->read_();
       }
       break;
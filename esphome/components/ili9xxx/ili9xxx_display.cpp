@@ -208,6 +208,8 @@ void HOT ILI9XXXDisplay::draw_absolute_pixel_internal(int x, int y, Color color)
 }
 
 void ILI9XXXDisplay::update() {
+  // the previous frame may still be read from the buffer
+  this->wait_for_transactions();
   if (this->prossing_update_) {
     this->need_update_ = true;
     return;
@@ -243,15 +245,20 @@ void ILI9XXXDisplay::display_() {
            this->is_18bitdisplay_, sw_time, mw_time);
   auto now = millis();
   if (this->buffer_color_mode_ == BITS_16 && !this->is_18bitdisplay_ && sw_time < mw_time) {
-    // 16 bit mode maps directly to display format
+    // 16 bit mode maps directly to display format, send the buffer without waiting for it
     ESP_LOGV(TAG, "Doing single write of %zu bytes", this->width_ * h * 2);
-    set_addr_window_(0, this->y_low_, this->width_ - 1, this->y_high_);
-    this->write_array(this->buffer_ + this->y_low_ * this->width_ * 2, h * this->width_ * 2);
+    spi::SPITransaction transaction(this->dc_pin_);
+    this->add_addr_window_(transaction, 0, this->y_low_, this->width_ - 1, this->y_high_);
+    transaction.data(this->buffer_ + this->y_low_ * this->width_ * 2, h * this->width_ * 2);
+    this->submit_transaction(std::move(transaction));
   } else {
     ESP_LOGV(TAG, "Doing multiple write");
     uint8_t transfer_buffer[ILI9XXX_TRANSFER_BUFFER_SIZE];
     size_t rem = h * w;  // remaining number of pixels to write
-    set_addr_window_(this->x_low_, this->y_low_, this->x_high_, this->y_high_);
+    spi::SPITransaction transaction(this->dc_pin_);
+    this->add_addr_window_(transaction, this->x_low_, this->y_low_, this->x_high_, this->y_high_);
+    this->write_transaction(transaction);
+    this->start_data_();
     size_t idx = 0;    // index into transfer_buffer
     size_t pixel = 0;  // pixel number offset
     size_t pos = this->y_low_ * this->width_ + this->x_low_;
@@ -293,8 +300,8 @@ void ILI9XXXDisplay::display_() {
     if (idx != 0) {
       this->write_array(transfer_buffer, idx);
     }
+    this->end_data_();
   }
-  this->end_data_();
   ESP_LOGV(TAG, "Data write took %dms", (unsigned) (millis() - now));
   // invalidate watermarks
   this->x_low_ = this->width_;
@@ -316,20 +323,24 @@ void ILI9XXXDisplay::draw_pixels_at(int x_start, int y_start, int w, int h, cons
     return display::Display::draw_pixels_at(x_start, y_start, w, h, ptr, order, bitness, big_endian, x_offset, y_offset,
                                             x_pad);
   }
-  this->set_addr_window_(x_start, y_start, x_start + w - 1, y_start + h - 1);
+  spi::SPITransaction transaction(this->dc_pin_);
+  this->add_addr_window_(transaction, x_start, y_start, x_start + w - 1, y_start + h - 1);
   // x_ and y_offset are offsets into the source buffer, unrelated to our own offsets into the display.
   auto stride = x_offset + w + x_pad;
   if (!this->is_18bitdisplay_) {
     if (x_offset == 0 && x_pad == 0 && y_offset == 0) {
       // we could deal here with a non-zero y_offset, but if x_offset is zero, y_offset probably will be so don't bother
-      this->write_array(ptr, w * h * 2);
+      transaction.data(ptr, w * h * 2);
     } else {
       for (size_t y = 0; y != h; y++) {
-        this->write_array(ptr + (y + y_offset) * stride + x_offset, w * 2);
+        transaction.data(ptr + (y + y_offset) * stride + x_offset, w * 2);
       }
     }
+    this->write_transaction(transaction);
   } else {
     // 18 bit mode
+    this->write_transaction(transaction);
+    this->start_data_();
     uint8_t transfer_buffer[ILI9XXX_TRANSFER_BUFFER_SIZE * 4];
     ESP_LOGV(TAG, "Doing multiple write");
     size_t rem = h * w;  // remaining number of pixels to write
@@ -357,8 +368,8 @@ void ILI9XXXDisplay::draw_pixels_at(int x_start, int y_start, int w, int h, cons
     if (idx != 0) {
       this->write_array(transfer_buffer, idx);
     }
+    this->end_data_();
   }
-  this->end_data_();
 }
 
 // should return the total size: return this->get_width_internal() * this->get_height_internal() * 2 // 16bit color
@@ -378,17 +389,19 @@ void ILI9XXXDisplay::data(uint8_t value) {
 }
 
 void ILI9XXXDisplay::send_command(uint8_t command_byte, const uint8_t *data_bytes, uint8_t num_data_bytes) {
-  this->command(command_byte);  // Send the command byte
-  this->start_data_();
-  this->write_array(data_bytes, num_data_bytes);
-  this->end_data_();
+  spi::SPITransaction transaction(this->dc_pin_);
+  transaction.command(command_byte).data(data_bytes, num_data_bytes);
+  this->write_transaction(transaction);
 }
 
+// a submitted frame may still be sending, wait for it before changing the DC pin.
 void ILI9XXXDisplay::start_command_() {
+  this->wait_for_transactions();
   this->dc_pin_->digital_write(false);
   this->enable();
 }
 void ILI9XXXDisplay::start_data_() {
+  this->wait_for_transactions();
   this->dc_pin_->digital_write(true);
   this->enable();
 }
@@ -429,23 +442,23 @@ void ILI9XXXDisplay::init_lcd_(const uint8_t *addr) {
 }
 
 // Tell the display controller where we want to draw pixels.
-void ILI9XXXDisplay::set_addr_window_(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2) {
+void ILI9XXXDisplay::add_addr_window_(spi::SPITransaction &transaction, uint16_t x1, uint16_t y1, uint16_t x2,
+                                      uint16_t y2) {
   x1 += this->offset_x_;
   x2 += this->offset_x_;
   y1 += this->offset_y_;
   y2 += this->offset_y_;
-  this->command(ILI9XXX_CASET);
-  this->data(x1 >> 8);
-  this->data(x1 & 0xFF);
-  this->data(x2 >> 8);
-  this->data(x2 & 0xFF);
-  this->command(ILI9XXX_PASET);  // Page address set
-  this->data(y1 >> 8);
-  this->data(y1 & 0xFF);
-  this->data(y2 >> 8);
-  this->data(y2 & 0xFF);
-  this->command(ILI9XXX_RAMWR);  // Write to RAM
-  this->start_data_();
+  transaction.command(ILI9XXX_CASET);
+  this->add_data_(transaction, x1 >> 8);
+  this->add_data_(transaction, x1 & 0xFF);
+  this->add_data_(transaction, x2 >> 8);
+  this->add_data_(transaction, x2 & 0xFF);
+  transaction.command(ILI9XXX_PASET);  // Page address set
+  this->add_data_(transaction, y1 >> 8);
+  this->add_data_(transaction, y1 & 0xFF);
+  this->add_data_(transaction, y2 >> 8);
+  this->add_data_(transaction, y2 & 0xFF);
+  transaction.command(ILI9XXX_RAMWR);  // Write to RAM
 }
 
 void ILI9XXXDisplay::invert_colors(bool invert) {
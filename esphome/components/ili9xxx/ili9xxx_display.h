@@ -110,7 +110,10 @@ class ILI9XXXDisplay : public display::DisplayBuffer,
   virtual void set_madctl();
   void display_();
   void init_lcd_(const uint8_t *addr);
-  void set_addr_window_(uint16_t x, uint16_t y, uint16_t x2, uint16_t y2);
+  // add the commands selecting the area to draw to, and starting the RAM write, to a transaction.
+  void add_addr_window_(spi::SPITransaction &transaction, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
+  // add a parameter byte to a transaction, the transaction equivalent of data().
+  virtual void add_data_(spi::SPITransaction &transaction, uint8_t value) { transaction.data(value); }
   void reset_();
 
   uint8_t const *init_sequence_{};
@@ -242,6 +245,12 @@ class WAVESHARERES35 : public ILI9XXXILI9488 {
     this->write_byte(value);
     this->end_data_();
   }
+
+ protected:
+  void add_data_(spi::SPITransaction &transaction, uint8_t value) override {
+    transaction.data(0);
+    transaction.data(value);
+  }
 };
 
 //-----------   ILI9XXX_35_TFT origin colors rotated display --------------
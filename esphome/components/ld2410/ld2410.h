@@ -23,6 +23,7 @@
 #include "esphome/components/text_sensor/text_sensor.h"
 #endif
 #include "esphome/components/uart/uart.h"
+#include "esphome/components/uart/uart_framer.h"
 #include "esphome/core/automation.h"
 #include "esphome/core/helpers.h"
 
@@ -205,9 +206,8 @@ class LD2410Component : public Component, public uart::UARTDevice {
   int two_byte_to_int_(char firstbyte, char secondbyte) { return (int16_t) (secondbyte << 8) + firstbyte; }
   void send_command_(uint8_t command_str, const uint8_t *command_value, int command_value_len);
   void set_config_mode_(bool enable);
-  void handle_periodic_data_(uint8_t *buffer, int len);
-  bool handle_ack_data_(uint8_t *buffer, int len);
-  void readline_(int readch, uint8_t *buffer, int len);
+  void handle_periodic_data_(const uint8_t *buffer, int len);
+  bool handle_ack_data_(const uint8_t *buffer, int len);
   void query_parameters_();
   void get_version_();
   void get_mac_();
@@ -215,6 +215,7 @@ class LD2410Component : public Component, public uart::UARTDevice {
   void get_light_control_();
   void restart_();
 
+  uart::UARTFramer framer_{80};
   int32_t last_periodic_millis_ = millis();
   int32_t last_engineering_mode_change_millis_ = millis();
   uint16_t throttle_;
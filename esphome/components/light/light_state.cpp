@@ -146,10 +146,12 @@ std::string LightState::get_effect_name() {
     return "None";
   }
 }
-
-void LightState::add_new_remote_values_callback(std::function<void()> &&send_callback) {
-  this->remote_values_callback_.add(std::move(send_callback));
+StringRef LightState::get_effect_name_ref() {
+  if (this->active_effect_index_ > 0)
+    return StringRef(this->effects_[this->active_effect_index_ - 1]->get_name());
+  return StringRef("None");
 }
+
 void LightState::add_new_target_state_reached_callback(std::function<void()> &&send_callback) {
   this->target_state_reached_callback_.add(std::move(send_callback));
 }
@@ -113,6 +113,8 @@ class LightState : public EntityBase, public Component {
 
   /// Return the name of the current effect, or if no effect is active "None".
   std::string get_effect_name();
+  /// Return the name of the current effect like get_effect_name(), without copying it.
+  StringRef get_effect_name_ref();
 
   /**
    * This lets front-end components subscribe to light change events. This callback is called once
@@ -120,7 +122,9 @@ class LightState : public EntityBase, public Component {
    *
    * @param send_callback The callback.
    */
-  void add_new_remote_values_callback(std::function<void()> &&send_callback);
+  template<typename F> void add_new_remote_values_callback(F &&send_callback) {
+    this->remote_values_callback_.add(std::forward<F>(send_callback));
+  }
 
   /**
    * The callback is called once the state of current_values and remote_values are equal (when the
@@ -55,8 +55,6 @@ void Lock::publish_state(LockState state) {
   this->state_callback_.call();
 }
 
-void Lock::add_on_state_callback(std::function<void()> &&callback) { this->state_callback_.add(std::move(callback)); }
-
 void LockCall::perform() {
   ESP_LOGD(TAG, "'%s' - Setting", this->parent_->get_name().c_str());
   this->validate_();
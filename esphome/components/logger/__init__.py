@@ -1,6 +1,7 @@
+from pathlib import Path
 import re
 
-from esphome import automation
+from esphome import automation, binary_log
 from esphome.automation import LambdaAction
 import esphome.codegen as cg
 from esphome.components.esp32 import add_idf_sdkconfig_option, get_esp32_variant
@@ -32,10 +33,11 @@ from esphome.const import (
     PLATFORM_BK72XX,
     PLATFORM_ESP32,
     PLATFORM_ESP8266,
+    PLATFORM_HOST,
     PLATFORM_RP2040,
     PLATFORM_RTL87XX,
 )
-from esphome.core import CORE, EsphomeError, Lambda, coroutine_with_priority
+from esphome.core import CORE, EsphomeError, HexInt, Lambda, coroutine_with_priority
 
 CODEOWNERS = ["@esphome/core"]
 logger_ns = cg.esphome_ns.namespace("logger")
@@ -170,6 +172,19 @@ LoggerMessageTrigger = logger_ns.class_(
 )
 
 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH = "esp8266_store_log_strings_in_flash"
+CONF_LOG_RING_SIZE = "log_ring_size"
+CONF_BINARY_LOGS = "binary_logs"
+CONF_FORMAT_IDS_ID = "format_ids_id"
+
+
+def validate_binary_logs(value):
+    if value.get(CONF_BINARY_LOGS) and CONF_LOG_RING_SIZE in value:
+        raise cv.Invalid(
+            f"{CONF_BINARY_LOGS} can not be combined with {CONF_LOG_RING_SIZE}"
+        )
+    return value
+
+
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
@@ -216,12 +231,41 @@ CONFIG_SCHEMA = cv.All(
             cv.SplitDefault(
                 CONF_ESP8266_STORE_LOG_STRINGS_IN_FLASH, esp8266=True
             ): cv.All(cv.only_on_esp8266, cv.boolean),
+            cv.Optional(CONF_LOG_RING_SIZE): cv.All(
+                cv.only_on([PLATFORM_ESP32, PLATFORM_HOST]),
+                cv.int_range(min=2, max=256),
+            ),
+            cv.Optional(CONF_BINARY_LOGS): cv.All(
+                cv.only_on(
+                    [
+                        PLATFORM_ESP32,
+                        PLATFORM_HOST,
+                        PLATFORM_RP2040,
+                        PLATFORM_BK72XX,
+                        PLATFORM_RTL87XX,
+                    ]
+                ),
+                cv.boolean,
+            ),
+            cv.GenerateID(CONF_FORMAT_IDS_ID): cv.declare_id(cg.uint32),
         }
     ).extend(cv.COMPONENT_SCHEMA),
     validate_local_no_higher_than_global,
+    validate_binary_logs,
 )
 
 
+def _log_format_sources() -> list[Path]:
+    from esphome.config import iter_components
+
+    paths = []
+    for _, component in iter_components(CORE.config):
+        for resource in component.resources:
+            with resource.path() as path:
+                paths.append(Path(path))
+    return paths
+
+
 @coroutine_with_priority(90.0)
 async def to_code(config):
     baud_rate = config[CONF_BAUD_RATE]
@@ -233,6 +277,17 @@ async def to_code(config):
             )
         )
     cg.add(log.pre_setup())
+    if CONF_LOG_RING_SIZE in config:
+        cg.add_define("USE_LOGGER_LOG_RING")
+        cg.add(log.init_log_ring(config[CONF_LOG_RING_SIZE]))
+    if config.get(CONF_BINARY_LOGS):
+        cg.add_define("USE_LOGGER_BINARY")
+        table = binary_log.build_format_table(_log_format_sources())
+        binary_log.write_format_table(table)
+        ids = cg.static_const_array(
+            config[CONF_FORMAT_IDS_ID], [HexInt(x) for x in sorted(table)]
+        )
+        cg.add(log.set_binary_format_ids(ids, len(table)))
 
     for tag, level in config[CONF_LOGS].items():
         cg.add(log.set_log_level(tag, LOG_LEVELS[level]))
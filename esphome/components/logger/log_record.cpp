@@ -0,0 +1,257 @@
+#include "log_record.h"
+
+#ifdef USE_LOGGER_BINARY
+
+#include <cstring>
+
+namespace esphome {
+namespace logger {
+
+namespace {
+
+class RecordWriter {
+ public:
+  RecordWriter(uint8_t *buffer, size_t size) : buffer_(buffer), size_(size) {}
+
+  void write_byte(uint8_t value) {
+    if (this->at_ < this->size_) {
+      this->buffer_[this->at_++] = value;
+    } else {
+      this->overflow_ = true;
+    }
+  }
+  void write_varint(uint64_t value) {
+    while (value >= 0x80) {
+      this->write_byte(static_cast<uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    this->write_byte(static_cast<uint8_t>(value));
+  }
+  void write_signed(int64_t value) {
+    this->write_varint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+  }
+  void write_float(float value) {
+    uint32_t raw;
+    memcpy(&raw, &value, sizeof(raw));
+    for (int i = 0; i < 4; i++)
+      this->write_byte(static_cast<uint8_t>(raw >> (i * 8)));
+  }
+  void write_string(const char *value, size_t len) {
+    this->write_varint(len);
+    if (this->at_ + len > this->size_) {
+      this->overflow_ = true;
+      return;
+    }
+    memcpy(this->buffer_ + this->at_, value, len);
+    this->at_ += len;
+  }
+  void write_header(int level, const char *tag, int line, uint32_t format_id) {
+    this->write_byte(LOG_RECORD_MARKER);
+    this->write_byte(static_cast<uint8_t>(level));
+    for (int i = 0; i < 4; i++)
+      this->write_byte(static_cast<uint8_t>(format_id >> (i * 8)));
+    this->write_varint(line);
+    this->write_string(tag, strlen(tag));
+  }
+  size_t finish() const { return this->overflow_ ? 0 : this->at_; }
+
+ protected:
+  uint8_t *buffer_;
+  size_t size_;
+  size_t at_{0};
+  bool overflow_{false};
+};
+
+enum LengthModifier : uint8_t { LEN_NONE, LEN_HH, LEN_H, LEN_L, LEN_LL, LEN_Z, LEN_J, LEN_T, LEN_LONG_DOUBLE };
+
+int64_t read_signed(va_list &args, LengthModifier len) {
+  switch (len) {
+    case LEN_L:
+      return va_arg(args, long);
+    case LEN_LL:
+      return va_arg(args, long long);
+    case LEN_Z:
+      return static_cast<int64_t>(va_arg(args, size_t));
+    case LEN_J:
+      return va_arg(args, intmax_t);
+    case LEN_T:
+      return va_arg(args, ptrdiff_t);
+    case LEN_HH:
+      return static_cast<signed char>(va_arg(args, int));
+    case LEN_H:
+      return static_cast<short>(va_arg(args, int));
+    default:
+      return va_arg(args, int);
+  }
+}
+
+uint64_t read_unsigned(va_list &args, LengthModifier len) {
+  switch (len) {
+    case LEN_L:
+      return va_arg(args, unsigned long);
+    case LEN_LL:
+      return va_arg(args, unsigned long long);
+    case LEN_Z:
+      return va_arg(args, size_t);
+    case LEN_J:
+      return va_arg(args, uintmax_t);
+    case LEN_T:
+      return static_cast<uint64_t>(va_arg(args, ptrdiff_t));
+    case LEN_HH:
+      return static_cast<unsigned char>(va_arg(args, unsigned int));
+    case LEN_H:
+      return static_cast<unsigned short>(va_arg(args, unsigned int));
+    default:
+      return va_arg(args, unsigned int);
+  }
+}
+
+/// Append the arguments described by `format`, returns false on an unsupported conversion.
+bool write_args(RecordWriter &writer, const char *format, va_list &args) {
+  for (const char *p = format; *p != '\0'; p++) {
+    if (*p != '%')
+      continue;
+    p++;
+    if (*p == '%')
+      continue;
+    while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0')
+      p++;
+    if (*p == '*') {
+      writer.write_signed(va_arg(args, int));
+      p++;
+    } else {
+      while (*p >= '0' && *p <= '9')
+        p++;
+    }
+    // Negative if there is none, strings with a precision don't need to be terminated
+    int precision = -1;
+    if (*p == '.') {
+      p++;
+      if (*p == '*') {
+        precision = va_arg(args, int);
+        writer.write_signed(precision);
+        p++;
+      } else {
+        precision = 0;
+        while (*p >= '0' && *p <= '9')
+          precision = precision * 10 + (*p++ - '0');
+      }
+    }
+
+    LengthModifier len = LEN_NONE;
+    switch (*p) {
+      case 'h':
+        len = p[1] == 'h' ? LEN_HH : LEN_H;
+        p += len == LEN_HH ? 2 : 1;
+        break;
+      case 'l':
+        len = p[1] == 'l' ? LEN_LL : LEN_L;
+        p += len == LEN_LL ? 2 : 1;
+        break;
+      case 'z':
+        len = LEN_Z;
+        p++;
+        break;
+      case 'j':
+        len = LEN_J;
+        p++;
+        break;
+      case 't':
+        len = LEN_T;
+        p++;
+        break;
+      case 'L':
+        len = LEN_LONG_DOUBLE;
+        p++;
+        break;
+      default:
+        break;
+    }
+
+    switch (*p) {
+      case 'd':
+      case 'i':
+        writer.write_signed(read_signed(args, len));
+        break;
+      case 'u':
+      case 'o':
+      case 'x':
+      case 'X':
+        writer.write_varint(read_unsigned(args, len));
+        break;
+      case 'c':
+        writer.write_varint(static_cast<unsigned char>(va_arg(args, int)));
+        break;
+      case 'f':
+      case 'F':
+      case 'e':
+      case 'E':
+      case 'g':
+      case 'G':
+      case 'a':
+      case 'A':
+        if (len == LEN_LONG_DOUBLE) {
+          writer.write_float(static_cast<float>(va_arg(args, long double)));
+        } else {
+          writer.write_float(static_cast<float>(va_arg(args, double)));
+        }
+        break;
+      case 's': {
+        const char *value = va_arg(args, const char *);
+        if (value == nullptr)
+          value = "(null)";
+        writer.write_string(value, precision < 0 ? strlen(value) : strnlen(value, precision));
+        break;
+      }
+      case 'p':
+        writer.write_varint(reinterpret_cast<uintptr_t>(va_arg(args, void *)));
+        break;
+      case 'n':
+        va_arg(args, void *);
+        break;
+      default:
+        // Unsupported or truncated conversion, let the caller fall back to text
+        return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+uint32_t log_format_id(const char *format) {
+  uint32_t hash = 2166136261UL;
+  for (const char *p = format; *p != '\0'; p++) {
+    hash ^= static_cast<uint8_t>(*p);
+    hash *= 16777619UL;
+  }
+  // Keep 0 reserved for text records
+  return hash == LOG_RECORD_TEXT_ID ? 1 : hash;
+}
+
+size_t encode_log_record(uint8_t *buffer, size_t size, int level, const char *tag, int line, uint32_t format_id,
+                         const char *format, va_list args) {
+  RecordWriter writer(buffer, size);
+  writer.write_header(level, tag, line, format_id);
+  // va_list may be an array type, copy it so it can be passed on by reference
+  va_list copy;
+  va_copy(copy, args);
+  bool ok = write_args(writer, format, copy);
+  va_end(copy);
+  if (!ok)
+    return 0;
+  return writer.finish();
+}
+
+size_t encode_log_text_record(uint8_t *buffer, size_t size, int level, const char *tag, int line, const char *text,
+                              size_t text_len) {
+  RecordWriter writer(buffer, size);
+  writer.write_header(level, tag, line, LOG_RECORD_TEXT_ID);
+  writer.write_string(text, text_len);
+  return writer.finish();
+}
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_BINARY
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_LOGGER_BINARY
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace logger {
+
+/// First byte of every binary log record. Text log lines never start with it.
+static const uint8_t LOG_RECORD_MARKER = 0x1E;
+/// Format id of records that carry an already formatted message instead of raw arguments.
+static const uint32_t LOG_RECORD_TEXT_ID = 0;
+
+/// 32-bit FNV-1a hash of a format string, must match `esphome.binary_log.format_id()`.
+uint32_t log_format_id(const char *format);
+
+/** Encode a log call as a compact binary record.
+ *
+ * Layout: marker, level, format id (uint32 little endian), line (varint), tag (varint length + bytes), followed by
+ * the arguments in format-string order. Integers are (zigzag) varints, floating point values are float32, strings
+ * are length-prefixed.
+ *
+ * @return The number of bytes written, or 0 if the record did not fit or the format uses an unsupported conversion.
+ */
+size_t encode_log_record(uint8_t *buffer, size_t size, int level, const char *tag, int line, uint32_t format_id,
+                         const char *format, va_list args);
+
+/// Encode a record with format id LOG_RECORD_TEXT_ID carrying `text` as its only argument.
+size_t encode_log_text_record(uint8_t *buffer, size_t size, int level, const char *tag, int line, const char *text,
+                              size_t text_len);
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_BINARY
@@ -0,0 +1,63 @@
+#include "log_ring.h"
+
+#ifdef USE_LOGGER_LOG_RING
+
+namespace esphome {
+namespace logger {
+
+LogRing::LogRing(size_t slots, size_t slot_size) : slot_size_(slot_size) {
+  size_t count = 1;
+  while (count < slots)
+    count <<= 1;
+  this->mask_ = count - 1;
+
+  this->slots_ = new LogRingSlot[count];             // NOLINT
+  char *storage = new char[count * (slot_size + 1)];  // NOLINT
+  for (size_t i = 0; i < count; i++) {
+    this->slots_[i].sequence.store(i, std::memory_order_relaxed);
+    this->slots_[i].text = storage + i * (slot_size + 1);
+  }
+}
+
+LogRingSlot *LogRing::acquire() {
+  uint32_t pos = this->enqueue_pos_.load(std::memory_order_relaxed);
+  while (true) {
+    LogRingSlot *slot = &this->slots_[pos & this->mask_];
+    uint32_t seq = slot->sequence.load(std::memory_order_acquire);
+    auto diff = static_cast<int32_t>(seq - pos);
+    if (diff == 0) {
+      if (this->enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        return slot;
+    } else if (diff < 0) {
+      // Consumer has not released this slot yet, ring is full
+      return nullptr;
+    } else {
+      pos = this->enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+void LogRing::commit(LogRingSlot *slot) {
+  // Only the producer owning this slot touches its sequence until it is published
+  uint32_t seq = slot->sequence.load(std::memory_order_relaxed);
+  slot->sequence.store(seq + 1, std::memory_order_release);
+}
+
+LogRingSlot *LogRing::front() {
+  LogRingSlot *slot = &this->slots_[this->dequeue_pos_ & this->mask_];
+  uint32_t seq = slot->sequence.load(std::memory_order_acquire);
+  if (seq != this->dequeue_pos_ + 1)
+    return nullptr;
+  return slot;
+}
+
+void LogRing::pop() {
+  LogRingSlot *slot = &this->slots_[this->dequeue_pos_ & this->mask_];
+  slot->sequence.store(this->dequeue_pos_ + this->mask_ + 1, std::memory_order_release);
+  this->dequeue_pos_++;
+}
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_LOG_RING
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_LOGGER_LOG_RING
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace logger {
+
+/// A single formatted log line waiting in the ring.
+struct LogRingSlot {
+  std::atomic<uint32_t> sequence;
+  const char *tag;
+  char *text;
+  uint8_t level;
+};
+
+/** Bounded lock-free multi-producer/single-consumer queue of formatted log lines.
+ *
+ * Producers (any task or core) reserve a slot with acquire(), format directly into its text buffer and publish it
+ * with commit(). The single consumer (the logger's main-loop drain) reads committed slots in order with front() and
+ * releases them with pop(). Slot sequencing follows Dmitry Vyukov's bounded queue, so neither side ever takes a lock.
+ */
+class LogRing {
+ public:
+  /// Create a ring with `slots` entries (rounded up to a power of two) of `slot_size` characters each.
+  LogRing(size_t slots, size_t slot_size);
+
+  /// Reserve a free slot for writing, or return nullptr if the ring is full.
+  LogRingSlot *acquire();
+  /// Publish a slot previously returned by acquire() to the consumer.
+  void commit(LogRingSlot *slot);
+
+  /// Oldest committed slot, or nullptr if none is ready. Consumer side only.
+  LogRingSlot *front();
+  /// Release the slot returned by front(). Consumer side only.
+  void pop();
+
+  size_t get_slot_count() const { return this->mask_ + 1; }
+  size_t get_slot_size() const { return this->slot_size_; }
+
+ protected:
+  LogRingSlot *slots_;
+  size_t mask_;
+  size_t slot_size_;
+  std::atomic<uint32_t> enqueue_pos_{0};
+  uint32_t dequeue_pos_{0};
+};
+
+}  // namespace logger
+}  // namespace esphome
+
+#endif  // USE_LOGGER_LOG_RING
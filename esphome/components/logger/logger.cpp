@@ -1,5 +1,7 @@
 #include "logger.h"
+#include <algorithm>
 #include <cinttypes>
+#include <cstring>
 
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
@@ -31,6 +33,23 @@ static const char *const LOG_LEVEL_LETTERS[] = {
     "VV",  // VERY_VERBOSE
 };
 
+const char *Logger::get_thread_name_() {
+#if defined(USE_ESP32) || defined(USE_LIBRETINY)
+  TaskHandle_t current_task = xTaskGetCurrentTaskHandle();
+#else
+  void *current_task = nullptr;
+#endif
+  if (current_task == main_task_)
+    return nullptr;
+  const char *thread_name = "";
+#if defined(USE_ESP32)
+  thread_name = pcTaskGetName(current_task);
+#elif defined(USE_LIBRETINY)
+  thread_name = pcTaskGetTaskName(current_task);
+#endif
+  return thread_name;
+}
+
 void Logger::write_header_(int level, const char *tag, int line) {
   if (level < 0)
     level = 0;
@@ -39,30 +58,34 @@ void Logger::write_header_(int level, const char *tag, int line) {
 
   const char *color = LOG_LEVEL_COLORS[level];
   const char *letter = LOG_LEVEL_LETTERS[level];
-#if defined(USE_ESP32) || defined(USE_LIBRETINY)
-  TaskHandle_t current_task = xTaskGetCurrentTaskHandle();
-#else
-  void *current_task = nullptr;
-#endif
-  if (current_task == main_task_) {
+  const char *thread_name = this->get_thread_name_();
+  if (thread_name == nullptr) {
     this->printf_to_buffer_("%s[%s][%s:%03u]: ", color, letter, tag, line);
   } else {
-    const char *thread_name = "";
-#if defined(USE_ESP32)
-    thread_name = pcTaskGetName(current_task);
-#elif defined(USE_LIBRETINY)
-    thread_name = pcTaskGetTaskName(current_task);
-#endif
     this->printf_to_buffer_("%s[%s][%s:%03u]%s[%s]%s: ", color, letter, tag, line,
                             ESPHOME_LOG_BOLD(ESPHOME_LOG_COLOR_RED), thread_name, color);
   }
 }
 
 void HOT Logger::log_vprintf_(int level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
+#ifdef USE_LOGGER_LOG_RING
+  if (this->log_ring_ != nullptr) {
+    if (level <= this->level_for(tag))
+      this->log_to_ring_(level, tag, line, format, args);
+    return;
+  }
+#endif
   if (level > this->level_for(tag) || recursion_guard_)
     return;
 
   recursion_guard_ = true;
+#ifdef USE_LOGGER_BINARY
+  if (this->format_ids_ != nullptr) {
+    this->log_binary_(level, tag, line, format, args);
+    recursion_guard_ = false;
+    return;
+  }
+#endif
   this->reset_buffer_();
   this->write_header_(level, tag, line);
   this->vprintf_to_buffer_(format, args);
@@ -121,12 +144,19 @@ void HOT Logger::log_message_(int level, const char *tag, int offset) {
   // make sure null terminator is present
   this->set_null_terminator_();
 
-  const char *msg = this->tx_buffer_ + offset;
+  this->deliver_message_(level, tag, this->tx_buffer_ + offset);
+}
 
+void HOT Logger::deliver_message_(int level, const char *tag, const char *msg) {
   if (this->baud_rate_ > 0) {
     this->write_msg_(msg);
   }
+  this->call_log_callbacks_(level, tag, msg);
+}
 
+void HOT Logger::call_log_callbacks_(int level, const char *tag, const char *msg) {
+  if (this->log_callback_.empty())
+    return;
 #ifdef USE_ESP32
   // Suppress network-logging if memory constrained, but still log to serial
   // ports. In some configurations (eg BLE enabled) there may be some transient
@@ -148,9 +178,170 @@ Logger::Logger(uint32_t baud_rate, size_t tx_buffer_size) : baud_rate_(baud_rate
 #endif
 }
 
-#ifdef USE_LOGGER_USB_CDC
+#ifdef USE_LOGGER_LOG_RING
+void Logger::init_log_ring(size_t slots) {
+  this->log_ring_ = make_unique<LogRing>(slots, this->tx_buffer_size_);
+}
+
+void HOT Logger::log_to_ring_(int level, const char *tag, int line, const char *format, va_list args) {
+  const char *thread_name = this->get_thread_name_();
+  if (thread_name == nullptr && this->recursion_guard_) {
+    // Logged from a callback while draining, same rule as the synchronous path
+    return;
+  }
+
+  LogRingSlot *slot = this->log_ring_->acquire();
+  if (slot == nullptr && thread_name == nullptr) {
+    // The main task is the consumer, so it can make room instead of dropping
+    this->drain_log_ring_();
+    slot = this->log_ring_->acquire();
+  }
+  if (slot == nullptr) {
+    this->log_ring_dropped_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  if (level < 0)
+    level = 0;
+  if (level > 7)
+    level = 7;
+  const char *color = LOG_LEVEL_COLORS[level];
+  const char *letter = LOG_LEVEL_LETTERS[level];
+  const size_t size = this->log_ring_->get_slot_size();
+  char *buf = slot->text;
+  size_t at;
+  int ret;
+  if (thread_name == nullptr) {
+    ret = snprintf(buf, size, "%s[%s][%s:%03u]: ", color, letter, tag, line);
+  } else {
+    ret = snprintf(buf, size, "%s[%s][%s:%03u]%s[%s]%s: ", color, letter, tag, line,
+                   ESPHOME_LOG_BOLD(ESPHOME_LOG_COLOR_RED), thread_name, color);
+  }
+  at = ret < 0 ? 0 : std::min<size_t>(ret, size);
+  if (at < size) {
+    ret = vsnprintf(buf + at, size - at, format, args);
+    if (ret > 0)
+      at = std::min<size_t>(at + ret, size);
+  }
+  if (at > 0 && buf[at - 1] == '\n')
+    at--;
+  const size_t reset_len = strlen(ESPHOME_LOG_RESET_COLOR);
+  if (at + reset_len <= size) {
+    memcpy(buf + at, ESPHOME_LOG_RESET_COLOR, reset_len);
+    at += reset_len;
+  }
+  buf[at] = '\0';
+
+  slot->level = level;
+  slot->tag = tag;
+  this->log_ring_->commit(slot);
+}
+
+void Logger::drain_log_ring_() {
+  this->recursion_guard_ = true;
+  uint32_t dropped = this->log_ring_dropped_.load(std::memory_order_relaxed);
+  if (dropped != this->log_ring_dropped_reported_) {
+    this->reset_buffer_();
+    this->write_header_(ESPHOME_LOG_LEVEL_WARN, TAG, __LINE__);
+    this->printf_to_buffer_("%" PRIu32 " messages dropped, log ring full", dropped - this->log_ring_dropped_reported_);
+    this->write_footer_();
+    this->log_message_(ESPHOME_LOG_LEVEL_WARN, TAG);
+    this->log_ring_dropped_reported_ = dropped;
+  }
+  // Bound the batch to one ring's worth so messages logged by the callbacks wait for the next loop
+  for (size_t i = 0, n = this->log_ring_->get_slot_count(); i < n; i++) {
+    LogRingSlot *slot = this->log_ring_->front();
+    if (slot == nullptr)
+      break;
+    this->deliver_message_(slot->level, slot->tag, slot->text);
+    this->log_ring_->pop();
+  }
+  this->recursion_guard_ = false;
+}
+#endif
+
+#ifdef USE_LOGGER_BINARY
+void Logger::set_binary_format_ids(const uint32_t *ids, size_t count) {
+  this->format_ids_ = ids;
+  this->format_id_count_ = count;
+  // Leave room for the base64 expansion of a record when it is written to serial
+  this->record_buffer_size_ = (this->tx_buffer_size_ - 1) / 4 * 3;
+  this->record_buffer_ = new uint8_t[this->record_buffer_size_];  // NOLINT
+}
+
+void HOT Logger::log_binary_(int level, const char *tag, int line, const char *format, va_list args) {
+  size_t len = 0;
+  uint32_t format_id = log_format_id(format);
+  if (std::binary_search(this->format_ids_, this->format_ids_ + this->format_id_count_, format_id)) {
+    len = encode_log_record(this->record_buffer_, this->record_buffer_size_, level, tag, line, format_id, format,
+                            args);
+  }
+
+  // Only format text if the format is unknown to the decoder or a text consumer wants it
+  bool text = this->wants_text_(level);
+  if (len == 0 || text) {
+    this->reset_buffer_();
+    this->write_header_(level, tag, line);
+    int msg_start = this->tx_buffer_at_;
+    this->vprintf_to_buffer_(format, args);
+    if (len == 0) {
+      int msg_len = this->tx_buffer_at_ - msg_start;
+      if (msg_len > 0 && this->tx_buffer_[this->tx_buffer_at_ - 1] == '\n')
+        msg_len--;
+      len = encode_log_text_record(this->record_buffer_, this->record_buffer_size_, level, tag, line,
+                                   this->tx_buffer_ + msg_start, msg_len);
+    }
+    if (text) {
+      this->write_footer_();
+      this->set_null_terminator_();
+      // Serial gets the record below instead of the text
+      this->call_log_callbacks_(level, tag, this->tx_buffer_);
+    }
+  }
+  if (len > 0)
+    this->write_record_(level, this->record_buffer_, len);
+}
+
+bool HOT Logger::wants_text_(int level) {
+  if (this->always_text_)
+    return true;
+  for (auto &check : this->text_checks_) {
+    if (check(level))
+      return true;
+  }
+  return false;
+}
+
+void HOT Logger::write_record_(int level, const uint8_t *record, size_t len) {
+  if (this->baud_rate_ > 0) {
+    // Serial is line based, so records are sent base64 encoded after the marker byte
+    static const char *const BASE64_CHARS = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    this->reset_buffer_();
+    this->write_to_buffer_(static_cast<char>(LOG_RECORD_MARKER));
+    for (size_t i = 0; i < len; i += 3) {
+      uint32_t chunk = record[i] << 16;
+      if (i + 1 < len)
+        chunk |= record[i + 1] << 8;
+      if (i + 2 < len)
+        chunk |= record[i + 2];
+      this->write_to_buffer_(BASE64_CHARS[(chunk >> 18) & 0x3F]);
+      this->write_to_buffer_(BASE64_CHARS[(chunk >> 12) & 0x3F]);
+      this->write_to_buffer_(i + 1 < len ? BASE64_CHARS[(chunk >> 6) & 0x3F] : '=');
+      this->write_to_buffer_(i + 2 < len ? BASE64_CHARS[chunk & 0x3F] : '=');
+    }
+    this->set_null_terminator_();
+    this->write_msg_(this->tx_buffer_);
+  }
+}
+#endif
+
+#if defined(USE_LOGGER_USB_CDC) || defined(USE_LOGGER_LOG_RING)
 void Logger::loop() {
-#ifdef USE_ARDUINO
+#ifdef USE_LOGGER_LOG_RING
+  if (this->log_ring_ != nullptr)
+    this->drain_log_ring_();
+#endif
+#if defined(USE_LOGGER_USB_CDC) && defined(USE_ARDUINO)
   if (this->uart_ != UART_SELECTION_USB_CDC) {
     return;
   }
@@ -177,6 +368,16 @@ UARTSelection Logger::get_uart() const { return this->uart_; }
 
 void Logger::add_on_log_callback(std::function<void(int, const char *, const char *)> &&callback) {
   this->log_callback_.add(std::move(callback));
+#ifdef USE_LOGGER_BINARY
+  this->always_text_ = true;
+#endif
+}
+void Logger::add_on_log_callback(std::function<void(int, const char *, const char *)> &&callback,
+                                 std::function<bool(int)> &&wants_text) {
+  this->log_callback_.add(std::move(callback));
+#ifdef USE_LOGGER_BINARY
+  this->text_checks_.push_back(std::move(wants_text));
+#endif
 }
 float Logger::get_setup_priority() const { return setup_priority::BUS + 500.0f; }
 const char *const LOG_LEVELS[] = {"NONE", "ERROR", "WARN", "INFO", "CONFIG", "DEBUG", "VERBOSE", "VERY_VERBOSE"};
@@ -192,6 +393,13 @@ void Logger::dump_config() {
   for (auto &it : this->log_levels_) {
     ESP_LOGCONFIG(TAG, "  Level for '%s': %s", it.tag.c_str(), LOG_LEVELS[it.level]);
   }
+#ifdef USE_LOGGER_LOG_RING
+  if (this->log_ring_ != nullptr) {
+    ESP_LOGCONFIG(TAG, "  Log Ring: %u slots of %u bytes", (unsigned) this->log_ring_->get_slot_count(),
+                  (unsigned) this->log_ring_->get_slot_size());
+    ESP_LOGCONFIG(TAG, "  Log Ring Dropped: %" PRIu32, this->get_log_ring_dropped());
+  }
+#endif
 }
 void Logger::write_footer_() { this->write_to_buffer_(ESPHOME_LOG_RESET_COLOR, strlen(ESPHOME_LOG_RESET_COLOR)); }
 
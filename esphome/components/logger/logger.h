@@ -7,6 +7,15 @@
 #include "esphome/core/defines.h"
 #include "esphome/core/helpers.h"
 
+#ifdef USE_LOGGER_LOG_RING
+#include <atomic>
+#include <memory>
+#include "log_ring.h"
+#endif
+#ifdef USE_LOGGER_BINARY
+#include "log_record.h"
+#endif
+
 #ifdef USE_ARDUINO
 #if defined(USE_ESP8266) || defined(USE_ESP32)
 #include <HardwareSerial.h>
@@ -56,8 +65,27 @@ enum UARTSelection {
 class Logger : public Component {
  public:
   explicit Logger(uint32_t baud_rate, size_t tx_buffer_size);
-#ifdef USE_LOGGER_USB_CDC
+#if defined(USE_LOGGER_USB_CDC) || defined(USE_LOGGER_LOG_RING)
   void loop() override;
+#endif
+#ifdef USE_LOGGER_LOG_RING
+  /** Defer message delivery through a lock-free ring of `slots` formatted lines.
+   *
+   * Callers only format and enqueue; serial output and the log callbacks (API, web_server, MQTT) are run in
+   * batches from loop().
+   */
+  void init_log_ring(size_t slots);
+  /// Number of messages dropped because the ring was full.
+  uint32_t get_log_ring_dropped() const { return this->log_ring_dropped_.load(std::memory_order_relaxed); }
+#endif
+#ifdef USE_LOGGER_BINARY
+  /** Enable binary log records for the given sorted table of known format ids.
+   *
+   * Calls with a known format are encoded by log_record.h instead of being run through vsnprintf; everything else
+   * is sent as a text record. Records only go to serial; text is still formatted when a text log callback (API,
+   * MQTT, web_server) is registered.
+   */
+  void set_binary_format_ids(const uint32_t *ids, size_t count);
 #endif
   /// Manually set the baud rate for serial, set to 0 to disable.
   void set_baud_rate(uint32_t baud_rate);
@@ -87,6 +115,12 @@ class Logger : public Component {
 
   /// Register a callback that will be called for every log message sent
   void add_on_log_callback(std::function<void(int, const char *, const char *)> &&callback);
+  /** Register a callback that only needs the messages of the levels `wants_text` returns true for.
+   *
+   * With binary logging, messages are only formatted as text when a callback needs them.
+   */
+  void add_on_log_callback(std::function<void(int, const char *, const char *)> &&callback,
+                           std::function<bool(int)> &&wants_text);
 
   float get_setup_priority() const override;
 
@@ -99,6 +133,21 @@ class Logger : public Component {
   void write_header_(int level, const char *tag, int line);
   void write_footer_();
   void log_message_(int level, const char *tag, int offset = 0);
+  void deliver_message_(int level, const char *tag, const char *msg);
+  /// Hand a message to the log callbacks unless memory is short.
+  void call_log_callbacks_(int level, const char *tag, const char *msg);
+  /// Name of the calling task, or nullptr when called from the main loop task.
+  const char *get_thread_name_();
+#ifdef USE_LOGGER_LOG_RING
+  void log_to_ring_(int level, const char *tag, int line, const char *format, va_list args);
+  void drain_log_ring_();
+#endif
+#ifdef USE_LOGGER_BINARY
+  void log_binary_(int level, const char *tag, int line, const char *format, va_list args);
+  void write_record_(int level, const uint8_t *record, size_t len);
+  /// Whether a log callback needs the text of a message with this level.
+  bool wants_text_(int level);
+#endif
   void write_msg_(const char *msg);
 
   inline bool is_buffer_full_() const { return this->tx_buffer_at_ >= this->tx_buffer_size_; }
@@ -168,6 +217,21 @@ class Logger : public Component {
   /// Prevents recursive log calls, if true a log message is already being processed.
   bool recursion_guard_ = false;
   void *main_task_ = nullptr;
+#ifdef USE_LOGGER_LOG_RING
+  std::unique_ptr<LogRing> log_ring_;
+  std::atomic<uint32_t> log_ring_dropped_{0};
+  uint32_t log_ring_dropped_reported_{0};
+#endif
+#ifdef USE_LOGGER_BINARY
+  const uint32_t *format_ids_{nullptr};
+  size_t format_id_count_{0};
+  uint8_t *record_buffer_{nullptr};
+  size_t record_buffer_size_{0};
+  /// Checks of the callbacks registered with a condition, see add_on_log_callback().
+  std::vector<std::function<bool(int)>> text_checks_;
+  /// Set once a callback without a condition is registered.
+  bool always_text_{false};
+#endif
 };
 
 extern Logger *global_logger;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
@@ -176,11 +240,13 @@ class LoggerMessageTrigger : public Trigger<int, const char *, const char *> {
  public:
   explicit LoggerMessageTrigger(Logger *parent, int level) {
     this->level_ = level;
-    parent->add_on_log_callback([this](int level, const char *tag, const char *message) {
-      if (level <= this->level_) {
-        this->trigger(level, tag, message);
-      }
-    });
+    parent->add_on_log_callback(
+        [this](int level, const char *tag, const char *message) {
+          if (level <= this->level_) {
+            this->trigger(level, tag, message);
+          }
+        },
+        [this](int level) { return level <= this->level_; });
   }
 
  protected:
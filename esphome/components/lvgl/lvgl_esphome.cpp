@@ -210,7 +210,7 @@ void LvButtonMatrixType::set_obj(lv_obj_t *lv_obj) {
       lv_obj,
       [](lv_event_t *event) {
         auto *self = static_cast<LvButtonMatrixType *>(event->user_data);
-        if (self->key_callback_.size() == 0)
+        if (self->key_callback_.empty())
           return;
         auto key_idx = lv_btnmatrix_get_selected_btn(self->obj);
         if (key_idx == LV_BTNMATRIX_BTN_NONE)
@@ -240,7 +240,7 @@ void LvKeyboardType::set_obj(lv_obj_t *lv_obj) {
       lv_obj,
       [](lv_event_t *event) {
         auto *self = static_cast<LvKeyboardType *>(event->user_data);
-        if (self->key_callback_.size() == 0)
+        if (self->key_callback_.empty())
           return;
 
         auto key_idx = lv_btnmatrix_get_selected_btn(self->obj);
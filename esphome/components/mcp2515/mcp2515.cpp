@@ -1,6 +1,8 @@
 #include "mcp2515.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
+
 namespace esphome {
 namespace mcp2515 {
 
@@ -20,6 +22,8 @@ bool MCP2515::setup_internal() {
     return false;
   if (this->set_bitrate_(this->bit_rate_, this->mcp_clock_) != canbus::ERROR_OK)
     return false;
+  if (this->set_filters_(this->get_filters_()) != canbus::ERROR_OK)
+    return false;
   if (this->set_mode_(this->mcp_mode_) != canbus::ERROR_OK)
     return false;
   uint8_t err_flags = this->get_error_flags_();
@@ -229,6 +233,71 @@ canbus::Error MCP2515::set_filter_(const RXF num, const bool extended, const uin
   return canbus::ERROR_OK;
 }
 
+canbus::Error MCP2515::set_filters_(const std::vector<canbus::CanFilter> &filters) {
+  // The masks are cleared by the reset, receiving every frame
+  if (filters.empty())
+    return canbus::ERROR_OK;
+
+  std::vector<canbus::CanFilter> sorted = filters;
+  std::sort(sorted.begin(), sorted.end(), [](const canbus::CanFilter &a, const canbus::CanFilter &b) {
+    return a.use_extended_id != b.use_extended_id ? b.use_extended_id : a.can_id < b.can_id;
+  });
+  // Receive buffer 0 has two filters sharing mask 0, receive buffer 1 four sharing mask 1. With both id types give
+  // each one a mask, the more common type the one with more filters. Otherwise split the filters ordered by id.
+  const size_t extended = std::count_if(sorted.begin(), sorted.end(), [](const canbus::CanFilter &filter) {
+    return filter.use_extended_id;
+  });
+  size_t split;
+  if (extended != 0 && extended != sorted.size()) {
+    split = sorted.size() - extended;
+    if (extended < split) {
+      std::rotate(sorted.begin(), sorted.begin() + split, sorted.end());
+      split = extended;
+    }
+  } else {
+    split = std::max<size_t>(1, sorted.size() / 3);
+  }
+  // A single filter goes into both groups
+  if (split == sorted.size())
+    split = 0;
+
+  static const RXF RXF_MASK0[] = {RXF0, RXF1};
+  static const RXF RXF_MASK1[] = {RXF2, RXF3, RXF4, RXF5};
+  const size_t count0 = split != 0 ? split : sorted.size();
+  canbus::Error err = this->set_filter_group_(MASK0, RXF_MASK0, 2, sorted.data(), count0);
+  if (err != canbus::ERROR_OK)
+    return err;
+  return this->set_filter_group_(MASK1, RXF_MASK1, 4, sorted.data() + split, sorted.size() - split);
+}
+
+canbus::Error MCP2515::set_filter_group_(MASK mask, const RXF *rxf, size_t rxf_count, const canbus::CanFilter *filters,
+                                         size_t count) {
+  // All filters of a group share the mask, so start with the bits all filters care about and drop the lowest ones
+  // until the distinct ids fit into the filters. Frames matching the wider filters are dropped by the triggers.
+  uint32_t common_mask = filters[0].use_extended_id ? 0x1FFFFFFF : 0x7FF;
+  for (size_t i = 0; i < count; i++)
+    common_mask &= filters[i].can_id_mask;
+  std::vector<uint32_t> ids;
+  while (true) {
+    ids.clear();
+    for (size_t i = 0; i < count; i++)
+      ids.push_back(filters[i].can_id & common_mask);
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    if (ids.size() <= rxf_count)
+      break;
+    common_mask &= common_mask - 1;
+  }
+
+  const bool extended = filters[0].use_extended_id;
+  ESP_LOGV(TAG, "mask %d=0x%08" PRIx32 " with %u filters", mask, common_mask, (unsigned) ids.size());
+  canbus::Error err = this->set_filter_mask_(mask, extended, common_mask);
+  // Unused filters repeat the last id
+  for (size_t i = 0; i < rxf_count && err == canbus::ERROR_OK; i++)
+    err = this->set_filter_(rxf[i], extended, ids[std::min(i, ids.size() - 1)]);
+  return err;
+}
+
 canbus::Error MCP2515::send_message_(TXBn txbn, struct canbus::CanFrame *frame) {
   const struct TxBnRegs *txbuf = &TXB[txbn];
 
@@ -91,6 +91,9 @@ class MCP2515 : public canbus::Canbus,
   canbus::Error set_bitrate_(canbus::CanSpeed can_speed, CanClock can_clock);
   canbus::Error set_filter_mask_(MASK mask, bool extended, uint32_t ul_data);
   canbus::Error set_filter_(RXF num, bool extended, uint32_t ul_data);
+  canbus::Error set_filters_(const std::vector<canbus::CanFilter> &filters);
+  canbus::Error set_filter_group_(MASK mask, const RXF *rxf, size_t rxf_count, const canbus::CanFilter *filters,
+                                  size_t count);
   canbus::Error send_message_(TXBn txbn, struct canbus::CanFrame *frame);
   canbus::Error send_message(struct canbus::CanFrame *frame) override;
   canbus::Error read_message_(RXBn rxbn, struct canbus::CanFrame *frame);
@@ -158,8 +158,8 @@ void MideaIR::transmit_state() {
 }
 
 bool MideaIR::on_receive(remote_base::RemoteReceiveData data) {
-  auto midea = remote_base::MideaProtocol().decode(data);
-  if (midea.has_value())
+  const auto *midea = remote_base::decode_once<remote_base::MideaProtocol>(data);
+  if (midea != nullptr)
     return this->on_midea_(*midea);
   return coolix::CoolixClimate::on_coolix(this, data);
 }
@@ -20,6 +20,8 @@ modbus_ns = cg.esphome_ns.namespace("modbus")
 Modbus = modbus_ns.class_("Modbus", cg.Component, uart.UARTDevice)
 ModbusDevice = modbus_ns.class_("ModbusDevice")
 MULTI_CONF = True
+# Loaded without an RTU bus by modbus_tcp
+MULTI_CONF_NO_DEFAULT = True
 
 CONF_ROLE = "role"
 CONF_MODBUS_ID = "modbus_id"
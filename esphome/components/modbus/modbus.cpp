@@ -2,129 +2,223 @@
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 
+#include <cinttypes>
+
 namespace esphome {
 namespace modbus {
 
 static const char *const TAG = "modbus";
 
+static const size_t MAX_FRAME_SIZE = 256;
+// Silence on the bus after which a partially received frame is dropped
+static const uint32_t FRAME_TIMEOUT = 50;
+
 void Modbus::setup() {
   if (this->flow_control_pin_ != nullptr) {
     this->flow_control_pin_->setup();
   }
+
+  // Modbus RTU frames have no header, their size depends on the function code
+  uart::FrameFormat format;
+  format.frame_length = [this](const uint8_t *data, size_t len) { return this->frame_length_(data, len); };
+  this->framer_.add_format(std::move(format),
+                           [this](const uint8_t *data, size_t len) { this->handle_frame_(data, len); });
+  this->framer_.set_timeout(FRAME_TIMEOUT);
+
+  // 3.5 characters of 11 bits, fixed at 1750 us above 19200 baud
+  uint32_t baud_rate = this->parent_->get_baud_rate();
+  this->frame_gap_ = baud_rate > 19200 ? 1750 : 38500000 / baud_rate;
+#if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERBOSE
+  this->set_interval("latency", 60000, [this]() { this->framer_.get_latency().log(TAG); });
+#endif
 }
 void Modbus::loop() {
   const uint32_t now = millis();
 
-  if (now - this->last_modbus_byte_ > 50) {
-    this->rx_buffer_.clear();
-    this->last_modbus_byte_ = now;
-  }
   // stop blocking new send commands after send_wait_time_ ms regardless if a response has been received since then
   if (now - this->last_send_ > send_wait_time_) {
     waiting_for_response = 0;
   }
 
-  while (this->available()) {
-    uint8_t byte;
-    this->read_byte(&byte);
-    if (this->parse_modbus_byte_(byte)) {
-      this->last_modbus_byte_ = now;
+  this->framer_.process(this);
+  this->schedule_();
+}
+
+uint32_t Modbus::get_byte_time() const {
+  // Start, 8 data, parity or second stop and stop bit
+  return 11000000 / this->parent_->get_baud_rate();
+}
+
+void Modbus::schedule_() {
+  if (this->waiting_for_response != 0)
+    return;
+
+  const uint32_t now = millis();
+  ModbusDevice *next = nullptr;
+  uint32_t next_waiting = 0;
+  int32_t next_late = 0;
+  for (auto *device : this->devices_) {
+    if (!device->has_pending_request())
+      continue;
+    uint32_t waiting = now - device->get_pending_since();
+    // How far the request is past its deadline, negative if it is not
+    int32_t late = device->deadline_ == 0 ? INT32_MIN : static_cast<int32_t>(waiting - device->deadline_);
+    bool before;
+    if (next == nullptr) {
+      before = true;
+    } else if ((late >= 0) != (next_late >= 0)) {
+      before = late >= 0;
+    } else if (late >= 0) {
+      before = late > next_late;
+    } else if (device->priority_ != next->priority_) {
+      before = device->priority_ > next->priority_;
     } else {
-      this->rx_buffer_.clear();
+      before = waiting > next_waiting;
+    }
+    if (before) {
+      next = device;
+      next_waiting = waiting;
+      next_late = late;
     }
   }
+
+  if (next == nullptr) {
+    if (this->cycle_active_) {
+      this->cycle_active_ = false;
+      this->cycle_time_ = now - this->cycle_start_;
+      ESP_LOGD(TAG, "Poll cycle took %" PRIu32 " ms for %u requests", this->cycle_time_, this->cycle_requests_);
+    }
+    return;
+  }
+
+  uint32_t silence = micros() - this->last_frame_end_;
+  if (silence < this->frame_gap_) {
+    // Not waited out in loop(), the timeout wakes the loop once the bus has been quiet for long enough
+    this->set_timeout("frame_gap", (this->frame_gap_ - silence + 999) / 1000, [this]() { this->schedule_(); });
+    return;
+  }
+
+  if (!this->cycle_active_) {
+    this->cycle_active_ = true;
+    this->cycle_start_ = now;
+    this->cycle_requests_ = 0;
+  }
+  if (next->send_next_request())
+    this->cycle_requests_++;
 }
 
-bool Modbus::parse_modbus_byte_(uint8_t byte) {
-  size_t at = this->rx_buffer_.size();
-  this->rx_buffer_.push_back(byte);
-  const uint8_t *raw = &this->rx_buffer_[0];
-  ESP_LOGV(TAG, "Modbus received Byte  %d (0X%x)", byte, byte);
-  // Byte 0: modbus address (match all)
-  if (at == 0)
-    return true;
-  uint8_t address = raw[0];
-  uint8_t function_code = raw[1];
+static bool is_user_defined_function(uint8_t function_code) {
+  // Per https://modbus.org/docs/Modbus_Application_Protocol_V1_1b3.pdf Ch 5 User-Defined function codes
+  return ((function_code >= 65) && (function_code <= 72)) || ((function_code >= 100) && (function_code <= 110));
+}
+
+uint8_t Modbus::data_offset_(uint8_t function_code) const {
+  // data starts at 2 and length is 4 for read registers commands
+  if (this->role == ModbusRole::SERVER && (function_code == 0x3 || function_code == 0x4))
+    return 2;
+  // the response for write command mirrors the requests and data starts at offset 2 instead of 3 for read commands
+  if (function_code == 0x5 || function_code == 0x06 || function_code == 0xF || function_code == 0x10)
+    return 2;
+  // Error ( msb indicates error )
+  // response format:  Byte[0] = device address, Byte[1] function code | 0x80 , Byte[2] exception code, Byte[3-4] crc
+  if ((function_code & 0x80) == 0x80)
+    return 2;
   // Byte 2: Size (with modbus rtu function code 4/3)
   // See also https://en.wikipedia.org/wiki/Modbus
-  if (at == 2)
-    return true;
+  return 3;
+}
 
-  uint8_t data_len = raw[2];
-  uint8_t data_offset = 3;
+int Modbus::frame_length_(const uint8_t *raw, size_t len) const {
+  // Byte 0: modbus address (match all), Byte 1: function code
+  if (len < 3)
+    return 0;
+  uint8_t function_code = raw[1];
 
-  // Per https://modbus.org/docs/Modbus_Application_Protocol_V1_1b3.pdf Ch 5 User-Defined function codes
-  if (((function_code >= 65) && (function_code <= 72)) || ((function_code >= 100) && (function_code <= 110))) {
+  if (is_user_defined_function(function_code)) {
     // Handle user-defined function, since we don't know how big this ought to be,
     // ideally we should delegate the entire length detection to whatever handler is
     // installed, but wait, there is the CRC, and if we get a hit there is a good
     // chance that this is a complete message ... admittedly there is a small chance is
     // isn't but that is quite small given the purpose of the CRC in the first place
-
-    // Fewer than 2 bytes can't calc CRC
-    if (at < 2)
-      return true;
-
-    data_len = at - 2;
-    data_offset = 1;
-
-    uint16_t computed_crc = crc16(raw, data_offset + data_len);
-    uint16_t remote_crc = uint16_t(raw[data_offset + data_len]) | (uint16_t(raw[data_offset + data_len + 1]) << 8);
-
-    if (computed_crc != remote_crc)
-      return true;
-
-    ESP_LOGD(TAG, "Modbus user-defined function %02X found", function_code);
-
-  } else {
-    // data starts at 2 and length is 4 for read registers commands
-    if (this->role == ModbusRole::SERVER && (function_code == 0x3 || function_code == 0x4)) {
-      data_offset = 2;
-      data_len = 4;
-    }
-
-    // the response for write command mirrors the requests and data starts at offset 2 instead of 3 for read commands
-    if (function_code == 0x5 || function_code == 0x06 || function_code == 0xF || function_code == 0x10) {
-      data_offset = 2;
-      data_len = 4;
-    }
-
-    // Error ( msb indicates error )
-    // response format:  Byte[0] = device address, Byte[1] function code | 0x80 , Byte[2] exception code, Byte[3-4] crc
-    if ((function_code & 0x80) == 0x80) {
-      data_offset = 2;
-      data_len = 1;
+    for (size_t size = 4; size <= len; size++) {
+      uint16_t computed_crc = crc16(raw, size - 2);
+      uint16_t remote_crc = uint16_t(raw[size - 2]) | (uint16_t(raw[size - 1]) << 8);
+      if (computed_crc == remote_crc)
+        return size;
     }
+    return len >= MAX_FRAME_SIZE ? -1 : 0;
+  }
 
-    // Byte data_offset..data_offset+data_len-1: Data
-    if (at < data_offset + data_len)
-      return true;
+  // Followed by CRC_LO and CRC_HI (over all bytes)
+  size_t frame_len = this->required_length_(raw) + 2;
+  return len < frame_len ? 0 : frame_len;
+}
 
-    // Byte 3+data_len: CRC_LO (over all bytes)
-    if (at == data_offset + data_len)
-      return true;
+size_t Modbus::required_length_(const uint8_t *frame) const {
+  uint8_t function_code = frame[1];
+  uint8_t data_offset = this->data_offset_(function_code);
+  uint8_t data_len = data_offset == 3 ? frame[2] : ((function_code & 0x80) == 0x80 ? 1 : 4);
+  return data_offset + data_len;
+}
 
-    // Byte data_offset+len+1: CRC_HI (over all bytes)
-    uint16_t computed_crc = crc16(raw, data_offset + data_len);
-    uint16_t remote_crc = uint16_t(raw[data_offset + data_len]) | (uint16_t(raw[data_offset + data_len + 1]) << 8);
+void Modbus::handle_frame_(const uint8_t *raw, size_t len) {
+  // The size of user-defined function frames was found by matching the CRC
+  if (!is_user_defined_function(raw[1])) {
+    uint16_t computed_crc = crc16(raw, len - 2);
+    uint16_t remote_crc = uint16_t(raw[len - 2]) | (uint16_t(raw[len - 1]) << 8);
     if (computed_crc != remote_crc) {
       if (this->disable_crc_) {
         ESP_LOGD(TAG, "Modbus CRC Check failed, but ignored! %02X!=%02X", computed_crc, remote_crc);
       } else {
         ESP_LOGW(TAG, "Modbus CRC Check failed! %02X!=%02X", computed_crc, remote_crc);
-        return false;
+        return;
       }
     }
   }
-  std::vector<uint8_t> data(this->rx_buffer_.begin() + data_offset, this->rx_buffer_.begin() + data_offset + data_len);
+  ESP_LOGV(TAG, "Modbus received %s", format_hex_pretty(raw, len).c_str());
+  this->dispatch_frame_(raw, len - 2);
+}
+
+void Modbus::dispatch_frame_(const uint8_t *frame, size_t len) {
+  uint8_t address = frame[0];
+  uint8_t function_code = frame[1];
+  uint8_t data_offset;
+
+  if (is_user_defined_function(function_code)) {
+    data_offset = 1;
+    ESP_LOGD(TAG, "Modbus user-defined function %02X found", function_code);
+  } else {
+    // Frames from a transport without function code specific framing may be shorter than their content needs
+    if (len < 3 || len < this->required_length_(frame)) {
+      ESP_LOGW(TAG, "Modbus frame with function code 0x%X too short: %zu bytes", function_code, len);
+      return;
+    }
+    data_offset = this->data_offset_(function_code);
+  }
+
+  const uint32_t now = micros();
+  // Time the device took to answer, without the transfer of the response itself
+  uint32_t response_time = 0;
+  if (this->role == ModbusRole::CLIENT && this->waiting_for_response == address) {
+    uint32_t elapsed = now - this->last_frame_end_;
+    uint32_t transfer = (len + 2) * this->get_byte_time();
+    response_time = elapsed > transfer ? elapsed - transfer : 1;
+  }
+  this->last_frame_end_ = now;
+
+  std::vector<uint8_t> data(frame + data_offset, frame + len);
   bool found = false;
   for (auto *device : this->devices_) {
     if (device->address_ == address) {
+      if (response_time != 0) {
+        device->response_time_ =
+            device->response_time_ == 0 ? response_time : (device->response_time_ * 7 + response_time) / 8;
+      }
       // Is it an error response?
       if ((function_code & 0x80) == 0x80) {
-        ESP_LOGD(TAG, "Modbus error function code: 0x%X exception: %d", function_code, raw[2]);
+        ESP_LOGD(TAG, "Modbus error function code: 0x%X exception: %d", function_code, frame[2]);
         if (waiting_for_response != 0) {
-          device->on_modbus_error(function_code & 0x7F, raw[2]);
+          device->on_modbus_error(function_code & 0x7F, frame[2]);
         } else {
           // Ignore modbus exception not related to a pending command
           ESP_LOGD(TAG, "Ignoring Modbus error - not expecting a response");
@@ -143,9 +237,6 @@ bool Modbus::parse_modbus_byte_(uint8_t byte) {
   if (!found) {
     ESP_LOGW(TAG, "Got Modbus frame from unknown address 0x%02X! ", address);
   }
-
-  // return false to reset buffer
-  return false;
 }
 
 void Modbus::dump_config() {
@@ -153,6 +244,7 @@ void Modbus::dump_config() {
   LOG_PIN("  Flow Control Pin: ", this->flow_control_pin_);
   ESP_LOGCONFIG(TAG, "  Send Wait Time: %d ms", this->send_wait_time_);
   ESP_LOGCONFIG(TAG, "  CRC Disabled: %s", YESNO(this->disable_crc_));
+  ESP_LOGCONFIG(TAG, "  Frame Gap: %" PRIu32 " us", this->frame_gap_);
 }
 float Modbus::get_setup_priority() const {
   // After UART bus
@@ -193,21 +285,7 @@ void Modbus::send(uint8_t address, uint8_t function_code, uint16_t start_address
     }
   }
 
-  auto crc = crc16(data.data(), data.size());
-  data.push_back(crc >> 0);
-  data.push_back(crc >> 8);
-
-  if (this->flow_control_pin_ != nullptr)
-    this->flow_control_pin_->digital_write(true);
-
-  this->write_array(data);
-  this->flush();
-
-  if (this->flow_control_pin_ != nullptr)
-    this->flow_control_pin_->digital_write(false);
-  waiting_for_response = address;
-  last_send_ = millis();
-  ESP_LOGV(TAG, "Modbus write: %s", format_hex_pretty(data).c_str());
+  this->send_frame_(data.data(), data.size());
 }
 
 // Helper function for lambdas
@@ -216,20 +294,28 @@ void Modbus::send_raw(const std::vector<uint8_t> &payload) {
   if (payload.empty()) {
     return;
   }
+  this->send_frame_(payload.data(), payload.size());
+}
+
+void Modbus::send_frame_(const uint8_t *frame, size_t len) {
+  this->transmit_(frame, len);
+  this->waiting_for_response = frame[0];
+  this->last_send_ = millis();
+  this->last_frame_end_ = micros();
+}
 
+void Modbus::transmit_(const uint8_t *frame, size_t len) {
   if (this->flow_control_pin_ != nullptr)
     this->flow_control_pin_->digital_write(true);
 
-  auto crc = crc16(payload.data(), payload.size());
-  this->write_array(payload);
+  auto crc = crc16(frame, len);
+  this->write_array(frame, len);
   this->write_byte(crc & 0xFF);
   this->write_byte((crc >> 8) & 0xFF);
   this->flush();
   if (this->flow_control_pin_ != nullptr)
     this->flow_control_pin_->digital_write(false);
-  waiting_for_response = payload[0];
-  ESP_LOGV(TAG, "Modbus write raw: %s", format_hex_pretty(payload).c_str());
-  last_send_ = millis();
+  ESP_LOGV(TAG, "Modbus write: %s", format_hex_pretty(frame, len).c_str());
 }
 
 }  // namespace modbus
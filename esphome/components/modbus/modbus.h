@@ -2,6 +2,7 @@
 
 #include "esphome/core/component.h"
 #include "esphome/components/uart/uart.h"
+#include "esphome/components/uart/uart_framer.h"
 
 #include <vector>
 
@@ -32,6 +33,10 @@ class Modbus : public uart::UARTDevice, public Component {
   void send(uint8_t address, uint8_t function_code, uint16_t start_address, uint16_t number_of_entities,
             uint8_t payload_len = 0, const uint8_t *payload = nullptr);
   void send_raw(const std::vector<uint8_t> &payload);
+  /// Time in us it takes to transmit one byte, used to weigh request overhead against payload.
+  virtual uint32_t get_byte_time() const;
+  /// Duration in ms of the last poll cycle, from the first scheduled request until all queues were empty.
+  uint32_t get_cycle_time() const { return this->cycle_time_; }
   void set_role(ModbusRole role) { this->role = role; }
   void set_flow_control_pin(GPIOPin *flow_control_pin) { this->flow_control_pin_ = flow_control_pin; }
   uint8_t waiting_for_response{0};
@@ -43,12 +48,38 @@ class Modbus : public uart::UARTDevice, public Component {
  protected:
   GPIOPin *flow_control_pin_{nullptr};
 
-  bool parse_modbus_byte_(uint8_t byte);
+  /** Hand the bus to the scheduled device that is due next.
+   *
+   * Called whenever the bus becomes idle, so requests of all devices go out back to back separated only by the
+   * inter-frame gap. Devices past their deadline come first, then higher priority, then the longest waiting.
+   */
+  void schedule_();
+  /// Transmit `frame`, which starts with the address and has no checksum, and start waiting for the response.
+  void send_frame_(const uint8_t *frame, size_t len);
+  /// Write a frame to the transport, see send_frame_().
+  virtual void transmit_(const uint8_t *frame, size_t len);
+  /// Hand a received frame without checksum to the devices, frames too short for their function code are dropped.
+  void dispatch_frame_(const uint8_t *frame, size_t len);
+  /// Offset of the data in a frame with this function code.
+  uint8_t data_offset_(uint8_t function_code) const;
+  /// Size without checksum the frame needs for its function code, `frame` must have at least 3 bytes.
+  size_t required_length_(const uint8_t *frame) const;
+  /// Size of the frame at the start of `raw`, see uart::FrameFormat::frame_length.
+  int frame_length_(const uint8_t *raw, size_t len) const;
+  void handle_frame_(const uint8_t *raw, size_t len);
   uint16_t send_wait_time_{250};
   bool disable_crc_;
-  std::vector<uint8_t> rx_buffer_;
-  uint32_t last_modbus_byte_{0};
+  // Largest RTU frame is 256 bytes, plus room for a partial one
+  uart::UARTFramer framer_{512};
   uint32_t last_send_{0};
+  /// micros() at the end of the last frame sent or received.
+  uint32_t last_frame_end_{0};
+  /// Silence required between two frames in us (3.5 characters).
+  uint32_t frame_gap_{0};
+  uint32_t cycle_start_{0};
+  uint32_t cycle_time_{0};
+  uint16_t cycle_requests_{0};
+  bool cycle_active_{false};
   std::vector<ModbusDevice *> devices_;
 };
 
@@ -67,11 +98,28 @@ class ModbusDevice {
   // If more than one device is connected block sending a new command before a response is received
   bool waiting_for_response() { return parent_->waiting_for_response != 0; }
 
+  /// Devices with a higher priority get the bus first.
+  void set_priority(int8_t priority) { this->priority_ = priority; }
+  /// Time in ms a request may wait for the bus before it is sent ahead of higher priorities, 0 for no deadline.
+  void set_deadline(uint32_t deadline) { this->deadline_ = deadline; }
+  /// Average time in us the device takes to start responding to a request.
+  uint32_t get_response_time() const { return this->response_time_; }
+
+  /// Whether a request is waiting for the bus scheduler, see Modbus::schedule_().
+  virtual bool has_pending_request() { return false; }
+  /// millis() when the next request was queued.
+  virtual uint32_t get_pending_since() { return 0; }
+  /// Send the next request, returns false if nothing was sent.
+  virtual bool send_next_request() { return false; }
+
  protected:
   friend Modbus;
 
   Modbus *parent_;
   uint8_t address_;
+  int8_t priority_{0};
+  uint32_t deadline_{0};
+  uint32_t response_time_{0};
 };
 
 }  // namespace modbus
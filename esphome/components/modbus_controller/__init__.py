@@ -10,6 +10,7 @@ from esphome.const import (
     CONF_LAMBDA,
     CONF_NAME,
     CONF_OFFSET,
+    CONF_PRIORITY,
     CONF_TRIGGER_ID,
 )
 from esphome.cpp_helpers import logging
@@ -20,8 +21,10 @@ from .const import (
     CONF_BYTE_OFFSET,
     CONF_COMMAND_THROTTLE,
     CONF_CUSTOM_COMMAND,
+    CONF_DEADLINE,
     CONF_FORCE_NEW_RANGE,
     CONF_MAX_CMD_RETRIES,
+    CONF_MAX_REGISTER_GAP,
     CONF_MODBUS_CONTROLLER_ID,
     CONF_OFFLINE_SKIP_UPDATES,
     CONF_ON_COMMAND_SENT,
@@ -136,6 +139,9 @@ CONFIG_SCHEMA = cv.All(
             ): cv.positive_time_period_milliseconds,
             cv.Optional(CONF_MAX_CMD_RETRIES, default=4): cv.positive_int,
             cv.Optional(CONF_OFFLINE_SKIP_UPDATES, default=0): cv.positive_int,
+            cv.Optional(CONF_PRIORITY, default=0): cv.int_range(-128, 127),
+            cv.Optional(CONF_DEADLINE): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_MAX_REGISTER_GAP, default=0): cv.int_range(0, 124),
             cv.Optional(
                 CONF_SERVER_REGISTERS,
             ): cv.ensure_list(ModbusServerRegisterSchema),
@@ -263,6 +269,10 @@ async def to_code(config):
     cg.add(var.set_command_throttle(config[CONF_COMMAND_THROTTLE]))
     cg.add(var.set_max_cmd_retries(config[CONF_MAX_CMD_RETRIES]))
     cg.add(var.set_offline_skip_updates(config[CONF_OFFLINE_SKIP_UPDATES]))
+    cg.add(var.set_priority(config[CONF_PRIORITY]))
+    if CONF_DEADLINE in config:
+        cg.add(var.set_deadline(config[CONF_DEADLINE]))
+    cg.add(var.set_max_register_gap(config[CONF_MAX_REGISTER_GAP]))
     if CONF_SERVER_REGISTERS in config:
         for server_register in config[CONF_SERVER_REGISTERS]:
             cg.add(
@@ -4,8 +4,10 @@ CONF_BYTE_OFFSET = "byte_offset"
 CONF_COMMAND_THROTTLE = "command_throttle"
 CONF_OFFLINE_SKIP_UPDATES = "offline_skip_updates"
 CONF_CUSTOM_COMMAND = "custom_command"
+CONF_DEADLINE = "deadline"
 CONF_FORCE_NEW_RANGE = "force_new_range"
 CONF_MAX_CMD_RETRIES = "max_cmd_retries"
+CONF_MAX_REGISTER_GAP = "max_register_gap"
 CONF_MODBUS_CONTROLLER_ID = "modbus_controller_id"
 CONF_MODBUS_FUNCTIONCODE = "modbus_functioncode"
 CONF_ON_COMMAND_SENT = "on_command_sent"
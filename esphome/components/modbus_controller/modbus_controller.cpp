@@ -2,23 +2,43 @@
 #include "esphome/core/application.h"
 #include "esphome/core/log.h"
 
+#include <cinttypes>
+
 namespace esphome {
 namespace modbus_controller {
 
 static const char *const TAG = "modbus_controller";
 
-void ModbusController::setup() { this->create_register_ranges_(); }
+// Request (8 bytes) and response (5 bytes) framing plus the inter-frame gaps before both (7 characters)
+static const uint32_t REQUEST_OVERHEAD_BYTES = 20;
+// Largest reads, within the limits of Modbus::send() and RegisterRange::register_count
+static const uint16_t MAX_MERGED_REGISTERS = 125;
+static const uint16_t MAX_MERGED_COILS = 128;
+
+static bool is_bit_register(ModbusRegisterType register_type) {
+  return register_type == ModbusRegisterType::COIL || register_type == ModbusRegisterType::DISCRETE_INPUT;
+}
+
+void ModbusController::setup() {
+  this->create_register_ranges_();
+  this->merge_register_ranges_();
+}
 
 /*
  To work with the existing modbus class and avoid polling for responses a command queue is used.
- send_next_command will submit the command at the top of the queue and set the corresponding callback
- to handle the response from the device.
+ The modbus bus schedules all controllers on it: when it is our turn send_next_request will submit the command at
+ the top of the queue and set the corresponding callback to handle the response from the device.
  Once the response has been processed it is removed from the queue and the next command is sent
 */
-bool ModbusController::send_next_command_() {
-  uint32_t last_send = millis() - this->last_command_timestamp_;
+bool ModbusController::has_pending_request() {
+  return !this->command_queue_.empty() && millis() - this->last_command_timestamp_ > this->command_throttle_;
+}
 
-  if ((last_send > this->command_throttle_) && !waiting_for_response() && !this->command_queue_.empty()) {
+uint32_t ModbusController::get_pending_since() { return this->command_queue_.front()->queued_at; }
+
+bool ModbusController::send_next_request() {
+  bool sent = false;
+  if (!this->command_queue_.empty()) {
     auto &command = this->command_queue_.front();
 
     // remove from queue if command was sent too often
@@ -41,6 +61,7 @@ bool ModbusController::send_next_command_() {
       ESP_LOGV(TAG, "Sending next modbus command to device %d register 0x%02X count %d", this->address_,
                command->register_address, command->register_count);
       command->send();
+      sent = true;
 
       this->last_command_timestamp_ = millis();
 
@@ -52,7 +73,7 @@ bool ModbusController::send_next_command_() {
       }
     }
   }
-  return (!this->command_queue_.empty());
+  return sent;
 }
 
 // Queue incoming response
@@ -188,6 +209,7 @@ void ModbusController::queue_command(const ModbusCommandItem &command) {
     }
   }
   this->command_queue_.push_back(make_unique<ModbusCommandItem>(command));
+  this->command_queue_.back()->queued_at = millis();
 }
 
 void ModbusController::update_range_(RegisterRange &r) {
@@ -341,11 +363,78 @@ size_t ModbusController::create_register_ranges_() {
   return register_ranges_.size();
 }
 
+bool ModbusController::can_merge_ranges_(const RegisterRange &range, const RegisterRange &next, uint32_t request_cost,
+                                         uint32_t byte_time) const {
+  if (range.register_type != next.register_type || range.register_type == ModbusRegisterType::CUSTOM ||
+      range.skip_updates != next.skip_updates)
+    return false;
+  uint32_t end = range.start_address + range.register_count;
+  if (next.start_address < end || next.start_address - end > this->max_register_gap_)
+    return false;
+
+  bool coils = is_bit_register(range.register_type);
+  uint32_t merged_count = next.start_address + next.register_count - range.start_address;
+  if (merged_count > (coils ? MAX_MERGED_COILS : MAX_MERGED_REGISTERS))
+    return false;
+
+  // Offsets are derived from register addresses, which only works if every item covers exactly its registers
+  for (const auto *sensors : {&range.sensors, &next.sensors}) {
+    for (auto *sensor : *sensors) {
+      if (sensor == nullptr || (!coils && sensor->get_register_size() != sensor->register_count * 2u))
+        return false;
+      if (sensors == &next.sensors && sensor->force_new_range)
+        return false;
+    }
+  }
+
+  uint32_t gap = next.start_address - end;
+  uint32_t gap_bytes = coils ? (gap + 7) / 8 : gap * 2;
+  return gap_bytes * byte_time < request_cost;
+}
+
+size_t ModbusController::merge_register_ranges_() {
+  this->planned_response_time_ = this->response_time_;
+  if (this->max_register_gap_ == 0 || this->register_ranges_.size() < 2)
+    return this->register_ranges_.size();
+
+  uint32_t byte_time = std::max<uint32_t>(this->parent_->get_byte_time(), 1);
+  uint32_t request_cost = REQUEST_OVERHEAD_BYTES * byte_time + this->response_time_;
+
+  std::vector<RegisterRange> merged;
+  for (auto &r : this->register_ranges_) {
+    if (merged.empty() || !this->can_merge_ranges_(merged.back(), r, request_cost, byte_time)) {
+      merged.push_back(std::move(r));
+      continue;
+    }
+    RegisterRange &range = merged.back();
+    uint16_t distance = r.start_address - range.start_address;
+    uint16_t unit = is_bit_register(r.register_type) ? 1 : 2;
+    for (auto *sensor : r.sensors) {
+      // the start address is part of the sort order
+      this->sensorset_.erase(sensor);
+      sensor->start_address = range.start_address;
+      sensor->offset += distance * unit;
+      this->sensorset_.insert(sensor);
+      range.sensors.insert(sensor);
+    }
+    ESP_LOGV(TAG, "Merge range 0x%X into 0x%X, reading %u unused registers", r.start_address, range.start_address,
+             r.start_address - (range.start_address + range.register_count));
+    range.register_count = r.start_address + r.register_count - range.start_address;
+  }
+  this->register_ranges_ = std::move(merged);
+  return this->register_ranges_.size();
+}
+
 void ModbusController::dump_config() {
   ESP_LOGCONFIG(TAG, "ModbusController:");
   ESP_LOGCONFIG(TAG, "  Address: 0x%02X", this->address_);
   ESP_LOGCONFIG(TAG, "  Max Command Retries: %d", this->max_cmd_retries_);
   ESP_LOGCONFIG(TAG, "  Offline Skip Updates: %d", this->offline_skip_updates_);
+  ESP_LOGCONFIG(TAG, "  Priority: %d", this->priority_);
+  if (this->deadline_ != 0)
+    ESP_LOGCONFIG(TAG, "  Deadline: %" PRIu32 " ms", this->deadline_);
+  if (this->max_register_gap_ != 0)
+    ESP_LOGCONFIG(TAG, "  Max Register Gap: %u", this->max_register_gap_);
 #if ESPHOME_LOG_LEVEL >= ESPHOME_LOG_LEVEL_VERBOSE
   ESP_LOGCONFIG(TAG, "sensormap");
   for (auto &it : sensorset_) {
@@ -374,9 +463,12 @@ void ModbusController::loop() {
       process_modbus_data_(message.get());
     incoming_queue_.pop();
 
-  } else {
-    // all messages processed send pending commands
-    send_next_command_();
+  } else if (this->max_register_gap_ != 0 && this->command_queue_.empty() &&
+             this->response_time_ > this->planned_response_time_ + this->planned_response_time_ / 4) {
+    // the device answers slower than planned for, reading more unused registers may now save requests
+    ESP_LOGD(TAG, "Response time of device %d is %" PRIu32 " us, merging register ranges", this->address_,
+             this->response_time_);
+    this->merge_register_ranges_();
   }
 }
 
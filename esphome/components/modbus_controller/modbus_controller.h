@@ -320,6 +320,8 @@ class ModbusCommandItem {
   std::function<void(ModbusRegisterType register_type, uint16_t start_address, const std::vector<uint8_t> &data)>
       on_data_func;
   std::vector<uint8_t> payload = {};
+  /// millis() when the command was added to the send queue
+  uint32_t queued_at{0};
   bool send();
   /// Check if the command should be retried based on the max_retries parameter
   bool should_retry(uint8_t max_retries) { return this->send_count_ <= max_retries; };
@@ -472,18 +474,30 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   void set_max_cmd_retries(uint8_t max_cmd_retries) { this->max_cmd_retries_ = max_cmd_retries; }
   /// get how many times a command will be (re)sent if no response is received
   uint8_t get_max_cmd_retries() { return this->max_cmd_retries_; }
+  /// called by esphome generated code to set the largest number of unused registers read to save a request
+  void set_max_register_gap(uint16_t max_register_gap) { this->max_register_gap_ = max_register_gap; }
+
+  /// the bus scheduler asks whether a command is ready to be sent
+  bool has_pending_request() override;
+  /// the bus scheduler asks how long the next command has been waiting
+  uint32_t get_pending_since() override;
+  /// the bus scheduler hands over the bus to send the command at the top of the queue
+  bool send_next_request() override;
 
  protected:
   /// parse sensormap_ and create range of sequential addresses
   size_t create_register_ranges_();
+  /// join ranges separated by unused registers where reading those is cheaper than another request
+  size_t merge_register_ranges_();
+  /// whether `next` can be appended to `range` by reading the registers between them
+  bool can_merge_ranges_(const RegisterRange &range, const RegisterRange &next, uint32_t request_cost,
+                         uint32_t byte_time) const;
   // find register in sensormap. Returns iterator with all registers having the same start address
   SensorSet find_sensors_(ModbusRegisterType register_type, uint16_t start_address) const;
   /// submit the read command for the address range to the send queue
   void update_range_(RegisterRange &r);
   /// parse incoming modbus data
   void process_modbus_data_(const ModbusCommandItem *response);
-  /// send the next modbus command from the send queue
-  bool send_next_command_();
   /// dump the parsed sensormap for diagnostics
   void dump_sensors_();
   /// Collection of all sensors for this component
@@ -508,6 +522,10 @@ class ModbusController : public PollingComponent, public modbus::ModbusDevice {
   uint16_t offline_skip_updates_;
   /// How many times we will retry a command if we get no response
   uint8_t max_cmd_retries_{4};
+  /// max number of unused registers between two ranges that are read to save a request, 0 to never read them
+  uint16_t max_register_gap_{0};
+  /// device response time the register ranges were merged for
+  uint32_t planned_response_time_{0};
   CallbackManager<void(int, int)> command_sent_callback_{};
 };
 
@@ -0,0 +1,75 @@
+import esphome.codegen as cg
+from esphome.components import modbus
+import esphome.config_validation as cv
+from esphome.const import (
+    CONF_ID,
+    CONF_PORT,
+    PLATFORM_BK72XX,
+    PLATFORM_ESP32,
+    PLATFORM_HOST,
+    PLATFORM_RTL87XX,
+)
+from esphome.core import CORE
+
+AUTO_LOAD = ["modbus", "socket"]
+DEPENDENCIES = ["network"]
+MULTI_CONF = True
+
+modbus_tcp_ns = cg.esphome_ns.namespace("modbus_tcp")
+ModbusTCP = modbus_tcp_ns.class_("ModbusTCP", modbus.Modbus)
+
+CONF_HOST = "host"
+CONF_MAX_CONNECTIONS = "max_connections"
+
+# Outgoing connections are not implemented by the raw lwIP sockets of ESP8266 and RP2040
+CLIENT_PLATFORMS = [PLATFORM_BK72XX, PLATFORM_ESP32, PLATFORM_HOST, PLATFORM_RTL87XX]
+
+
+def validate_role(config):
+    if config[modbus.CONF_ROLE] == "client":
+        if CONF_HOST not in config:
+            raise cv.Invalid(f"'{CONF_HOST}' is required for the client role")
+        if CORE.target_platform not in CLIENT_PLATFORMS:
+            raise cv.Invalid(
+                f"The client role is only supported on {', '.join(CLIENT_PLATFORMS)}"
+            )
+        if CONF_MAX_CONNECTIONS in config:
+            raise cv.Invalid(
+                f"'{CONF_MAX_CONNECTIONS}' can only be used with the server role"
+            )
+    elif CONF_HOST in config:
+        raise cv.Invalid(f"'{CONF_HOST}' can only be used with the client role")
+    return config
+
+
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(ModbusTCP),
+            cv.Optional(modbus.CONF_ROLE, default="client"): cv.enum(
+                modbus.MODBUS_ROLES
+            ),
+            cv.Optional(CONF_HOST): cv.ipv4,
+            cv.Optional(CONF_PORT, default=502): cv.port,
+            cv.Optional(CONF_MAX_CONNECTIONS): cv.int_range(min=1, max=16),
+            cv.Optional(
+                modbus.CONF_SEND_WAIT_TIME, default="250ms"
+            ): cv.positive_time_period_milliseconds,
+        }
+    ).extend(cv.COMPONENT_SCHEMA),
+    validate_role,
+)
+
+
+async def to_code(config):
+    cg.add_global(modbus.modbus_ns.using)
+    var = cg.new_Pvariable(config[CONF_ID])
+    await cg.register_component(var, config)
+
+    cg.add(var.set_role(config[modbus.CONF_ROLE]))
+    if CONF_HOST in config:
+        cg.add(var.set_host(str(config[CONF_HOST])))
+    cg.add(var.set_port(config[CONF_PORT]))
+    if CONF_MAX_CONNECTIONS in config:
+        cg.add(var.set_max_connections(config[CONF_MAX_CONNECTIONS]))
+    cg.add(var.set_send_wait_time(config[modbus.CONF_SEND_WAIT_TIME]))
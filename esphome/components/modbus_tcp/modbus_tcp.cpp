@@ -0,0 +1,262 @@
+#include "modbus_tcp.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#include <cerrno>
+
+namespace esphome {
+namespace modbus_tcp {
+
+static const char *const TAG = "modbus_tcp";
+
+// Transaction id, protocol id and length, followed by the unit id and the PDU
+static const size_t MBAP_HEADER_SIZE = 6;
+// Unit id, function code and up to 252 bytes of data
+static const uint16_t MAX_FRAME_LENGTH = 254;
+static const uint32_t RECONNECT_INTERVAL = 5000;
+
+void ModbusTCP::setup() {
+  if (this->role == modbus::ModbusRole::CLIENT) {
+    this->connect_();
+    return;
+  }
+
+  this->server_ = socket::socket_ip(SOCK_STREAM, 0);
+  if (this->server_ == nullptr) {
+    ESP_LOGW(TAG, "Could not create socket.");
+    this->mark_failed();
+    return;
+  }
+  int enable = 1;
+  int err = this->server_->setsockopt(SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(int));
+  if (err != 0) {
+    ESP_LOGW(TAG, "Socket unable to set reuseaddr: errno %d", err);
+    // we can still continue
+  }
+  err = this->server_->setblocking(false);
+  if (err != 0) {
+    ESP_LOGW(TAG, "Socket unable to set nonblocking mode: errno %d", err);
+    this->mark_failed();
+    return;
+  }
+
+  struct sockaddr_storage server;
+  socklen_t sl = socket::set_sockaddr_any((struct sockaddr *) &server, sizeof(server), this->port_);
+  if (sl == 0) {
+    ESP_LOGW(TAG, "Socket unable to set sockaddr: errno %d", errno);
+    this->mark_failed();
+    return;
+  }
+  err = this->server_->bind((struct sockaddr *) &server, sl);
+  if (err != 0) {
+    ESP_LOGW(TAG, "Socket unable to bind: errno %d", errno);
+    this->mark_failed();
+    return;
+  }
+  err = this->server_->listen(4);
+  if (err != 0) {
+    ESP_LOGW(TAG, "Socket unable to listen: errno %d", errno);
+    this->mark_failed();
+    return;
+  }
+}
+
+void ModbusTCP::connect_() {
+  this->last_connect_attempt_ = millis();
+  this->connections_.clear();
+  this->connected_ = false;
+
+  auto sock = socket::socket(AF_INET, SOCK_STREAM, 0);
+  if (sock == nullptr) {
+    ESP_LOGW(TAG, "Could not create socket.");
+    return;
+  }
+  sock->setblocking(false);
+  this->server_address_len_ = socket::set_sockaddr((struct sockaddr *) &this->server_address_,
+                                                   sizeof(this->server_address_), this->host_, this->port_);
+  if (this->server_address_len_ == 0) {
+    ESP_LOGW(TAG, "Socket unable to set sockaddr: errno %d", errno);
+    return;
+  }
+  int err = sock->connect((struct sockaddr *) &this->server_address_, this->server_address_len_);
+  if (err != 0 && errno != EINPROGRESS) {
+    ESP_LOGW(TAG, "Connecting to %s:%u failed: errno %d", this->host_.c_str(), this->port_, errno);
+    return;
+  }
+  this->connections_.push_back({std::move(sock), {}});
+}
+
+void ModbusTCP::loop() {
+  const uint32_t now = millis();
+
+  // stop blocking new send commands after send_wait_time_ ms regardless if a response has been received since then
+  if (now - this->last_send_ > this->send_wait_time_) {
+    this->waiting_for_response = 0;
+  }
+
+  if (this->role == modbus::ModbusRole::SERVER) {
+    if (this->server_ == nullptr)
+      return;
+    while (true) {
+      struct sockaddr_storage source_addr;
+      socklen_t addr_len = sizeof(source_addr);
+      auto sock = this->server_->accept((struct sockaddr *) &source_addr, &addr_len);
+      if (!sock)
+        break;
+      if (this->connections_.size() >= this->max_connections_) {
+        // Closed again right away, so the client doesn't wait on a connection that is never served
+        ESP_LOGW(TAG, "Refused %s, %u connections are open", sock->getpeername().c_str(), this->max_connections_);
+        continue;
+      }
+      sock->setblocking(false);
+      ESP_LOGD(TAG, "Accepted %s", sock->getpeername().c_str());
+      this->connections_.push_back({std::move(sock), {}});
+    }
+  } else if (this->connections_.empty()) {
+    if (now - this->last_connect_attempt_ > RECONNECT_INTERVAL)
+      this->connect_();
+    return;
+  } else if (!this->connected_) {
+    // Wait for the non-blocking connect to finish, a failure is reported through SO_ERROR
+    auto &sock = this->connections_.front().socket;
+    int error = 0;
+    socklen_t len = sizeof(error);
+    if (sock->getsockopt(SOL_SOCKET, SO_ERROR, &error, &len) != 0 || error != 0) {
+      ESP_LOGW(TAG, "Connecting to %s:%u failed: errno %d", this->host_.c_str(), this->port_, error);
+      this->connections_.clear();
+      return;
+    }
+    // Connecting again tells whether it finished: EISCONN once it has, EALREADY while it is still in progress
+    if (sock->connect((struct sockaddr *) &this->server_address_, this->server_address_len_) != 0 && errno != EISCONN) {
+      if (errno != EALREADY && errno != EINPROGRESS) {
+        ESP_LOGW(TAG, "Connecting to %s:%u failed: errno %d", this->host_.c_str(), this->port_, errno);
+        this->connections_.clear();
+      } else if (now - this->last_connect_attempt_ > RECONNECT_INTERVAL) {
+        ESP_LOGW(TAG, "Connecting to %s:%u timed out", this->host_.c_str(), this->port_);
+        this->connections_.clear();
+      }
+      return;
+    }
+    ESP_LOGI(TAG, "Connected to %s:%u", this->host_.c_str(), this->port_);
+    this->connected_ = true;
+  }
+
+  for (auto it = this->connections_.begin(); it != this->connections_.end();) {
+    if (this->read_(*it)) {
+      ++it;
+    } else {
+      it = this->connections_.erase(it);
+    }
+  }
+
+  if (this->role == modbus::ModbusRole::CLIENT) {
+    if (this->connections_.empty()) {
+      this->connected_ = false;
+      this->waiting_for_response = 0;
+      return;
+    }
+    this->schedule_();
+  }
+}
+
+bool ModbusTCP::read_(Connection &connection) {
+  if (connection.closed)
+    return false;
+  uint8_t chunk[256];
+  while (true) {
+    ssize_t received = connection.socket->read(chunk, sizeof(chunk));
+    if (received == 0) {
+      ESP_LOGD(TAG, "Connection closed by %s", connection.socket->getpeername().c_str());
+      return false;
+    }
+    if (received < 0) {
+      if (errno == EWOULDBLOCK || errno == EAGAIN)
+        break;
+      ESP_LOGW(TAG, "Socket read failed: errno %d", errno);
+      return false;
+    }
+    connection.buffer.insert(connection.buffer.end(), chunk, chunk + received);
+  }
+
+  auto &buffer = connection.buffer;
+  size_t at = 0;
+  while (buffer.size() - at >= MBAP_HEADER_SIZE) {
+    const uint8_t *adu = buffer.data() + at;
+    uint16_t protocol = encode_uint16(adu[2], adu[3]);
+    uint16_t length = encode_uint16(adu[4], adu[5]);
+    if (protocol != 0 || length < 2 || length > MAX_FRAME_LENGTH) {
+      ESP_LOGW(TAG, "Invalid MBAP header, closing connection");
+      return false;
+    }
+    if (buffer.size() - at < MBAP_HEADER_SIZE + length)
+      break;
+
+    uint16_t transaction = encode_uint16(adu[0], adu[1]);
+    ESP_LOGV(TAG, "Modbus received %s", format_hex_pretty(adu, MBAP_HEADER_SIZE + length).c_str());
+    if (this->role == modbus::ModbusRole::CLIENT && transaction != this->transaction_id_) {
+      ESP_LOGW(TAG, "Ignoring response to transaction %u", transaction);
+    } else {
+      this->transaction_id_ = transaction;
+      this->current_ = &connection;
+      this->dispatch_frame_(adu + MBAP_HEADER_SIZE, length);
+      this->current_ = nullptr;
+      if (connection.closed)
+        return false;
+    }
+    at += MBAP_HEADER_SIZE + length;
+  }
+  buffer.erase(buffer.begin(), buffer.begin() + at);
+  return true;
+}
+
+void ModbusTCP::transmit_(const uint8_t *frame, size_t len) {
+  Connection *connection = nullptr;
+  if (this->role == modbus::ModbusRole::SERVER) {
+    connection = this->current_;
+  } else if (this->connected_) {
+    connection = &this->connections_.front();
+    this->transaction_id_++;
+  }
+  if (connection == nullptr || connection->closed) {
+    ESP_LOGW(TAG, "Not connected, dropping frame");
+    return;
+  }
+
+  uint8_t header[MBAP_HEADER_SIZE] = {
+      uint8_t(this->transaction_id_ >> 8), uint8_t(this->transaction_id_), 0, 0, uint8_t(len >> 8), uint8_t(len),
+  };
+  struct iovec iov[2];
+  iov[0].iov_base = header;
+  iov[0].iov_len = sizeof(header);
+  iov[1].iov_base = const_cast<uint8_t *>(frame);
+  iov[1].iov_len = len;
+  ssize_t sent = connection->socket->writev(iov, 2);
+  if (sent != static_cast<ssize_t>(sizeof(header) + len)) {
+    // The peer would read the rest of a partly sent frame as the start of the next one
+    if (sent < 0) {
+      ESP_LOGW(TAG, "Socket write failed: errno %d, closing connection", errno);
+    } else {
+      ESP_LOGW(TAG, "Socket write sent %zd of %zu bytes, closing connection", sent, sizeof(header) + len);
+    }
+    connection->closed = true;
+    return;
+  }
+  ESP_LOGV(TAG, "Modbus write: %s %s", format_hex_pretty(header, sizeof(header)).c_str(),
+           format_hex_pretty(frame, len).c_str());
+}
+
+void ModbusTCP::dump_config() {
+  ESP_LOGCONFIG(TAG, "Modbus TCP:");
+  if (this->role == modbus::ModbusRole::SERVER) {
+    ESP_LOGCONFIG(TAG, "  Role: server");
+    ESP_LOGCONFIG(TAG, "  Port: %u", this->port_);
+    ESP_LOGCONFIG(TAG, "  Max Connections: %u", this->max_connections_);
+  } else {
+    ESP_LOGCONFIG(TAG, "  Role: client");
+    ESP_LOGCONFIG(TAG, "  Server: %s:%u", this->host_.c_str(), this->port_);
+  }
+  ESP_LOGCONFIG(TAG, "  Send Wait Time: %d ms", this->send_wait_time_);
+}
+
+}  // namespace modbus_tcp
+}  // namespace esphome
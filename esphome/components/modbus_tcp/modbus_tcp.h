@@ -0,0 +1,65 @@
+#pragma once
+
+#include "esphome/components/modbus/modbus.h"
+#include "esphome/components/socket/socket.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace modbus_tcp {
+
+/** Modbus TCP transport for the devices of a modbus hub.
+ *
+ * As a client it connects to `host` and polls the devices behind it, using the unit identifier as their address. As
+ * a server it accepts connections and answers requests for its server devices. Frames carry the MBAP header instead
+ * of the RTU checksum, everything else is shared with the RTU bus including the request scheduler.
+ */
+class ModbusTCP : public modbus::Modbus {
+ public:
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::AFTER_WIFI; }
+
+  /// Bytes take no noticeable time compared to the round trip, which is part of the response time.
+  uint32_t get_byte_time() const override { return 1; }
+
+  void set_host(const std::string &host) { this->host_ = host; }
+  void set_port(uint16_t port) { this->port_ = port; }
+  /// Connections the server keeps open at once, further clients are disconnected right after they were accepted.
+  void set_max_connections(uint8_t max_connections) { this->max_connections_ = max_connections; }
+
+ protected:
+  struct Connection {
+    std::unique_ptr<socket::Socket> socket;
+    std::vector<uint8_t> buffer;
+    /// Set when a frame could only be written partly, the stream is out of sync and the connection is dropped.
+    bool closed{false};
+  };
+
+  void transmit_(const uint8_t *frame, size_t len) override;
+  void connect_();
+  /// Read from `connection` and dispatch its complete frames, returns false once the connection is gone.
+  bool read_(Connection &connection);
+
+  std::string host_;
+  uint16_t port_{502};
+  uint8_t max_connections_{4};
+  /// Address of the server the client connects to.
+  struct sockaddr_storage server_address_;
+  socklen_t server_address_len_{0};
+  std::unique_ptr<socket::Socket> server_;
+  /// Connections of clients to the server, or the single connection of the client.
+  std::vector<Connection> connections_;
+  /// Connection the frame being dispatched came from, responses go back to it.
+  Connection *current_{nullptr};
+  /// Last transaction sent as client, or of the request being answered as server.
+  uint16_t transaction_id_{0};
+  uint32_t last_connect_attempt_{0};
+  bool connected_{false};
+};
+
+}  // namespace modbus_tcp
+}  // namespace esphome
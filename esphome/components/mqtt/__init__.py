@@ -65,6 +65,9 @@ def AUTO_LOAD():
 CONF_DISCOVER_IP = "discover_ip"
 CONF_IDF_SEND_ASYNC = "idf_send_async"
 CONF_SKIP_CERT_CN_CHECK = "skip_cert_cn_check"
+CONF_PUBLISH_QUEUE_SIZE = "publish_queue_size"
+CONF_DISCOVERY_RATE_LIMIT = "discovery_rate_limit"
+CONF_DISCOVERY_SKIP_UNCHANGED = "discovery_skip_unchanged"
 
 
 def validate_message_just_topic(value):
@@ -231,6 +234,11 @@ CONFIG_SCHEMA = cv.All(
                 cv.boolean, cv.one_of("CLEAN", upper=True)
             ),
             cv.Optional(CONF_DISCOVERY_RETAIN, default=True): cv.boolean,
+            cv.Optional(CONF_DISCOVERY_SKIP_UNCHANGED, default=False): cv.boolean,
+            # Payload bytes per second, 0 sends the discovery messages as fast as possible
+            cv.Optional(CONF_DISCOVERY_RATE_LIMIT, default=0): cv.All(
+                cv.validate_bytes, cv.int_range(min=0)
+            ),
             cv.Optional(CONF_DISCOVER_IP, default=True): cv.boolean,
             cv.Optional(
                 CONF_DISCOVERY_PREFIX, default="homeassistant"
@@ -262,6 +270,9 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(
                 CONF_REBOOT_TIMEOUT, default="15min"
             ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_PUBLISH_QUEUE_SIZE, default=16): cv.int_range(
+                min=0, max=1024
+            ),
             cv.Optional(CONF_ON_CONNECT): automation.validate_automation(
                 {
                     cv.GenerateID(CONF_TRIGGER_ID): cv.declare_id(MQTTConnectTrigger),
@@ -406,6 +417,9 @@ async def to_code(config):
     cg.add(var.set_keep_alive(config[CONF_KEEPALIVE]))
 
     cg.add(var.set_reboot_timeout(config[CONF_REBOOT_TIMEOUT]))
+    cg.add(var.set_publish_queue_size(config[CONF_PUBLISH_QUEUE_SIZE]))
+    cg.add(var.set_discovery_rate_limit(config[CONF_DISCOVERY_RATE_LIMIT]))
+    cg.add(var.set_discovery_skip_unchanged(config[CONF_DISCOVERY_SKIP_UNCHANGED]))
 
     # esp-idf only
     if CONF_CERTIFICATE_AUTHORITY in config:
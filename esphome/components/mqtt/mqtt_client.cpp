@@ -2,6 +2,7 @@
 
 #ifdef USE_MQTT
 
+#include <algorithm>
 #include <utility>
 #include "esphome/components/network/util.h"
 #include "esphome/core/application.h"
@@ -27,6 +28,9 @@ namespace mqtt {
 
 static const char *const TAG = "mqtt";
 
+/// Attempts to send a component's discovery message before it is left out until the next reconnect.
+static const uint8_t MAX_DISCOVERY_ATTEMPTS = 5;
+
 MQTTClientComponent::MQTTClientComponent() {
   global_mqtt_client = this;
   this->credentials_.client_id = App.get_name() + "-" + get_mac_address();
@@ -55,14 +59,16 @@ void MQTTClientComponent::setup() {
   });
 #ifdef USE_LOGGER
   if (this->is_log_message_enabled() && logger::global_logger != nullptr) {
-    logger::global_logger->add_on_log_callback([this](int level, const char *tag, const char *message) {
-      if (level <= this->log_level_ && this->is_connected()) {
-        this->publish({.topic = this->log_message_.topic,
-                       .payload = message,
-                       .qos = this->log_message_.qos,
-                       .retain = this->log_message_.retain});
-      }
-    });
+    logger::global_logger->add_on_log_callback(
+        [this](int level, const char *tag, const char *message) {
+          if (level <= this->log_level_ && this->is_connected()) {
+            this->publish({.topic = this->log_message_.topic,
+                           .payload = message,
+                           .qos = this->log_message_.qos,
+                           .retain = this->log_message_.retain});
+          }
+        },
+        [this](int level) { return level <= this->log_level_ && this->is_connected(); });
   }
 #endif
 
@@ -77,6 +83,15 @@ void MQTTClientComponent::setup() {
         topic, [this](const std::string &topic, const std::string &payload) { this->send_device_info_(); }, 2);
   }
 
+  if (this->is_discovery_enabled() && this->is_discovery_skip_unchanged()) {
+    // Home Assistant announces itself on restart, its broker may have lost the retained messages we skip
+    this->subscribe(this->discovery_info_.prefix + "/status",
+                    [this](const std::string &topic, const std::string &payload) {
+                      if (payload == "online")
+                        this->resend_discovery_();
+                    });
+  }
+
   this->last_connected_ = millis();
   this->start_dnslookup_();
 }
@@ -154,6 +169,10 @@ void MQTTClientComponent::dump_config() {
   if (!this->discovery_info_.prefix.empty()) {
     ESP_LOGCONFIG(TAG, "  Discovery prefix: '%s'", this->discovery_info_.prefix.c_str());
     ESP_LOGCONFIG(TAG, "  Discovery retain: %s", YESNO(this->discovery_info_.retain));
+    ESP_LOGCONFIG(TAG, "  Discovery skip unchanged: %s", YESNO(this->is_discovery_skip_unchanged()));
+    if (this->discovery_rate_limit_ != 0) {
+      ESP_LOGCONFIG(TAG, "  Discovery rate limit: %" PRIu32 " bytes/s", this->discovery_rate_limit_);
+    }
   }
   ESP_LOGCONFIG(TAG, "  Topic Prefix: '%s'", this->topic_prefix_.c_str());
   if (!this->log_message_.topic.empty()) {
@@ -162,6 +181,7 @@ void MQTTClientComponent::dump_config() {
   if (!this->availability_.topic.empty()) {
     ESP_LOGCONFIG(TAG, "  Availability: '%s'", this->availability_.topic.c_str());
   }
+  ESP_LOGCONFIG(TAG, "  Publish Queue Size: %zu", this->publish_queue_.get_max_size());
 }
 bool MQTTClientComponent::can_proceed() { return network::is_disabled() || this->is_connected(); }
 
@@ -354,11 +374,17 @@ void MQTTClientComponent::loop() {
       if (!this->mqtt_backend_.connected()) {
         this->state_ = MQTT_CLIENT_DISCONNECTED;
         ESP_LOGW(TAG, "Lost MQTT Client connection!");
+        // Components resend their full state on reconnect
+        this->publish_queue_.clear();
         this->start_dnslookup_();
       } else {
         if (!this->birth_message_.topic.empty() && !this->sent_birth_message_) {
           this->sent_birth_message_ = this->publish(this->birth_message_);
         }
+        if (!this->publish_queue_.empty())
+          this->flush_publish_queue_();
+        if (!this->discovery_queue_.empty())
+          this->process_discovery_queue_();
 
         this->last_connected_ = now;
         this->resubscribe_subscriptions_();
@@ -466,35 +492,119 @@ bool MQTTClientComponent::publish(const std::string &topic, const std::string &p
 
 bool MQTTClientComponent::publish(const std::string &topic, const char *payload, size_t payload_length, uint8_t qos,
                                   bool retain) {
-  return publish({.topic = topic, .payload = payload, .qos = qos, .retain = retain});
+  return this->publish(topic.c_str(), payload, payload_length, qos, retain);
 }
 
 bool MQTTClientComponent::publish(const MQTTMessage &message) {
+  return this->publish(message.topic.c_str(), message.payload.data(), message.payload.size(), message.qos,
+                       message.retain);
+}
+
+bool MQTTClientComponent::publish(const char *topic, const char *payload, size_t payload_length, uint8_t qos,
+                                  bool retain) {
   if (!this->is_connected()) {
     // critical components will re-transmit their messages
     return false;
   }
-  bool logging_topic = this->log_message_.topic == message.topic;
-  bool ret = this->mqtt_backend_.publish(message);
+  bool logging_topic = this->log_message_.topic == topic;
+  // An older message for this topic is still waiting, sending this one now would let the older one overwrite it
+  if (!logging_topic && this->publish_queue_.contains(topic))
+    return this->publish_queue_.enqueue(topic, payload, payload_length, qos, retain);
+
+  bool ret = this->mqtt_backend_.publish(topic, payload, payload_length, qos, retain);
   delay(0);
   if (!ret && !logging_topic && this->is_connected()) {
     delay(0);
-    ret = this->mqtt_backend_.publish(message);
+    ret = this->mqtt_backend_.publish(topic, payload, payload_length, qos, retain);
     delay(0);
   }
 
   if (!logging_topic) {
     if (ret) {
-      ESP_LOGV(TAG, "Publish(topic='%s' payload='%s' retain=%d qos=%d)", message.topic.c_str(), message.payload.c_str(),
-               message.retain, message.qos);
+      ESP_LOGV(TAG, "Publish(topic='%s' payload='%.*s' retain=%d qos=%d)", topic, (int) payload_length, payload, retain,
+               qos);
+    } else if (this->publish_queue_.enqueue(topic, payload, payload_length, qos, retain)) {
+      ESP_LOGV(TAG, "Publish queued for topic='%s' (len=%zu)", topic, payload_length);
+      ret = true;
     } else {
-      ESP_LOGV(TAG, "Publish failed for topic='%s' (len=%u). will retry later..", message.topic.c_str(),
-               message.payload.length());
+      ESP_LOGV(TAG, "Publish failed for topic='%s' (len=%zu). will retry later..", topic, payload_length);
       this->status_momentary_warning("publish", 1000);
     }
   }
   return ret != 0;
 }
+
+void MQTTClientComponent::flush_publish_queue_() {
+  size_t sent = this->publish_queue_.flush([this](const MQTTPendingPublish &pending) {
+    return this->mqtt_backend_.publish(pending.topic.c_str(), pending.payload.data(), pending.payload.size(),
+                                       pending.qos, pending.retain);
+  });
+  if (sent > 0)
+    ESP_LOGV(TAG, "Sent %zu queued publishes", sent);
+}
+
+void MQTTClientComponent::schedule_discovery(MQTTComponent *component) {
+  auto &queue = this->discovery_queue_;
+  auto it = std::find_if(queue.begin(), queue.end(),
+                         [component](const MQTTPendingDiscovery &pending) { return pending.component == component; });
+  if (it == queue.end())
+    queue.push_back({.component = component, .attempts = 0});
+}
+
+void MQTTClientComponent::resend_discovery_() {
+  ESP_LOGD(TAG, "Resending discovery messages");
+  for (MQTTComponent *component : this->children_) {
+    if (!component->is_discovery_enabled())
+      continue;
+    component->invalidate_discovery();
+    this->schedule_discovery(component);
+  }
+}
+
+void MQTTClientComponent::process_discovery_queue_() {
+  if (this->discovery_rate_limit_ != 0) {
+    const uint32_t now = millis();
+    const uint32_t elapsed = now - this->discovery_last_refill_;
+    this->discovery_last_refill_ = now;
+    // Allow a burst of at most one second worth of bytes
+    int64_t budget = this->discovery_budget_ + (int64_t) elapsed * this->discovery_rate_limit_ / 1000;
+    this->discovery_budget_ = (int32_t) std::min<int64_t>(budget, this->discovery_rate_limit_);
+    if (this->discovery_budget_ <= 0)
+      return;
+  }
+
+  // One message per loop iteration, a large node would otherwise block the loop for the whole burst
+  MQTTPendingDiscovery pending = this->discovery_queue_.front();
+  MQTTComponent *component = pending.component;
+  size_t bytes_sent = 0;
+  switch (component->process_discovery(bytes_sent)) {
+    case MQTT_DISCOVERY_FAILED:
+      this->discovery_queue_.pop_front();
+      // Retried after the other components, so one that keeps failing doesn't hold back the rest
+      if (++pending.attempts < MAX_DISCOVERY_ATTEMPTS) {
+        this->discovery_queue_.push_back(pending);
+      } else {
+        ESP_LOGW(TAG, "'%s': Discovery failed %u times, giving up until the next reconnect",
+                 component->friendly_name().c_str(), pending.attempts);
+      }
+      return;
+    case MQTT_DISCOVERY_SENT:
+      this->discovery_published_++;
+      this->discovery_budget_ -= bytes_sent;
+      break;
+    case MQTT_DISCOVERY_SKIPPED:
+      this->discovery_skipped_++;
+      break;
+  }
+  this->discovery_queue_.pop_front();
+  if (!component->send_initial_state())
+    component->schedule_resend_state();
+  if (this->discovery_queue_.empty()) {
+    ESP_LOGD(TAG, "Discovery done, %" PRIu32 " published, %" PRIu32 " unchanged", this->discovery_published_,
+             this->discovery_skipped_);
+  }
+}
+
 bool MQTTClientComponent::publish_json(const std::string &topic, const json::json_build_t &f, uint8_t qos,
                                        bool retain) {
   std::string message = json::build_json(f);
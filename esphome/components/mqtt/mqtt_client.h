@@ -17,7 +17,9 @@
 #include "mqtt_backend_libretiny.h"
 #endif
 #include "lwip/ip_addr.h"
+#include "mqtt_publish_queue.h"
 
+#include <deque>
 #include <vector>
 
 namespace esphome {
@@ -86,6 +88,21 @@ struct MQTTDiscoveryInfo {
   MQTTDiscoveryObjectIdGenerator object_id_generator;
 };
 
+/// Outcome of sending a component's discovery message.
+enum MQTTDiscoveryResult {
+  MQTT_DISCOVERY_FAILED = 0,
+  MQTT_DISCOVERY_SENT,
+  MQTT_DISCOVERY_SKIPPED,
+};
+
+class MQTTComponent;
+
+/// internal struct for a component waiting for its discovery message to be sent.
+struct MQTTPendingDiscovery {
+  MQTTComponent *component;
+  uint8_t attempts;  ///< Failed attempts to send it so far.
+};
+
 enum MQTTClientState {
   MQTT_CLIENT_DISCONNECTED = 0,
   MQTT_CLIENT_RESOLVING_ADDRESS,
@@ -93,8 +110,6 @@ enum MQTTClientState {
   MQTT_CLIENT_CONNECTED,
 };
 
-class MQTTComponent;
-
 class MQTTClientComponent : public Component {
  public:
   MQTTClientComponent();
@@ -133,6 +148,23 @@ class MQTTClientComponent : public Component {
   bool is_discovery_enabled() const;
   bool is_discovery_ip_enabled() const;
 
+  /// Limit the discovery messages sent after connecting to this many payload bytes per second, 0 for no limit.
+  void set_discovery_rate_limit(uint32_t bytes_per_second) { this->discovery_rate_limit_ = bytes_per_second; }
+  /// Skip retained discovery messages whose payload did not change since they were last sent.
+  void set_discovery_skip_unchanged(bool skip_unchanged) { this->discovery_skip_unchanged_ = skip_unchanged; }
+  bool is_discovery_skip_unchanged() const {
+    return this->discovery_skip_unchanged_ && this->discovery_info_.retain && !this->discovery_info_.clean;
+  }
+  /// Queue the discovery message of a component, they are sent one at a time from loop(), each followed by the
+  /// component's initial state.
+  void schedule_discovery(MQTTComponent *component);
+  /// Number of discovery messages published since boot.
+  uint32_t get_discovery_published() const { return this->discovery_published_; }
+  /// Number of discovery messages skipped because the broker already retained the same payload.
+  uint32_t get_discovery_skipped() const { return this->discovery_skipped_; }
+  /// Number of components still waiting for their discovery message to be sent.
+  size_t get_discovery_pending() const { return this->discovery_queue_.size(); }
+
 #if ASYNC_TCP_SSL_ENABLED
   /** Add a SSL fingerprint to use for TCP SSL connections to the MQTT broker.
    *
@@ -220,6 +252,25 @@ class MQTTClientComponent : public Component {
   bool publish(const std::string &topic, const char *payload, size_t payload_length, uint8_t qos = 0,
                bool retain = false);
 
+  /** Publish a MQTT message without allocating.
+   *
+   * If the connection is backpressured the message is kept in the publish queue, where a newer message for the
+   * same topic replaces the older one.
+   *
+   * @param topic The topic, must be null-terminated.
+   * @param payload The payload buffer.
+   * @param payload_length The length of the payload in bytes.
+   * @param retain Whether to retain the message.
+   */
+  bool publish(const char *topic, const char *payload, size_t payload_length, uint8_t qos = 0, bool retain = false);
+
+  /// Set the number of topics that can wait for a backpressured connection, 0 disables the queue.
+  void set_publish_queue_size(size_t publish_queue_size) { this->publish_queue_.set_max_size(publish_queue_size); }
+  /// Number of queued publishes that were replaced by a newer message for the same topic.
+  uint32_t get_publish_queue_coalesced() const { return this->publish_queue_.get_coalesced(); }
+  /// Number of publishes dropped because the queue was full.
+  uint32_t get_publish_queue_dropped() const { return this->publish_queue_.get_dropped(); }
+
   /** Construct and send a JSON MQTT message.
    *
    * @param topic The topic.
@@ -275,6 +326,14 @@ class MQTTClientComponent : public Component {
   /// Re-calculate the availability property.
   void recalculate_availability_();
 
+  /// Retry queued publishes in order until the backend refuses one.
+  void flush_publish_queue_();
+
+  /// Send the next queued discovery message if the rate limit allows it.
+  void process_discovery_queue_();
+  /// Resend the discovery messages of all components, e.g. when Home Assistant comes back online.
+  void resend_discovery_();
+
   bool subscribe_(const char *topic, uint8_t qos);
   void resubscribe_subscription_(MQTTSubscription *sub);
   void resubscribe_subscriptions_();
@@ -306,6 +365,14 @@ class MQTTClientComponent : public Component {
   int log_level_{ESPHOME_LOG_LEVEL};
 
   std::vector<MQTTSubscription> subscriptions_;
+  MQTTPublishQueue publish_queue_;
+  std::deque<MQTTPendingDiscovery> discovery_queue_;
+  uint32_t discovery_rate_limit_{0};
+  int32_t discovery_budget_{0};
+  uint32_t discovery_last_refill_{0};
+  uint32_t discovery_published_{0};
+  uint32_t discovery_skipped_{0};
+  bool discovery_skip_unchanged_{false};
 #if defined(USE_ESP32)
   MQTTBackendESP32 mqtt_backend_;
 #elif defined(USE_ESP8266)
@@ -8,6 +8,7 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/entity_base.h"
+#include "esphome/core/preferences.h"
 #include "esphome/core/string_ref.h"
 #include "mqtt_client.h"
 
@@ -112,6 +113,15 @@ class MQTTComponent : public Component {
   /// Internal method for the MQTT client base to schedule a resend of the state on reconnect.
   void schedule_resend_state();
 
+  /** Internal method for the MQTT client's discovery queue to send the discovery message.
+   *
+   * @param bytes_sent Set to the size of the published payload.
+   * @return Whether the message was sent, skipped because the broker already retains it, or failed.
+   */
+  MQTTDiscoveryResult process_discovery(size_t &bytes_sent);
+  /// Internal method to send the next discovery payload even if the broker should still retain it.
+  void invalidate_discovery() { this->discovery_forced_ = true; }
+
   /** Send a MQTT message.
    *
    * @param topic The topic.
@@ -119,6 +129,15 @@ class MQTTComponent : public Component {
    */
   bool publish(const std::string &topic, const std::string &payload);
 
+  /** Send a MQTT message without copying the payload.
+   *
+   * @param topic The topic.
+   * @param payload The payload buffer.
+   * @param payload_length The length of the payload in bytes.
+   */
+  bool publish(const std::string &topic, const char *payload, size_t payload_length);
+  bool publish(const std::string &topic, const char *payload) { return this->publish(topic, payload, strlen(payload)); }
+
   /** Construct and send a JSON MQTT message.
    *
    * @param topic The topic.
@@ -177,16 +196,16 @@ class MQTTComponent : public Component {
   /// Get whether the underlying Entity is disabled by default
   virtual bool is_disabled_by_default() const;
 
-  /// Get the MQTT topic that new states will be shared to.
-  std::string get_state_topic_() const;
+  /// Get the MQTT topic that new states will be shared to, built on first use.
+  const std::string &get_state_topic_() const;
 
-  /// Get the MQTT topic for listening to commands.
-  std::string get_command_topic_() const;
+  /// Get the MQTT topic for listening to commands, built on first use.
+  const std::string &get_command_topic_() const;
 
   bool is_connected_() const;
 
-  /// Internal method to start sending discovery info, this will call send_discovery().
-  bool send_discovery_();
+  /// Build the full discovery payload, this will call send_discovery().
+  std::string build_discovery_();
 
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
@@ -198,6 +217,16 @@ class MQTTComponent : public Component {
 
   std::unique_ptr<Availability> availability_;
 
+  /// Hash of the last retained discovery payload, persisted so unchanged payloads are not resent after a reboot.
+  ESPPreferenceObject discovery_pref_;
+  uint32_t discovery_hash_{0};
+  bool discovery_pref_loaded_{false};
+  bool discovery_forced_{false};
+
+  // Topics never change after codegen, so they are built once instead of on every publish.
+  mutable std::string state_topic_{};
+  mutable std::string command_topic_{};
+
   bool has_custom_state_topic_{false};
   bool has_custom_command_topic_{false};
 
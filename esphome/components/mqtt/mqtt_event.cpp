@@ -20,8 +20,8 @@ void MQTTEventComponent::send_discovery(JsonObject root, mqtt::SendDiscoveryConf
   for (const auto &event_type : this->event_->get_event_types())
     event_types.add(event_type);
 
-  if (!this->event_->get_device_class().empty())
-    root[MQTT_DEVICE_CLASS] = this->event_->get_device_class();
+  if (!this->event_->get_device_class_ref().empty())
+    root[MQTT_DEVICE_CLASS] = this->event_->get_device_class_ref();
 
   config.command_topic = false;
 }
@@ -43,8 +43,8 @@ void MQTTNumberComponent::send_discovery(JsonObject root, mqtt::SendDiscoveryCon
   root[MQTT_MIN] = traits.get_min_value();
   root[MQTT_MAX] = traits.get_max_value();
   root[MQTT_STEP] = traits.get_step();
-  if (!this->number_->traits.get_unit_of_measurement().empty())
-    root[MQTT_UNIT_OF_MEASUREMENT] = this->number_->traits.get_unit_of_measurement();
+  if (!this->number_->traits.get_unit_of_measurement_ref().empty())
+    root[MQTT_UNIT_OF_MEASUREMENT] = this->number_->traits.get_unit_of_measurement_ref();
   switch (this->number_->traits.get_mode()) {
     case NUMBER_MODE_AUTO:
       break;
@@ -55,8 +55,8 @@ void MQTTNumberComponent::send_discovery(JsonObject root, mqtt::SendDiscoveryCon
       root[MQTT_MODE] = "slider";
       break;
   }
-  if (!this->number_->traits.get_device_class().empty())
-    root[MQTT_DEVICE_CLASS] = this->number_->traits.get_device_class();
+  if (!this->number_->traits.get_device_class_ref().empty())
+    root[MQTT_DEVICE_CLASS] = this->number_->traits.get_device_class_ref();
 
   config.command_topic = true;
 }
@@ -68,9 +68,9 @@ bool MQTTNumberComponent::send_initial_state() {
   }
 }
 bool MQTTNumberComponent::publish_state(float value) {
-  char buffer[64];
-  snprintf(buffer, sizeof(buffer), "%f", value);
-  return this->publish(this->get_state_topic_(), buffer);
+  char buffer[FLOAT_BUF_SIZE];
+  size_t len = float_to_buf(buffer, sizeof(buffer), value);
+  return this->publish(this->get_state_topic_(), buffer, len);
 }
 
 }  // namespace mqtt
@@ -0,0 +1,51 @@
+#include "mqtt_publish_queue.h"
+
+#ifdef USE_MQTT
+
+namespace esphome {
+namespace mqtt {
+
+bool MQTTPublishQueue::contains(const char *topic) const {
+  for (const auto &pending : this->queue_) {
+    if (pending.topic == topic)
+      return true;
+  }
+  return false;
+}
+
+bool MQTTPublishQueue::enqueue(const char *topic, const char *payload, size_t payload_length, uint8_t qos,
+                               bool retain) {
+  for (auto &pending : this->queue_) {
+    if (pending.topic == topic) {
+      pending.payload.assign(payload, payload_length);
+      pending.qos = qos;
+      pending.retain = retain;
+      this->coalesced_++;
+      return true;
+    }
+  }
+  if (this->queue_.size() >= this->max_size_) {
+    this->dropped_++;
+    return false;
+  }
+  this->queue_.push_back(
+      {.topic = topic, .payload = std::string(payload, payload_length), .qos = qos, .retain = retain});
+  return true;
+}
+
+size_t MQTTPublishQueue::flush(const publish_t &publish) {
+  size_t sent = 0;
+  for (const auto &pending : this->queue_) {
+    if (!publish(pending))
+      break;
+    sent++;
+  }
+  if (sent > 0)
+    this->queue_.erase(this->queue_.begin(), this->queue_.begin() + sent);
+  return sent;
+}
+
+}  // namespace mqtt
+}  // namespace esphome
+
+#endif  // USE_MQTT
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_MQTT
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace mqtt {
+
+/// internal struct for a publish waiting for the broker connection to accept it.
+struct MQTTPendingPublish {
+  std::string topic;
+  std::string payload;
+  uint8_t qos;
+  bool retain;
+};
+
+/** Publishes waiting for a backpressured broker connection, at most one per topic.
+ *
+ * A newer message for a topic that is already waiting replaces the older one in its place, so the broker only gets
+ * the latest state and the topics keep the order they were first queued in.
+ */
+class MQTTPublishQueue {
+ public:
+  using publish_t = std::function<bool(const MQTTPendingPublish &)>;
+
+  /// Set the number of topics that can wait, 0 disables the queue.
+  void set_max_size(size_t max_size) { this->max_size_ = max_size; }
+  size_t get_max_size() const { return this->max_size_; }
+
+  /// Whether a publish for this topic is waiting.
+  bool contains(const char *topic) const;
+  /// Queue a publish, replacing the one waiting for the same topic. Returns false if the queue is full.
+  bool enqueue(const char *topic, const char *payload, size_t payload_length, uint8_t qos, bool retain);
+  /// Publish the waiting messages in order until `publish` refuses one, returns the number sent.
+  size_t flush(const publish_t &publish);
+  void clear() { this->queue_.clear(); }
+
+  bool empty() const { return this->queue_.empty(); }
+  size_t size() const { return this->queue_.size(); }
+  /// Number of queued publishes that were replaced by a newer message for the same topic.
+  uint32_t get_coalesced() const { return this->coalesced_; }
+  /// Number of publishes dropped because the queue was full.
+  uint32_t get_dropped() const { return this->dropped_; }
+
+ protected:
+  std::vector<MQTTPendingPublish> queue_;
+  size_t max_size_{0};
+  uint32_t coalesced_{0};
+  uint32_t dropped_{0};
+};
+
+}  // namespace mqtt
+}  // namespace esphome
+
+#endif  // USE_MQTT
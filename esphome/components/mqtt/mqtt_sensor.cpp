@@ -44,11 +44,11 @@ void MQTTSensorComponent::set_expire_after(uint32_t expire_after) { this->expire
 void MQTTSensorComponent::disable_expire_after() { this->expire_after_ = 0; }
 
 void MQTTSensorComponent::send_discovery(JsonObject root, mqtt::SendDiscoveryConfig &config) {
-  if (!this->sensor_->get_device_class().empty())
-    root[MQTT_DEVICE_CLASS] = this->sensor_->get_device_class();
+  if (!this->sensor_->get_device_class_ref().empty())
+    root[MQTT_DEVICE_CLASS] = this->sensor_->get_device_class_ref();
 
-  if (!this->sensor_->get_unit_of_measurement().empty())
-    root[MQTT_UNIT_OF_MEASUREMENT] = this->sensor_->get_unit_of_measurement();
+  if (!this->sensor_->get_unit_of_measurement_ref().empty())
+    root[MQTT_UNIT_OF_MEASUREMENT] = this->sensor_->get_unit_of_measurement_ref();
 
   if (this->get_expire_after() > 0)
     root[MQTT_EXPIRE_AFTER] = this->get_expire_after() / 1000;
@@ -70,7 +70,9 @@ bool MQTTSensorComponent::send_initial_state() {
 }
 bool MQTTSensorComponent::publish_state(float value) {
   int8_t accuracy = this->sensor_->get_accuracy_decimals();
-  return this->publish(this->get_state_topic_(), value_accuracy_to_string(value, accuracy));
+  char buf[32];
+  size_t len = value_accuracy_to_buf(buf, sizeof(buf), value, accuracy);
+  return this->publish(this->get_state_topic_(), buf, len);
 }
 std::string MQTTSensorComponent::unique_id() { return this->sensor_->unique_id(); }
 
@@ -15,8 +15,8 @@ using namespace esphome::text_sensor;
 
 MQTTTextSensor::MQTTTextSensor(TextSensor *sensor) : sensor_(sensor) {}
 void MQTTTextSensor::send_discovery(JsonObject root, mqtt::SendDiscoveryConfig &config) {
-  if (!this->sensor_->get_device_class().empty())
-    root[MQTT_DEVICE_CLASS] = this->sensor_->get_device_class();
+  if (!this->sensor_->get_device_class_ref().empty())
+    root[MQTT_DEVICE_CLASS] = this->sensor_->get_device_class_ref();
   config.command_topic = false;
 }
 void MQTTTextSensor::setup() {
@@ -47,8 +47,8 @@ void MQTTValveComponent::dump_config() {
   }
 }
 void MQTTValveComponent::send_discovery(JsonObject root, mqtt::SendDiscoveryConfig &config) {
-  if (!this->valve_->get_device_class().empty())
-    root[MQTT_DEVICE_CLASS] = this->valve_->get_device_class();
+  if (!this->valve_->get_device_class_ref().empty())
+    root[MQTT_DEVICE_CLASS] = this->valve_->get_device_class_ref();
 
   auto traits = this->valve_->get_traits();
   if (traits.get_is_assumed_state()) {
@@ -247,9 +247,11 @@ async def setup_number_core_(
         await automation.build_automation(trigger, [(float, "x")], conf)
 
     if (unit_of_measurement := config.get(CONF_UNIT_OF_MEASUREMENT)) is not None:
-        cg.add(var.traits.set_unit_of_measurement(unit_of_measurement))
+        cg.add(
+            var.traits.set_unit_of_measurement(cg.entity_string(unit_of_measurement))
+        )
     if (device_class := config.get(CONF_DEVICE_CLASS)) is not None:
-        cg.add(var.traits.set_device_class(device_class))
+        cg.add(var.traits.set_device_class(cg.entity_string(device_class)))
 
     if (mqtt_id := config.get(CONF_MQTT_ID)) is not None:
         mqtt_ = cg.new_Pvariable(mqtt_id, var)
@@ -1,5 +1,7 @@
 #include "one_wire_bus.h"
 #include "esphome/core/helpers.h"
+#include <algorithm>
+#include <cinttypes>
 
 namespace esphome {
 namespace one_wire {
@@ -14,6 +16,8 @@ static const uint8_t DALLAS_MODEL_DS28EA00 = 0x42;
 
 const uint8_t ONE_WIRE_ROM_SELECT = 0x55;
 const uint8_t ONE_WIRE_ROM_SEARCH = 0xF0;
+const uint8_t ONE_WIRE_CONVERT_T = 0x44;
+const uint8_t ONE_WIRE_READ_SCRATCH_PAD = 0xBE;
 
 const std::vector<uint64_t> &OneWireBus::get_devices() { return this->devices_; }
 
@@ -56,6 +60,119 @@ void OneWireBus::skip() {
   this->write8(0xCC);  // skip ROM
 }
 
+void OneWireBus::request_conversion(uint32_t wait_ms, std::function<void(bool)> &&callback) {
+  if (this->converting_) {
+    // the device started converting with the broadcast as well
+    this->conversion_wait_ = std::max(this->conversion_wait_, wait_ms);
+    this->conversion_callbacks_.push_back(std::move(callback));
+    return;
+  }
+  this->requested_wait_ = std::max(this->requested_wait_, wait_ms);
+  this->conversion_requests_.push_back(std::move(callback));
+}
+
+void OneWireBus::process_conversions_() {
+  if (this->converting_) {
+    const uint32_t now = millis();
+    if (now - this->conversion_start_ < this->conversion_wait_)
+      return;
+    this->converting_ = false;
+    std::vector<std::function<void(bool)>> callbacks;
+    callbacks.swap(this->conversion_callbacks_);
+    for (auto &callback : callbacks)
+      callback(true);
+    this->last_read_time_ = millis() - now;
+    this->last_cycle_time_ = millis() - this->conversion_start_;
+    ESP_LOGD(TAG, "Conversion cycle of %zu devices took %" PRIu32 " ms, reading %" PRIu32 " ms", callbacks.size(),
+             this->last_cycle_time_, this->last_read_time_);
+  }
+  if (this->conversion_requests_.empty())
+    return;
+
+  bool success;
+  {
+    InterruptLock lock;
+    success = this->reset();
+    if (success) {
+      this->skip();
+      this->write8(ONE_WIRE_CONVERT_T);
+    }
+  }
+  this->conversion_callbacks_.swap(this->conversion_requests_);
+  this->conversion_wait_ = this->requested_wait_;
+  this->requested_wait_ = 0;
+  if (!success) {
+    ESP_LOGW(TAG, "Bus reset failed, can't start conversion");
+    std::vector<std::function<void(bool)>> callbacks;
+    callbacks.swap(this->conversion_callbacks_);
+    for (auto &callback : callbacks)
+      callback(false);
+    return;
+  }
+  this->converting_ = true;
+  this->conversion_start_ = millis();
+}
+
+bool OneWireBus::load_devices_(uint32_t hash) {
+  this->device_cache_ = global_preferences->make_preference<DeviceCache>(hash, true);
+  DeviceCache cache{};
+  if (!this->device_cache_.load(&cache) || cache.count == 0 || cache.count > DeviceCache::MAX_DEVICES)
+    return false;
+  this->devices_.assign(cache.addresses, cache.addresses + cache.count);
+  ESP_LOGD(TAG, "Loaded %u devices found by the previous search", cache.count);
+  return true;
+}
+
+bool OneWireBus::is_present_(uint64_t address) {
+  switch (address & 0xff) {
+    case DALLAS_MODEL_DS18S20:
+    case DALLAS_MODEL_DS1822:
+    case DALLAS_MODEL_DS18B20:
+    case DALLAS_MODEL_DS1825:
+    case DALLAS_MODEL_DS28EA00:
+      break;
+    default:
+      // only the answer of these can be checked, by the CRC of their scratch pad
+      return false;
+  }
+  uint8_t scratch_pad[9];
+  {
+    InterruptLock lock;
+    if (!this->select(address))
+      return false;
+    this->write8(ONE_WIRE_READ_SCRATCH_PAD);
+    for (uint8_t &value : scratch_pad)
+      value = this->read8();
+  }
+  // without an answer the bus reads as all ones, which fails the CRC, a shorted bus reads as all zeros which doesn't
+  if (std::all_of(scratch_pad, scratch_pad + 9, [](uint8_t value) { return value == 0; }))
+    return false;
+  return crc8(scratch_pad, 8) == scratch_pad[8];
+}
+
+bool OneWireBus::validate_devices_() {
+  for (uint64_t address : this->devices_) {
+    if (!this->is_present_(address)) {
+      ESP_LOGD(TAG, "Device 0x%s found by the previous search didn't answer", format_hex(address).c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+void OneWireBus::save_devices_() {
+  if (this->devices_.size() > DeviceCache::MAX_DEVICES)
+    return;
+  DeviceCache cache{};
+  if (this->device_cache_.load(&cache) && cache.count == this->devices_.size() &&
+      std::equal(this->devices_.begin(), this->devices_.end(), cache.addresses))
+    return;
+  ESP_LOGD(TAG, "Storing %zu found devices", this->devices_.size());
+  cache.count = this->devices_.size();
+  std::copy(this->devices_.begin(), this->devices_.end(), cache.addresses);
+  this->device_cache_.save(&cache);
+}
+
 const LogString *OneWireBus::get_model_str(uint8_t model) {
   switch (model) {
     case DALLAS_MODEL_DS18S20:
@@ -2,6 +2,8 @@
 
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
+#include "esphome/core/preferences.h"
+#include <functional>
 #include <vector>
 
 namespace esphome {
@@ -44,8 +46,53 @@ class OneWireBus {
   /// Get the description string for this model.
   const LogString *get_model_str(uint8_t model);
 
+  /** Have all devices on the bus start a temperature conversion.
+   *
+   * A single "Convert T" is broadcast with skip ROM for all requests made before the bus gets to it, and requests
+   * made while a conversion is running join it. `callback` is called from the loop of the bus once the conversion
+   * finished, after waiting for the longest `wait_ms` of the joined requests, with false if the bus reset failed.
+   * All callbacks of a conversion are called back to back so the devices read their results in one batch.
+   */
+  void request_conversion(uint32_t wait_ms, std::function<void(bool)> &&callback);
+
+  /// Duration in ms of the last conversion cycle, from the broadcast until all results were read.
+  uint32_t get_last_cycle_time() const { return this->last_cycle_time_; }
+  /// Time in ms spent reading results in the last conversion cycle.
+  uint32_t get_last_read_time() const { return this->last_read_time_; }
+
  protected:
+  /// Devices found by a search, stored in flash so the next boot can skip it.
+  struct DeviceCache {
+    static const uint8_t MAX_DEVICES = 16;
+    uint8_t count;
+    uint64_t addresses[MAX_DEVICES];
+  };
+
   std::vector<uint64_t> devices_;
+  std::vector<std::function<void(bool)>> conversion_requests_;   ///< waiting for the next conversion
+  std::vector<std::function<void(bool)>> conversion_callbacks_;  ///< waiting for the running conversion
+  uint32_t requested_wait_{0};
+  uint32_t conversion_wait_{0};
+  uint32_t conversion_start_{0};
+  bool converting_{false};
+  uint32_t last_cycle_time_{0};
+  uint32_t last_read_time_{0};
+  ESPPreferenceObject device_cache_;
+
+  /// Start and complete conversions, to be called from the loop of the bus.
+  void process_conversions_();
+
+  /// Load the devices found by a previous search, returns false if there are none.
+  bool load_devices_(uint32_t hash);
+  /// Store the found devices for load_devices_() if they changed.
+  void save_devices_();
+  /** Check that every loaded device still answers when addressed, much faster than searching the bus again.
+   *
+   * Returns false as soon as one doesn't, or isn't a model whose answer can be checked.
+   */
+  bool validate_devices_();
+  /// Address the device and read its scratch pad, returns whether it answered with a valid CRC.
+  bool is_present_(uint64_t address);
 
   /// log the found devices
   void dump_devices_(const char *tag);
@@ -1,6 +1,7 @@
-from esphome.const import CONF_ID
+from esphome.const import CONF_ID, PLATFORM_ESP32, PLATFORM_HOST
 import esphome.codegen as cg
 import esphome.config_validation as cv
+from esphome.core import CORE
 
 CODEOWNERS = ["@esphome/core"]
 
@@ -8,12 +9,28 @@ preferences_ns = cg.esphome_ns.namespace("preferences")
 IntervalSyncer = preferences_ns.class_("IntervalSyncer", cg.Component)
 
 CONF_FLASH_WRITE_INTERVAL = "flash_write_interval"
+CONF_STORAGE = "storage"
+
+STORAGE_DEFAULT = "default"
+STORAGE_LOG = "log"
+
+
+def validate_storage(value):
+    value = cv.one_of(STORAGE_DEFAULT, STORAGE_LOG, lower=True)(value)
+    if value == STORAGE_LOG and not (CORE.is_esp32 or CORE.is_host):
+        raise cv.Invalid(
+            f"'{STORAGE_LOG}' storage is only available on {PLATFORM_ESP32} and {PLATFORM_HOST}"
+        )
+    return value
+
+
 CONFIG_SCHEMA = cv.Schema(
     {
         cv.GenerateID(): cv.declare_id(IntervalSyncer),
         cv.Optional(
             CONF_FLASH_WRITE_INTERVAL, default="60s"
         ): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_STORAGE, default=STORAGE_DEFAULT): validate_storage,
     }
 ).extend(cv.COMPONENT_SCHEMA)
 
@@ -22,3 +39,6 @@ async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     cg.add(var.set_write_interval(config[CONF_FLASH_WRITE_INTERVAL]))
     await cg.register_component(var, config)
+    if config[CONF_STORAGE] == STORAGE_LOG:
+        # On ESP32 this uses a data partition labelled "prefs", which has to be added with custom partitions
+        cg.add_define("USE_PREFERENCES_LOG")
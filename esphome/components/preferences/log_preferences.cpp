@@ -0,0 +1,324 @@
+#include "log_preferences.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cinttypes>
+
+namespace esphome {
+namespace preferences {
+
+static const char *const TAG = "preferences.log";
+
+static const uint32_t SECTOR_MAGIC = 0x50E5106A;
+static const uint32_t FREE_KEY = 0xFFFFFFFF;
+static const uint16_t FREE_LEN = 0xFFFF;
+/// Sectors kept erased to copy the records of the sector being compacted into.
+static const size_t RESERVED_SECTORS = 1;
+/// sync() compacts a sector once no more sectors than this are erased.
+static const size_t COMPACT_THRESHOLD = RESERVED_SECTORS + 1;
+
+// The magic comes last, a header cut short by a reset is not valid
+struct SectorHeader {
+  uint32_t sequence;
+  uint32_t magic;
+};
+
+struct RecordHeader {
+  uint32_t key;
+  uint16_t len;
+  uint16_t crc;
+};
+
+static size_t record_size(size_t len) { return (sizeof(RecordHeader) + len + 3) & ~size_t(3); }
+
+static uint16_t record_crc(uint32_t key, uint16_t len, const uint8_t *data) {
+  uint8_t header[sizeof(key) + sizeof(len)];
+  memcpy(header, &key, sizeof(key));
+  memcpy(header + sizeof(key), &len, sizeof(len));
+  return crc16(data, len, crc16(header, sizeof(header)));
+}
+
+class LogPreferenceBackend : public ESPPreferenceBackend {
+ public:
+  LogPreferenceBackend(LogPreferences *parent, uint32_t key) : parent_(parent), key_(key) {}
+  bool save(const uint8_t *data, size_t len) override { return this->parent_->save(this->key_, data, len); }
+  bool load(uint8_t *data, size_t len) override { return this->parent_->load(this->key_, data, len); }
+
+ protected:
+  LogPreferences *parent_;
+  uint32_t key_;
+};
+
+bool LogPreferences::setup() {
+  if (this->setup_complete_)
+    return this->usable_;
+  this->setup_complete_ = true;
+  const size_t sector_size = this->flash_->get_sector_size();
+  const size_t sector_count = this->flash_->get_sector_count();
+  if (sector_count < RESERVED_SECTORS + 2 || sector_size < 4 * sizeof(RecordHeader)) {
+    ESP_LOGE(TAG, "%u sectors of %u bytes are too small for preferences", (unsigned) sector_count,
+             (unsigned) sector_size);
+    return false;
+  }
+
+  this->sequences_.assign(sector_count, 0);
+  std::vector<size_t> order;
+  for (size_t sector = 0; sector < sector_count; sector++) {
+    SectorHeader header;
+    if (this->flash_->read(sector * sector_size, &header, sizeof(header)) && header.magic == SECTOR_MAGIC &&
+        header.sequence != 0 && header.sequence != 0xFFFFFFFF) {
+      this->sequences_[sector] = header.sequence;
+      order.push_back(sector);
+    }
+  }
+  std::sort(order.begin(), order.end(),
+            [this](size_t a, size_t b) { return this->sequences_[a] < this->sequences_[b]; });
+
+  // Replay from the oldest to the newest sector, so the index ends up with the newest record of every key
+  this->write_offset_ = sector_size;
+  for (size_t sector : order) {
+    const size_t base = sector * sector_size;
+    size_t offset = sizeof(SectorHeader);
+    while (true) {
+      RecordHeader header;
+      if (offset + sizeof(header) > sector_size || !this->flash_->read(base + offset, &header, sizeof(header)))
+        break;
+      if (header.key == FREE_KEY && header.len == FREE_LEN)
+        break;
+      if (record_size(header.len) > sector_size - offset) {
+        offset = sector_size;
+        break;
+      }
+      this->buffer_.resize(header.len);
+      if (!this->flash_->read(base + offset + sizeof(header), this->buffer_.data(), header.len) ||
+          record_crc(header.key, header.len, this->buffer_.data()) != header.crc) {
+        ESP_LOGW(TAG, "Dropping damaged record in sector %u at %u", (unsigned) sector, (unsigned) offset);
+        offset = sector_size;
+        break;
+      }
+      auto previous = this->index_.find(header.key);
+      if (previous != this->index_.end())
+        this->live_bytes_ -= record_size(previous->second.len);
+      this->index_[header.key] = Location{uint32_t(base + offset + sizeof(header)), header.len};
+      this->live_bytes_ += record_size(header.len);
+      offset += record_size(header.len);
+    }
+    this->head_ = sector;
+    this->sequence_ = this->sequences_[sector];
+    this->write_offset_ = offset;
+  }
+
+  // Only continue the newest sector if nothing was written behind its last record
+  uint8_t chunk[32];
+  for (size_t offset = this->write_offset_; offset < sector_size; offset += sizeof(chunk)) {
+    const size_t len = std::min(sizeof(chunk), sector_size - offset);
+    if (!this->flash_->read(this->head_ * sector_size + offset, chunk, len) ||
+        std::any_of(chunk, chunk + len, [](uint8_t byte) { return byte != 0xFF; })) {
+      this->write_offset_ = sector_size;
+      break;
+    }
+  }
+
+  ESP_LOGD(TAG, "Loaded %u preferences from %u of %u sectors", (unsigned) this->index_.size(), (unsigned) order.size(),
+           (unsigned) sector_count);
+  this->usable_ = true;
+  return true;
+}
+
+ESPPreferenceObject LogPreferences::make_preference(size_t length, uint32_t type, bool in_flash) {
+  auto *pref = new LogPreferenceBackend(this, type);  // NOLINT(cppcoreguidelines-owning-memory)
+  return ESPPreferenceObject(pref);
+}
+
+bool LogPreferences::save(uint32_t key, const uint8_t *data, size_t len) {
+  if (!this->setup() || this->is_reset_ ||
+      record_size(len) > this->flash_->get_sector_size() - sizeof(SectorHeader) || len >= FREE_LEN)
+    return false;
+  // Only kept in RAM until the next sync, saving a key again replaces its value
+  auto &value = this->values_[key];
+  value.data.assign(data, data + len);
+  value.dirty = true;
+  return true;
+}
+
+bool LogPreferences::load(uint32_t key, uint8_t *data, size_t len) {
+  if (!this->setup())
+    return false;
+  auto value = this->values_.find(key);
+  if (value != this->values_.end()) {
+    if (value->second.data.size() != len)
+      return false;
+    memcpy(data, value->second.data.data(), len);
+    return true;
+  }
+  auto location = this->index_.find(key);
+  if (location == this->index_.end() || location->second.len != len)
+    return false;
+  return this->flash_->read(location->second.offset, data, len);
+}
+
+bool LogPreferences::sync() {
+  if (!this->setup() || this->is_reset_)
+    return false;
+
+  size_t unchanged = 0, written = 0, failed = 0;
+  for (auto &it : this->values_) {
+    Value &value = it.second;
+    if (!value.dirty)
+      continue;
+    if (this->matches_stored_(it.first, value.data.data(), value.data.size())) {
+      unchanged++;
+    } else if (this->append_(it.first, value.data.data(), value.data.size(), false)) {
+      written++;
+    } else {
+      // Stays dirty and is retried on the next sync
+      failed++;
+      continue;
+    }
+    value.dirty = false;
+  }
+  if (unchanged + written + failed != 0) {
+    ESP_LOGD(TAG, "Saving %u preferences to flash: %u unchanged, %u written, %u failed",
+             (unsigned) (unchanged + written + failed), (unsigned) unchanged, (unsigned) written, (unsigned) failed);
+  }
+
+  // Free a sector ahead of time, so a later sync doesn't have to wait for it
+  if (failed == 0 && this->count_free_sectors_() <= COMPACT_THRESHOLD)
+    this->compact_();
+  return failed == 0;
+}
+
+bool LogPreferences::reset() {
+  ESP_LOGD(TAG, "Cleaning up preferences in flash...");
+  // Refuse any saves until restart, so the values of the running components don't end up in flash again
+  this->is_reset_ = true;
+  this->values_.clear();
+  this->index_.clear();
+  this->live_bytes_ = 0;
+  bool success = true;
+  for (size_t sector = 0; sector < this->sequences_.size(); sector++) {
+    success &= this->flash_->erase(sector);
+    this->sequences_[sector] = 0;
+  }
+  this->write_offset_ = this->flash_->get_sector_size();
+  return success;
+}
+
+bool LogPreferences::matches_stored_(uint32_t key, const uint8_t *data, size_t len) {
+  auto location = this->index_.find(key);
+  if (location == this->index_.end() || location->second.len != len)
+    return false;
+  this->buffer_.resize(len);
+  return this->flash_->read(location->second.offset, this->buffer_.data(), len) &&
+         memcmp(this->buffer_.data(), data, len) == 0;
+}
+
+bool LogPreferences::append_(uint32_t key, const uint8_t *data, size_t len, bool compacting) {
+  const size_t sector_size = this->flash_->get_sector_size();
+  const size_t size = record_size(len);
+  auto previous = this->index_.find(key);
+  const size_t previous_size = previous != this->index_.end() ? record_size(previous->second.len) : 0;
+  // Compaction can only make room while the values in use fit into all sectors but the reserved and the current one
+  const size_t capacity = sector_size - sizeof(SectorHeader);
+  if (!compacting &&
+      this->live_bytes_ - previous_size + size > (this->sequences_.size() - RESERVED_SECTORS - 1) * capacity) {
+    ESP_LOGE(TAG, "No space left for preferences");
+    return false;
+  }
+  if (this->write_offset_ + size > sector_size) {
+    if (!compacting) {
+      for (size_t i = 0; i < this->sequences_.size() && this->count_free_sectors_() <= RESERVED_SECTORS; i++) {
+        if (!this->compact_())
+          break;
+      }
+      if (this->count_free_sectors_() <= RESERVED_SECTORS) {
+        ESP_LOGE(TAG, "No space left for preferences");
+        return false;
+      }
+    }
+    if (!this->open_sector_())
+      return false;
+  }
+
+  RecordHeader header{key, uint16_t(len), record_crc(key, len, data)};
+  this->buffer_.assign(size, 0xFF);
+  memcpy(this->buffer_.data(), &header, sizeof(header));
+  memcpy(this->buffer_.data() + sizeof(header), data, len);
+  const size_t offset = this->head_ * sector_size + this->write_offset_;
+  if (!this->flash_->write(offset, this->buffer_.data(), size)) {
+    // Whatever made it into flash fails its CRC, continue in the next sector
+    this->write_offset_ = sector_size;
+    return false;
+  }
+  this->index_[key] = Location{uint32_t(offset + sizeof(header)), uint16_t(len)};
+  this->live_bytes_ += size - previous_size;
+  this->write_offset_ += size;
+  this->record_count_++;
+  return true;
+}
+
+bool LogPreferences::open_sector_() {
+  // Take the next free sector after the current one, so all sectors are erased equally often
+  const size_t sector_count = this->sequences_.size();
+  for (size_t i = 1; i <= sector_count; i++) {
+    const size_t sector = (this->head_ + i) % sector_count;
+    if (this->sequences_[sector] != 0)
+      continue;
+    this->erase_count_++;
+    SectorHeader header{this->sequence_ + 1, SECTOR_MAGIC};
+    if (!this->flash_->erase(sector) ||
+        !this->flash_->write(sector * this->flash_->get_sector_size(), &header, sizeof(header))) {
+      ESP_LOGW(TAG, "Could not prepare sector %u", (unsigned) sector);
+      continue;
+    }
+    this->sequence_ = header.sequence;
+    this->sequences_[sector] = header.sequence;
+    this->head_ = sector;
+    this->write_offset_ = sizeof(SectorHeader);
+    return true;
+  }
+  return false;
+}
+
+bool LogPreferences::compact_() {
+  const size_t sector_size = this->flash_->get_sector_size();
+
+  // Always the oldest sector, so every sector is erased equally often, even those holding values that never change
+  const size_t none = this->sequences_.size();
+  size_t victim = none;
+  for (size_t sector = 0; sector < this->sequences_.size(); sector++) {
+    if (this->sequences_[sector] != 0 && sector != this->head_ &&
+        (victim == none || this->sequences_[sector] < this->sequences_[victim]))
+      victim = sector;
+  }
+  if (victim == none)
+    return false;
+
+  std::vector<uint32_t> keys;
+  for (auto &it : this->index_) {
+    if (it.second.offset / sector_size == victim)
+      keys.push_back(it.first);
+  }
+  std::vector<uint8_t> data;
+  for (uint32_t key : keys) {
+    const Location location = this->index_[key];
+    data.resize(location.len);
+    if (!this->flash_->read(location.offset, data.data(), location.len) ||
+        !this->append_(key, data.data(), location.len, true))
+      return false;
+  }
+  // Not erased until it is reused, until then the copies are newer than the records it still holds
+  this->sequences_[victim] = 0;
+  ESP_LOGV(TAG, "Compacted sector %u, moved %u records", (unsigned) victim, (unsigned) keys.size());
+  return true;
+}
+
+size_t LogPreferences::count_free_sectors_() const {
+  return std::count(this->sequences_.begin(), this->sequences_.end(), 0);
+}
+
+LogPreferences *global_log_preferences = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace preferences
+}  // namespace esphome
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "esphome/core/preferences.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace esphome {
+namespace preferences {
+
+/// Raw storage for LogPreferences with the semantics of NOR flash: erasing sets all bytes of a sector to 0xFF and
+/// writes may only clear bits of erased bytes.
+class LogFlash {
+ public:
+  virtual size_t get_sector_size() const = 0;
+  virtual size_t get_sector_count() const = 0;
+  virtual bool read(size_t offset, void *data, size_t len) = 0;
+  virtual bool write(size_t offset, const void *data, size_t len) = 0;
+  virtual bool erase(size_t sector) = 0;
+};
+
+/** Preferences stored as an append-only log of records in raw flash.
+ *
+ * Each sector starts with a header holding a sequence number and contains records of a key, the length and a CRC
+ * followed by the value. A save only goes to RAM and replaces earlier unsynced saves of the same key, sync() then
+ * appends the values that differ from the stored ones. Sectors are filled in turn, which spreads the erases over the
+ * whole area. When only a few erased sectors are left, the records still in use are copied out of the oldest sector,
+ * one sector per sync(), so it can be reused.
+ *
+ * On setup the sectors are replayed from the oldest to the newest into an index of the newest record of every key.
+ * Records that were cut short by a reset fail their CRC and end the sector, an interrupted sync() therefore leaves
+ * every key with either its old or its new value.
+ */
+class LogPreferences : public ESPPreferences {
+ public:
+  explicit LogPreferences(LogFlash *flash) : flash_(flash) {}
+
+  /// Build the index from the records in flash, false if the flash can't be used. Called by the other methods if
+  /// needed, backends that aren't available at boot can delay it that way.
+  bool setup();
+
+  ESPPreferenceObject make_preference(size_t length, uint32_t type, bool in_flash) override;
+  ESPPreferenceObject make_preference(size_t length, uint32_t type) override {
+    return this->make_preference(length, type, true);
+  }
+  bool sync() override;
+  bool reset() override;
+
+  bool save(uint32_t key, const uint8_t *data, size_t len);
+  bool load(uint32_t key, uint8_t *data, size_t len);
+
+  /// Number of keys with a record in flash.
+  size_t get_key_count() const { return this->index_.size(); }
+  /// Number of sectors erased since setup, to observe the wear.
+  uint32_t get_erase_count() const { return this->erase_count_; }
+  /// Number of records written since setup.
+  uint32_t get_record_count() const { return this->record_count_; }
+
+ protected:
+  struct Location {
+    uint32_t offset;  ///< of the value in flash
+    uint16_t len;
+  };
+  struct Value {
+    std::vector<uint8_t> data;
+    bool dirty{false};  ///< not synced to flash yet
+  };
+
+  bool append_(uint32_t key, const uint8_t *data, size_t len, bool compacting);
+  bool open_sector_();
+  bool compact_();
+  size_t count_free_sectors_() const;
+  bool matches_stored_(uint32_t key, const uint8_t *data, size_t len);
+
+  LogFlash *flash_;
+  std::unordered_map<uint32_t, Location> index_;
+  /// Every value saved since boot, their buffers are reused by later saves.
+  std::unordered_map<uint32_t, Value> values_;
+  std::vector<uint8_t> buffer_;      ///< holds a record while it is written or compared
+  std::vector<uint32_t> sequences_;  ///< sequence number of every sector, 0 for a sector that is free
+  uint32_t sequence_{0};             ///< sequence number of the sector being written
+  size_t head_{0};                   ///< sector being written
+  size_t write_offset_{0};           ///< within head_, the sector size once it can't take more records
+  size_t live_bytes_{0};             ///< size of the newest record of every key
+  bool setup_complete_{false};
+  bool usable_{false};
+  bool is_reset_{false};
+  uint32_t erase_count_{0};
+  uint32_t record_count_{0};
+};
+
+/// The preferences if they are stored in a log, nullptr if the platform fell back to its default storage.
+extern LogPreferences *global_log_preferences;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace preferences
+}  // namespace esphome
@@ -0,0 +1,28 @@
+#include "syncer.h"
+#include "esphome/core/log.h"
+
+#include <cinttypes>
+
+#ifdef USE_PREFERENCES_LOG
+#include "log_preferences.h"
+#endif
+
+namespace esphome {
+namespace preferences {
+
+static const char *const TAG = "preferences";
+
+void IntervalSyncer::dump_config() {
+  ESP_LOGCONFIG(TAG, "Preferences:");
+  ESP_LOGCONFIG(TAG, "  Write Interval: %" PRIu32 "ms", this->write_interval_);
+#ifdef USE_PREFERENCES_LOG
+  if (global_log_preferences != nullptr) {
+    ESP_LOGCONFIG(TAG, "  Storage: log, %u keys", (unsigned) global_log_preferences->get_key_count());
+  } else {
+    ESP_LOGW(TAG, "  Storage: no usable partition labelled 'prefs', using the default storage");
+  }
+#endif
+}
+
+}  // namespace preferences
+}  // namespace esphome
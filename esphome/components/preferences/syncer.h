@@ -13,6 +13,7 @@ class IntervalSyncer : public Component {
     set_interval(write_interval_, []() { global_preferences->sync(); });
   }
   void on_shutdown() override { global_preferences->sync(); }
+  void dump_config() override;
   float get_setup_priority() const override { return setup_priority::BUS; }
 
  protected:
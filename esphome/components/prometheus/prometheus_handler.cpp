@@ -2,352 +2,361 @@
 #ifdef USE_NETWORK
 #include "esphome/core/application.h"
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
 namespace esphome {
 namespace prometheus {
 
-void PrometheusHandler::handleRequest(AsyncWebServerRequest *req) {
-  AsyncResponseStream *stream = req->beginResponseStream("text/plain; version=0.0.4; charset=utf-8");
+static const char *const TEXT_CONTENT_TYPE = "text/plain; version=0.0.4; charset=utf-8";
+static const char *const OPEN_METRICS_CONTENT_TYPE = "application/openmetrics-text; version=1.0.0; charset=utf-8";
 
+const PrometheusHandler::Metric PrometheusHandler::METRICS[] = {
 #ifdef USE_SENSOR
-  this->sensor_type_(stream);
-  for (auto *obj : App.get_sensors())
-    this->sensor_row_(stream, obj);
+    {"esphome_sensor_value", Kind::SENSOR, Field::VALUE, 1},
+    {"esphome_sensor_failed", Kind::SENSOR, Field::FAILED, 1},
 #endif
-
 #ifdef USE_BINARY_SENSOR
-  this->binary_sensor_type_(stream);
-  for (auto *obj : App.get_binary_sensors())
-    this->binary_sensor_row_(stream, obj);
+    {"esphome_binary_sensor_value", Kind::BINARY_SENSOR, Field::VALUE, 1},
+    {"esphome_binary_sensor_failed", Kind::BINARY_SENSOR, Field::FAILED, 1},
 #endif
-
 #ifdef USE_FAN
-  this->fan_type_(stream);
-  for (auto *obj : App.get_fans())
-    this->fan_row_(stream, obj);
+    {"esphome_fan_value", Kind::FAN, Field::VALUE, 1},
+    {"esphome_fan_failed", Kind::FAN, Field::FAILED, 1},
+    {"esphome_fan_speed", Kind::FAN, Field::SPEED, 1},
+    {"esphome_fan_oscillation", Kind::FAN, Field::OSCILLATION, 1},
 #endif
-
 #ifdef USE_LIGHT
-  this->light_type_(stream);
-  for (auto *obj : App.get_lights())
-    this->light_row_(stream, obj);
+    {"esphome_light_state", Kind::LIGHT, Field::STATE, 1},
+    {"esphome_light_color", Kind::LIGHT, Field::COLOR, 5},
+    {"esphome_light_effect_active", Kind::LIGHT, Field::EFFECT_ACTIVE, 1},
 #endif
-
 #ifdef USE_COVER
-  this->cover_type_(stream);
-  for (auto *obj : App.get_covers())
-    this->cover_row_(stream, obj);
+    {"esphome_cover_value", Kind::COVER, Field::VALUE, 1},
+    {"esphome_cover_failed", Kind::COVER, Field::FAILED, 1},
+    {"esphome_cover_tilt", Kind::COVER, Field::TILT, 1},
 #endif
-
 #ifdef USE_SWITCH
-  this->switch_type_(stream);
-  for (auto *obj : App.get_switches())
-    this->switch_row_(stream, obj);
+    {"esphome_switch_value", Kind::SWITCH, Field::VALUE, 1},
+    {"esphome_switch_failed", Kind::SWITCH, Field::FAILED, 1},
 #endif
-
 #ifdef USE_LOCK
-  this->lock_type_(stream);
-  for (auto *obj : App.get_locks())
-    this->lock_row_(stream, obj);
+    {"esphome_lock_value", Kind::LOCK, Field::VALUE, 1},
+    {"esphome_lock_failed", Kind::LOCK, Field::FAILED, 1},
 #endif
+    {nullptr, Kind::SENSOR, Field::VALUE, 0},
+};
 
-  req->send(stream);
+/// Append a label value with backslashes, quotes and line feeds escaped.
+static void append_label_value(std::string &out, StringRef value) {
+  for (char c : value) {
+    if (c == '\\' || c == '"') {
+      out += '\\';
+      out += c;
+    } else if (c == '\n') {
+      out += "\\n";
+    } else {
+      out += c;
+    }
+  }
 }
 
-std::string PrometheusHandler::relabel_id_(EntityBase *obj) {
-  auto item = relabel_map_id_.find(obj);
-  return item == relabel_map_id_.end() ? obj->get_object_id() : item->second;
+static void append_label(std::string &out, const char *name, StringRef value) {
+  out += ',';
+  out += name;
+  out += "=\"";
+  append_label_value(out, value);
+  out += '"';
 }
 
-std::string PrometheusHandler::relabel_name_(EntityBase *obj) {
-  auto item = relabel_map_name_.find(obj);
-  return item == relabel_map_name_.end() ? obj->get_name() : item->second;
+/// Close the labels and append the value.
+static bool append_value(std::string &out, float value, int8_t accuracy_decimals = 2) {
+  char buf[32];
+  out += "} ";
+  out.append(buf, value_accuracy_to_buf(buf, sizeof(buf), value, accuracy_decimals));
+  return true;
 }
 
-// Type-specific implementation
-#ifdef USE_SENSOR
-void PrometheusHandler::sensor_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_sensor_value gauge\n"));
-  stream->print(F("#TYPE esphome_sensor_failed gauge\n"));
+static bool append_value(std::string &out, uint32_t value) {
+  char buf[10];
+  char *end = buf + sizeof(buf);
+  char *pos = end;
+  do {
+    *--pos = char('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  out += "} ";
+  out.append(pos, end - pos);
+  return true;
 }
-void PrometheusHandler::sensor_row_(AsyncResponseStream *stream, sensor::Sensor *obj) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
-  if (!std::isnan(obj->state)) {
-    // We have a valid value, output this value
-    stream->print(F("esphome_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
-    // Data itself
-    stream->print(F("esphome_sensor_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",unit=\""));
-    stream->print(obj->get_unit_of_measurement().c_str());
-    stream->print(F("\"} "));
-    stream->print(value_accuracy_to_string(obj->state, obj->get_accuracy_decimals()).c_str());
-    stream->print(F("\n"));
-  } else {
-    // Invalid state
-    stream->print(F("esphome_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
-  }
+
+void PrometheusHandler::setup() {
+  this->build_targets_();
+  this->base_->init();
+  this->base_->add_handler(this);
 }
+
+void PrometheusHandler::handleRequest(AsyncWebServerRequest *req) {
+  bool open_metrics = false;
+#ifdef USE_ARDUINO
+  if (req->hasHeader("Accept"))
+    open_metrics = req->getHeader("Accept")->value().indexOf("application/openmetrics-text") >= 0;
+#else
+  auto accept = req->get_header("Accept");
+  open_metrics = accept.has_value() && accept->find("application/openmetrics-text") != std::string::npos;
 #endif
+  const char *content_type = open_metrics ? OPEN_METRICS_CONTENT_TYPE : TEXT_CONTENT_TYPE;
 
-// Type-specific implementation
-#ifdef USE_BINARY_SENSOR
-void PrometheusHandler::binary_sensor_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_binary_sensor_value gauge\n"));
-  stream->print(F("#TYPE esphome_binary_sensor_failed gauge\n"));
-}
-void PrometheusHandler::binary_sensor_row_(AsyncResponseStream *stream, binary_sensor::BinarySensor *obj) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
-  if (obj->has_state()) {
-    // We have a valid value, output this value
-    stream->print(F("esphome_binary_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
-    // Data itself
-    stream->print(F("esphome_binary_sensor_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->state);
-    stream->print(F("\n"));
-  } else {
-    // Invalid state
-    stream->print(F("esphome_binary_sensor_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+#ifdef USE_ARDUINO
+  // The lines are rendered while the response is sent, so it never has to hold the whole exposition
+  auto scrape = std::make_shared<Scrape>();
+  scrape->open_metrics = open_metrics;
+  req->send(req->beginChunkedResponse(content_type, [this, scrape](uint8_t *buf, size_t max_len, size_t /*index*/) {
+    return this->fill_(*scrape, buf, max_len);
+  }));
+#else
+  // The IDF web server sends a response in one piece
+  Scrape scrape;
+  scrape.open_metrics = open_metrics;
+  AsyncResponseStream *stream = req->beginResponseStream(content_type);
+  char buf[256];
+  size_t len;
+  while ((len = this->fill_(scrape, reinterpret_cast<uint8_t *>(buf), sizeof(buf) - 1)) != 0) {
+    buf[len] = '\0';
+    stream->print(buf);
   }
-}
+  req->send(stream);
 #endif
+}
 
+void PrometheusHandler::build_targets_() {
+  for (size_t kind = 0; kind < KIND_COUNT; kind++) {
+    this->kind_start_[kind] = this->targets_.size();
+    switch (static_cast<Kind>(kind)) {
+#ifdef USE_SENSOR
+      case Kind::SENSOR:
+        for (auto *obj : App.get_sensors())
+          this->add_target_(obj);
+        break;
+#endif
+#ifdef USE_BINARY_SENSOR
+      case Kind::BINARY_SENSOR:
+        for (auto *obj : App.get_binary_sensors())
+          this->add_target_(obj);
+        break;
+#endif
 #ifdef USE_FAN
-void PrometheusHandler::fan_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_fan_value gauge\n"));
-  stream->print(F("#TYPE esphome_fan_failed gauge\n"));
-  stream->print(F("#TYPE esphome_fan_speed gauge\n"));
-  stream->print(F("#TYPE esphome_fan_oscillation gauge\n"));
-}
-void PrometheusHandler::fan_row_(AsyncResponseStream *stream, fan::Fan *obj) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
-  stream->print(F("esphome_fan_failed{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} 0\n"));
-  // Data itself
-  stream->print(F("esphome_fan_value{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->state);
-  stream->print(F("\n"));
-  // Speed if available
-  if (obj->get_traits().supports_speed()) {
-    stream->print(F("esphome_fan_speed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->speed);
-    stream->print(F("\n"));
-  }
-  // Oscillation if available
-  if (obj->get_traits().supports_oscillation()) {
-    stream->print(F("esphome_fan_oscillation{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->oscillating);
-    stream->print(F("\n"));
-  }
-}
+      case Kind::FAN:
+        for (auto *obj : App.get_fans())
+          this->add_target_(obj);
+        break;
 #endif
-
 #ifdef USE_LIGHT
-void PrometheusHandler::light_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_light_state gauge\n"));
-  stream->print(F("#TYPE esphome_light_color gauge\n"));
-  stream->print(F("#TYPE esphome_light_effect_active gauge\n"));
+      case Kind::LIGHT:
+        for (auto *obj : App.get_lights())
+          this->add_target_(obj);
+        break;
+#endif
+#ifdef USE_COVER
+      case Kind::COVER:
+        for (auto *obj : App.get_covers())
+          this->add_target_(obj);
+        break;
+#endif
+#ifdef USE_SWITCH
+      case Kind::SWITCH:
+        for (auto *obj : App.get_switches())
+          this->add_target_(obj);
+        break;
+#endif
+#ifdef USE_LOCK
+      case Kind::LOCK:
+        for (auto *obj : App.get_locks())
+          this->add_target_(obj);
+        break;
+#endif
+      default:
+        break;
+    }
+  }
+  this->kind_start_[KIND_COUNT] = this->targets_.size();
+  this->labels_.shrink_to_fit();
+  // The labels are rendered, the relabeling isn't needed anymore
+  this->relabel_map_id_.clear();
+  this->relabel_map_name_.clear();
 }
-void PrometheusHandler::light_row_(AsyncResponseStream *stream, light::LightState *obj) {
+
+void PrometheusHandler::add_target_(EntityBase *obj) {
   if (obj->is_internal() && !this->include_internal_)
     return;
-  // State
-  stream->print(F("esphome_light_state{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->remote_values.is_on());
-  stream->print(F("\n"));
-  // Brightness and RGBW
-  light::LightColorValues color = obj->current_values;
-  float brightness, r, g, b, w;
-  color.as_brightness(&brightness);
-  color.as_rgbw(&r, &g, &b, &w);
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"brightness\"} "));
-  stream->print(brightness);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"r\"} "));
-  stream->print(r);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"g\"} "));
-  stream->print(g);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"b\"} "));
-  stream->print(b);
-  stream->print(F("\n"));
-  stream->print(F("esphome_light_color{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\",channel=\"w\"} "));
-  stream->print(w);
-  stream->print(F("\n"));
-  // Effect
-  std::string effect = obj->get_effect_name();
-  if (effect == "None") {
-    stream->print(F("esphome_light_effect_active{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",effect=\"None\"} 0\n"));
-  } else {
-    stream->print(F("esphome_light_effect_active{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\",effect=\""));
-    stream->print(effect.c_str());
-    stream->print(F("\"} 1\n"));
-  }
+  const size_t offset = this->labels_.size();
+  this->labels_ += "id=\"";
+  append_label_value(this->labels_, this->relabel_id_(obj));
+  this->labels_ += '"';
+  append_label(this->labels_, "name", this->relabel_name_(obj));
+  this->targets_.push_back(Target{obj, uint32_t(offset), uint16_t(this->labels_.size() - offset)});
 }
-#endif
 
-#ifdef USE_COVER
-void PrometheusHandler::cover_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_cover_value gauge\n"));
-  stream->print(F("#TYPE esphome_cover_failed gauge\n"));
+size_t PrometheusHandler::fill_(Scrape &scrape, uint8_t *buf, size_t max_len) {
+  size_t len = 0;
+  while (len < max_len) {
+    if (scrape.line_offset == scrape.line.size()) {
+      if (!this->next_line_(scrape))
+        break;
+    }
+    const size_t chunk = std::min(max_len - len, scrape.line.size() - scrape.line_offset);
+    memcpy(buf + len, scrape.line.data() + scrape.line_offset, chunk);
+    scrape.line_offset += chunk;
+    len += chunk;
+  }
+  return len;
 }
-void PrometheusHandler::cover_row_(AsyncResponseStream *stream, cover::Cover *obj) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
-  if (!std::isnan(obj->position)) {
-    // We have a valid value, output this value
-    stream->print(F("esphome_cover_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 0\n"));
-    // Data itself
-    stream->print(F("esphome_cover_value{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} "));
-    stream->print(obj->position);
-    stream->print(F("\n"));
-    if (obj->get_traits().get_supports_tilt()) {
-      stream->print(F("esphome_cover_tilt{id=\""));
-      stream->print(relabel_id_(obj).c_str());
-      stream->print(F("\",name=\""));
-      stream->print(relabel_name_(obj).c_str());
-      stream->print(F("\"} "));
-      stream->print(obj->tilt);
-      stream->print(F("\n"));
+
+bool PrometheusHandler::next_line_(Scrape &scrape) {
+  scrape.line.clear();
+  scrape.line_offset = 0;
+  while (!scrape.done) {
+    const Metric &metric = METRICS[scrape.metric];
+    if (metric.name == nullptr) {
+      scrape.done = true;
+      if (!scrape.open_metrics)
+        return false;
+      scrape.line += "# EOF\n";
+      return true;
+    }
+    const size_t kind = static_cast<size_t>(metric.kind);
+    if (!scrape.type_written) {
+      // All samples of a metric follow its TYPE line
+      scrape.type_written = true;
+      scrape.target = this->kind_start_[kind];
+      scrape.sample = 0;
+      scrape.line += "# TYPE ";
+      scrape.line += metric.name;
+      scrape.line += " gauge\n";
+      return true;
+    }
+    if (scrape.target >= this->kind_start_[kind + 1]) {
+      scrape.metric++;
+      scrape.type_written = false;
+      continue;
+    }
+
+    const Target &target = this->targets_[scrape.target];
+    const uint8_t sample = scrape.sample;
+    if (++scrape.sample == metric.samples) {
+      scrape.sample = 0;
+      scrape.target++;
+    }
+    scrape.line += metric.name;
+    scrape.line += '{';
+    scrape.line.append(this->labels_, target.labels_offset, target.labels_len);
+    if (this->write_value_(scrape.line, metric, target.obj, sample)) {
+      scrape.line += '\n';
+      return true;
     }
-  } else {
-    // Invalid state
-    stream->print(F("esphome_cover_failed{id=\""));
-    stream->print(relabel_id_(obj).c_str());
-    stream->print(F("\",name=\""));
-    stream->print(relabel_name_(obj).c_str());
-    stream->print(F("\"} 1\n"));
+    scrape.line.clear();
   }
+  return false;
 }
-#endif
 
+bool PrometheusHandler::write_value_(std::string &line, const Metric &metric, EntityBase *entity, uint8_t sample) {
+  switch (metric.kind) {
+#ifdef USE_SENSOR
+    case Kind::SENSOR: {
+      auto *obj = static_cast<sensor::Sensor *>(entity);
+      if (metric.field == Field::FAILED)
+        return append_value(line, uint32_t(std::isnan(obj->state)));
+      if (std::isnan(obj->state))
+        return false;
+      append_label(line, "unit", obj->get_unit_of_measurement_ref());
+      return append_value(line, obj->state, obj->get_accuracy_decimals());
+    }
+#endif
+#ifdef USE_BINARY_SENSOR
+    case Kind::BINARY_SENSOR: {
+      auto *obj = static_cast<binary_sensor::BinarySensor *>(entity);
+      if (metric.field == Field::FAILED)
+        return append_value(line, uint32_t(!obj->has_state()));
+      return obj->has_state() && append_value(line, uint32_t(obj->state));
+    }
+#endif
+#ifdef USE_FAN
+    case Kind::FAN: {
+      auto *obj = static_cast<fan::Fan *>(entity);
+      switch (metric.field) {
+        case Field::FAILED:
+          return append_value(line, uint32_t(0));
+        case Field::SPEED:
+          return obj->get_traits().supports_speed() && append_value(line, uint32_t(obj->speed));
+        case Field::OSCILLATION:
+          return obj->get_traits().supports_oscillation() && append_value(line, uint32_t(obj->oscillating));
+        default:
+          return append_value(line, uint32_t(obj->state));
+      }
+    }
+#endif
+#ifdef USE_LIGHT
+    case Kind::LIGHT: {
+      auto *obj = static_cast<light::LightState *>(entity);
+      if (metric.field == Field::STATE)
+        return append_value(line, uint32_t(obj->remote_values.is_on()));
+      if (metric.field == Field::EFFECT_ACTIVE) {
+        const StringRef effect = obj->get_effect_name_ref();
+        append_label(line, "effect", effect);
+        return append_value(line, uint32_t(effect != "None"));
+      }
+      // Brightness and RGBW
+      static const char *const CHANNELS[] = {"brightness", "r", "g", "b", "w"};
+      float values[5];
+      obj->current_values.as_brightness(&values[0]);
+      obj->current_values.as_rgbw(&values[1], &values[2], &values[3], &values[4]);
+      append_label(line, "channel", StringRef(CHANNELS[sample]));
+      return append_value(line, values[sample]);
+    }
+#endif
+#ifdef USE_COVER
+    case Kind::COVER: {
+      auto *obj = static_cast<cover::Cover *>(entity);
+      if (metric.field == Field::FAILED)
+        return append_value(line, uint32_t(std::isnan(obj->position)));
+      if (std::isnan(obj->position))
+        return false;
+      if (metric.field == Field::TILT)
+        return obj->get_traits().get_supports_tilt() && append_value(line, obj->tilt);
+      return append_value(line, obj->position);
+    }
+#endif
 #ifdef USE_SWITCH
-void PrometheusHandler::switch_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_switch_value gauge\n"));
-  stream->print(F("#TYPE esphome_switch_failed gauge\n"));
-}
-void PrometheusHandler::switch_row_(AsyncResponseStream *stream, switch_::Switch *obj) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
-  stream->print(F("esphome_switch_failed{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} 0\n"));
-  // Data itself
-  stream->print(F("esphome_switch_value{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->state);
-  stream->print(F("\n"));
-}
+    case Kind::SWITCH: {
+      auto *obj = static_cast<switch_::Switch *>(entity);
+      if (metric.field == Field::FAILED)
+        return append_value(line, uint32_t(0));
+      return append_value(line, uint32_t(obj->state));
+    }
 #endif
-
 #ifdef USE_LOCK
-void PrometheusHandler::lock_type_(AsyncResponseStream *stream) {
-  stream->print(F("#TYPE esphome_lock_value gauge\n"));
-  stream->print(F("#TYPE esphome_lock_failed gauge\n"));
+    case Kind::LOCK: {
+      auto *obj = static_cast<lock::Lock *>(entity);
+      if (metric.field == Field::FAILED)
+        return append_value(line, uint32_t(0));
+      return append_value(line, uint32_t(obj->state));
+    }
+#endif
+    default:
+      return false;
+  }
 }
-void PrometheusHandler::lock_row_(AsyncResponseStream *stream, lock::Lock *obj) {
-  if (obj->is_internal() && !this->include_internal_)
-    return;
-  stream->print(F("esphome_lock_failed{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} 0\n"));
-  // Data itself
-  stream->print(F("esphome_lock_value{id=\""));
-  stream->print(relabel_id_(obj).c_str());
-  stream->print(F("\",name=\""));
-  stream->print(relabel_name_(obj).c_str());
-  stream->print(F("\"} "));
-  stream->print(obj->state);
-  stream->print(F("\n"));
+
+StringRef PrometheusHandler::relabel_id_(EntityBase *obj) {
+  auto item = relabel_map_id_.find(obj);
+  return item == relabel_map_id_.end() ? obj->get_object_id_ref() : StringRef(item->second);
+}
+
+StringRef PrometheusHandler::relabel_name_(EntityBase *obj) {
+  auto item = relabel_map_name_.find(obj);
+  return item == relabel_map_name_.end() ? obj->get_name() : StringRef(item->second);
 }
-#endif
 
 }  // namespace prometheus
 }  // namespace esphome
@@ -1,8 +1,11 @@
 #pragma once
 #include "esphome/core/defines.h"
 #ifdef USE_NETWORK
+#include <array>
 #include <map>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "esphome/components/web_server_base/web_server_base.h"
 #include "esphome/core/component.h"
@@ -23,14 +26,14 @@ class PrometheusHandler : public AsyncWebHandler, public Component {
    */
   void set_include_internal(bool include_internal) { include_internal_ = include_internal; }
 
-  /** Add the value for an entity's "id" label.
+  /** Add the value for an entity's "id" label. The labels are rendered in setup(), later calls have no effect.
    *
    * @param obj The entity for which to set the "id" label
    * @param value The value for the "id" label
    */
   void add_label_id(EntityBase *obj, const std::string &value) { relabel_map_id_.insert({obj, value}); }
 
-  /** Add the value for an entity's "name" label.
+  /** Add the value for an entity's "name" label. The labels are rendered in setup(), later calls have no effect.
    *
    * @param obj The entity for which to set the "name" label
    * @param value The value for the "name" label
@@ -39,8 +42,13 @@ class PrometheusHandler : public AsyncWebHandler, public Component {
 
   bool canHandle(AsyncWebServerRequest *request) override {
     if (request->method() == HTTP_GET) {
-      if (request->url() == "/metrics")
+      if (request->url() == "/metrics") {
+#ifdef USE_ARDUINO
+        // Keep it to negotiate the exposition format
+        request->addInterestingHeader("Accept");
+#endif
         return true;
+      }
     }
 
     return false;
@@ -48,72 +56,87 @@ class PrometheusHandler : public AsyncWebHandler, public Component {
 
   void handleRequest(AsyncWebServerRequest *req) override;
 
-  void setup() override {
-    this->base_->init();
-    this->base_->add_handler(this);
-  }
+  void setup() override;
   float get_setup_priority() const override {
     // After WiFi
     return setup_priority::WIFI - 1.0f;
   }
 
  protected:
-  std::string relabel_id_(EntityBase *obj);
-  std::string relabel_name_(EntityBase *obj);
-
-#ifdef USE_SENSOR
-  /// Return the type for prometheus
-  void sensor_type_(AsyncResponseStream *stream);
-  /// Return the sensor state as prometheus data point
-  void sensor_row_(AsyncResponseStream *stream, sensor::Sensor *obj);
-#endif
-
-#ifdef USE_BINARY_SENSOR
-  /// Return the type for prometheus
-  void binary_sensor_type_(AsyncResponseStream *stream);
-  /// Return the sensor state as prometheus data point
-  void binary_sensor_row_(AsyncResponseStream *stream, binary_sensor::BinarySensor *obj);
-#endif
-
-#ifdef USE_FAN
-  /// Return the type for prometheus
-  void fan_type_(AsyncResponseStream *stream);
-  /// Return the sensor state as prometheus data point
-  void fan_row_(AsyncResponseStream *stream, fan::Fan *obj);
-#endif
-
-#ifdef USE_LIGHT
-  /// Return the type for prometheus
-  void light_type_(AsyncResponseStream *stream);
-  /// Return the Light Values state as prometheus data point
-  void light_row_(AsyncResponseStream *stream, light::LightState *obj);
-#endif
-
-#ifdef USE_COVER
-  /// Return the type for prometheus
-  void cover_type_(AsyncResponseStream *stream);
-  /// Return the switch Values state as prometheus data point
-  void cover_row_(AsyncResponseStream *stream, cover::Cover *obj);
-#endif
-
-#ifdef USE_SWITCH
-  /// Return the type for prometheus
-  void switch_type_(AsyncResponseStream *stream);
-  /// Return the switch Values state as prometheus data point
-  void switch_row_(AsyncResponseStream *stream, switch_::Switch *obj);
-#endif
-
-#ifdef USE_LOCK
-  /// Return the type for prometheus
-  void lock_type_(AsyncResponseStream *stream);
-  /// Return the lock Values state as prometheus data point
-  void lock_row_(AsyncResponseStream *stream, lock::Lock *obj);
-#endif
+  /// The entity types with metrics, the samples of one type are written one metric after the other.
+  enum class Kind : uint8_t {
+    SENSOR,
+    BINARY_SENSOR,
+    FAN,
+    LIGHT,
+    COVER,
+    SWITCH,
+    LOCK,
+  };
+  static constexpr size_t KIND_COUNT = 7;
+  /// The value of an entity a metric exports.
+  enum class Field : uint8_t {
+    VALUE,
+    FAILED,
+    SPEED,
+    OSCILLATION,
+    STATE,
+    COLOR,
+    EFFECT_ACTIVE,
+    TILT,
+  };
+  /// One metric family of the exposition.
+  struct Metric {
+    const char *name;
+    Kind kind;
+    Field field;
+    uint8_t samples;  ///< per entity, more than one for the light color channels
+  };
+  /// The metrics of all entity types in the order they are written, terminated by an entry without a name.
+  static const Metric METRICS[];
+
+  /// An exported entity with its `id` and `name` labels rendered once at setup.
+  struct Target {
+    EntityBase *obj;
+    uint32_t labels_offset;  ///< into labels_
+    uint16_t labels_len;
+  };
+  /// Position of a running scrape, a response may be filled over several calls.
+  struct Scrape {
+    size_t metric{0};  ///< into METRICS
+    bool type_written{false};
+    size_t target{0};   ///< into targets_
+    uint8_t sample{0};  ///< of the current target
+    bool open_metrics{false};
+    bool done{false};
+    std::string line;       ///< reused for every line, only the first lines of a scrape allocate
+    size_t line_offset{0};  ///< start of the part of line that was not copied out yet
+  };
+
+  /// Collect the exported entities and render their labels.
+  void build_targets_();
+  void add_target_(EntityBase *obj);
+  /// Copy the next part of the exposition to buf, returns the number of bytes and 0 once everything was written.
+  size_t fill_(Scrape &scrape, uint8_t *buf, size_t max_len);
+  /// Render the next line of the exposition to scrape.line, false at the end.
+  bool next_line_(Scrape &scrape);
+  /// Append the labels specific to the sample and the value, false if the entity has no such sample right now.
+  bool write_value_(std::string &line, const Metric &metric, EntityBase *obj, uint8_t sample);
+
+  /// Return the sanitized name for this Entity, or the relabeled one if set
+  StringRef relabel_id_(EntityBase *obj);
+  /// Return the name for this Entity, or the relabeled one if set
+  StringRef relabel_name_(EntityBase *obj);
 
   web_server_base::WebServerBase *base_;
   bool include_internal_{false};
   std::map<EntityBase *, std::string> relabel_map_id_;
   std::map<EntityBase *, std::string> relabel_map_name_;
+  /// Exported entities sorted by kind, the entities of METRICS[i] start at kind_start_[METRICS[i].kind].
+  std::vector<Target> targets_;
+  std::array<uint16_t, KIND_COUNT + 1> kind_start_{};
+  /// `id="...",name="..."` of all targets back to back.
+  std::string labels_;
 };
 
 }  // namespace prometheus
@@ -0,0 +1,41 @@
+#include "pulse_capture.h"
+
+namespace esphome {
+namespace pulse_capture {
+
+void IRAM_ATTR PulseSampleSlot::write(uint32_t time_us, uint32_t pulses, uint32_t high_us) {
+  const uint32_t sequence = this->sequence_.load(std::memory_order_relaxed);
+  this->sequence_.store(sequence + 1, std::memory_order_relaxed);
+  // The odd sequence is visible before any of the fields change
+  std::atomic_thread_fence(std::memory_order_release);
+  this->time_us_.store(time_us, std::memory_order_relaxed);
+  this->pulses_.store(pulses, std::memory_order_relaxed);
+  this->high_us_.store(high_us, std::memory_order_relaxed);
+  this->sequence_.store(sequence + 2, std::memory_order_release);
+}
+
+PulseSample PulseSampleSlot::read() const {
+  PulseSample sample;
+  uint32_t sequence;
+  do {
+    sequence = this->sequence_.load(std::memory_order_acquire);
+    sample.time_us = this->time_us_.load(std::memory_order_relaxed);
+    sample.pulses = this->pulses_.load(std::memory_order_relaxed);
+    sample.high_us = this->high_us_.load(std::memory_order_relaxed);
+    // The fields are read before the sequence is checked again
+    std::atomic_thread_fence(std::memory_order_acquire);
+  } while ((sequence & 1) != 0 || sequence != this->sequence_.load(std::memory_order_relaxed));
+  return sample;
+}
+
+PulseWindow PulseAnalyzer::update(const PulseSample &sample) {
+  // The counters start at zero, so the first window holds every pulse since boot
+  PulseWindow window;
+  window.pulses = sample.pulses - this->last_.pulses;
+  window.high_us = sample.high_us - this->last_.high_us;
+  this->last_ = sample;
+  return window;
+}
+
+}  // namespace pulse_capture
+}  // namespace esphome
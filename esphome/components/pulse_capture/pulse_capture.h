@@ -0,0 +1,64 @@
+#pragma once
+
+#include "esphome/core/hal.h"
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+namespace esphome {
+namespace pulse_capture {
+
+/** Cumulative counters of a pulse input at the time of an edge.
+ *
+ * The difference of two samples gives the pulses and the high time between two edges, so rates computed from them do
+ * not depend on when the main loop happens to look at the input, and skipped samples lose no pulses.
+ */
+struct PulseSample {
+  uint32_t time_us{0};  ///< micros() at the edge
+  uint32_t pulses{0};   ///< pulses counted up to and including this edge
+  uint32_t high_us{0};  ///< total time the input was high up to this edge, 0 if not measured
+};
+
+/** Hands the newest PulseSample from an interrupt handler to the main loop without locking.
+ *
+ * The interrupt handler is the only writer and never waits. The main loop retries reading while a write is in
+ * progress, which can only happen when the two run on different cores. The sequence is released by the writer and
+ * acquired by the reader, so the fields read between two equal even sequence values belong to the same write. Only
+ * loads and stores are used, no read-modify-write, which single core chips without atomic instructions lack.
+ */
+class PulseSampleSlot {
+ public:
+  /// Publish a sample, only call this from the interrupt handler.
+  void write(uint32_t time_us, uint32_t pulses, uint32_t high_us);
+  /// Read the newest sample, only call this from the main loop.
+  PulseSample read() const;
+
+ protected:
+  std::atomic<uint32_t> sequence_{0};  ///< odd while a write is in progress
+  std::atomic<uint32_t> time_us_{0};
+  std::atomic<uint32_t> pulses_{0};
+  std::atomic<uint32_t> high_us_{0};
+};
+
+/// Pulses and high time between two samples.
+struct PulseWindow {
+  uint32_t pulses{0};
+  uint32_t high_us{0};
+
+  /// Mean time a pulse was high in µs, NAN without pulses.
+  float get_mean_high_us() const { return this->pulses == 0 ? NAN : float(this->high_us) / this->pulses; }
+};
+
+/// Turns consecutive samples into windows, decimating the pulses in between to one result.
+class PulseAnalyzer {
+ public:
+  /// The window since the sample passed to the previous call, or since boot on the first call.
+  PulseWindow update(const PulseSample &sample);
+
+ protected:
+  PulseSample last_{};
+};
+
+}  // namespace pulse_capture
+}  // namespace esphome
@@ -34,34 +34,32 @@ void PulseMeterSensor::setup() {
 void PulseMeterSensor::loop() {
   const uint32_t now = micros();
 
-  // Reset the count in get before we pass it back to the ISR as set
-  this->get_->count_ = 0;
-
-  // Swap out set and get to get the latest state from the ISR
-  // The ISR could interrupt on any of these lines and the results would be consistent
-  auto *temp = this->set_;
-  this->set_ = this->get_;
-  this->get_ = temp;
+  // Edges detected by the ISR since the last loop
+  const pulse_capture::PulseSample sample = this->samples_.read();
+  uint32_t count = sample.pulses - this->last_pulses_;
+  uint32_t detected_edge_us = sample.time_us;
+  this->last_pulses_ = sample.pulses;
 
   // If an edge was peeked, repay the debt
-  if (this->peeked_edge_ && this->get_->count_ > 0) {
+  if (this->peeked_edge_ && count > 0) {
     this->peeked_edge_ = false;
-    this->get_->count_--;
+    count--;
   }
 
   // If there is an unprocessed edge, and filter_us_ has passed since, count this edge early
-  if (this->get_->last_rising_edge_us_ != this->get_->last_detected_edge_us_ &&
-      now - this->get_->last_rising_edge_us_ >= this->filter_us_) {
+  const uint32_t rising_edge_us = this->last_rising_edge_us_;
+  if (!this->peeked_edge_ && rising_edge_us != detected_edge_us && rising_edge_us != this->last_processed_edge_us_ &&
+      now - rising_edge_us >= this->filter_us_) {
     this->peeked_edge_ = true;
-    this->get_->last_detected_edge_us_ = this->get_->last_rising_edge_us_;
-    this->get_->count_++;
+    detected_edge_us = rising_edge_us;
+    count++;
   }
 
   // Check if we detected a pulse this loop
-  if (this->get_->count_ > 0) {
+  if (count > 0) {
     // Keep a running total of pulses if a total sensor is configured
     if (this->total_sensor_ != nullptr) {
-      this->total_pulses_ += this->get_->count_;
+      this->total_pulses_ += count;
       const uint32_t total = this->total_pulses_;
       this->total_sensor_->publish_state(total);
     }
@@ -73,13 +71,13 @@ void PulseMeterSensor::loop() {
         this->meter_state_ = MeterState::RUNNING;
       } break;
       case MeterState::RUNNING: {
-        uint32_t delta_us = this->get_->last_detected_edge_us_ - this->last_processed_edge_us_;
-        float pulse_width_us = delta_us / float(this->get_->count_);
+        uint32_t delta_us = detected_edge_us - this->last_processed_edge_us_;
+        float pulse_width_us = delta_us / float(count);
         this->publish_state((60.0f * 1000000.0f) / pulse_width_us);
       } break;
     }
 
-    this->last_processed_edge_us_ = this->get_->last_detected_edge_us_;
+    this->last_processed_edge_us_ = detected_edge_us;
   }
   // No detected edges this loop
   else {
@@ -121,13 +119,13 @@ void IRAM_ATTR PulseMeterSensor::edge_intr(PulseMeterSensor *sensor) {
   // Get the current time before we do anything else so the measurements are consistent
   const uint32_t now = micros();
   auto &state = sensor->edge_state_;
-  auto &set = *sensor->set_;
 
   if ((now - state.last_sent_edge_us_) >= sensor->filter_us_) {
     state.last_sent_edge_us_ = now;
-    set.last_detected_edge_us_ = now;
-    set.last_rising_edge_us_ = now;
-    set.count_++;
+    sensor->last_detected_edge_us_ = now;
+    sensor->last_rising_edge_us_ = now;
+    sensor->pulses_++;
+    sensor->samples_.write(now, sensor->pulses_, 0);
   }
 }
 
@@ -137,7 +135,6 @@ void IRAM_ATTR PulseMeterSensor::pulse_intr(PulseMeterSensor *sensor) {
   const uint32_t now = micros();
   const bool pin_val = sensor->isr_pin_.digital_read();
   auto &state = sensor->pulse_state_;
-  auto &set = *sensor->set_;
 
   // Filter length has passed since the last interrupt
   const bool length = now - state.last_intr_ >= sensor->filter_us_;
@@ -146,14 +143,15 @@ void IRAM_ATTR PulseMeterSensor::pulse_intr(PulseMeterSensor *sensor) {
     state.latched_ = false;
   } else if (length && !state.latched_ && state.last_pin_val_) {  // Long enough high edge
     state.latched_ = true;
-    set.last_detected_edge_us_ = state.last_intr_;
-    set.count_++;
+    sensor->last_detected_edge_us_ = state.last_intr_;
+    sensor->pulses_++;
+    sensor->samples_.write(state.last_intr_, sensor->pulses_, 0);
   }
 
   // Due to order of operations this includes
   //    length && latched && rising   (just reset from a long low edge)
   //    !latched && (rising || high)  (noise on the line resetting the potential rising edge)
-  set.last_rising_edge_us_ = !state.latched_ && pin_val ? now : set.last_detected_edge_us_;
+  sensor->last_rising_edge_us_ = !state.latched_ && pin_val ? now : sensor->last_detected_edge_us_;
 
   state.last_intr_ = now;
   state.last_pin_val_ = pin_val;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "esphome/components/pulse_capture/pulse_capture.h"
 #include "esphome/components/sensor/sensor.h"
 #include "esphome/core/component.h"
 #include "esphome/core/hal.h"
@@ -46,23 +47,17 @@ class PulseMeterSensor : public sensor::Sensor, public Component {
   bool peeked_edge_ = false;
   uint32_t total_pulses_ = 0;
   uint32_t last_processed_edge_us_ = 0;
+  uint32_t last_pulses_ = 0;
 
-  // This struct (and the two pointers) are used to pass data between the ISR and loop.
-  // These two pointers are exchanged each loop.
-  // Therefore you can't use data in the pointer to loop receives to set values in the pointer to loop sends.
-  // As a result it's easiest if you only use these pointers to send data from the ISR to the loop.
-  // (except for resetting the values)
-  struct State {
-    uint32_t last_detected_edge_us_ = 0;
-    uint32_t last_rising_edge_us_ = 0;
-    uint32_t count_ = 0;
-  };
-  State state_[2];
-  volatile State *set_ = state_;
-  volatile State *get_ = state_ + 1;
+  // Passes the time of the last detected edge and the number of detected edges from the ISR to the loop
+  pulse_capture::PulseSampleSlot samples_;
+  // Start of a pulse that may be detected once it lasted filter_us_, equal to the last detected edge otherwise
+  volatile uint32_t last_rising_edge_us_ = 0;
 
   // Only use these variables in the ISR
   ISRInternalGPIOPin isr_pin_;
+  uint32_t pulses_ = 0;
+  uint32_t last_detected_edge_us_ = 0;
 
   /// Filter state for edge mode
   struct EdgeState {
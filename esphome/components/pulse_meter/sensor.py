@@ -20,6 +20,7 @@ from esphome.const import (
 from esphome.core import CORE
 
 CODEOWNERS = ["@stevebaxter", "@cstaahl", "@TrentHouliston"]
+AUTO_LOAD = ["pulse_capture"]
 
 pulse_meter_ns = cg.esphome_ns.namespace("pulse_meter")
 
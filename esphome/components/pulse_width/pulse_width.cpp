@@ -12,7 +12,11 @@ void IRAM_ATTR PulseWidthSensorStore::gpio_intr(PulseWidthSensorStore *arg) {
   if (new_level) {
     arg->last_rise_ = now;
   } else {
-    arg->last_width_ = (now - arg->last_rise_);
+    const uint32_t width = now - arg->last_rise_;
+    arg->last_width_ = width;
+    arg->pulses_++;
+    arg->high_us_ += width;
+    arg->samples_.write(now, arg->pulses_, arg->high_us_);
   }
 }
 
@@ -20,9 +24,16 @@ void PulseWidthSensor::dump_config() {
   LOG_SENSOR("", "Pulse Width", this)
   LOG_UPDATE_INTERVAL(this)
   LOG_PIN("  Pin: ", this->pin_);
+  ESP_LOGCONFIG(TAG, "  Mode: %s", this->mode_ == MODE_MEAN ? "MEAN" : "LAST");
 }
 void PulseWidthSensor::update() {
   float width = this->store_.get_pulse_width_s();
+  if (this->mode_ == MODE_MEAN) {
+    // Average all pulses since the last update, keep the last pulse if none ended since
+    const pulse_capture::PulseWindow window = this->analyzer_.update(this->store_.get_sample());
+    if (window.pulses != 0)
+      width = window.get_mean_high_us() / 1e6f;
+  }
   ESP_LOGCONFIG(TAG, "'%s' - Got pulse width %.3f s", this->name_.c_str(), width);
   this->publish_state(width);
 }
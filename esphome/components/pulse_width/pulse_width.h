@@ -2,6 +2,7 @@
 
 #include "esphome/core/component.h"
 #include "esphome/core/hal.h"
+#include "esphome/components/pulse_capture/pulse_capture.h"
 #include "esphome/components/sensor/sensor.h"
 
 namespace esphome {
@@ -20,16 +21,30 @@ class PulseWidthSensorStore {
   uint32_t get_pulse_width_us() const { return this->last_width_; }
   float get_pulse_width_s() const { return this->last_width_ / 1e6f; }
   uint32_t get_last_rise() const { return last_rise_; }
+  /// Pulses and total high time up to the latest falling edge.
+  pulse_capture::PulseSample get_sample() const { return this->samples_.read(); }
 
  protected:
   ISRInternalGPIOPin pin_;
   volatile uint32_t last_width_{0};
   volatile uint32_t last_rise_{0};
+  // Only written in the ISR
+  uint32_t pulses_{0};
+  uint32_t high_us_{0};
+  pulse_capture::PulseSampleSlot samples_;
 };
 
 class PulseWidthSensor : public sensor::Sensor, public PollingComponent {
  public:
+  enum Mode {
+    /// The width of the last pulse.
+    MODE_LAST,
+    /// The mean width of the pulses that ended since the last update, the last width if none did.
+    MODE_MEAN,
+  };
+
   void set_pin(InternalGPIOPin *pin) { pin_ = pin; }
+  void set_mode(Mode mode) { this->mode_ = mode; }
   void setup() override { this->store_.setup(this->pin_); }
   void dump_config() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
@@ -37,7 +52,9 @@ class PulseWidthSensor : public sensor::Sensor, public PollingComponent {
 
  protected:
   PulseWidthSensorStore store_;
+  pulse_capture::PulseAnalyzer analyzer_;
   InternalGPIOPin *pin_;
+  Mode mode_{MODE_LAST};
 };
 
 }  // namespace pulse_width
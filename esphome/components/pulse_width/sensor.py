@@ -3,17 +3,25 @@ import esphome.config_validation as cv
 from esphome import pins
 from esphome.components import sensor
 from esphome.const import (
+    CONF_MODE,
     CONF_PIN,
     STATE_CLASS_MEASUREMENT,
     UNIT_SECOND,
     ICON_TIMER,
 )
 
+AUTO_LOAD = ["pulse_capture"]
+
 pulse_width_ns = cg.esphome_ns.namespace("pulse_width")
 
 PulseWidthSensor = pulse_width_ns.class_(
     "PulseWidthSensor", sensor.Sensor, cg.PollingComponent
 )
+PulseWidthMode = PulseWidthSensor.enum("Mode")
+MODES = {
+    "LAST": PulseWidthMode.MODE_LAST,
+    "MEAN": PulseWidthMode.MODE_MEAN,
+}
 
 CONFIG_SCHEMA = (
     sensor.sensor_schema(
@@ -26,6 +34,7 @@ CONFIG_SCHEMA = (
     .extend(
         {
             cv.Required(CONF_PIN): cv.All(pins.internal_gpio_input_pin_schema),
+            cv.Optional(CONF_MODE, default="LAST"): cv.enum(MODES, upper=True),
         }
     )
     .extend(cv.polling_component_schema("60s"))
@@ -38,3 +47,4 @@ async def to_code(config):
 
     pin = await cg.gpio_pin_expression(config[CONF_PIN])
     cg.add(var.set_pin(pin))
+    cg.add(var.set_mode(config[CONF_MODE]))
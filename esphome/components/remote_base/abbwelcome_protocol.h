@@ -190,8 +190,8 @@ class ABBWelcomeProtocol : public RemoteProtocol<ABBWelcomeData> {
 class ABBWelcomeBinarySensor : public RemoteReceiverBinarySensorBase {
  public:
   bool matches(RemoteReceiveData src) override {
-    auto data = ABBWelcomeProtocol().decode(src);
-    return data.has_value() && data.value() == this->data_;
+    const auto *data = decode_once<ABBWelcomeProtocol>(src);
+    return data != nullptr && *data == this->data_;
   }
   void set_source_address(const uint32_t source_address) { this->data_.set_source_address(source_address); }
   void set_destination_address(const uint32_t destination_address) {
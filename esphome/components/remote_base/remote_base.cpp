@@ -1,6 +1,7 @@
 #include "remote_base.h"
 #include "esphome/core/log.h"
 
+#include <algorithm>
 #include <cinttypes>
 
 namespace esphome {
@@ -27,6 +28,26 @@ void RemoteRMTChannel::config_rmt(rmt_config_t &rmt) {
   rmt.clk_div = this->clock_divider_;
   rmt.mem_block_num = this->mem_block_num_;
 }
+
+void RemoteRMTItems::append(int32_t value) {
+  const bool level = value >= 0;
+  uint32_t ticks = static_cast<uint32_t>(level ? value : -value) * this->ticks_per_ten_us_ / 10;
+  do {
+    const uint32_t duration = std::min(ticks, uint32_t(32767));
+    ticks -= duration;
+    if (!this->half_) {
+      rmt_item32_t item{};
+      item.level0 = static_cast<uint32_t>(level ^ this->inverted_);
+      item.duration0 = duration;
+      this->items_.push_back(item);
+    } else {
+      rmt_item32_t &item = this->items_.back();
+      item.level1 = static_cast<uint32_t>(level ^ this->inverted_);
+      item.duration1 = duration;
+    }
+    this->half_ = !this->half_;
+  } while (ticks != 0);
+}
 #endif
 
 /* RemoteReceiveData */
@@ -108,18 +129,18 @@ void RemoteReceiverBase::register_dumper(RemoteReceiverDumperBase *dumper) {
 
 void RemoteReceiverBase::call_listeners_() {
   for (auto *listener : this->listeners_)
-    listener->on_receive(RemoteReceiveData(this->temp_, this->tolerance_, this->tolerance_mode_));
+    listener->on_receive(RemoteReceiveData(this->temp_, this->tolerance_, this->tolerance_mode_, &this->decode_cache_));
 }
 
 void RemoteReceiverBase::call_dumpers_() {
   bool success = false;
   for (auto *dumper : this->dumpers_) {
-    if (dumper->dump(RemoteReceiveData(this->temp_, this->tolerance_, this->tolerance_mode_)))
+    if (dumper->dump(RemoteReceiveData(this->temp_, this->tolerance_, this->tolerance_mode_, &this->decode_cache_)))
       success = true;
   }
   if (!success) {
     for (auto *dumper : this->secondary_dumpers_)
-      dumper->dump(RemoteReceiveData(this->temp_, this->tolerance_, this->tolerance_mode_));
+      dumper->dump(RemoteReceiveData(this->temp_, this->tolerance_, this->tolerance_mode_, &this->decode_cache_));
   }
 }
 
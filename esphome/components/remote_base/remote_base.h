@@ -1,3 +1,4 @@
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -7,6 +8,8 @@
 #include "esphome/core/automation.h"
 #include "esphome/core/component.h"
 #include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/optional.h"
 
 #ifdef USE_ESP32
 #include <driver/rmt.h>
@@ -22,33 +25,108 @@ enum ToleranceMode : uint8_t {
 
 using RawTimings = std::vector<int32_t>;
 
+class RemoteDecodeCache;
+
+#ifdef USE_ESP32
+/** RMT items built directly from the marks and spaces of an encoder.
+ *
+ * Each item holds two timings of at most 32767 ticks, longer timings are split over several. At the default clock
+ * divider that is half the memory of the same frame as RawTimings, and no conversion is needed before transmitting.
+ */
+class RemoteRMTItems {
+ public:
+  void set_timebase(uint32_t ticks_per_ten_us, bool inverted) {
+    this->ticks_per_ten_us_ = ticks_per_ten_us;
+    this->inverted_ = inverted;
+  }
+  /// Append a timing in microseconds, positive for a mark and negative for a space like in RawTimings.
+  void append(int32_t value);
+  void reserve(size_t timings) { this->items_.reserve((timings + 1) / 2); }
+  void clear() {
+    this->items_.clear();
+    this->half_ = false;
+  }
+  bool empty() const { return this->items_.empty(); }
+  const std::vector<rmt_item32_t> &get_items() const { return this->items_; }
+
+ protected:
+  std::vector<rmt_item32_t> items_;
+  uint32_t ticks_per_ten_us_{10};
+  bool inverted_{false};
+  /// Whether the second timing of the last item is still free.
+  bool half_{false};
+};
+#endif
+
 class RemoteTransmitData {
  public:
-  void mark(uint32_t length) { this->data_.push_back(length); }
-  void space(uint32_t length) { this->data_.push_back(-length); }
+  void mark(uint32_t length) { this->push_(length); }
+  void space(uint32_t length) { this->push_(-length); }
   void item(uint32_t mark, uint32_t space) {
     this->mark(mark);
     this->space(space);
   }
-  void reserve(uint32_t len) { this->data_.reserve(len); }
+  void reserve(uint32_t len) {
+#ifdef USE_ESP32
+    if (this->rmt_items_ != nullptr) {
+      this->rmt_items_->reserve(len);
+      return;
+    }
+#endif
+    this->data_.reserve(len);
+  }
   void set_carrier_frequency(uint32_t carrier_frequency) { this->carrier_frequency_ = carrier_frequency; }
   uint32_t get_carrier_frequency() const { return this->carrier_frequency_; }
+  /// The encoded timings, empty when they are written to RMT items directly (see set_rmt_items()).
   const RawTimings &get_data() const { return this->data_; }
-  void set_data(const RawTimings &data) { this->data_ = data; }
+  void set_data(const RawTimings &data) {
+#ifdef USE_ESP32
+    if (this->rmt_items_ != nullptr) {
+      this->rmt_items_->clear();
+      this->rmt_items_->reserve(data.size());
+      for (int32_t value : data)
+        this->rmt_items_->append(value);
+      return;
+    }
+#endif
+    this->data_ = data;
+  }
   void reset() {
     this->data_.clear();
+#ifdef USE_ESP32
+    if (this->rmt_items_ != nullptr)
+      this->rmt_items_->clear();
+#endif
     this->carrier_frequency_ = 0;
   }
+#ifdef USE_ESP32
+  /// Have encoders write RMT items instead of timings, nullptr to go back to timings.
+  void set_rmt_items(RemoteRMTItems *rmt_items) { this->rmt_items_ = rmt_items; }
+#endif
 
  protected:
+  void push_(int32_t value) {
+#ifdef USE_ESP32
+    if (this->rmt_items_ != nullptr) {
+      this->rmt_items_->append(value);
+      return;
+    }
+#endif
+    this->data_.push_back(value);
+  }
+
   RawTimings data_{};
   uint32_t carrier_frequency_{0};
+#ifdef USE_ESP32
+  RemoteRMTItems *rmt_items_{nullptr};
+#endif
 };
 
 class RemoteReceiveData {
  public:
-  explicit RemoteReceiveData(const RawTimings &data, uint32_t tolerance, ToleranceMode tolerance_mode)
-      : data_(data), index_(0), tolerance_(tolerance), tolerance_mode_(tolerance_mode) {}
+  explicit RemoteReceiveData(const RawTimings &data, uint32_t tolerance, ToleranceMode tolerance_mode,
+                             RemoteDecodeCache *decode_cache = nullptr)
+      : data_(data), index_(0), tolerance_(tolerance), tolerance_mode_(tolerance_mode), decode_cache_(decode_cache) {}
 
   const RawTimings &get_raw_data() const { return this->data_; }
   uint32_t get_index() const { return index_; }
@@ -76,6 +154,8 @@ class RemoteReceiveData {
   }
   uint32_t get_tolerance() { return tolerance_; }
   ToleranceMode get_tolerance_mode() { return this->tolerance_mode_; }
+  /// Decoding results shared by everyone receiving this frame, nullptr if the frame is not dispatched by a receiver.
+  RemoteDecodeCache *get_decode_cache() const { return this->decode_cache_; }
 
  protected:
   int32_t lower_bound_(uint32_t length) const {
@@ -99,6 +179,63 @@ class RemoteReceiveData {
   uint32_t index_;
   uint32_t tolerance_;
   ToleranceMode tolerance_mode_;
+  RemoteDecodeCache *decode_cache_;
+};
+
+/** Decoding results of the frame a receiver is currently dispatching.
+ *
+ * Listeners and dumpers of the same protocol share a single decode of every frame: the first one asking for a
+ * protocol decodes the frame, everyone after it gets the stored result. Protocols are identified by type, so this only
+ * works for protocols without configuration (see decode_once()).
+ */
+class RemoteDecodeCache {
+ public:
+  /// Forget the results of the previous frame.
+  void next_frame() { this->frame_++; }
+
+  /// Result of decoding `src` with protocol `T`, nullptr if the frame is not a valid `T` frame.
+  template<typename T> const typename T::ProtocolData *decode(const RemoteReceiveData &src) {
+    const void *key = protocol_key<T>();
+    Entry<T> *entry = nullptr;
+    for (auto &it : this->entries_) {
+      if (it->protocol == key) {
+        entry = static_cast<Entry<T> *>(it.get());
+        break;
+      }
+    }
+    if (entry == nullptr) {
+      // One entry per protocol for the lifetime of the receiver, later frames reuse it
+      auto owned = make_unique<Entry<T>>();
+      entry = owned.get();
+      entry->protocol = key;
+      this->entries_.push_back(std::move(owned));
+    }
+    if (entry->frame != this->frame_) {
+      entry->frame = this->frame_;
+      entry->result.reset();
+      auto res = T().decode(src);
+      if (res.has_value())
+        entry->result = std::move(*res);
+    }
+    return entry->result.has_value() ? &*entry->result : nullptr;
+  }
+
+ protected:
+  struct EntryBase {
+    virtual ~EntryBase() = default;
+    const void *protocol{nullptr};
+    uint32_t frame{0};
+  };
+  template<typename T> struct Entry : EntryBase { optional<typename T::ProtocolData> result; };
+
+  /// Address unique to every protocol type, avoids the need for RTTI.
+  template<typename T> static const void *protocol_key() {
+    static const uint8_t KEY = 0;
+    return &KEY;
+  }
+
+  std::vector<std::unique_ptr<EntryBase>> entries_;
+  uint32_t frame_{1};
 };
 
 class RemoteComponentBase {
@@ -198,6 +335,7 @@ class RemoteReceiverBase : public RemoteComponentBase {
   void call_listeners_();
   void call_dumpers_();
   void call_listeners_dumpers_() {
+    this->decode_cache_.next_frame();
     this->call_listeners_();
     this->call_dumpers_();
   }
@@ -205,6 +343,7 @@ class RemoteReceiverBase : public RemoteComponentBase {
   std::vector<RemoteReceiverListener *> listeners_;
   std::vector<RemoteReceiverDumperBase *> dumpers_;
   std::vector<RemoteReceiverDumperBase *> secondary_dumpers_;
+  RemoteDecodeCache decode_cache_;
   RawTimings temp_;
   uint32_t tolerance_{25};
   ToleranceMode tolerance_mode_{TOLERANCE_MODE_PERCENTAGE};
@@ -230,15 +369,28 @@ template<typename T> class RemoteProtocol {
   virtual void dump(const ProtocolData &data) = 0;
 };
 
+/** Decode `src` with protocol `T`, at most once per received frame.
+ *
+ * Returns nullptr if the frame is not a valid `T` frame. The result stays valid until the next frame is received.
+ */
+template<typename T> const typename T::ProtocolData *decode_once(const RemoteReceiveData &src) {
+  RemoteDecodeCache *cache = src.get_decode_cache();
+  if (cache == nullptr) {
+    static RemoteDecodeCache fallback_cache;
+    fallback_cache.next_frame();
+    cache = &fallback_cache;
+  }
+  return cache->decode<T>(src);
+}
+
 template<typename T> class RemoteReceiverBinarySensor : public RemoteReceiverBinarySensorBase {
  public:
   RemoteReceiverBinarySensor() : RemoteReceiverBinarySensorBase() {}
 
  protected:
   bool matches(RemoteReceiveData src) override {
-    auto proto = T();
-    auto res = proto.decode(src);
-    return res.has_value() && *res == this->data_;
+    const auto *res = decode_once<T>(src);
+    return res != nullptr && *res == this->data_;
   }
 
  public:
@@ -252,9 +404,8 @@ template<typename T>
 class RemoteReceiverTrigger : public Trigger<typename T::ProtocolData>, public RemoteReceiverListener {
  protected:
   bool on_receive(RemoteReceiveData src) override {
-    auto proto = T();
-    auto res = proto.decode(src);
-    if (res.has_value()) {
+    const auto *res = decode_once<T>(src);
+    if (res != nullptr) {
       this->trigger(*res);
       return true;
     }
@@ -294,11 +445,10 @@ template<typename... Ts> class RemoteTransmitterActionBase : public RemoteTransm
 template<typename T> class RemoteReceiverDumper : public RemoteReceiverDumperBase {
  public:
   bool dump(RemoteReceiveData src) override {
-    auto proto = T();
-    auto decoded = proto.decode(src);
-    if (!decoded.has_value())
+    const auto *decoded = decode_once<T>(src);
+    if (decoded == nullptr)
       return false;
-    proto.dump(*decoded);
+    T().dump(*decoded);
     return true;
   }
 };
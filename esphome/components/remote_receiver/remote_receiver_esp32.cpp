@@ -59,6 +59,8 @@ void RemoteReceiverComponent::setup() {
     this->mark_failed();
     return;
   }
+  // A frame can't be longer than the channel memory, two timings per item plus the trailing idle space
+  this->temp_.reserve(this->mem_block_num_ * 64 * 2 + 1);
 }
 void RemoteReceiverComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "Remote Receiver:");
@@ -54,7 +54,7 @@ class RemoteTransmitterComponent : public remote_base::RemoteTransmitterBase,
 
   uint32_t current_carrier_frequency_{38000};
   bool initialized_{false};
-  std::vector<rmt_item32_t> rmt_temp_;
+  remote_base::RemoteRMTItems rmt_items_;
   esp_err_t error_code_{ESP_OK};
   std::string error_string_{""};
   bool inverted_{false};
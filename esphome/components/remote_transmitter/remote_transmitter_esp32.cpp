@@ -9,7 +9,16 @@ namespace remote_transmitter {
 
 static const char *const TAG = "remote_transmitter";
 
-void RemoteTransmitterComponent::setup() { this->configure_rmt_(); }
+void RemoteTransmitterComponent::setup() {
+  this->configure_rmt_();
+  this->rmt_items_.set_timebase(80000000u / this->clock_divider_ / 100000u, this->inverted_);
+  // Enough for a frame fitting the channel memory, longer ones grow the buffer once
+  this->rmt_items_.reserve(this->mem_block_num_ * 64 * 2);
+#ifndef ESPHOME_LOG_HAS_VERY_VERBOSE
+  // Encode straight into RMT items, very verbose logging needs the timings
+  this->temp_.set_rmt_items(&this->rmt_items_);
+#endif
+}
 
 void RemoteTransmitterComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "Remote Transmitter...");
@@ -87,46 +96,22 @@ void RemoteTransmitterComponent::send_internal(uint32_t send_times, uint32_t sen
     this->configure_rmt_();
   }
 
-  this->rmt_temp_.clear();
-  this->rmt_temp_.reserve((this->temp_.get_data().size() + 1) / 2);
-  uint32_t rmt_i = 0;
-  rmt_item32_t rmt_item;
-
-  for (int32_t val : this->temp_.get_data()) {
-    bool level = val >= 0;
-    if (!level)
-      val = -val;
-    val = this->from_microseconds_(static_cast<uint32_t>(val));
-
-    do {
-      int32_t item = std::min(val, int32_t(32767));
-      val -= item;
-
-      if (rmt_i % 2 == 0) {
-        rmt_item.level0 = static_cast<uint32_t>(level ^ this->inverted_);
-        rmt_item.duration0 = static_cast<uint32_t>(item);
-      } else {
-        rmt_item.level1 = static_cast<uint32_t>(level ^ this->inverted_);
-        rmt_item.duration1 = static_cast<uint32_t>(item);
-        this->rmt_temp_.push_back(rmt_item);
-      }
-      rmt_i++;
-    } while (val != 0);
-  }
-
-  if (rmt_i % 2 == 1) {
-    rmt_item.level1 = 0;
-    rmt_item.duration1 = 0;
-    this->rmt_temp_.push_back(rmt_item);
+  if (!this->temp_.get_data().empty()) {
+    // Not encoded into RMT items directly
+    this->rmt_items_.clear();
+    this->rmt_items_.reserve(this->temp_.get_data().size());
+    for (int32_t value : this->temp_.get_data())
+      this->rmt_items_.append(value);
   }
 
-  if ((this->rmt_temp_.data() == nullptr) || this->rmt_temp_.empty()) {
+  if (this->rmt_items_.empty()) {
     ESP_LOGE(TAG, "Empty data");
     return;
   }
   this->transmit_trigger_->trigger();
   for (uint32_t i = 0; i < send_times; i++) {
-    esp_err_t error = rmt_write_items(this->channel_, this->rmt_temp_.data(), this->rmt_temp_.size(), true);
+    const auto &items = this->rmt_items_.get_items();
+    esp_err_t error = rmt_write_items(this->channel_, items.data(), items.size(), true);
     if (error != ESP_OK) {
       ESP_LOGW(TAG, "rmt_write_items failed: %s", esp_err_to_name(error));
       this->status_set_warning();
@@ -136,6 +121,7 @@ void RemoteTransmitterComponent::send_internal(uint32_t send_times, uint32_t sen
     if (i + 1 < send_times)
       delayMicroseconds(send_wait);
   }
+  this->rmt_items_.clear();
   this->complete_trigger_->trigger();
 }
 
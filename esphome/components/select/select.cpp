@@ -19,10 +19,6 @@ void Select::publish_state(const std::string &state) {
   }
 }
 
-void Select::add_on_state_callback(std::function<void(std::string, size_t)> &&callback) {
-  this->state_callback_.add(std::move(callback));
-}
-
 bool Select::has_option(const std::string &option) const { return this->index_of(option).has_value(); }
 
 bool Select::has_index(size_t index) const { return index < this->size(); }
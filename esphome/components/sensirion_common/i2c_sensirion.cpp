@@ -18,16 +18,19 @@ bool SensirionI2CDevice::read_data(uint16_t *data, uint8_t len) {
   if (last_error_ != i2c::ERROR_OK) {
     return false;
   }
+  return this->decode_data_(buf.data(), data, len);
+}
 
+bool SensirionI2CDevice::decode_data_(const uint8_t *raw, uint16_t *data, uint8_t len) {
   for (uint8_t i = 0; i < len; i++) {
     const uint8_t j = 3 * i;
-    uint8_t crc = sht_crc_(buf[j], buf[j + 1]);
-    if (crc != buf[j + 2]) {
-      ESP_LOGE(TAG, "CRC8 Checksum invalid at pos %d! 0x%02X != 0x%02X", i, buf[j + 2], crc);
+    uint8_t crc = sht_crc_(raw[j], raw[j + 1]);
+    if (crc != raw[j + 2]) {
+      ESP_LOGE(TAG, "CRC8 Checksum invalid at pos %d! 0x%02X != 0x%02X", i, raw[j + 2], crc);
       last_error_ = i2c::ERROR_CRC;
       return false;
     }
-    data[i] = encode_uint16(buf[j], buf[j + 1]);
+    data[i] = encode_uint16(raw[j], raw[j + 1]);
   }
   return true;
 }
@@ -761,11 +761,11 @@ async def setup_sensor_core_(var, config):
     await setup_entity(var, config)
 
     if (device_class := config.get(CONF_DEVICE_CLASS)) is not None:
-        cg.add(var.set_device_class(device_class))
+        cg.add(var.set_device_class(cg.entity_string(device_class)))
     if (state_class := config.get(CONF_STATE_CLASS)) is not None:
         cg.add(var.set_state_class(state_class))
     if (unit_of_measurement := config.get(CONF_UNIT_OF_MEASUREMENT)) is not None:
-        cg.add(var.set_unit_of_measurement(unit_of_measurement))
+        cg.add(var.set_unit_of_measurement(cg.entity_string(unit_of_measurement)))
     if (accuracy_decimals := config.get(CONF_ACCURACY_DECIMALS)) is not None:
         cg.add(var.set_accuracy_decimals(accuracy_decimals))
     cg.add(var.set_force_update(config[CONF_FORCE_UPDATE]))
@@ -100,6 +100,10 @@ template<typename... Ts> class SensorInRangeCondition : public Condition<Ts...>
       return this->min_ <= state && state <= this->max_;
     }
   }
+  bool watch(const std::function<void()> &callback) override {
+    this->parent_->add_on_state_callback([callback](float state) { callback(); });
+    return true;
+  }
 
  protected:
   Sensor *parent_;
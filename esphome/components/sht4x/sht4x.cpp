@@ -50,36 +50,42 @@ void SHT4XComponent::setup() {
 void SHT4XComponent::dump_config() { LOG_I2C_DEVICE(this); }
 
 void SHT4XComponent::update() {
-  // Send command
-  this->write_command(MEASURECOMMANDS[this->precision_]);
+  // Queue the command and the read of the result once converted, so the loop is not blocked by the bus
+  this->write_register_async(MEASURECOMMANDS[this->precision_], nullptr, 0, [this](i2c::ErrorCode err) {
+    if (err != i2c::ERROR_OK) {
+      ESP_LOGD(TAG, "Sensor command failed");
+      return;
+    }
+    this->set_timeout(10, [this]() {
+      this->read_async(this->buffer_, sizeof(this->buffer_), [this](i2c::ErrorCode err) { this->publish_(err); });
+    });
+  });
+}
 
-  this->set_timeout(10, [this]() {
-    uint16_t buffer[2];
+void SHT4XComponent::publish_(i2c::ErrorCode err) {
+  uint16_t buffer[2];
 
-    // Read measurement
-    bool read_status = this->read_data(buffer, 2);
+  // Evaluate the measurement
+  if (err != i2c::ERROR_OK || !this->decode_data_(this->buffer_, buffer, 2)) {
+    ESP_LOGD(TAG, "Sensor read failed");
+    return;
+  }
 
-    if (read_status) {
-      // Evaluate and publish measurements
-      if (this->temp_sensor_ != nullptr) {
-        // Temp is contained in the first result word
-        float sensor_value_temp = buffer[0];
-        float temp = -45 + 175 * sensor_value_temp / 65535;
+  if (this->temp_sensor_ != nullptr) {
+    // Temp is contained in the first result word
+    float sensor_value_temp = buffer[0];
+    float temp = -45 + 175 * sensor_value_temp / 65535;
 
-        this->temp_sensor_->publish_state(temp);
-      }
+    this->temp_sensor_->publish_state(temp);
+  }
 
-      if (this->humidity_sensor_ != nullptr) {
-        // Relative humidity is in the second result word
-        float sensor_value_rh = buffer[1];
-        float rh = -6 + 125 * sensor_value_rh / 65535;
+  if (this->humidity_sensor_ != nullptr) {
+    // Relative humidity is in the second result word
+    float sensor_value_rh = buffer[1];
+    float rh = -6 + 125 * sensor_value_rh / 65535;
 
-        this->humidity_sensor_->publish_state(rh);
-      }
-    } else {
-      ESP_LOGD(TAG, "Sensor read failed");
-    }
-  });
+    this->humidity_sensor_->publish_state(rh);
+  }
 }
 
 }  // namespace sht4x
@@ -39,6 +39,11 @@ class SHT4XComponent : public PollingComponent, public sensirion_common::Sensiri
   void start_heater_();
   uint8_t heater_command_;
 
+  /// Publishes the measurement read into buffer_
+  void publish_(i2c::ErrorCode err);
+  /// Two words with their crc, read without blocking
+  uint8_t buffer_[6];
+
   sensor::Sensor *temp_sensor_{nullptr};
   sensor::Sensor *humidity_sensor_{nullptr};
 };
@@ -4,6 +4,7 @@
 
 #ifdef USE_SOCKET_IMPL_BSD_SOCKETS
 
+#include <algorithm>
 #include <cstring>
 
 #ifdef USE_ESP32
@@ -53,6 +54,7 @@ class BSDSocketImpl : public Socket {
     return make_unique<BSDSocketImpl>(fd);
   }
   int bind(const struct sockaddr *addr, socklen_t addrlen) override { return ::bind(fd_, addr, addrlen); }
+  int connect(const struct sockaddr *addr, socklen_t addrlen) override { return ::connect(fd_, addr, addrlen); }
   int close() override {
     int ret = ::close(fd_);
     closed_ = true;
@@ -114,6 +116,29 @@ class BSDSocketImpl : public Socket {
     return ::sendto(fd_, buf, len, flags, to, tolen);
   }
 
+#if defined(USE_HOST) && defined(__linux__)
+  int sendto_batch(const struct iovec *datagrams, int count, const struct sockaddr *to, socklen_t tolen) override {
+    static const int CHUNK = 16;
+    struct mmsghdr msgs[CHUNK];
+    int sent = 0;
+    while (sent != count) {
+      int chunk = std::min(count - sent, CHUNK);
+      memset(msgs, 0, sizeof(msgs[0]) * chunk);
+      for (int i = 0; i != chunk; i++) {
+        msgs[i].msg_hdr.msg_name = const_cast<struct sockaddr *>(to);
+        msgs[i].msg_hdr.msg_namelen = tolen;
+        msgs[i].msg_hdr.msg_iov = const_cast<struct iovec *>(&datagrams[sent + i]);
+        msgs[i].msg_hdr.msg_iovlen = 1;
+      }
+      int ret = ::sendmmsg(fd_, msgs, chunk, 0);
+      if (ret <= 0)
+        return sent == 0 ? -1 : sent;
+      sent += ret;
+    }
+    return sent;
+  }
+#endif
+
   int setblocking(bool blocking) override {
     int fl = ::fcntl(fd_, F_GETFL, 0);
     if (blocking) {
@@ -0,0 +1,42 @@
+#include "datagram_batch.h"
+
+#include <algorithm>
+
+namespace esphome {
+namespace socket {
+
+void DatagramBatch::init(size_t mtu, size_t depth) {
+  this->storage_ = std::unique_ptr<uint32_t[]>(new uint32_t[(mtu * depth + 3) / 4]);  // NOLINT
+  this->sizes_ = std::unique_ptr<uint16_t[]>(new uint16_t[depth]);                    // NOLINT
+  this->mtu_ = mtu;
+  this->depth_ = depth;
+  this->clear();
+}
+
+void DatagramBatch::close() {
+  this->sizes_[this->closed_++] = this->used_;
+  this->used_ = 0;
+}
+
+#if defined(USE_SOCKET_IMPL_LWIP_TCP) || defined(USE_SOCKET_IMPL_LWIP_SOCKETS) || defined(USE_SOCKET_IMPL_BSD_SOCKETS)
+int DatagramBatch::send(Socket *socket, const struct sockaddr *to, socklen_t tolen) const {
+  static const size_t CHUNK = 16;
+  struct iovec iov[CHUNK];
+  size_t sent = 0;
+  while (sent != this->closed_) {
+    size_t chunk = std::min(this->closed_ - sent, CHUNK);
+    for (size_t i = 0; i != chunk; i++) {
+      iov[i].iov_base = this->datagram_(sent + i);
+      iov[i].iov_len = this->sizes_[sent + i];
+    }
+    int ret = socket->sendto_batch(iov, chunk, to, tolen);
+    if (ret <= 0)
+      return sent == 0 ? -1 : sent;
+    sent += ret;
+  }
+  return sent;
+}
+#endif
+
+}  // namespace socket
+}  // namespace esphome
@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include "esphome/core/defines.h"
+#include "socket.h"
+
+namespace esphome {
+namespace socket {
+
+/// Datagrams queued before a batch is sent. Only the host can hand several to the kernel in one call; elsewhere each
+/// datagram goes out as soon as it is full, so a single buffer is enough.
+#ifdef USE_HOST
+static const size_t DEFAULT_BATCH_DEPTH = 16;
+#else
+static const size_t DEFAULT_BATCH_DEPTH = 1;
+#endif
+
+/** Packs small records into a fixed pool of datagrams, so a burst of metrics goes out in as few packets as possible
+ * without allocating per update.
+ *
+ * Records are appended to the open datagram. When the next record doesn't fit, the owner finishes the datagram
+ * (padding, encryption) in place and calls close(), which opens the next one. Once full() the closed datagrams must be
+ * sent and the batch cleared before anything else is appended.
+ */
+class DatagramBatch {
+ public:
+  /// Allocate @p depth datagrams of up to @p mtu bytes each. The storage is word aligned, as is every datagram if
+  /// @p mtu is a multiple of 4.
+  void init(size_t mtu, size_t depth);
+
+  /// Whether @p len more bytes fit into the open datagram.
+  bool fits(size_t len) const { return this->used_ + len <= this->mtu_; }
+  /// Bytes written to the open datagram.
+  size_t size() const { return this->used_; }
+  /// Start of the open datagram.
+  uint8_t *data() { return this->datagram_(this->closed_); }
+  void append(const void *data, size_t len) {
+    memcpy(this->data() + this->used_, data, len);
+    this->used_ += len;
+  }
+  void append(uint8_t byte) { this->data()[this->used_++] = byte; }
+
+  /// Close the open datagram and start the next one.
+  void close();
+  /// Whether every datagram is closed and the batch has to be sent before appending.
+  bool full() const { return this->closed_ == this->depth_; }
+  /// Number of closed datagrams.
+  size_t count() const { return this->closed_; }
+  const uint8_t *datagram(size_t index) const { return this->datagram_(index); }
+  size_t datagram_size(size_t index) const { return this->sizes_[index]; }
+  /// Drop all closed datagrams and empty the open one.
+  void clear() {
+    this->closed_ = 0;
+    this->used_ = 0;
+  }
+
+#if defined(USE_SOCKET_IMPL_LWIP_TCP) || defined(USE_SOCKET_IMPL_LWIP_SOCKETS) || defined(USE_SOCKET_IMPL_BSD_SOCKETS)
+  /// Send the closed datagrams to @p to, keeping them for further destinations. Returns the number sent, or -1.
+  int send(Socket *socket, const struct sockaddr *to, socklen_t tolen) const;
+#endif
+
+ protected:
+  uint8_t *datagram_(size_t index) const {
+    return reinterpret_cast<uint8_t *>(this->storage_.get()) + index * this->mtu_;
+  }
+
+  std::unique_ptr<uint32_t[]> storage_;
+  std::unique_ptr<uint16_t[]> sizes_;
+  size_t mtu_{0};
+  size_t depth_{0};
+  size_t closed_{0};
+  size_t used_{0};
+};
+
+}  // namespace socket
+}  // namespace esphome
@@ -126,6 +126,11 @@ class LWIPRawImpl : public Socket {
     }
     return 0;
   }
+  int connect(const struct sockaddr *name, socklen_t addrlen) override {
+    // Only listening sockets are implemented on top of the raw API
+    errno = EOPNOTSUPP;
+    return -1;
+  }
   int close() override {
     if (pcb_ == nullptr) {
       errno = ECONNRESET;
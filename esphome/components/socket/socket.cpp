@@ -10,6 +10,14 @@ namespace socket {
 
 Socket::~Socket() {}
 
+int Socket::sendto_batch(const struct iovec *datagrams, int count, const struct sockaddr *to, socklen_t tolen) {
+  for (int i = 0; i != count; i++) {
+    if (this->sendto(datagrams[i].iov_base, datagrams[i].iov_len, 0, to, tolen) < 0)
+      return i == 0 ? -1 : i;
+  }
+  return count;
+}
+
 std::unique_ptr<Socket> socket_ip(int type, int protocol) {
 #if USE_NETWORK_IPV6
   return socket(AF_INET6, type, protocol);
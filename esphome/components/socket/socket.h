@@ -21,7 +21,8 @@ class Socket {
   virtual int close() = 0;
   // not supported yet:
   // virtual int connect(const std::string &address) = 0;
-  // virtual int connect(const struct sockaddr *addr, socklen_t addrlen) = 0;
+  /// Connect to a remote address. Not supported by the raw lwIP implementation (ESP8266, RP2040).
+  virtual int connect(const struct sockaddr *addr, socklen_t addrlen) = 0;
   virtual int shutdown(int how) = 0;
 
   virtual int getpeername(struct sockaddr *addr, socklen_t *addrlen) = 0;
@@ -39,6 +40,9 @@ class Socket {
   virtual ssize_t write(const void *buf, size_t len) = 0;
   virtual ssize_t writev(const struct iovec *iov, int iovcnt) = 0;
   virtual ssize_t sendto(const void *buf, size_t len, int flags, const struct sockaddr *to, socklen_t tolen) = 0;
+  /// Send each of @p count buffers as its own datagram to the same address. Returns the number of datagrams sent,
+  /// or -1 if none could be. Implementations that can, hand them all to the kernel in one call.
+  virtual int sendto_batch(const struct iovec *datagrams, int count, const struct sockaddr *to, socklen_t tolen);
 
   virtual int setblocking(bool blocking) = 0;
   virtual int loop() { return 0; };
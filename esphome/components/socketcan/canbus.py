@@ -0,0 +1,28 @@
+import esphome.codegen as cg
+from esphome.components import canbus
+from esphome.components.canbus import CanbusComponent
+import esphome.config_validation as cv
+from esphome.const import CONF_ID, PLATFORM_HOST
+
+CONF_INTERFACE = "interface"
+
+socketcan_ns = cg.esphome_ns.namespace("socketcan")
+SocketCan = socketcan_ns.class_("SocketCan", CanbusComponent)
+
+# The bit rate of a SocketCAN interface is set when bringing it up (ip link set can0 type can bitrate 125000), the
+# bit_rate option is accepted for configurations shared with other platforms but not used.
+CONFIG_SCHEMA = cv.All(
+    canbus.CANBUS_SCHEMA.extend(
+        {
+            cv.GenerateID(): cv.declare_id(SocketCan),
+            cv.Optional(CONF_INTERFACE, default="vcan0"): cv.string_strict,
+        }
+    ),
+    cv.only_on(PLATFORM_HOST),
+)
+
+
+async def to_code(config):
+    var = cg.new_Pvariable(config[CONF_ID])
+    await canbus.register_canbus(var, config)
+    cg.add(var.set_interface(config[CONF_INTERFACE]))
@@ -0,0 +1,116 @@
+#ifdef USE_HOST
+#include "socketcan.h"
+#include "esphome/core/log.h"
+
+#ifndef __linux__
+#error SocketCAN is only available on Linux
+#endif
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace esphome {
+namespace socketcan {
+
+static const char *const TAG = "socketcan";
+
+void SocketCan::dump_config() {
+  canbus::Canbus::dump_config();
+  ESP_LOGCONFIG(TAG, "  Interface: %s", this->interface_.c_str());
+}
+
+bool SocketCan::setup_internal() {
+  this->fd_ = socket(PF_CAN, SOCK_RAW | SOCK_NONBLOCK, CAN_RAW);
+  if (this->fd_ < 0) {
+    ESP_LOGE(TAG, "Could not open a CAN socket: %s", strerror(errno));
+    return false;
+  }
+
+  struct ifreq ifr {};
+  strncpy(ifr.ifr_name, this->interface_.c_str(), IFNAMSIZ - 1);
+  if (ioctl(this->fd_, SIOCGIFINDEX, &ifr) < 0) {
+    ESP_LOGE(TAG, "Unknown interface %s: %s", this->interface_.c_str(), strerror(errno));
+    close(this->fd_);
+    this->fd_ = -1;
+    return false;
+  }
+
+  // Let the kernel drop the frames no trigger is interested in
+  const std::vector<canbus::CanFilter> filters = this->get_filters_();
+  if (!filters.empty()) {
+    std::vector<struct can_filter> raw_filters;
+    raw_filters.reserve(filters.size());
+    for (const auto &filter : filters) {
+      struct can_filter raw_filter {};
+      if (filter.use_extended_id) {
+        raw_filter.can_id = (filter.can_id & CAN_EFF_MASK) | CAN_EFF_FLAG;
+        raw_filter.can_mask = (filter.can_id_mask & CAN_EFF_MASK) | CAN_EFF_FLAG;
+      } else {
+        raw_filter.can_id = filter.can_id & CAN_SFF_MASK;
+        raw_filter.can_mask = (filter.can_id_mask & CAN_SFF_MASK) | CAN_EFF_FLAG;
+      }
+      raw_filters.push_back(raw_filter);
+    }
+    if (setsockopt(this->fd_, SOL_CAN_RAW, CAN_RAW_FILTER, raw_filters.data(),
+                   raw_filters.size() * sizeof(struct can_filter)) < 0) {
+      ESP_LOGW(TAG, "Could not set the receive filters: %s", strerror(errno));
+    }
+  }
+
+  struct sockaddr_can addr {};
+  addr.can_family = AF_CAN;
+  addr.can_ifindex = ifr.ifr_ifindex;
+  if (bind(this->fd_, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0) {
+    ESP_LOGE(TAG, "Could not bind to %s: %s", this->interface_.c_str(), strerror(errno));
+    close(this->fd_);
+    this->fd_ = -1;
+    return false;
+  }
+  return true;
+}
+
+canbus::Error SocketCan::send_message(struct canbus::CanFrame *frame) {
+  if (frame->can_data_length_code > canbus::CAN_MAX_DATA_LENGTH) {
+    return canbus::ERROR_FAILTX;
+  }
+
+  struct can_frame raw {};
+  raw.can_id = frame->can_id & (frame->use_extended_id ? CAN_EFF_MASK : CAN_SFF_MASK);
+  if (frame->use_extended_id)
+    raw.can_id |= CAN_EFF_FLAG;
+  if (frame->remote_transmission_request)
+    raw.can_id |= CAN_RTR_FLAG;
+  raw.can_dlc = frame->can_data_length_code;
+  memcpy(raw.data, frame->data, frame->can_data_length_code);
+
+  if (write(this->fd_, &raw, sizeof(raw)) != sizeof(raw)) {
+    return canbus::ERROR_ALLTXBUSY;
+  }
+  return canbus::ERROR_OK;
+}
+
+canbus::Error SocketCan::read_message(struct canbus::CanFrame *frame) {
+  struct can_frame raw;
+  if (read(this->fd_, &raw, sizeof(raw)) != sizeof(raw)) {
+    return canbus::ERROR_NOMSG;
+  }
+
+  frame->use_extended_id = (raw.can_id & CAN_EFF_FLAG) != 0;
+  frame->remote_transmission_request = (raw.can_id & CAN_RTR_FLAG) != 0;
+  frame->can_id = raw.can_id & (frame->use_extended_id ? CAN_EFF_MASK : CAN_SFF_MASK);
+  frame->can_data_length_code = raw.can_dlc < canbus::CAN_MAX_DATA_LENGTH ? raw.can_dlc : canbus::CAN_MAX_DATA_LENGTH;
+  memcpy(frame->data, raw.data, frame->can_data_length_code);
+  return canbus::ERROR_OK;
+}
+
+}  // namespace socketcan
+}  // namespace esphome
+
+#endif
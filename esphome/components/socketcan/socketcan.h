@@ -0,0 +1,31 @@
+#pragma once
+
+#ifdef USE_HOST
+
+#include "esphome/components/canbus/canbus.h"
+#include "esphome/core/component.h"
+
+#include <string>
+
+namespace esphome {
+namespace socketcan {
+
+/// CAN bus on a Linux SocketCAN interface, a virtual one (vcan) allows testing without hardware.
+class SocketCan : public canbus::Canbus {
+ public:
+  void set_interface(const std::string &interface) { this->interface_ = interface; }
+  void dump_config() override;
+
+ protected:
+  bool setup_internal() override;
+  canbus::Error send_message(struct canbus::CanFrame *frame) override;
+  canbus::Error read_message(struct canbus::CanFrame *frame) override;
+
+  std::string interface_;
+  int fd_{-1};
+};
+
+}  // namespace socketcan
+}  // namespace esphome
+
+#endif
@@ -28,6 +28,7 @@ from esphome.const import (
     CONF_DATA_RATE,
     PLATFORM_ESP32,
     PLATFORM_ESP8266,
+    PLATFORM_HOST,
     PLATFORM_RP2040,
     CONF_DATA_PINS,
 )
@@ -274,7 +275,8 @@ SPI_SCHEMA = cv.All(
         }
     ),
     cv.has_at_least_one_key(CONF_MISO_PIN, CONF_MOSI_PIN),
-    cv.only_on([PLATFORM_ESP32, PLATFORM_ESP8266, PLATFORM_RP2040]),
+    # the host platform records the transfers with a mock bus, the pins are not used
+    cv.only_on([PLATFORM_ESP32, PLATFORM_ESP8266, PLATFORM_RP2040, PLATFORM_HOST]),
 )
 
 SPI_QUAD_SCHEMA = cv.All(
@@ -1,4 +1,5 @@
 #include "spi.h"
+#include "spi_mock.h"
 #include "esphome/core/log.h"
 #include "esphome/core/application.h"
 
@@ -9,6 +10,39 @@ const char *const TAG = "spi";
 
 bool SPIDelegate::is_ready() { return true; }
 
+void SPIDelegate::execute(const SPITransaction &transaction) {
+  GPIOPin *dc_pin = transaction.get_dc_pin();
+  this->begin_transaction();
+  for (const auto &segment : transaction.get_segments()) {
+    if (dc_pin != nullptr)
+      dc_pin->digital_write(segment.dc);
+    this->write_array(transaction.get_data(segment), segment.length);
+  }
+  this->end_transaction();
+}
+
+SPITransaction &SPITransaction::add(const uint8_t *data, size_t length, bool dc) {
+  if (length == 0)
+    return *this;
+  this->length_ += length;
+  if (length > COPY_THRESHOLD) {
+    this->segments_.push_back({data, 0, length, dc});
+    return *this;
+  }
+  // extend the previous segment if its bytes are the last ones stored in the transaction
+  if (!this->segments_.empty()) {
+    Segment &last = this->segments_.back();
+    if (last.data == nullptr && last.dc == dc && last.offset + last.length == this->buffer_.size()) {
+      this->buffer_.insert(this->buffer_.end(), data, data + length);
+      last.length += length;
+      return *this;
+    }
+  }
+  this->segments_.push_back({nullptr, this->buffer_.size(), length, dc});
+  this->buffer_.insert(this->buffer_.end(), data, data + length);
+  return *this;
+}
+
 GPIOPin *const NullPin::NULL_PIN = new NullPin();  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
 
 SPIDelegate *SPIComponent::register_device(SPIClient *device, SPIMode mode, SPIBitOrder bit_order, uint32_t data_rate,
@@ -34,6 +68,11 @@ void SPIComponent::unregister_device(SPIClient *device) {
 void SPIComponent::setup() {
   ESP_LOGD(TAG, "Setting up SPI bus...");
 
+#ifdef USE_HOST
+  this->spi_bus_ = new MockSPIBus();  // NOLINT
+  return;
+#endif
+
   if (this->sdo_pin_ == nullptr)
     this->sdo_pin_ = NullPin::NULL_PIN;
   if (this->sdi_pin_ == nullptr)
@@ -60,6 +99,11 @@ void SPIComponent::setup() {
   }
 }
 
+void SPIComponent::loop() {
+  for (auto &device : this->devices_)
+    device.second->poll();
+}
+
 void SPIComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "SPI bus:");
   LOG_PIN("  CLK Pin: ", this->clk_pin_)
@@ -68,11 +112,15 @@ void SPIComponent::dump_config() {
   for (size_t i = 0; i != this->data_pins_.size(); i++) {
     ESP_LOGCONFIG(TAG, "  Data pin %u: GPIO%d", i, this->data_pins_[i]);
   }
+#ifdef USE_HOST
+  ESP_LOGCONFIG(TAG, "  Using mock SPI");
+#else
   if (this->spi_bus_->is_hw()) {
     ESP_LOGCONFIG(TAG, "  Using HW SPI: %s", this->interface_name_);
   } else {
     ESP_LOGCONFIG(TAG, "  Using software SPI");
   }
+#endif
 }
 
 uint8_t SPIDelegateBitBash::transfer(uint8_t data) { return this->transfer_(data, 8); }
@@ -4,6 +4,7 @@
 #include "esphome/core/component.h"
 #include "esphome/core/hal.h"
 #include "esphome/core/log.h"
+#include <functional>
 #include <map>
 #include <utility>
 #include <vector>
@@ -28,6 +29,13 @@ using SPIInterface = spi_host_device_t;
 
 #endif  // USE_ESP_IDF
 
+#ifdef USE_HOST
+
+// the host platform only has a mock bus, see MockSPIBus
+using SPIInterface = void *;
+
+#endif  // USE_HOST
+
 /**
  * Implementation of SPI Controller mode.
  */
@@ -163,6 +171,64 @@ class Utility {
   }
 };
 
+/** A batch of writes to one device, sent with CS asserted from the first to the last byte.
+ *
+ * Every segment is sent with the data/command pin of the transaction (if any) set to the level of the segment, so a
+ * display command, its parameters and the pixel data following it form a single unit. Platforms that support it queue
+ * all segments to the DMA engine at once instead of waiting for each write to finish.
+ *
+ * Segments of up to COPY_THRESHOLD bytes are copied into the transaction, larger ones are referenced and must stay
+ * valid until the transaction completed.
+ */
+class SPITransaction {
+ public:
+  static const size_t COPY_THRESHOLD = 32;
+
+  struct Segment {
+    const uint8_t *data;  ///< referenced bytes, nullptr if they are stored in the transaction
+    size_t offset;        ///< position of the bytes in the transaction if data is nullptr
+    size_t length;
+    bool dc;  ///< level of the data/command pin while sending
+  };
+
+  SPITransaction() = default;
+  explicit SPITransaction(GPIOPin *dc_pin) : dc_pin_(dc_pin) {}
+
+  /// Add a command byte, sent with the data/command pin low.
+  SPITransaction &command(uint8_t value) { return this->add(&value, 1, false); }
+  /// Add a data byte, sent with the data/command pin high.
+  SPITransaction &data(uint8_t value) { return this->add(&value, 1, true); }
+  /// Add data bytes, sent with the data/command pin high.
+  SPITransaction &data(const uint8_t *data, size_t length) { return this->add(data, length, true); }
+  /// Add a 16 bit data value, most significant byte first.
+  SPITransaction &data16(uint16_t value) {
+    uint8_t buf[2] = {uint8_t(value >> 8), uint8_t(value)};
+    return this->add(buf, 2, true);
+  }
+  /// Add bytes sent with the data/command pin at the given level, merged into the previous segment if possible.
+  SPITransaction &add(const uint8_t *data, size_t length, bool dc);
+
+  GPIOPin *get_dc_pin() const { return this->dc_pin_; }
+  const std::vector<Segment> &get_segments() const { return this->segments_; }
+  const uint8_t *get_data(const Segment &segment) const {
+    return segment.data != nullptr ? segment.data : this->buffer_.data() + segment.offset;
+  }
+  /// Total number of bytes in the transaction.
+  size_t get_length() const { return this->length_; }
+  bool empty() const { return this->segments_.empty(); }
+  void clear() {
+    this->segments_.clear();
+    this->buffer_.clear();
+    this->length_ = 0;
+  }
+
+ protected:
+  GPIOPin *dc_pin_{nullptr};
+  std::vector<Segment> segments_;
+  std::vector<uint8_t> buffer_;
+  size_t length_{0};
+};
+
 // represents a device attached to an SPI bus, with a defined clock rate, mode and bit order. On Arduino this is
 // a thin wrapper over SPIClass.
 class SPIDelegate {
@@ -243,6 +309,23 @@ class SPIDelegate {
   // check if device is ready
   virtual bool is_ready();
 
+  // send a transaction, returns once it completed.
+  virtual void execute(const SPITransaction &transaction);
+
+  // start sending a transaction and return. The callback is called from the loop of the bus once the transaction
+  // completed. Platforms without queued transfers send it right away and call the callback before returning.
+  virtual void submit(SPITransaction &&transaction, std::function<void()> &&callback) {
+    this->execute(transaction);
+    if (callback)
+      callback();
+  }
+
+  // complete submitted transactions that have finished, called from the loop of the bus.
+  virtual void poll() {}
+
+  // block until all submitted transactions completed.
+  virtual void wait() {}
+
  protected:
   SPIBitOrder bit_order_{BIT_ORDER_MSB_FIRST};
   uint32_t data_rate_{1000000};
@@ -331,8 +414,11 @@ class SPIComponent : public Component {
   float get_setup_priority() const override { return setup_priority::BUS; }
 
   void setup() override;
+  void loop() override;
   void dump_config() override;
 
+  SPIBus *get_spi_bus() const { return this->spi_bus_; }
+
  protected:
   GPIOPin *clk_pin_{nullptr};
   GPIOPin *sdi_pin_{nullptr};
@@ -471,6 +557,21 @@ class SPIDevice : public SPIClient {
   void write_array(const std::vector<uint8_t> &data) { this->write_array(data.data(), data.size()); }
 
   template<size_t N> void transfer_array(std::array<uint8_t, N> &data) { this->transfer_array(data.data(), N); }
+
+  /// Send a transaction with CS asserted throughout, returns once it completed. Do not call enable() first.
+  void write_transaction(const SPITransaction &transaction) { this->delegate_->execute(transaction); }
+
+  /** Start sending a transaction and return without waiting for it.
+   *
+   * The referenced data of the transaction must stay unchanged until `callback` is called from the loop of the SPI
+   * bus. Any other access to the device waits for the transaction to complete first.
+   */
+  void submit_transaction(SPITransaction &&transaction, std::function<void()> &&callback = nullptr) {
+    this->delegate_->submit(std::move(transaction), std::move(callback));
+  }
+
+  /// Wait until all submitted transactions completed.
+  void wait_for_transactions() { this->delegate_->wait(); }
 };
 
 }  // namespace spi
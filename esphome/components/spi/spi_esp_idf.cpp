@@ -1,25 +1,39 @@
 #include "spi.h"
 #include <vector>
 
+#ifdef USE_ESP_IDF
+#include "driver/gpio.h"
+#endif
+
 namespace esphome {
 namespace spi {
 
 #ifdef USE_ESP_IDF
 static const char *const TAG = "spi-esp-idf";
 static const size_t MAX_TRANSFER_SIZE = 4092;  // dictated by ESP-IDF API.
+static const size_t QUEUE_SIZE = 8;            // transfers of a transaction queued to the driver at once
+
+class SPIDelegateHw;
+
+// state shared by the devices on a bus
+struct SPIBusState {
+  // device with a submitted transaction, it holds the bus until the transaction completed
+  SPIDelegateHw *pending{nullptr};
+};
 
 class SPIDelegateHw : public SPIDelegate {
  public:
-  SPIDelegateHw(SPIInterface channel, uint32_t data_rate, SPIBitOrder bit_order, SPIMode mode, GPIOPin *cs_pin,
-                bool write_only)
-      : SPIDelegate(data_rate, bit_order, mode, cs_pin), channel_(channel), write_only_(write_only) {
+  SPIDelegateHw(SPIInterface channel, SPIBusState *bus_state, uint32_t data_rate, SPIBitOrder bit_order, SPIMode mode,
+                GPIOPin *cs_pin, bool write_only)
+      : SPIDelegate(data_rate, bit_order, mode, cs_pin), channel_(channel), bus_state_(bus_state),
+        write_only_(write_only) {
     spi_device_interface_config_t config = {};
     config.mode = static_cast<uint8_t>(mode);
     config.clock_speed_hz = static_cast<int>(data_rate);
     config.spics_io_num = -1;
     config.flags = 0;
-    config.queue_size = 1;
-    config.pre_cb = nullptr;
+    config.queue_size = QUEUE_SIZE;
+    config.pre_cb = pre_transfer;
     config.post_cb = nullptr;
     if (bit_order == BIT_ORDER_LSB_FIRST)
       config.flags |= SPI_DEVICE_BIT_LSBFIRST;
@@ -33,6 +47,8 @@ class SPIDelegateHw : public SPIDelegate {
   bool is_ready() override { return this->handle_ != nullptr; }
 
   void begin_transaction() override {
+    while (this->bus_state_->pending != nullptr)
+      this->bus_state_->pending->wait();
     if (this->is_ready()) {
       if (spi_device_acquire_bus(this->handle_, portMAX_DELAY) != ESP_OK)
         ESP_LOGE(TAG, "Failed to acquire SPI bus");
@@ -50,6 +66,7 @@ class SPIDelegateHw : public SPIDelegate {
   }
 
   ~SPIDelegateHw() override {
+    this->wait();
     esp_err_t const err = spi_bus_remove_device(this->handle_);
     if (err != ESP_OK)
       ESP_LOGE(TAG, "Remove device failed - err %X", err);
@@ -188,10 +205,125 @@ class SPIDelegateHw : public SPIDelegate {
 
   void read_array(uint8_t *ptr, size_t length) override { this->transfer(nullptr, ptr, length); }
 
+  void execute(const SPITransaction &transaction) override {
+    if (!this->start_(transaction)) {
+      SPIDelegate::execute(transaction);
+      return;
+    }
+    this->wait();
+  }
+
+  void submit(SPITransaction &&transaction, std::function<void()> &&callback) override {
+    while (this->bus_state_->pending != nullptr)
+      this->bus_state_->pending->wait();
+    this->transaction_ = std::move(transaction);
+    this->callback_ = std::move(callback);
+    if (!this->start_(this->transaction_)) {
+      SPIDelegate::execute(this->transaction_);
+      this->finish_callback_();
+    }
+  }
+
+  void poll() override {
+    if (this->bus_state_->pending == this)
+      this->pump_(0);
+  }
+
+  void wait() override {
+    if (this->bus_state_->pending == this)
+      this->pump_(portMAX_DELAY);
+  }
+
  protected:
+  // sets the data/command pin of a queued transfer, encoded as (pin << 1 | level) + 1 in the user field.
+  static void IRAM_ATTR pre_transfer(spi_transaction_t *trans) {
+    auto dc = reinterpret_cast<intptr_t>(trans->user);
+    if (dc != 0)
+      gpio_set_level(static_cast<gpio_num_t>((dc - 1) >> 1), (dc - 1) & 1);
+  }
+
+  // acquire the bus and queue the first transfers of a transaction, false if it cannot be queued
+  bool start_(const SPITransaction &transaction) {
+    GPIOPin *dc_pin = transaction.get_dc_pin();
+    int dc = dc_pin == nullptr ? -1 : Utility::get_pin_no(dc_pin);
+    if ((dc_pin != nullptr && dc < 0) || !this->is_ready())
+      return false;
+    this->begin_transaction();
+    for (const auto &segment : transaction.get_segments()) {
+      const uint8_t *data = transaction.get_data(segment);
+      size_t length = segment.length;
+      void *user = dc < 0 ? nullptr : reinterpret_cast<void *>(intptr_t((dc << 1 | segment.dc) + 1));
+      while (length != 0) {
+        size_t const partial = std::min(length, MAX_TRANSFER_SIZE);
+        spi_transaction_t desc = {};
+        desc.length = partial * 8;
+        desc.tx_buffer = data;
+        desc.user = user;
+        this->transfers_.push_back(desc);
+        length -= partial;
+        data += partial;
+      }
+    }
+    this->queued_ = 0;
+    this->completed_ = 0;
+    this->bus_state_->pending = this;
+    this->pump_(0);
+    return true;
+  }
+
+  // keep the driver queue filled and collect completed transfers until all are done or none completed within `wait`
+  void pump_(TickType_t wait) {
+    while (this->completed_ != this->transfers_.size()) {
+      while (this->queued_ != this->transfers_.size() && this->queued_ - this->completed_ < QUEUE_SIZE) {
+        if (spi_device_queue_trans(this->handle_, &this->transfers_[this->queued_], 0) != ESP_OK)
+          break;
+        this->queued_++;
+      }
+      if (this->queued_ == this->completed_) {
+        ESP_LOGE(TAG, "Queueing transfer failed");
+        break;
+      }
+      spi_transaction_t *done;
+      esp_err_t const err = spi_device_get_trans_result(this->handle_, &done, wait);
+      if (err == ESP_ERR_TIMEOUT)
+        return;
+      if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Transmit failed - err %X", err);
+        break;
+      }
+      this->completed_++;
+    }
+    // wait for transfers still in flight after an error
+    spi_transaction_t *done;
+    while (this->queued_ != this->completed_ &&
+           spi_device_get_trans_result(this->handle_, &done, portMAX_DELAY) == ESP_OK)
+      this->completed_++;
+    this->transfers_.clear();
+    this->bus_state_->pending = nullptr;
+    this->end_transaction();
+    this->finish_callback_();
+  }
+
+  void finish_callback_() {
+    this->transaction_.clear();
+    if (this->callback_) {
+      auto callback = std::move(this->callback_);
+      this->callback_ = nullptr;
+      callback();
+    }
+  }
+
   SPIInterface channel_{};
+  SPIBusState *bus_state_;
   spi_device_handle_t handle_{};
   bool write_only_{false};
+  // queued transaction
+  std::vector<spi_transaction_t> transfers_;
+  size_t queued_{0};
+  size_t completed_{0};
+  // transaction and callback given to submit()
+  SPITransaction transaction_;
+  std::function<void()> callback_;
 };
 
 class SPIBusHw : public SPIBus {
@@ -224,12 +356,13 @@ class SPIBusHw : public SPIBus {
   }
 
   SPIDelegate *get_delegate(uint32_t data_rate, SPIBitOrder bit_order, SPIMode mode, GPIOPin *cs_pin) override {
-    return new SPIDelegateHw(this->channel_, data_rate, bit_order, mode, cs_pin,
+    return new SPIDelegateHw(this->channel_, &this->state_, data_rate, bit_order, mode, cs_pin,
                              Utility::get_pin_no(this->sdi_pin_) == -1);
   }
 
  protected:
   SPIInterface channel_{};
+  SPIBusState state_;
 
   bool is_hw() override { return true; }
 };
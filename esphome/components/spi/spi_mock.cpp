@@ -0,0 +1,109 @@
+#ifdef USE_HOST
+
+#include "spi_mock.h"
+
+namespace esphome {
+namespace spi {
+
+class MockSPIDelegate : public SPIDelegate {
+ public:
+  MockSPIDelegate(MockSPIBus *bus, uint32_t data_rate, SPIBitOrder bit_order, SPIMode mode, GPIOPin *cs_pin)
+      : SPIDelegate(data_rate, bit_order, mode, cs_pin), bus_(bus) {}
+
+  ~MockSPIDelegate() override { this->wait(); }
+
+  void begin_transaction() override {
+    this->wait();
+    SPIDelegate::begin_transaction();
+    this->current_ = {{}, false};
+  }
+
+  void end_transaction() override {
+    SPIDelegate::end_transaction();
+    this->bus_->record_(std::move(this->current_), this->data_rate_);
+  }
+
+  uint8_t transfer(uint8_t data) override {
+    this->append_(-1, &data, 1);
+    return 0;
+  }
+
+  void write_array(const uint8_t *ptr, size_t length) override { this->append_(-1, ptr, length); }
+
+  void execute(const SPITransaction &transaction) override {
+    this->begin_transaction();
+    this->record_transaction_(transaction);
+    this->end_transaction();
+  }
+
+  void submit(SPITransaction &&transaction, std::function<void()> &&callback) override {
+    this->wait();
+    this->pending_.push_back({std::move(transaction), std::move(callback)});
+  }
+
+  void poll() override {
+    std::vector<Pending> pending;
+    pending.swap(this->pending_);
+    for (auto &p : pending) {
+      SPIDelegate::begin_transaction();
+      this->current_ = {{}, true};
+      this->record_transaction_(p.transaction);
+      this->end_transaction();
+      if (p.callback)
+        p.callback();
+    }
+  }
+
+  void wait() override {
+    if (!this->pending_.empty())
+      this->poll();
+  }
+
+ protected:
+  struct Pending {
+    SPITransaction transaction;
+    std::function<void()> callback;
+  };
+
+  void append_(int8_t dc, const uint8_t *data, size_t length) {
+    auto &segments = this->current_.segments;
+    if (segments.empty() || segments.back().dc != dc)
+      segments.push_back({dc, {}});
+    segments.back().data.insert(segments.back().data.end(), data, data + length);
+  }
+
+  void record_transaction_(const SPITransaction &transaction) {
+    for (const auto &segment : transaction.get_segments()) {
+      if (transaction.get_dc_pin() != nullptr)
+        transaction.get_dc_pin()->digital_write(segment.dc);
+      this->append_(segment.dc, transaction.get_data(segment), segment.length);
+    }
+  }
+
+  MockSPIBus *bus_;
+  MockSPITransfer current_{};
+  std::vector<Pending> pending_;
+};
+
+SPIDelegate *MockSPIBus::get_delegate(uint32_t data_rate, SPIBitOrder bit_order, SPIMode mode, GPIOPin *cs_pin) {
+  return new MockSPIDelegate(this, data_rate, bit_order, mode, cs_pin);  // NOLINT
+}
+
+void MockSPIBus::record_(MockSPITransfer &&transfer, uint32_t data_rate) {
+  this->stats_.transfers++;
+  for (const auto &segment : transfer.segments) {
+    this->stats_.segments++;
+    this->stats_.bytes += segment.data.size();
+    this->stats_.bus_time_us += uint64_t(segment.data.size()) * 8 * 1000000 / data_rate;
+  }
+  if (this->record_limit_ == 0)
+    return;
+  if (this->transfers_.size() == this->record_limit_)
+    this->transfers_.pop_front();
+  this->transfers_.push_back(std::move(transfer));
+}
+
+}  // namespace spi
+}  // namespace esphome
+
+#endif  // USE_HOST
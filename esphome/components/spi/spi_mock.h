@@ -0,0 +1,70 @@
+#pragma once
+
+#ifdef USE_HOST
+
+#include "spi.h"
+
+#include <deque>
+
+namespace esphome {
+namespace spi {
+
+/// Bytes sent with the data/command pin at one level.
+struct MockSPISegment {
+  int8_t dc;  ///< level of the data/command pin, -1 if written outside of an SPITransaction
+  std::vector<uint8_t> data;
+};
+
+/// Everything sent to a device while its CS was asserted.
+struct MockSPITransfer {
+  std::vector<MockSPISegment> segments;
+  bool queued;  ///< sent with SPIDevice::submit_transaction()
+};
+
+/// Statistics of a MockSPIBus.
+struct MockSPIStats {
+  uint32_t transfers{0};  ///< number of times CS was asserted
+  uint32_t segments{0};
+  uint32_t bytes{0};
+  uint64_t bus_time_us{0};  ///< time the bytes take at the data rate of their device, without setup overhead
+};
+
+/** SPI bus for the host platform that keeps statistics of everything written instead of sending it.
+ *
+ * The transfers themselves are only kept after set_record_limit(), and only the newest ones, so a display refreshing
+ * forever doesn't fill the memory. Submitted transactions complete on the next loop of the SPI component and are
+ * recorded at that point, so changing their referenced data too early shows up in the recording.
+ */
+class MockSPIBus : public SPIBus {
+ public:
+  SPIDelegate *get_delegate(uint32_t data_rate, SPIBitOrder bit_order, SPIMode mode, GPIOPin *cs_pin) override;
+  bool is_hw() override { return false; }
+
+  /// Keep the last `limit` transfers, 0 (the default) keeps none.
+  void set_record_limit(size_t limit) {
+    this->record_limit_ = limit;
+    while (this->transfers_.size() > limit)
+      this->transfers_.pop_front();
+  }
+  const std::deque<MockSPITransfer> &get_transfers() const { return this->transfers_; }
+  const MockSPIStats &get_stats() const { return this->stats_; }
+  /// Forget the recorded transfers and reset the statistics.
+  void clear() {
+    this->transfers_.clear();
+    this->stats_ = {};
+  }
+
+ protected:
+  friend class MockSPIDelegate;
+
+  void record_(MockSPITransfer &&transfer, uint32_t data_rate);
+
+  std::deque<MockSPITransfer> transfers_;
+  size_t record_limit_{0};
+  MockSPIStats stats_;
+};
+
+}  // namespace spi
+}  // namespace esphome
+
+#endif  // USE_HOST
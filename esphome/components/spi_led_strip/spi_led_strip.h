@@ -33,6 +33,16 @@ class SpiLedStrip : public light::AddressableLight,
       return;
     }
 
+#ifdef USE_ESP_IDF
+    // the frame being sent by DMA, so the next one can be prepared meanwhile
+    this->tx_buf_ = allocator.allocate(this->buffer_size_);
+    if (this->tx_buf_ == nullptr) {
+      esph_log_e(TAG, "Failed to allocate buffer of size %u", this->buffer_size_);
+      this->mark_failed();
+      return;
+    }
+#endif
+
     this->effect_data_ = allocator.allocate(num_leds);
     if (this->effect_data_ == nullptr) {
       esph_log_e(TAG, "Failed to allocate effect data of size %u", num_leds);
@@ -65,9 +75,18 @@ class SpiLedStrip : public light::AddressableLight,
       }
       esph_log_v(TAG, "write_state: buf = %s", strbuf);
     }
-    this->enable();
-    this->write_array(this->buf_, this->buffer_size_);
-    this->disable();
+    spi::SPITransaction transaction;
+#ifdef USE_ESP_IDF
+    // the previous frame may still be sending from tx_buf_
+    this->wait_for_transactions();
+    memcpy(this->tx_buf_, this->buf_, this->buffer_size_);
+    transaction.data(this->tx_buf_, this->buffer_size_);
+    this->submit_transaction(std::move(transaction));
+#else
+    // transactions are sent synchronously here, a second buffer wouldn't gain anything
+    transaction.data(this->buf_, this->buffer_size_);
+    this->write_transaction(transaction);
+#endif
   }
 
   void clear_effect_data() override {
@@ -85,6 +104,9 @@ class SpiLedStrip : public light::AddressableLight,
   size_t buffer_size_{};
   uint8_t *effect_data_{nullptr};
   uint8_t *buf_{nullptr};
+#ifdef USE_ESP_IDF
+  uint8_t *tx_buf_{nullptr};
+#endif
   uint16_t num_leds_;
 };
 
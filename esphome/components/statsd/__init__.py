@@ -2,6 +2,7 @@ import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import sensor, binary_sensor
 from esphome.const import (
+    CONF_DELTA,
     CONF_ID,
     CONF_PORT,
     CONF_NAME,
@@ -39,6 +40,7 @@ CONFIG_SCHEMA = cv.Schema(
         cv.Required(CONF_HOST): cv.string_strict,
         cv.Optional(CONF_PORT, default=8125): cv.port,
         cv.Optional(CONF_PREFIX, default=""): cv.string_strict,
+        cv.Optional(CONF_DELTA): cv.positive_float,
         cv.Optional(CONF_SENSORS): cv.ensure_list(CONFIG_SENSORS_SCHEMA),
         cv.Optional(CONF_BINARY_SENSORS): cv.ensure_list(CONFIG_BINARY_SENSORS_SCHEMA),
     }
@@ -55,6 +57,8 @@ async def to_code(config):
             config.get(CONF_PREFIX),
         )
     )
+    if (delta := config.get(CONF_DELTA)) is not None:
+        cg.add(var.set_delta(delta))
 
     for sensor_cfg in config.get(CONF_SENSORS, []):
         s = await cg.get_variable(sensor_cfg[CONF_ID])
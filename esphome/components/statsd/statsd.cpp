@@ -1,3 +1,6 @@
+#include <cmath>
+#include <cstring>
+
 #include "esphome/core/log.h"
 
 #include "statsd.h"
@@ -5,13 +8,20 @@
 namespace esphome {
 namespace statsd {
 
-// send UDP packet if we reach 1Kb packed size
+// largest UDP packet we send
 // this is needed since statsD does not support fragmented UDP packets
-static const uint16_t SEND_THRESHOLD = 1024;
+static const size_t MAX_PACKET_SIZE = 1024;
 
 static const char *const TAG = "statsD";
 
+static bool value_changed(float last, float value, float delta) {
+  if (std::isnan(last) || std::isnan(value))
+    return std::isnan(last) != std::isnan(value);
+  return std::fabs(value - last) > delta;
+}
+
 void StatsdComponent::setup() {
+  this->batch_.init(MAX_PACKET_SIZE, socket::DEFAULT_BATCH_DEPTH);
 #ifndef USE_ESP8266
   this->sock_ = esphome::socket::socket(AF_INET, SOCK_DGRAM, 0);
 
@@ -43,6 +53,9 @@ void StatsdComponent::dump_config() {
   if (this->prefix_) {
     ESP_LOGCONFIG(TAG, "  prefix: %s", this->prefix_);
   }
+  if (this->delta_.has_value()) {
+    ESP_LOGCONFIG(TAG, "  delta: %f", *this->delta_);
+  }
 
   ESP_LOGCONFIG(TAG, "  metrics:");
   for (sensors_t s : this->sensors_) {
@@ -59,6 +72,7 @@ void StatsdComponent::register_sensor(const char *name, esphome::sensor::Sensor
   s.name = name;
   s.sensor = sensor;
   s.type = TYPE_SENSOR;
+  s.last_sent = NAN;
   this->sensors_.push_back(s);
 }
 #endif
@@ -69,16 +83,14 @@ void StatsdComponent::register_binary_sensor(const char *name, esphome::binary_s
   s.name = name;
   s.binary_sensor = binary_sensor;
   s.type = TYPE_BINARY_SENSOR;
+  s.last_sent = NAN;
   this->sensors_.push_back(s);
 }
 #endif
 
 void StatsdComponent::update() {
-  std::string out;
-  out.reserve(SEND_THRESHOLD);
-
-  for (sensors_t s : this->sensors_) {
-    double val = 0;
+  for (sensors_t &s : this->sensors_) {
+    float val = 0;
     switch (s.type) {
 #ifdef USE_SENSOR
       case TYPE_SENSOR:
@@ -93,7 +105,7 @@ void StatsdComponent::update() {
         if (!s.binary_sensor->has_state()) {
           continue;
         }
-        // map bool to double
+        // map bool to float
         if (s.binary_sensor->state) {
           val = 1;
         }
@@ -104,52 +116,85 @@ void StatsdComponent::update() {
         continue;
     }
 
-    // statsD gauge:
-    // https://github.com/statsd/statsd/blob/master/docs/metric_types.md
-    // This implies you can't explicitly set a gauge to a negative number without first setting it to zero.
-    if (val < 0) {
-      if (this->prefix_) {
-        out.append(str_sprintf("%s.", this->prefix_));
-      }
-      out.append(str_sprintf("%s:0|g\n", s.name));
+    // statsD keeps the last value of a gauge, so an unchanged one needn't be sent again
+    if (this->delta_.has_value() && !value_changed(s.last_sent, val, *this->delta_)) {
+      continue;
     }
-    if (this->prefix_) {
-      out.append(str_sprintf("%s.", this->prefix_));
-    }
-    out.append(str_sprintf("%s:%f|g\n", s.name, val));
+    s.last_sent = val;
+    this->add_metric_(s.name, val);
+  }
+
+  if (this->batch_.size() != 0) {
+    this->batch_.close();
+  }
+  this->send_();
+}
 
-    if (out.length() > SEND_THRESHOLD) {
-      this->send_(&out);
-      out.clear();
+void StatsdComponent::add_metric_(const char *name, float value) {
+  char buf[FLOAT_BUF_SIZE];
+  size_t value_len = float_to_buf(buf, sizeof(buf), value);
+  size_t prefix_len = this->prefix_ != nullptr ? strlen(this->prefix_) : 0;
+  size_t name_len = (prefix_len != 0 ? prefix_len + 1 : 0) + strlen(name);
+
+  // statsD gauge:
+  // https://github.com/statsd/statsd/blob/master/docs/metric_types.md
+  // This implies you can't explicitly set a gauge to a negative number without first setting it to zero.
+  bool reset = value < 0;
+  // "name:value|g\n", preceded by "name:0|g\n" for a negative value
+  size_t len = name_len + value_len + 4 + (reset ? name_len + 5 : 0);
+  if (len > MAX_PACKET_SIZE) {
+    ESP_LOGW(TAG, "Metric %s is too long to send", name);
+    return;
+  }
+  if (!this->batch_.fits(len)) {
+    this->batch_.close();
+    if (this->batch_.full()) {
+      this->send_();
     }
   }
 
-  this->send_(&out);
+  auto append_name = [&]() {
+    if (prefix_len != 0) {
+      this->batch_.append(this->prefix_, prefix_len);
+      this->batch_.append('.');
+    }
+    this->batch_.append(name, strlen(name));
+  };
+  if (reset) {
+    append_name();
+    this->batch_.append(":0|g\n", 5);
+  }
+  append_name();
+  this->batch_.append(':');
+  this->batch_.append(buf, value_len);
+  this->batch_.append("|g\n", 3);
 }
 
-void StatsdComponent::send_(std::string *out) {
-  if (out->empty()) {
+void StatsdComponent::send_() {
+  size_t count = this->batch_.count();
+  if (count == 0) {
     return;
   }
 #ifdef USE_ESP8266
   IPAddress ip;
   ip.fromString(this->host_);
 
-  this->sock_.beginPacket(ip, this->port_);
-  this->sock_.write((const uint8_t *) out->c_str(), out->length());
-  this->sock_.endPacket();
-
-#else
-  if (!this->sock_) {
-    return;
+  for (size_t i = 0; i != count; i++) {
+    this->sock_.beginPacket(ip, this->port_);
+    this->sock_.write(this->batch_.datagram(i), this->batch_.datagram_size(i));
+    this->sock_.endPacket();
   }
 
-  int n_bytes = this->sock_->sendto(out->c_str(), out->length(), 0, reinterpret_cast<sockaddr *>(&this->destination_),
-                                    sizeof(this->destination_));
-  if (n_bytes != out->length()) {
-    ESP_LOGE(TAG, "Failed to send UDP packed (%d of %d)", n_bytes, out->length());
+#else
+  if (this->sock_) {
+    int sent = this->batch_.send(this->sock_.get(), reinterpret_cast<sockaddr *>(&this->destination_),
+                                 sizeof(this->destination_));
+    if (sent != (int) count) {
+      ESP_LOGE(TAG, "Failed to send UDP packets (%d of %u)", sent, (unsigned) count);
+    }
   }
 #endif
+  this->batch_.clear();
 }
 
 }  // namespace statsd
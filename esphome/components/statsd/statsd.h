@@ -5,6 +5,7 @@
 #include "esphome/core/defines.h"
 #include "esphome/core/component.h"
 #include "esphome/components/socket/socket.h"
+#include "esphome/components/socket/datagram_batch.h"
 #include "esphome/components/network/ip_address.h"
 
 #ifdef USE_SENSOR
@@ -32,6 +33,7 @@ using sensor_type_t = enum { TYPE_SENSOR, TYPE_BINARY_SENSOR };
 using sensors_t = struct {
   const char *name;
   sensor_type_t type;
+  float last_sent;
   union {
 #ifdef USE_SENSOR
     esphome::sensor::Sensor *sensor;
@@ -56,6 +58,8 @@ class StatsdComponent : public PollingComponent {
     this->port_ = port;
     this->prefix_ = prefix;
   }
+  /// Only send metrics whose value moved by more than @p delta since they were last sent.
+  void set_delta(float delta) { this->delta_ = delta; }
 
 #ifdef USE_SENSOR
   void register_sensor(const char *name, esphome::sensor::Sensor *sensor);
@@ -69,8 +73,10 @@ class StatsdComponent : public PollingComponent {
   const char *host_;
   const char *prefix_;
   uint16_t port_;
+  optional<float> delta_{};
 
   std::vector<sensors_t> sensors_;
+  socket::DatagramBatch batch_;
 
 #ifdef USE_ESP8266
   WiFiUDP sock_;
@@ -79,7 +85,8 @@ class StatsdComponent : public PollingComponent {
   struct sockaddr_in destination_;
 #endif
 
-  void send_(std::string *out);
+  void add_metric_(const char *name, float value);
+  void send_();
 };
 
 }  // namespace statsd
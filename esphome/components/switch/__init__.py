@@ -160,7 +160,7 @@ async def setup_switch_core_(var, config):
         await web_server.add_entity_config(var, web_server_config)
 
     if (device_class := config.get(CONF_DEVICE_CLASS)) is not None:
-        cg.add(var.set_device_class(device_class))
+        cg.add(var.set_device_class(cg.entity_string(device_class)))
 
     cg.add(var.set_restore_mode(config[CONF_RESTORE_MODE]))
 
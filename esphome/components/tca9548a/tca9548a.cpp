@@ -7,21 +7,42 @@ namespace tca9548a {
 static const char *const TAG = "tca9548a";
 
 i2c::ErrorCode TCA9548AChannel::readv(uint8_t address, i2c::ReadBuffer *buffers, size_t cnt) {
+  // Queued transactions of the parent bus must not switch the channel in between
+  this->hold();
   auto err = this->parent_->switch_to_channel(channel_);
-  if (err != i2c::ERROR_OK)
-    return err;
-  err = this->parent_->bus_->readv(address, buffers, cnt);
-  this->parent_->disable_all_channels();
+  if (err == i2c::ERROR_OK) {
+    err = this->parent_->bus_->readv(address, buffers, cnt);
+    this->parent_->disable_all_channels();
+  }
+  this->release();
   return err;
 }
 i2c::ErrorCode TCA9548AChannel::writev(uint8_t address, i2c::WriteBuffer *buffers, size_t cnt, bool stop) {
+  this->hold();
   auto err = this->parent_->switch_to_channel(channel_);
-  if (err != i2c::ERROR_OK)
-    return err;
-  err = this->parent_->bus_->writev(address, buffers, cnt, stop);
-  this->parent_->disable_all_channels();
+  if (err == i2c::ERROR_OK) {
+    err = this->parent_->bus_->writev(address, buffers, cnt, stop);
+    this->parent_->disable_all_channels();
+  }
+  this->release();
   return err;
 }
+void TCA9548AChannel::submit(i2c::I2CTransaction &&transaction) {
+  // The parent bus executes its queue in order, so switching the channel around the transaction is enough
+  i2c::I2CTransaction select;
+  select.address = this->parent_->address_;
+  select.header[0] = 1 << this->channel_;
+  select.header_len = 1;
+  this->parent_->bus_->submit(std::move(select));
+  this->parent_->bus_->submit(std::move(transaction));
+  i2c::I2CTransaction disable;
+  disable.address = this->parent_->address_;
+  disable.header[0] = TCA9548A_DISABLE_CHANNELS_COMMAND;
+  disable.header_len = 1;
+  this->parent_->bus_->submit(std::move(disable));
+}
+void TCA9548AChannel::hold() { this->parent_->bus_->hold(); }
+void TCA9548AChannel::release() { this->parent_->bus_->release(); }
 
 void TCA9548AComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up TCA9548A...");
@@ -34,6 +34,9 @@ async def to_code(config):
             lamb, [], return_type=cg.optional.template(bool)
         )
         cg.add(var.set_template(template_))
+        dependencies = await automation.lambda_dependencies(lamb, [], config[CONF_ID])
+        for dependency in dependencies or []:
+            cg.add(var.add_dependency(dependency))
     if condition := config.get(CONF_CONDITION):
         condition = await automation.build_condition(
             condition, cg.TemplateArguments(), []
@@ -42,6 +45,7 @@ async def to_code(config):
             f"return {condition.check()};", [], return_type=cg.optional.template(bool)
         )
         cg.add(var.set_template(template_))
+        cg.add(var.watch_condition(condition))
 
 
 @automation.register_action(
@@ -17,15 +17,20 @@ void TemplateBinarySensor::setup() {
   }
 }
 void TemplateBinarySensor::loop() {
-  if (this->f_ == nullptr)
+  if (this->f_ == nullptr || (this->reactive_ && !this->changed_))
     return;
+  this->changed_ = false;
 
   auto s = this->f_();
   if (s.has_value()) {
     this->publish_state(*s);
   }
 }
-void TemplateBinarySensor::dump_config() { LOG_BINARY_SENSOR("", "Template Binary Sensor", this); }
+void TemplateBinarySensor::dump_config() {
+  LOG_BINARY_SENSOR("", "Template Binary Sensor", this);
+  if (this->reactive_)
+    ESP_LOGCONFIG(TAG, "  Evaluated when its dependencies change");
+}
 
 }  // namespace template_
 }  // namespace esphome
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "esphome/core/automation.h"
 #include "esphome/core/component.h"
 #include "esphome/components/binary_sensor/binary_sensor.h"
 
@@ -9,6 +10,16 @@ namespace template_ {
 class TemplateBinarySensor : public Component, public binary_sensor::BinarySensor {
  public:
   void set_template(std::function<optional<bool>()> &&f) { this->f_ = f; }
+  /// Evaluate the template only after `entity` published a state, set for every entity read by the lambda if the code
+  /// generator found that it doesn't read anything else.
+  template<typename T> void add_dependency(T *entity) {
+    this->reactive_ = true;
+    on_entity_state(entity, [this]() { this->changed_ = true; });
+  }
+  /// Evaluate the template only after the condition it checks may have changed, if the condition can be watched.
+  void watch_condition(Condition<> *condition) {
+    this->reactive_ = condition->watch([this]() { this->changed_ = true; });
+  }
 
   void setup() override;
   void loop() override;
@@ -18,6 +29,8 @@ class TemplateBinarySensor : public Component, public binary_sensor::BinarySenso
 
  protected:
   std::function<optional<bool>()> f_{nullptr};
+  bool reactive_{false};
+  bool changed_{true};  ///< a dependency published since the last evaluation
 };
 
 }  // namespace template_
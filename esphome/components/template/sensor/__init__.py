@@ -1,3 +1,5 @@
+import logging
+
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome import automation
@@ -6,9 +8,14 @@ from esphome.const import (
     CONF_ID,
     CONF_LAMBDA,
     CONF_STATE,
+    CONF_UPDATE_INTERVAL,
 )
 from .. import template_ns
 
+_LOGGER = logging.getLogger(__name__)
+
+CONF_UPDATE_ON_CHANGE = "update_on_change"
+
 TemplateSensor = template_ns.class_(
     "TemplateSensor", sensor.Sensor, cg.PollingComponent
 )
@@ -21,9 +28,12 @@ CONFIG_SCHEMA = (
     .extend(
         {
             cv.Optional(CONF_LAMBDA): cv.returning_lambda,
+            cv.Optional(CONF_UPDATE_ON_CHANGE, default=False): cv.boolean,
+            # 60s, or never if the lambda is evaluated on change
+            cv.Optional(CONF_UPDATE_INTERVAL): cv.update_interval,
         }
     )
-    .extend(cv.polling_component_schema("60s"))
+    .extend(cv.COMPONENT_SCHEMA)
 )
 
 
@@ -37,6 +47,24 @@ async def to_code(config):
         )
         cg.add(var.set_template(template_))
 
+    # Updating on every publish of a dependency may publish far more often than polling
+    dependencies = None
+    if config[CONF_UPDATE_ON_CHANGE]:
+        if CONF_LAMBDA in config:
+            dependencies = await automation.lambda_dependencies(
+                config[CONF_LAMBDA], [], config[CONF_ID]
+            )
+        if dependencies is None:
+            _LOGGER.warning(
+                "'%s': the lambda reads more than entity states, polling it instead",
+                config[CONF_ID],
+            )
+        for dependency in dependencies or []:
+            cg.add(var.add_dependency(dependency))
+    if CONF_UPDATE_INTERVAL not in config:
+        interval = "never" if dependencies else "60s"
+        cg.add(var.set_update_interval(cv.update_interval(interval)))
+
 
 @automation.register_action(
     "sensor.template.publish",
@@ -7,6 +7,11 @@ namespace template_ {
 
 static const char *const TAG = "template.sensor";
 
+void TemplateSensor::setup() {
+  if (this->reactive_)
+    this->request_update_();
+}
+
 void TemplateSensor::update() {
   if (!this->f_.has_value())
     return;
@@ -16,11 +21,22 @@ void TemplateSensor::update() {
     this->publish_state(*val);
   }
 }
+void TemplateSensor::request_update_() {
+  if (this->update_pending_)
+    return;
+  this->update_pending_ = true;
+  this->defer([this]() {
+    this->update_pending_ = false;
+    this->update();
+  });
+}
 float TemplateSensor::get_setup_priority() const { return setup_priority::HARDWARE; }
 void TemplateSensor::set_template(std::function<optional<float>()> &&f) { this->f_ = f; }
 void TemplateSensor::dump_config() {
   LOG_SENSOR("", "Template Sensor", this);
   LOG_UPDATE_INTERVAL(this);
+  if (this->reactive_)
+    ESP_LOGCONFIG(TAG, "  Updated when its dependencies change");
 }
 
 }  // namespace template_
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "esphome/core/automation.h"
 #include "esphome/core/component.h"
 #include "esphome/components/sensor/sensor.h"
 
@@ -9,7 +10,14 @@ namespace template_ {
 class TemplateSensor : public sensor::Sensor, public PollingComponent {
  public:
   void set_template(std::function<optional<float>()> &&f);
-
+  /// Update whenever `entity` publishes a state, set for every entity read by the lambda with `update_on_change` if the
+  /// code generator found that it doesn't read anything else.
+  template<typename T> void add_dependency(T *entity) {
+    this->reactive_ = true;
+    on_entity_state(entity, [this]() { this->request_update_(); });
+  }
+
+  void setup() override;
   void update() override;
 
   void dump_config() override;
@@ -17,7 +25,12 @@ class TemplateSensor : public sensor::Sensor, public PollingComponent {
   float get_setup_priority() const override;
 
  protected:
+  /// Update from the next loop, several dependencies changing at once cause a single update.
+  void request_update_();
+
   optional<std::function<optional<float>()>> f_;
+  bool reactive_{false};
+  bool update_pending_{false};
 };
 
 }  // namespace template_
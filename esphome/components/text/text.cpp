@@ -18,9 +18,5 @@ void Text::publish_state(const std::string &state) {
   this->state_callback_.call(state);
 }
 
-void Text::add_on_state_callback(std::function<void(std::string)> &&callback) {
-  this->state_callback_.add(std::move(callback));
-}
-
 }  // namespace text
 }  // namespace esphome
@@ -30,6 +30,12 @@ template<typename... Ts> class TextSensorStateCondition : public Condition<Ts...
   TEMPLATABLE_VALUE(std::string, state)
 
   bool check(Ts... x) override { return this->parent_->state == this->state_.value(x...); }
+  bool watch(const std::function<void()> &callback) override {
+    if (this->state_.is_lambda())
+      return false;
+    this->parent_->add_on_state_callback([callback](const std::string &state) { callback(); });
+    return true;
+  }
 
  protected:
   TextSensor *parent_;
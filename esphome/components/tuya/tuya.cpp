@@ -20,8 +20,21 @@ static const char *const TAG = "tuya";
 static const int COMMAND_DELAY = 10;
 static const int RECEIVE_TIMEOUT = 300;
 static const int MAX_RETRIES = 5;
+static const uint8_t FRAME_HEADER[2] = {0x55, 0xAA};
 
 void Tuya::setup() {
+  uart::FrameFormat format;
+  format.header = FRAME_HEADER;
+  format.header_len = sizeof(FRAME_HEADER);
+  format.length_offset = 4;
+  format.length_size = 2;
+  format.length_big_endian = true;
+  format.length_extra = 7;  // header, version, command, length and checksum
+  format.checksum = uart::FRAME_CHECKSUM_SUM8;
+  this->framer_.add_format(std::move(format),
+                           [this](const uint8_t *data, size_t len) { this->handle_frame_(data, len); });
+  this->framer_.set_timeout(RECEIVE_TIMEOUT);
+
   this->set_interval("heartbeat", 15000, [this] { this->send_empty_command_(TuyaCommandType::HEARTBEAT); });
   if (this->status_pin_ != nullptr) {
     this->status_pin_->digital_write(false);
@@ -29,11 +42,7 @@ void Tuya::setup() {
 }
 
 void Tuya::loop() {
-  while (this->available()) {
-    uint8_t c;
-    this->read_byte(&c);
-    this->handle_char_(c);
-  }
+  this->framer_.process(this);
   process_command_queue_();
 }
 
@@ -74,69 +83,18 @@ void Tuya::dump_config() {
   ESP_LOGCONFIG(TAG, "  Product: '%s'", this->product_.c_str());
 }
 
-bool Tuya::validate_message_() {
-  uint32_t at = this->rx_message_.size() - 1;
-  auto *data = &this->rx_message_[0];
-  uint8_t new_byte = data[at];
-
-  // Byte 0: HEADER1 (always 0x55)
-  if (at == 0)
-    return new_byte == 0x55;
-  // Byte 1: HEADER2 (always 0xAA)
-  if (at == 1)
-    return new_byte == 0xAA;
-
-  // Byte 2: VERSION
-  // no validation for the following fields:
+void Tuya::handle_frame_(const uint8_t *data, size_t len) {
+  // Byte 0-1: HEADER (0x55 0xAA), byte 2: VERSION, byte 3: COMMAND, byte 4-5: LENGTH,
+  // byte 6+LEN: CHECKSUM - sum of all bytes (including header) modulo 256, verified by the framer
   uint8_t version = data[2];
-  if (at == 2)
-    return true;
-  // Byte 3: COMMAND
   uint8_t command = data[3];
-  if (at == 3)
-    return true;
-
-  // Byte 4: LENGTH1
-  // Byte 5: LENGTH2
-  if (at <= 5) {
-    // no validation for these fields
-    return true;
-  }
-
-  uint16_t length = (uint16_t(data[4]) << 8) | (uint16_t(data[5]));
-
-  // wait until all data is read
-  if (at - 6 < length)
-    return true;
-
-  // Byte 6+LEN: CHECKSUM - sum of all bytes (including header) modulo 256
-  uint8_t rx_checksum = new_byte;
-  uint8_t calc_checksum = 0;
-  for (uint32_t i = 0; i < 6 + length; i++)
-    calc_checksum += data[i];
-
-  if (rx_checksum != calc_checksum) {
-    ESP_LOGW(TAG, "Tuya Received invalid message checksum %02X!=%02X", rx_checksum, calc_checksum);
-    return false;
-  }
+  uint16_t length = len - 7;
 
   // valid message
   const uint8_t *message_data = data + 6;
   ESP_LOGV(TAG, "Received Tuya: CMD=0x%02X VERSION=%u DATA=[%s] INIT_STATE=%u", command, version,
            format_hex_pretty(message_data, length).c_str(), static_cast<uint8_t>(this->init_state_));
   this->handle_command_(command, version, message_data, length);
-
-  // return false to reset rx buffer
-  return false;
-}
-
-void Tuya::handle_char_(uint8_t c) {
-  this->rx_message_.push_back(c);
-  if (!this->validate_message_()) {
-    this->rx_message_.clear();
-  } else {
-    this->last_rx_char_timestamp_ = millis();
-  }
 }
 
 void Tuya::handle_command_(uint8_t command, uint8_t version, const uint8_t *buffer, size_t len) {
@@ -452,10 +410,6 @@ void Tuya::process_command_queue_() {
   uint32_t now = millis();
   uint32_t delay = now - this->last_command_timestamp_;
 
-  if (now - this->last_rx_char_timestamp_ > RECEIVE_TIMEOUT) {
-    this->rx_message_.clear();
-  }
-
   if (this->expected_response_.has_value() && delay > RECEIVE_TIMEOUT) {
     this->expected_response_.reset();
     if (init_state_ != TuyaInitState::INIT_DONE) {
@@ -471,7 +425,7 @@ void Tuya::process_command_queue_() {
   }
 
   // Left check of delay since last command in case there's ever a command sent by calling send_raw_command_ directly
-  if (delay > COMMAND_DELAY && !this->command_queue_.empty() && this->rx_message_.empty() &&
+  if (delay > COMMAND_DELAY && !this->command_queue_.empty() && !this->framer_.is_receiving() &&
       !this->expected_response_.has_value()) {
     this->send_raw_command_(command_queue_.front());
     if (!this->expected_response_.has_value())
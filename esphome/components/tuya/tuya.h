@@ -7,6 +7,7 @@
 #include "esphome/core/defines.h"
 #include "esphome/core/helpers.h"
 #include "esphome/components/uart/uart.h"
+#include "esphome/components/uart/uart_framer.h"
 
 #ifdef USE_TIME
 #include "esphome/components/time/real_time_clock.h"
@@ -117,10 +118,9 @@ class Tuya : public Component, public uart::UARTDevice {
   }
 
  protected:
-  void handle_char_(uint8_t c);
+  void handle_frame_(const uint8_t *data, size_t len);
   void handle_datapoints_(const uint8_t *buffer, size_t len);
   optional<TuyaDatapoint> get_datapoint_(uint8_t datapoint_id);
-  bool validate_message_();
 
   void handle_command_(uint8_t command, uint8_t version, const uint8_t *buffer, size_t len);
   void send_raw_command_(TuyaCommand command);
@@ -150,11 +150,11 @@ class Tuya : public Component, public uart::UARTDevice {
   int status_pin_reported_ = -1;
   int reset_pin_reported_ = -1;
   uint32_t last_command_timestamp_ = 0;
-  uint32_t last_rx_char_timestamp_ = 0;
   std::string product_ = "";
   std::vector<TuyaDatapointListener> listeners_;
   std::vector<TuyaDatapoint> datapoints_;
-  std::vector<uint8_t> rx_message_;
+  // The length field allows 64 KiB, but MCU frames stay far below 1 KiB; longer ones are dropped with a warning
+  uart::UARTFramer framer_{1024};
   std::vector<uint8_t> ignore_mcu_update_on_datapoints_{};
   std::vector<TuyaCommand> command_queue_;
   optional<TuyaCommandType> expected_response_{};
@@ -39,6 +39,7 @@ class UARTDevice {
   }
 
   int available() { return this->parent_->available(); }
+  uint32_t get_rx_timestamp() { return this->parent_->get_rx_timestamp(); }
 
   void flush() { return this->parent_->flush(); }
 
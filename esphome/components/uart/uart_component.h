@@ -74,6 +74,10 @@ class UARTComponent {
   // Pure virtual method to block until all bytes have been written to the UART bus.
   virtual void flush() = 0;
 
+  // Returns when the driver reported the oldest unread data as received.
+  // @return Timestamp in microseconds (see micros()), 0 if the platform does not track it.
+  virtual uint32_t get_rx_timestamp() { return 0; }
+
   // Sets the TX (transmit) pin for the UART bus.
   // @param tx_pin Pointer to the internal GPIO pin used for transmission.
   void set_tx_pin(InternalGPIOPin *tx_pin) { this->tx_pin_ = tx_pin; }
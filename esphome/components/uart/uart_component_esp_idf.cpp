@@ -139,9 +139,38 @@ void IDFUARTComponent::setup() {
     return;
   }
 
+  if (xTaskCreate(IDFUARTComponent::rx_event_task, "uart_rx_event", 2048, this, 5, &this->rx_event_task_handle_) !=
+      pdPASS) {
+    // Without the task, available() keeps asking the driver on every call
+    ESP_LOGW(TAG, "Could not create RX event task, polling instead");
+    this->rx_event_task_handle_ = nullptr;
+  }
+
   xSemaphoreGive(this->lock_);
 }
 
+void IDFUARTComponent::rx_event_task(void *param) {
+  auto *uart = static_cast<IDFUARTComponent *>(param);
+  uart_event_t event;
+  while (true) {
+    if (xQueueReceive(uart->uart_event_queue_, &event, portMAX_DELAY) != pdTRUE)
+      continue;
+    switch (event.type) {
+      case UART_DATA:
+      case UART_BREAK:
+      case UART_PATTERN_DET:
+      case UART_FIFO_OVF:
+      case UART_BUFFER_FULL:
+        if (!uart->rx_pending_.exchange(true))
+          uart->rx_timestamp_ = micros();
+        App.wake_loop();
+        break;
+      default:
+        break;
+    }
+  }
+}
+
 void IDFUARTComponent::load_settings(bool dump_config) {
   uart_config_t uart_config = this->get_config_();
   esp_err_t err = uart_param_config(this->uart_num_, &uart_config);
@@ -224,8 +253,14 @@ bool IDFUARTComponent::read_array(uint8_t *data, size_t len) {
 int IDFUARTComponent::available() {
   size_t available;
 
+  // Cleared before asking the driver, so data arriving in between raises it again
+  if (this->rx_event_task_handle_ != nullptr && !this->rx_pending_.exchange(false))
+    return this->has_peek_ ? 1 : 0;
+
   xSemaphoreTake(this->lock_, portMAX_DELAY);
   uart_get_buffered_data_len(this->uart_num_, &available);
+  if (available != 0)
+    this->rx_pending_ = true;
   if (this->has_peek_)
     available++;
   xSemaphoreGive(this->lock_);
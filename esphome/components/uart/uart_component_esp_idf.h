@@ -3,6 +3,7 @@
 #ifdef USE_ESP_IDF
 
 #include <driver/uart.h>
+#include <atomic>
 #include "esphome/core/component.h"
 #include "uart_component.h"
 
@@ -22,6 +23,7 @@ class IDFUARTComponent : public UARTComponent, public Component {
 
   int available() override;
   void flush() override;
+  uint32_t get_rx_timestamp() override { return this->rx_timestamp_; }
 
   uint8_t get_hw_serial_number() { return this->uart_num_; }
   QueueHandle_t *get_uart_event_queue() { return &this->uart_event_queue_; }
@@ -50,6 +52,13 @@ class IDFUARTComponent : public UARTComponent, public Component {
 
   bool has_peek_{false};
   uint8_t peek_byte_;
+
+  /// Waits for driver events and wakes up the main loop when data arrives.
+  static void rx_event_task(void *param);
+  TaskHandle_t rx_event_task_handle_{nullptr};
+  /// Set by the event task on RX data, a break or a pattern match, cleared once the driver buffer has been drained.
+  std::atomic<bool> rx_pending_{true};
+  std::atomic<uint32_t> rx_timestamp_{0};
 };
 
 }  // namespace uart
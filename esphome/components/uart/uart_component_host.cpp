@@ -176,6 +176,15 @@ void HostUartComponent::setup() {
   cfsetispeed(&options, baud);
   cfsetospeed(&options, baud);
   tcsetattr(this->file_descriptor_, TCSANOW, &options);
+
+  // The main loop polls the port and wakes up when data arrives, available() only asks the kernel after that and
+  // hands the port back to the loop once it has been drained
+  App.register_wake_fd(this->file_descriptor_, [this]() {
+    if (!this->rx_ready_) {
+      this->rx_ready_ = true;
+      this->rx_timestamp_ = micros();
+    }
+  });
 }
 
 void HostUartComponent::dump_config() {
@@ -221,6 +230,8 @@ bool HostUartComponent::peek_byte(uint8_t *data) {
     return false;
   }
   if (!this->has_peek_) {
+    // A blocking read waits for bytes that have not been announced by the main loop yet
+    this->rx_ready_ = true;
     if (!this->check_read_timeout_()) {
       return false;
     }
@@ -238,6 +249,7 @@ bool HostUartComponent::read_array(uint8_t *data, size_t len) {
   if ((this->file_descriptor_ == -1) || (len == 0)) {
     return false;
   }
+  this->rx_ready_ = true;
   if (!this->check_read_timeout_(len))
     return false;
   uint8_t *data_ptr = data;
@@ -260,6 +272,8 @@ bool HostUartComponent::read_array(uint8_t *data, size_t len) {
     this->debug_callback_.call(UART_DIRECTION_RX, data[i]);
   }
 #endif
+  // Hands the port back to the loop if this emptied it
+  this->available();
   return true;
 }
 
@@ -267,12 +281,18 @@ int HostUartComponent::available() {
   if (this->file_descriptor_ == -1) {
     return 0;
   }
+  if (!this->rx_ready_)
+    return this->has_peek_ ? 1 : 0;
   int available;
   int res = ioctl(this->file_descriptor_, FIONREAD, &available);
   if (res == -1) {
     this->update_error_(strerror(errno));
     return 0;
   }
+  if (available == 0) {
+    this->rx_ready_ = false;
+    App.rearm_wake_fd(this->file_descriptor_);
+  }
   if (this->has_peek_)
     available++;
   return available;
@@ -20,6 +20,7 @@ class HostUartComponent : public UARTComponent, public Component {
   bool read_array(uint8_t *data, size_t len) override;
   int available() override;
   void flush() override;
+  uint32_t get_rx_timestamp() override { return this->rx_timestamp_; }
   void set_name(std::string port_name) { port_name_ = port_name; };
 
  protected:
@@ -30,6 +31,9 @@ class HostUartComponent : public UARTComponent, public Component {
   int file_descriptor_ = -1;
   bool has_peek_{false};
   uint8_t peek_byte_;
+  /// Set when poll() reported the port as readable, cleared once it has been drained.
+  bool rx_ready_{false};
+  uint32_t rx_timestamp_{0};
 };
 
 }  // namespace uart
@@ -0,0 +1,255 @@
+#include "uart_framer.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/log.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+
+namespace esphome {
+namespace uart {
+
+static const char *const TAG = "uart.framer";
+
+void LatencyHistogram::record(uint32_t latency_us) {
+  size_t bucket = 0;
+  while (bucket < BUCKETS - 1 && latency_us >= (128u << bucket))
+    bucket++;
+  this->counts_[bucket]++;
+}
+
+uint32_t LatencyHistogram::get_total() const {
+  uint32_t total = 0;
+  for (uint32_t count : this->counts_)
+    total += count;
+  return total;
+}
+
+uint32_t LatencyHistogram::get_percentile(uint8_t percent) const {
+  uint32_t total = this->get_total();
+  if (total == 0)
+    return 0;
+  uint64_t target = (uint64_t(total) * percent + 99) / 100;
+  uint32_t seen = 0;
+  for (size_t i = 0; i < BUCKETS; i++) {
+    seen += this->counts_[i];
+    if (seen >= target)
+      return 128u << i;
+  }
+  return 128u << (BUCKETS - 1);
+}
+
+void LatencyHistogram::log(const char *tag) const {
+  uint32_t total = this->get_total();
+  if (total == 0)
+    return;
+  ESP_LOGD(tag, "Frame latency: %" PRIu32 " frames, p50 < %" PRIu32 " us, p99 < %" PRIu32 " us", total,
+           this->get_percentile(50), this->get_percentile(99));
+  for (size_t i = 0; i < BUCKETS; i++) {
+    if (this->counts_[i] == 0)
+      continue;
+    if (i == BUCKETS - 1) {
+      ESP_LOGD(tag, "  >= %6" PRIu32 " us: %" PRIu32, 128u << (i - 1), this->counts_[i]);
+    } else {
+      ESP_LOGD(tag, "  <  %6" PRIu32 " us: %" PRIu32, 128u << i, this->counts_[i]);
+    }
+  }
+}
+
+void UARTFramer::add_format(FrameFormat format, frame_callback_t &&callback) {
+  int lead = format.header_len == 0 ? -1 : format.header[0];
+  if (this->handlers_.empty()) {
+    this->lead_byte_ = lead;
+  } else if (this->lead_byte_ != lead) {
+    this->lead_byte_ = -1;
+  }
+  this->handlers_.push_back({std::move(format), std::move(callback)});
+}
+
+void UARTFramer::process(UARTDevice *device) {
+  if (this->len_ != 0 && this->timeout_ != 0 && millis() - this->last_byte_ > this->timeout_) {
+    ESP_LOGV(TAG, "Dropping %zu bytes of an incomplete frame", this->len_);
+    this->len_ = 0;
+  }
+
+  int available;
+  while ((available = device->available()) > 0) {
+    size_t space = this->buffer_.size() - this->len_;
+    if (space == 0) {
+      // Still no frame in a full buffer, it can only be garbage
+      this->overflows_++;
+      this->len_ = 0;
+      space = this->buffer_.size();
+    }
+    size_t chunk = std::min(static_cast<size_t>(available), space);
+    if (this->len_ == 0)
+      this->rx_started_ = device->get_rx_timestamp();
+    if (!device->read_array(this->buffer_.data() + this->len_, chunk))
+      break;
+    this->len_ += chunk;
+    this->last_byte_ = millis();
+    this->scan_();
+  }
+}
+
+void UARTFramer::feed(const uint8_t *data, size_t len) {
+  while (len > 0) {
+    size_t space = this->buffer_.size() - this->len_;
+    if (space == 0) {
+      this->overflows_++;
+      this->len_ = 0;
+      space = this->buffer_.size();
+    }
+    size_t chunk = std::min(len, space);
+    if (this->len_ == 0)
+      this->rx_started_ = 0;
+    memcpy(this->buffer_.data() + this->len_, data, chunk);
+    this->len_ += chunk;
+    data += chunk;
+    len -= chunk;
+    this->last_byte_ = millis();
+    this->scan_();
+  }
+}
+
+int UARTFramer::match_(const Handler &handler, const uint8_t *data, size_t len) {
+  const FrameFormat &format = handler.format;
+  size_t header_len = std::min<size_t>(format.header_len, len);
+  if (header_len != 0 && memcmp(data, format.header, header_len) != 0)
+    return -1;
+  if (len < format.header_len)
+    return 0;
+
+  size_t frame_len;
+  if (format.length_size != 0) {
+    if (len < format.length_offset + format.length_size)
+      return 0;
+    const uint8_t *field = data + format.length_offset;
+    uint16_t value = field[0];
+    if (format.length_size == 2)
+      value = format.length_big_endian ? encode_uint16(field[0], field[1]) : encode_uint16(field[1], field[0]);
+    frame_len = value + format.length_extra;
+    if (frame_len > this->buffer_.size()) {
+      ESP_LOGW(TAG, "Dropping a %zu byte frame, the buffer holds %zu", frame_len, this->buffer_.size());
+      return -1;
+    }
+    if (len < frame_len)
+      return 0;
+    if (format.footer_len != 0 && memcmp(data + frame_len - format.footer_len, format.footer, format.footer_len) != 0)
+      return -1;
+  } else if (format.frame_length) {
+    int result = format.frame_length(data, len);
+    if (result <= 0)
+      return result;
+    frame_len = result;
+    if (frame_len > this->buffer_.size()) {
+      ESP_LOGW(TAG, "Dropping a %zu byte frame, the buffer holds %zu", frame_len, this->buffer_.size());
+      return -1;
+    }
+    // Never hand out a frame whose tail hasn't arrived yet
+    if (len < frame_len)
+      return 0;
+  } else if (format.footer_len != 0) {
+    const uint8_t *at = data + format.header_len;
+    const uint8_t *end = data + len;
+    while (true) {
+      at = static_cast<const uint8_t *>(memchr(at, format.footer[0], end - at));
+      if (at == nullptr || static_cast<size_t>(end - at) < format.footer_len)
+        return len >= this->buffer_.size() ? -1 : 0;
+      if (memcmp(at, format.footer, format.footer_len) == 0)
+        break;
+      at++;
+    }
+    frame_len = at - data + format.footer_len;
+  } else {
+    return -1;
+  }
+
+  size_t checked_len = frame_len - format.footer_len;
+  switch (format.checksum) {
+    case FRAME_CHECKSUM_NONE:
+      break;
+    case FRAME_CHECKSUM_SUM8: {
+      if (checked_len < 1)
+        return -1;
+      uint8_t sum = 0;
+      for (size_t i = 0; i < checked_len - 1; i++)
+        sum += data[i];
+      if (sum != data[checked_len - 1]) {
+        ESP_LOGW(TAG, "Invalid frame checksum %02X!=%02X", data[checked_len - 1], sum);
+        this->checksum_errors_++;
+        return -1;
+      }
+      break;
+    }
+    case FRAME_CHECKSUM_CRC16_MODBUS: {
+      if (checked_len < 2)
+        return -1;
+      uint16_t crc = crc16(data, checked_len - 2);
+      uint16_t remote = encode_uint16(data[checked_len - 1], data[checked_len - 2]);
+      if (crc != remote) {
+        ESP_LOGW(TAG, "Invalid frame CRC %04X!=%04X", remote, crc);
+        this->checksum_errors_++;
+        return -1;
+      }
+      break;
+    }
+  }
+  return frame_len;
+}
+
+size_t UARTFramer::next_candidate_(size_t from) const {
+  if (from >= this->len_)
+    return this->len_;
+  const uint8_t *data = this->buffer_.data();
+  if (this->lead_byte_ >= 0) {
+    const void *at = memchr(data + from, this->lead_byte_, this->len_ - from);
+    return at == nullptr ? this->len_ : static_cast<const uint8_t *>(at) - data;
+  }
+  for (size_t i = from; i < this->len_; i++) {
+    for (const auto &handler : this->handlers_) {
+      if (handler.format.header_len == 0 || data[i] == handler.format.header[0])
+        return i;
+    }
+  }
+  return this->len_;
+}
+
+void UARTFramer::scan_() {
+  uint8_t *data = this->buffer_.data();
+  size_t start = this->next_candidate_(0);
+  while (start < this->len_) {
+    const Handler *match = nullptr;
+    int frame_len = -1;
+    for (const auto &handler : this->handlers_) {
+      int result = this->match_(handler, data + start, this->len_ - start);
+      if (result > 0) {
+        match = &handler;
+        frame_len = result;
+        break;
+      }
+      if (result == 0)
+        frame_len = 0;
+    }
+    if (frame_len == 0)
+      break;  // Wait for the rest of the frame
+    if (match == nullptr) {
+      start = this->next_candidate_(start + 1);
+      continue;
+    }
+    if (this->rx_started_ != 0)
+      this->latency_.record(micros() - this->rx_started_);
+    match->callback(data + start, frame_len);
+    start += frame_len;
+    start = this->next_candidate_(start);
+  }
+
+  if (start != 0) {
+    this->len_ -= start;
+    memmove(data, data + start, this->len_);
+  }
+}
+
+}  // namespace uart
+}  // namespace esphome
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "uart.h"
+
+namespace esphome {
+namespace uart {
+
+/// Integrity check directly before the footer of a frame, covering every byte before it.
+enum FrameChecksum : uint8_t {
+  FRAME_CHECKSUM_NONE = 0,
+  FRAME_CHECKSUM_SUM8,          ///< 1 byte, sum of all preceding bytes modulo 256.
+  FRAME_CHECKSUM_CRC16_MODBUS,  ///< 2 bytes little endian, crc16() of all preceding bytes.
+};
+
+/** Declarative description of a binary frame.
+ *
+ * A frame starts with `header`. Its total size is either read from a length field, found by scanning for `footer`
+ * or, for protocols where neither works, computed by `frame_length`.
+ */
+struct FrameFormat {
+  const uint8_t *header{nullptr};
+  uint8_t header_len{0};
+  /// Offset of the length field from the start of the frame.
+  uint8_t length_offset{0};
+  /// Size of the length field in bytes (1 or 2), 0 if the frame has none.
+  uint8_t length_size{0};
+  bool length_big_endian{false};
+  /// Bytes in the frame besides the number given by the length field (header, length field, checksum, footer).
+  uint16_t length_extra{0};
+  FrameChecksum checksum{FRAME_CHECKSUM_NONE};
+  /// Bytes every frame ends with. Without a length field the frame ends at the first occurrence.
+  const uint8_t *footer{nullptr};
+  uint8_t footer_len{0};
+  /** Custom size detection for frames without length field or footer.
+   *
+   * Called with the buffered bytes starting at a candidate frame. Returns the frame size, 0 if more bytes are needed
+   * or -1 if the data cannot be the start of a frame.
+   */
+  std::function<int(const uint8_t *data, size_t len)> frame_length{};
+};
+
+/** Distribution of the delay between the UART driver announcing received data and the frame callback.
+ *
+ * Only platforms that timestamp RX data (see UARTComponent::get_rx_timestamp()) produce samples.
+ */
+class LatencyHistogram {
+ public:
+  /// Bucket `i` counts latencies below 2^(i + 7) us (128 us, 256 us, ...), the last one everything above.
+  static const size_t BUCKETS = 12;
+
+  void record(uint32_t latency_us);
+  void reset() { this->counts_.fill(0); }
+  uint32_t get_count(size_t bucket) const { return this->counts_[bucket]; }
+  uint32_t get_total() const;
+  /// Upper bound in us of the bucket the given percentile (0-100) falls into, 0 without samples.
+  uint32_t get_percentile(uint8_t percent) const;
+  /// Log the non-empty buckets with the given tag.
+  void log(const char *tag) const;
+
+ protected:
+  std::array<uint32_t, BUCKETS> counts_{};
+};
+
+/** Reassembles frames from a UART stream.
+ *
+ * Instead of handing every byte to a parser, process() reads everything the UART has buffered in one go, scans the
+ * buffer for frame headers and hands each complete frame to the callback of its format as one contiguous block.
+ * Garbage between frames and frames failing their checksum are skipped by resynchronizing on the next header.
+ */
+class UARTFramer {
+ public:
+  using frame_callback_t = std::function<void(const uint8_t *data, size_t len)>;
+
+  /// Create a framer that can hold up to `capacity` bytes, the size of the largest expected frame.
+  explicit UARTFramer(size_t capacity) : buffer_(capacity) {}
+
+  /// Deliver frames matching `format` to `callback`. Formats are tried in the order they were added.
+  void add_format(FrameFormat format, frame_callback_t &&callback);
+  /// Drop a partially received frame if no byte arrived for `timeout` ms, 0 to wait forever.
+  void set_timeout(uint32_t timeout) { this->timeout_ = timeout; }
+
+  /// Read all available bytes from `device` and dispatch the complete frames, call this from loop().
+  void process(UARTDevice *device);
+  /// Append bytes received by other means and dispatch the complete frames.
+  void feed(const uint8_t *data, size_t len);
+
+  /// Discard the partially received frame.
+  void reset() { this->len_ = 0; }
+  /// Whether part of a frame has been received.
+  bool is_receiving() const { return this->len_ != 0; }
+
+  uint32_t get_checksum_errors() const { return this->checksum_errors_; }
+  /// Number of times the buffer filled up without containing a frame and was discarded.
+  uint32_t get_overflows() const { return this->overflows_; }
+  /// Latency of the frames read by process().
+  const LatencyHistogram &get_latency() const { return this->latency_; }
+
+ protected:
+  struct Handler {
+    FrameFormat format;
+    frame_callback_t callback;
+  };
+
+  /// Size of the frame of `handler` at the start of `data`, 0 if incomplete, -1 if there is none.
+  int match_(const Handler &handler, const uint8_t *data, size_t len);
+  /// Position of the next byte at or after `from` that can start a frame.
+  size_t next_candidate_(size_t from) const;
+  /// Dispatch all complete frames and drop everything that cannot be part of one.
+  void scan_();
+
+  std::vector<uint8_t> buffer_;
+  size_t len_{0};
+  std::vector<Handler> handlers_;
+  /// First header byte shared by all formats, or -1 if any position can start a frame.
+  int lead_byte_{-1};
+  uint32_t timeout_{0};
+  uint32_t last_byte_{0};
+  uint32_t checksum_errors_{0};
+  uint32_t overflows_{0};
+  /// RX timestamp of the first buffered byte, 0 if unknown.
+  uint32_t rx_started_{0};
+  LatencyHistogram latency_;
+};
+
+}  // namespace uart
+}  // namespace esphome
@@ -7,6 +7,7 @@ from esphome.components.sensor import Sensor
 import esphome.config_validation as cv
 from esphome.const import (
     CONF_BINARY_SENSORS,
+    CONF_DELTA,
     CONF_ID,
     CONF_INTERNAL,
     CONF_KEY,
@@ -34,6 +35,9 @@ CONF_UDP_ID = "udp_id"
 CONF_PING_PONG_ENABLE = "ping_pong_enable"
 CONF_PING_PONG_RECYCLE_TIME = "ping_pong_recycle_time"
 CONF_ROLLING_CODE_ENABLE = "rolling_code_enable"
+CONF_ENCODING = "encoding"
+ENCODING_FULL = "full"
+ENCODING_COMPACT = "compact"
 
 
 def sensor_validation(cls: MockObjClass):
@@ -66,6 +70,19 @@ PROVIDER_SCHEMA = cv.Schema(
 ).extend(ENCRYPTION_SCHEMA)
 
 
+def fnv1_hash(value: str) -> int:
+    """Same as fnv1_hash() in esphome/core/helpers.cpp."""
+    result = 2166136261
+    for char in value.encode():
+        result = (result * 16777619) & 0xFFFFFFFF
+        result ^= char
+    return result
+
+
+def sensor_id(config):
+    return config.get(CONF_BROADCAST_ID, config[CONF_ID].id)
+
+
 def validate_(config):
     if CONF_ENCRYPTION in config:
         if CONF_SENSORS not in config and CONF_BINARY_SENSORS not in config:
@@ -75,6 +92,16 @@ def validate_(config):
     if config[CONF_PING_PONG_ENABLE]:
         if not any(CONF_ENCRYPTION in p for p in config.get(CONF_PROVIDERS) or ()):
             raise cv.Invalid("Ping-pong requires at least one encrypted provider")
+    if config[CONF_ENCODING] == ENCODING_COMPACT:
+        for key in (CONF_SENSORS, CONF_BINARY_SENSORS):
+            hashes = {}
+            for sens_conf in config.get(key, ()):
+                name = sensor_id(sens_conf)
+                other = hashes.setdefault(fnv1_hash(name), name)
+                if other != name:
+                    raise cv.Invalid(
+                        f"Compact encoding can't tell '{other}' from '{name}'", [key]
+                    )
     return config
 
 
@@ -89,6 +116,10 @@ CONFIG_SCHEMA = cv.All(
             ),
             cv.Optional(CONF_ROLLING_CODE_ENABLE, default=False): cv.boolean,
             cv.Optional(CONF_PING_PONG_ENABLE, default=False): cv.boolean,
+            cv.Optional(CONF_ENCODING, default=ENCODING_FULL): cv.one_of(
+                ENCODING_FULL, ENCODING_COMPACT, lower=True
+            ),
+            cv.Optional(CONF_DELTA): cv.positive_float,
             cv.Optional(
                 CONF_PING_PONG_RECYCLE_TIME, default="600s"
             ): cv.positive_time_period_seconds,
@@ -135,16 +166,15 @@ async def to_code(config):
             config[CONF_PING_PONG_RECYCLE_TIME].total_seconds
         )
     )
+    cg.add(var.set_compact(config[CONF_ENCODING] == ENCODING_COMPACT))
+    if (delta := config.get(CONF_DELTA)) is not None:
+        cg.add(var.set_delta(delta))
     for sens_conf in config.get(CONF_SENSORS, ()):
-        sens_id = sens_conf[CONF_ID]
-        sensor = await cg.get_variable(sens_id)
-        bcst_id = sens_conf.get(CONF_BROADCAST_ID, sens_id.id)
-        cg.add(var.add_sensor(bcst_id, sensor))
+        sensor = await cg.get_variable(sens_conf[CONF_ID])
+        cg.add(var.add_sensor(sensor_id(sens_conf), sensor))
     for sens_conf in config.get(CONF_BINARY_SENSORS, ()):
-        sens_id = sens_conf[CONF_ID]
-        sensor = await cg.get_variable(sens_id)
-        bcst_id = sens_conf.get(CONF_BROADCAST_ID, sens_id.id)
-        cg.add(var.add_binary_sensor(bcst_id, sensor))
+        sensor = await cg.get_variable(sens_conf[CONF_ID])
+        cg.add(var.add_binary_sensor(sensor_id(sens_conf), sensor))
     for address in config[CONF_ADDRESSES]:
         cg.add(var.add_address(str(address)))
 
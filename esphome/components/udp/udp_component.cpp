@@ -28,12 +28,20 @@ namespace udp {
  *      float value: 4 bytes
  *      name length: 1 byte
  *      name
+ *  or, with compact encoding:
+ *      SENSOR_HASH_KEY: 1 byte
+ *      name hash (fnv1): 4 bytes
+ *      float value: 4 bytes
  * Binary Sensors:
  * repeat:
  *      BINARY_SENSOR_KEY: 1 byte
  *      bool value: 1 bytes
  *      name length: 1 byte
  *      name
+ *  or, with compact encoding:
+ *      BINARY_SENSOR_HASH_KEY: 1 byte
+ *      name hash (fnv1): 4 bytes
+ *      bool value: 1 byte
  *
  * Padded to a 4 byte boundary with nulls
  *
@@ -112,6 +120,8 @@ enum DataKey {
   BINARY_SENSOR_KEY,
   PING_KEY,
   ROLLING_CODE_KEY,
+  SENSOR_HASH_KEY,
+  BINARY_SENSOR_HASH_KEY,
 };
 
 static const size_t MAX_PING_KEYS = 4;
@@ -151,6 +161,24 @@ static void add(std::vector<uint8_t> &vec, const char *str) {
   }
 }
 
+static inline void add(socket::DatagramBatch &batch, uint32_t data) {
+  const uint8_t bytes[4] = {(uint8_t) data, (uint8_t) (data >> 8), (uint8_t) (data >> 16), (uint8_t) (data >> 24)};
+  batch.append(bytes, sizeof(bytes));
+}
+static inline void add(socket::DatagramBatch &batch, uint8_t data) { batch.append(data); }
+static inline void add(socket::DatagramBatch &batch, DataKey data) { batch.append((uint8_t) data); }
+static void add(socket::DatagramBatch &batch, const char *str) {
+  auto len = strlen(str);
+  batch.append((uint8_t) len);
+  batch.append(str, len);
+}
+
+static bool value_changed(float last, float value, float delta) {
+  if (std::isnan(last) || std::isnan(value))
+    return std::isnan(last) != std::isnan(value);
+  return std::fabs(value - last) > delta;
+}
+
 void UDPComponent::setup() {
   this->name_ = App.get_name().c_str();
   if (strlen(this->name_) > 255) {
@@ -168,7 +196,11 @@ void UDPComponent::setup() {
   ESP_LOGV(TAG, "Rolling code incremented, upper part now %u", (unsigned) this->rolling_code_[1]);
 #ifdef USE_SENSOR
   for (auto &sensor : this->sensors_) {
+    if (this->compact_)
+      sensor.id_hash = fnv1_hash(sensor.id);
     sensor.sensor->add_on_state_callback([this, &sensor](float x) {
+      if (this->delta_.has_value() && !value_changed(sensor.last_sent, x, *this->delta_))
+        return;
       this->updated_ = true;
       sensor.updated = true;
     });
@@ -176,6 +208,8 @@ void UDPComponent::setup() {
 #endif
 #ifdef USE_BINARY_SENSOR
   for (auto &sensor : this->binary_sensors_) {
+    if (this->compact_)
+      sensor.id_hash = fnv1_hash(sensor.id);
     sensor.sensor->add_on_state_callback([this, &sensor](bool value) {
       this->updated_ = true;
       sensor.updated = true;
@@ -196,6 +230,8 @@ void UDPComponent::setup() {
   // pad to a multiple of 4 bytes
   while (this->header_.size() & 0x3)
     this->header_.push_back(0);
+  if (this->should_send_)
+    this->batch_.init(MAX_PACKET_SIZE, socket::DEFAULT_BATCH_DEPTH);
 #if defined(USE_SOCKET_IMPL_BSD_SOCKETS) || defined(USE_SOCKET_IMPL_LWIP_SOCKETS)
   for (const auto &address : this->addresses_) {
     struct sockaddr saddr {};
@@ -273,71 +309,87 @@ void UDPComponent::setup() {
 #endif
 }
 
-void UDPComponent::init_data_() {
-  this->data_.clear();
+void UDPComponent::open_packet_() {
+  this->batch_.append(this->header_.data(), this->header_.size());
   if (this->rolling_code_enable_) {
-    add(this->data_, ROLLING_CODE_KEY);
-    add(this->data_, this->rolling_code_[0]);
-    add(this->data_, this->rolling_code_[1]);
+    add(this->batch_, ROLLING_CODE_KEY);
+    add(this->batch_, this->rolling_code_[0]);
+    add(this->batch_, this->rolling_code_[1]);
     this->increment_code_();
   } else {
-    add(this->data_, DATA_KEY);
+    add(this->batch_, DATA_KEY);
   }
   for (auto pkey : this->ping_keys_) {
-    add(this->data_, PING_KEY);
-    add(this->data_, pkey.second);
+    add(this->batch_, PING_KEY);
+    add(this->batch_, pkey.second);
   }
 }
 
-void UDPComponent::flush_() {
-  if (!network::is_connected() || this->data_.empty())
-    return;
-  uint32_t buffer[MAX_PACKET_SIZE / 4];
-  memset(buffer, 0, sizeof buffer);
+void UDPComponent::close_packet_() {
   // len must be a multiple of 4
-  auto header_len = round4(this->header_.size()) / 4;
-  auto len = round4(data_.size()) / 4;
-  memcpy(buffer, this->header_.data(), this->header_.size());
-  memcpy(buffer + header_len, this->data_.data(), this->data_.size());
+  while (this->batch_.size() & 0x3)
+    add(this->batch_, ZERO_FILL_KEY);
   if (this->is_encrypted_()) {
-    xxtea_encrypt(buffer + header_len, len, (uint32_t *) this->encryption_key_.data());
+    auto header_len = this->header_.size();
+    xxtea_encrypt(reinterpret_cast<uint32_t *>(this->batch_.data() + header_len),
+                  (this->batch_.size() - header_len) / 4, (uint32_t *) this->encryption_key_.data());
   }
-  auto total_len = (header_len + len) * 4;
-  this->send_packet_(buffer, total_len);
+  this->batch_.close();
+  if (this->batch_.full())
+    this->send_batch_();
 }
 
-void UDPComponent::add_binary_data_(uint8_t key, const char *id, bool data) {
-  auto len = 1 + 1 + 1 + strlen(id);
-  if (len + this->header_.size() + this->data_.size() > MAX_PACKET_SIZE) {
-    this->flush_();
-  }
-  add(this->data_, key);
-  add(this->data_, (uint8_t) data);
-  add(this->data_, id);
+bool UDPComponent::reserve_(size_t len) {
+  if (this->batch_.fits(len))
+    return true;
+  this->close_packet_();
+  this->open_packet_();
+  return this->batch_.fits(len);
 }
-void UDPComponent::add_data_(uint8_t key, const char *id, float data) {
-  FuData udata{.f32 = data};
-  this->add_data_(key, id, udata.u32);
+
+void UDPComponent::add_binary_data_(const char *id, uint32_t id_hash, bool data) {
+  if (this->compact_) {
+    if (!this->reserve_(1 + 4 + 1))
+      return;
+    add(this->batch_, BINARY_SENSOR_HASH_KEY);
+    add(this->batch_, id_hash);
+    add(this->batch_, (uint8_t) data);
+    return;
+  }
+  if (!this->reserve_(1 + 1 + 1 + strlen(id)))
+    return ESP_LOGW(TAG, "Binary sensor %s does not fit in a packet", id);
+  add(this->batch_, BINARY_SENSOR_KEY);
+  add(this->batch_, (uint8_t) data);
+  add(this->batch_, id);
 }
 
-void UDPComponent::add_data_(uint8_t key, const char *id, uint32_t data) {
-  auto len = 4 + 1 + 1 + strlen(id);
-  if (len + this->header_.size() + this->data_.size() > MAX_PACKET_SIZE) {
-    this->flush_();
+void UDPComponent::add_data_(const char *id, uint32_t id_hash, float data) {
+  FuData udata{.f32 = data};
+  if (this->compact_) {
+    if (!this->reserve_(1 + 4 + 4))
+      return;
+    add(this->batch_, SENSOR_HASH_KEY);
+    add(this->batch_, id_hash);
+    add(this->batch_, udata.u32);
+    return;
   }
-  add(this->data_, key);
-  add(this->data_, data);
-  add(this->data_, id);
+  if (!this->reserve_(1 + 4 + 1 + strlen(id)))
+    return ESP_LOGW(TAG, "Sensor %s does not fit in a packet", id);
+  add(this->batch_, SENSOR_KEY);
+  add(this->batch_, udata.u32);
+  add(this->batch_, id);
 }
+
 void UDPComponent::send_data_(bool all) {
   if (!this->should_send_ || !network::is_connected())
     return;
-  this->init_data_();
+  this->open_packet_();
 #ifdef USE_SENSOR
   for (auto &sensor : this->sensors_) {
     if (all || sensor.updated) {
       sensor.updated = false;
-      this->add_data_(SENSOR_KEY, sensor.id, sensor.sensor->get_state());
+      sensor.last_sent = sensor.sensor->get_state();
+      this->add_data_(sensor.id, sensor.id_hash, sensor.last_sent);
     }
   }
 #endif
@@ -345,11 +397,12 @@ void UDPComponent::send_data_(bool all) {
   for (auto &sensor : this->binary_sensors_) {
     if (all || sensor.updated) {
       sensor.updated = false;
-      this->add_binary_data_(BINARY_SENSOR_KEY, sensor.id, sensor.sensor->state);
+      this->add_binary_data_(sensor.id, sensor.id_hash, sensor.sensor->state);
     }
   }
 #endif
-  this->flush_();
+  this->close_packet_();
+  this->send_batch_();
   this->updated_ = false;
   this->resend_data_ = false;
 }
@@ -474,9 +527,11 @@ void UDPComponent::process_(uint8_t *buf, const size_t len) {
   ESP_LOGV(TAG, "Found hostname %s", namebuf);
 #ifdef USE_SENSOR
   auto &sensors = this->remote_sensors_[namebuf];
+  auto &sensor_hashes = this->remote_sensor_hashes_[namebuf];
 #endif
 #ifdef USE_BINARY_SENSOR
   auto &binary_sensors = this->remote_binary_sensors_[namebuf];
+  auto &binary_sensor_hashes = this->remote_binary_sensor_hashes_[namebuf];
 #endif
 
   if (!provider.encryption_key.empty()) {
@@ -511,6 +566,29 @@ void UDPComponent::process_(uint8_t *buf, const size_t len) {
       this->resend_ping_key_ = true;
       break;
     }
+    if (byte == SENSOR_HASH_KEY || byte == BINARY_SENSOR_HASH_KEY) {
+      if (end - buf < (byte == SENSOR_HASH_KEY ? 8 : 5)) {
+        return ESP_LOGV(TAG, "Sensor hash key %d requires more bytes", byte);
+      }
+      auto id_hash = get_uint32(buf);
+      rdata.u32 = byte == SENSOR_HASH_KEY ? get_uint32(buf) : *buf++;
+      ESP_LOGV(TAG, "Found sensor key %d, id hash %08X, data %lX", byte, (unsigned) id_hash, (unsigned long) rdata.u32);
+#ifdef USE_SENSOR
+      if (byte == SENSOR_HASH_KEY) {
+        auto it = sensor_hashes.find(id_hash);
+        if (it != sensor_hashes.end())
+          it->second->publish_state(rdata.f32);
+      }
+#endif
+#ifdef USE_BINARY_SENSOR
+      if (byte == BINARY_SENSOR_HASH_KEY) {
+        auto it = binary_sensor_hashes.find(id_hash);
+        if (it != binary_sensor_hashes.end())
+          it->second->publish_state(rdata.u32 != 0);
+      }
+#endif
+      continue;
+    }
     if (byte == BINARY_SENSOR_KEY) {
       if (end - buf < 3) {
         return ESP_LOGV(TAG, "Binary sensor key requires at least 3 more bytes");
@@ -549,6 +627,9 @@ void UDPComponent::dump_config() {
   ESP_LOGCONFIG(TAG, "  Port: %u", this->port_);
   ESP_LOGCONFIG(TAG, "  Encrypted: %s", YESNO(this->is_encrypted_()));
   ESP_LOGCONFIG(TAG, "  Ping-pong: %s", YESNO(this->ping_pong_enable_));
+  ESP_LOGCONFIG(TAG, "  Compact: %s", YESNO(this->compact_));
+  if (this->delta_.has_value())
+    ESP_LOGCONFIG(TAG, "  Delta: %f", *this->delta_);
   for (const auto &address : this->addresses_)
     ESP_LOGCONFIG(TAG, "  Address: %s", address.c_str());
 #ifdef USE_SENSOR
@@ -580,7 +661,22 @@ void UDPComponent::increment_code_() {
     }
   }
 }
-void UDPComponent::send_packet_(void *data, size_t len) {
+void UDPComponent::send_batch_() {
+#if defined(USE_SOCKET_IMPL_BSD_SOCKETS) || defined(USE_SOCKET_IMPL_LWIP_SOCKETS)
+  if (this->batch_.count() != 0) {
+    for (const auto &saddr : this->sockaddrs_) {
+      if (this->batch_.send(this->broadcast_socket_.get(), &saddr, sizeof(saddr)) < 0)
+        ESP_LOGW(TAG, "sendto() error %d", errno);
+    }
+  }
+#else
+  for (size_t i = 0; i != this->batch_.count(); i++)
+    this->send_packet_(this->batch_.datagram(i), this->batch_.datagram_size(i));
+#endif
+  this->batch_.clear();
+}
+
+void UDPComponent::send_packet_(const void *data, size_t len) {
 #if defined(USE_SOCKET_IMPL_BSD_SOCKETS) || defined(USE_SOCKET_IMPL_LWIP_SOCKETS)
   for (const auto &saddr : this->sockaddrs_) {
     auto result = this->broadcast_socket_->sendto(data, len, 0, &saddr, sizeof(saddr));
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "esphome/core/component.h"
+#include "esphome/core/helpers.h"
+#include "esphome/core/optional.h"
 #ifdef USE_SENSOR
 #include "esphome/components/sensor/sensor.h"
 #endif
@@ -12,6 +14,8 @@
 #else
 #include <WiFiUdp.h>
 #endif
+#include "esphome/components/socket/datagram_batch.h"
+#include <cmath>
 #include <vector>
 #include <map>
 
@@ -29,6 +33,8 @@ struct Sensor {
   sensor::Sensor *sensor;
   const char *id;
   bool updated;
+  uint32_t id_hash;
+  float last_sent;
 };
 #endif
 #ifdef USE_BINARY_SENSOR
@@ -36,6 +42,7 @@ struct BinarySensor {
   binary_sensor::BinarySensor *sensor;
   const char *id;
   bool updated;
+  uint32_t id_hash;
 };
 #endif
 
@@ -48,23 +55,25 @@ class UDPComponent : public PollingComponent {
 
 #ifdef USE_SENSOR
   void add_sensor(const char *id, sensor::Sensor *sensor) {
-    Sensor st{sensor, id, true};
+    Sensor st{sensor, id, true, 0, NAN};
     this->sensors_.push_back(st);
   }
   void add_remote_sensor(const char *hostname, const char *remote_id, sensor::Sensor *sensor) {
     this->add_provider(hostname);
     this->remote_sensors_[hostname][remote_id] = sensor;
+    this->remote_sensor_hashes_[hostname][fnv1_hash(remote_id)] = sensor;
   }
 #endif
 #ifdef USE_BINARY_SENSOR
   void add_binary_sensor(const char *id, binary_sensor::BinarySensor *sensor) {
-    BinarySensor st{sensor, id, true};
+    BinarySensor st{sensor, id, true, 0};
     this->binary_sensors_.push_back(st);
   }
 
   void add_remote_binary_sensor(const char *hostname, const char *remote_id, binary_sensor::BinarySensor *sensor) {
     this->add_provider(hostname);
     this->remote_binary_sensors_[hostname][remote_id] = sensor;
+    this->remote_binary_sensor_hashes_[hostname][fnv1_hash(remote_id)] = sensor;
   }
 #endif
   void add_address(const char *addr) { this->addresses_.emplace_back(addr); }
@@ -92,6 +101,10 @@ class UDPComponent : public PollingComponent {
   void set_rolling_code_enable(bool enable) { this->rolling_code_enable_ = enable; }
   void set_ping_pong_enable(bool enable) { this->ping_pong_enable_ = enable; }
   void set_ping_pong_recycle_time(uint32_t recycle_time) { this->ping_pong_recyle_time_ = recycle_time; }
+  /// Identify sensors by a hash of their id instead of the id itself, which only newer receivers understand.
+  void set_compact(bool compact) { this->compact_ = compact; }
+  /// Only send a sensor between updates if it moved by more than @p delta since it was last sent.
+  void set_delta(float delta) { this->delta_ = delta; }
   void set_provider_encryption(const char *name, std::vector<uint8_t> key) {
     this->providers_[name].encryption_key = std::move(key);
   }
@@ -99,12 +112,13 @@ class UDPComponent : public PollingComponent {
  protected:
   void send_data_(bool all);
   void process_(uint8_t *buf, size_t len);
-  void flush_();
-  void add_data_(uint8_t key, const char *id, float data);
-  void add_data_(uint8_t key, const char *id, uint32_t data);
+  void open_packet_();
+  void close_packet_();
+  bool reserve_(size_t len);
+  void send_batch_();
+  void add_data_(const char *id, uint32_t id_hash, float data);
   void increment_code_();
-  void add_binary_data_(uint8_t key, const char *id, bool data);
-  void init_data_();
+  void add_binary_data_(const char *id, uint32_t id_hash, bool data);
 
   bool updated_{};
   uint16_t port_{18511};
@@ -119,6 +133,8 @@ class UDPComponent : public PollingComponent {
   bool should_send_{};
   const char *name_{};
   bool should_listen_{};
+  bool compact_{};
+  optional<float> delta_{};
   ESPPreferenceObject pref_;
 
 #if defined(USE_SOCKET_IMPL_BSD_SOCKETS) || defined(USE_SOCKET_IMPL_LWIP_SOCKETS)
@@ -135,20 +151,22 @@ class UDPComponent : public PollingComponent {
 #ifdef USE_SENSOR
   std::vector<Sensor> sensors_{};
   std::map<std::string, std::map<std::string, sensor::Sensor *>> remote_sensors_{};
+  std::map<std::string, std::map<uint32_t, sensor::Sensor *>> remote_sensor_hashes_{};
 #endif
 #ifdef USE_BINARY_SENSOR
   std::vector<BinarySensor> binary_sensors_{};
   std::map<std::string, std::map<std::string, binary_sensor::BinarySensor *>> remote_binary_sensors_{};
+  std::map<std::string, std::map<uint32_t, binary_sensor::BinarySensor *>> remote_binary_sensor_hashes_{};
 #endif
 
   std::map<std::string, Provider> providers_{};
   std::vector<uint8_t> ping_header_{};
   std::vector<uint8_t> header_{};
-  std::vector<uint8_t> data_{};
+  socket::DatagramBatch batch_{};
   std::map<const char *, uint32_t> ping_keys_{};
   void add_key_(const char *name, uint32_t key);
   void send_ping_pong_request_();
-  void send_packet_(void *data, size_t len);
+  void send_packet_(const void *data, size_t len);
   void process_ping_request_(const char *name, uint8_t *ptr, size_t len);
 
   inline bool is_encrypted_() { return !this->encryption_key_.empty(); }
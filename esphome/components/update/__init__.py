@@ -60,7 +60,7 @@ async def setup_update_core_(var, config):
     await setup_entity(var, config)
 
     if device_class_config := config.get(CONF_DEVICE_CLASS):
-        cg.add(var.set_device_class(device_class_config))
+        cg.add(var.set_device_class(cg.entity_string(device_class_config)))
 
     if on_update_available := config.get(CONF_ON_UPDATE_AVAILABLE):
         await automation.build_automation(
@@ -118,7 +118,9 @@ class Valve : public EntityBase, public EntityBase_DeviceClass {
   /// Construct a new valve call used to control the valve.
   ValveCall make_call();
 
-  void add_on_state_callback(std::function<void()> &&f);
+  template<typename F> void add_on_state_callback(F &&callback) {
+    this->state_callback_.add(std::forward<F>(callback));
+  }
 
   /** Publish the current state of the valve.
    *
@@ -72,6 +72,7 @@ class ListEntitiesIterator : public ComponentIterator {
 #ifdef USE_UPDATE
   bool on_update(update::UpdateEntity *update) override;
 #endif
+  bool on_end() override;
 
  protected:
   WebServer *web_server_;
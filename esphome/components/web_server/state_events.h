@@ -0,0 +1,144 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+
+#ifdef USE_WEBSERVER
+
+#include "esphome/core/entity_base.h"
+#include "esphome/core/hal.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace esphome {
+namespace web_server {
+
+class WebServer;
+
+/// Builds the DETAIL_STATE or DETAIL_ALL JSON of an entity from its current state.
+using state_json_t = std::string (*)(WebServer *web_server, EntityBase *entity);
+
+/// The last state event sent for an entity, shared by all event source clients.
+struct StateEventCache {
+  std::string json;
+  std::string initial_json;  ///< DETAIL_ALL sent to new clients, empty once the state changed
+  state_json_t build{nullptr};
+  uint32_t last_sent{0};
+  bool pending{false};
+};
+
+/** The state events of all entities on an event source, each built once and sent to every client.
+ *
+ * An update whose JSON is the same as the last one sent for the entity is not sent again. With a coalesce interval,
+ * updates within the interval after the last event of an entity are merged and loop() sends the latest one. Clients
+ * that just connected get the DETAIL_ALL JSON instead, which is kept until the state changes so that clients
+ * connecting one after another share it.
+ */
+template<typename EventSource, typename Client> class StateEvents {
+ public:
+  StateEvents(WebServer *web_server, EventSource *events) : web_server_(web_server), events_(events) {}
+
+  void set_coalesce_interval(uint32_t coalesce_interval) { this->coalesce_interval_ = coalesce_interval; }
+  uint32_t get_coalesce_interval() const { return this->coalesce_interval_; }
+
+  /// Send the state of `entity` to all clients, or defer it while inside the coalescing window.
+  void send(EntityBase *entity, state_json_t build) {
+    if (this->events_->count() == 0) {
+      // Nobody sees the change, but the snapshot for new clients is stale now
+      auto it = this->caches_.find(entity);
+      if (it != this->caches_.end())
+        it->second.initial_json.clear();
+      return;
+    }
+    StateEventCache &cache = this->caches_[entity];
+    cache.initial_json.clear();
+    cache.build = build;
+    if (cache.pending)
+      return;  // loop() sends the latest state once the window has passed
+
+    const uint32_t now = millis();
+    if (this->coalesce_interval_ != 0 && !cache.json.empty() && now - cache.last_sent < this->coalesce_interval_) {
+      cache.pending = true;
+      this->pending_++;
+      return;
+    }
+    this->flush_(cache, entity, now);
+  }
+
+  /// Send the deferred states whose window has passed.
+  void loop() {
+    if (this->pending_ == 0)
+      return;
+    const uint32_t now = millis();
+    for (auto &it : this->caches_) {
+      if (it.second.pending && now - it.second.last_sent >= this->coalesce_interval_)
+        this->flush_(it.second, it.first, now);
+    }
+  }
+
+  /// Queue a client that just connected for the initial state.
+  void add_new_client(Client *client) {
+    this->new_clients_.push_back(client);
+    // The new client gets the full state, so the next update must not be suppressed as a duplicate
+    for (auto &it : this->caches_)
+      it.second.json.clear();
+  }
+  /// Send the DETAIL_ALL JSON of `entity` to the queued clients that are still connected.
+  void send_initial_state(EntityBase *entity, state_json_t build) {
+    if (this->events_->count() == 0)
+      return;
+    const std::string &json = this->initial_state_(entity, build);
+    for (Client *client : this->new_clients_) {
+      if (this->events_->has_client(client))
+        client->send(json.c_str(), "state");
+    }
+  }
+  /// Send the DETAIL_ALL JSON of `entity` to all clients, for event sources that can't tell whether a queued client
+  /// is still connected.
+  void broadcast_initial_state(EntityBase *entity, state_json_t build) {
+    if (this->events_->count() == 0)
+      return;
+    this->events_->send(this->initial_state_(entity, build).c_str(), "state");
+  }
+  /// The queued clients got the initial state of every entity.
+  void clear_new_clients() { this->new_clients_.clear(); }
+
+ protected:
+  /// Rebuild the cached state JSON and send it if it changed.
+  void flush_(StateEventCache &cache, EntityBase *entity, uint32_t now) {
+    if (cache.pending) {
+      cache.pending = false;
+      this->pending_--;
+    }
+    cache.last_sent = now;
+    if (this->events_->count() == 0)
+      return;
+    std::string json = cache.build(this->web_server_, entity);
+    if (json == cache.json)
+      return;
+    // Built once and sent to every client as the same buffer
+    cache.json = std::move(json);
+    this->events_->send(cache.json.c_str(), "state");
+  }
+  /// The DETAIL_ALL JSON of `entity`, built again only if the state changed.
+  const std::string &initial_state_(EntityBase *entity, state_json_t build) {
+    StateEventCache &cache = this->caches_[entity];
+    if (cache.initial_json.empty())
+      cache.initial_json = build(this->web_server_, entity);
+    return cache.initial_json;
+  }
+
+  WebServer *web_server_;
+  EventSource *events_;
+  std::map<EntityBase *, StateEventCache> caches_;
+  std::vector<Client *> new_clients_;
+  uint32_t coalesce_interval_{0};
+  size_t pending_{0};
+};
+
+}  // namespace web_server
+}  // namespace esphome
+
+#endif  // USE_WEBSERVER
@@ -12,6 +12,7 @@
 #include "StreamString.h"
 #endif
 
+#include <cinttypes>
 #include <cstdlib>
 
 #ifdef USE_LIGHT
@@ -113,7 +114,11 @@ void WebServer::setup() {
                    "sorting_group");
     }
 
-    this->entities_iterator_.begin(this->include_internal_);
+    // This may run on the web server task, the state is sent from loop()
+    this->schedule_([this, client]() {
+      this->state_events_.add_new_client(client);
+      this->entities_iterator_.begin(this->include_internal_);
+    });
   });
 
 #ifdef USE_LOGGER
@@ -147,11 +152,24 @@ void WebServer::loop() {
     }
   }
 #endif
+  this->state_events_.loop();
   this->entities_iterator_.advance();
 }
 void WebServer::dump_config() {
   ESP_LOGCONFIG(TAG, "Web Server:");
   ESP_LOGCONFIG(TAG, "  Address: %s:%u", network::get_use_address().c_str(), this->base_->get_port());
+  if (this->state_events_.get_coalesce_interval() != 0) {
+    ESP_LOGCONFIG(TAG, "  State Coalesce Interval: %" PRIu32 "ms", this->state_events_.get_coalesce_interval());
+  }
+}
+
+void WebServer::send_initial_state_(EntityBase *entity, state_json_t build) {
+#ifdef USE_ESP_IDF
+  this->state_events_.send_initial_state(entity, build);
+#else
+  // The Arduino event source deletes a client as soon as it disconnects, only the broadcast is safe after onConnect
+  this->state_events_.broadcast_initial_state(entity, build);
+#endif
 }
 float WebServer::get_setup_priority() const { return setup_priority::WIFI - 1.0f; }
 
@@ -203,7 +221,7 @@ void WebServer::handle_js_request(AsyncWebServerRequest *request) {
   (root)["id"] = sensor; \
   if (((start_config) == DETAIL_ALL)) { \
     (root)["name"] = (obj)->get_name(); \
-    (root)["icon"] = (obj)->get_icon(); \
+    (root)["icon"] = (obj)->get_icon_ref(); \
     (root)["entity_category"] = (obj)->get_entity_category(); \
     if ((obj)->is_disabled_by_default()) \
       (root)["is_disabled_by_default"] = (obj)->is_disabled_by_default(); \
@@ -219,13 +237,14 @@ void WebServer::handle_js_request(AsyncWebServerRequest *request) {
 
 #ifdef USE_SENSOR
 void WebServer::on_sensor_update(sensor::Sensor *obj, float state) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->sensor_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, [](WebServer *ws, EntityBase *entity) {
+    auto *o = static_cast<sensor::Sensor *>(entity);
+    return ws->sensor_json(o, o->state, DETAIL_STATE);
+  });
 }
 void WebServer::handle_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (sensor::Sensor *obj : App.get_sensors()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
     if (request->method() == HTTP_GET && match.method.empty()) {
       auto detail = DETAIL_STATE;
@@ -247,10 +266,10 @@ std::string WebServer::sensor_json(sensor::Sensor *obj, float value, JsonDetail
       state = "NA";
     } else {
       state = value_accuracy_to_string(value, obj->get_accuracy_decimals());
-      if (!obj->get_unit_of_measurement().empty())
-        state += " " + obj->get_unit_of_measurement();
+      if (!obj->get_unit_of_measurement_ref().empty())
+        state += " " + obj->get_unit_of_measurement_ref();
     }
-    set_json_icon_state_value(root, obj, "sensor-" + obj->get_object_id(), state, value, start_config);
+    set_json_icon_state_value(root, obj, "sensor-" + obj->get_object_id_ref(), state, value, start_config);
     if (start_config == DETAIL_ALL) {
       if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
         root["sorting_weight"] = this->sorting_entitys_[obj].weight;
@@ -258,8 +277,8 @@ std::string WebServer::sensor_json(sensor::Sensor *obj, float value, JsonDetail
           root["sorting_group"] = this->sorting_groups_[this->sorting_entitys_[obj].group_id].name;
         }
       }
-      if (!obj->get_unit_of_measurement().empty())
-        root["uom"] = obj->get_unit_of_measurement();
+      if (!obj->get_unit_of_measurement_ref().empty())
+        root["uom"] = obj->get_unit_of_measurement_ref();
     }
   });
 }
@@ -267,13 +286,14 @@ std::string WebServer::sensor_json(sensor::Sensor *obj, float value, JsonDetail
 
 #ifdef USE_TEXT_SENSOR
 void WebServer::on_text_sensor_update(text_sensor::TextSensor *obj, const std::string &state) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->text_sensor_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, [](WebServer *ws, EntityBase *entity) {
+    auto *o = static_cast<text_sensor::TextSensor *>(entity);
+    return ws->text_sensor_json(o, o->state, DETAIL_STATE);
+  });
 }
 void WebServer::handle_text_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (text_sensor::TextSensor *obj : App.get_text_sensors()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
     if (request->method() == HTTP_GET && match.method.empty()) {
       auto detail = DETAIL_STATE;
@@ -291,7 +311,7 @@ void WebServer::handle_text_sensor_request(AsyncWebServerRequest *request, const
 std::string WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std::string &value,
                                         JsonDetail start_config) {
   return json::build_json([this, obj, value, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "text_sensor-" + obj->get_object_id(), value, value, start_config);
+    set_json_icon_state_value(root, obj, "text_sensor-" + obj->get_object_id_ref(), value, value, start_config);
     if (start_config == DETAIL_ALL) {
       if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
         root["sorting_weight"] = this->sorting_entitys_[obj].weight;
@@ -306,13 +326,14 @@ std::string WebServer::text_sensor_json(text_sensor::TextSensor *obj, const std:
 
 #ifdef USE_SWITCH
 void WebServer::on_switch_update(switch_::Switch *obj, bool state) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->switch_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, [](WebServer *ws, EntityBase *entity) {
+    auto *o = static_cast<switch_::Switch *>(entity);
+    return ws->switch_json(o, o->state, DETAIL_STATE);
+  });
 }
 void WebServer::handle_switch_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (switch_::Switch *obj : App.get_switches()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
 
     if (request->method() == HTTP_GET && match.method.empty()) {
@@ -341,7 +362,8 @@ void WebServer::handle_switch_request(AsyncWebServerRequest *request, const UrlM
 }
 std::string WebServer::switch_json(switch_::Switch *obj, bool value, JsonDetail start_config) {
   return json::build_json([this, obj, value, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "switch-" + obj->get_object_id(), value ? "ON" : "OFF", value, start_config);
+    set_json_icon_state_value(root, obj, "switch-" + obj->get_object_id_ref(), value ? "ON" : "OFF", value,
+                              start_config);
     if (start_config == DETAIL_ALL) {
       root["assumed_state"] = obj->assumed_state();
       if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
@@ -358,7 +380,7 @@ std::string WebServer::switch_json(switch_::Switch *obj, bool value, JsonDetail
 #ifdef USE_BUTTON
 void WebServer::handle_button_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (button::Button *obj : App.get_buttons()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
     if (request->method() == HTTP_GET && match.method.empty()) {
       auto detail = DETAIL_STATE;
@@ -381,7 +403,7 @@ void WebServer::handle_button_request(AsyncWebServerRequest *request, const UrlM
 }
 std::string WebServer::button_json(button::Button *obj, JsonDetail start_config) {
   return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_id(root, obj, "button-" + obj->get_object_id(), start_config);
+    set_json_id(root, obj, "button-" + obj->get_object_id_ref(), start_config);
     if (start_config == DETAIL_ALL) {
       if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
         root["sorting_weight"] = this->sorting_entitys_[obj].weight;
@@ -396,13 +418,14 @@ std::string WebServer::button_json(button::Button *obj, JsonDetail start_config)
 
 #ifdef USE_BINARY_SENSOR
 void WebServer::on_binary_sensor_update(binary_sensor::BinarySensor *obj, bool state) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->binary_sensor_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, [](WebServer *ws, EntityBase *entity) {
+    auto *o = static_cast<binary_sensor::BinarySensor *>(entity);
+    return ws->binary_sensor_json(o, o->state, DETAIL_STATE);
+  });
 }
 void WebServer::handle_binary_sensor_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (binary_sensor::BinarySensor *obj : App.get_binary_sensors()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
     if (request->method() == HTTP_GET && match.method.empty()) {
       auto detail = DETAIL_STATE;
@@ -419,7 +442,7 @@ void WebServer::handle_binary_sensor_request(AsyncWebServerRequest *request, con
 }
 std::string WebServer::binary_sensor_json(binary_sensor::BinarySensor *obj, bool value, JsonDetail start_config) {
   return json::build_json([this, obj, value, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "binary_sensor-" + obj->get_object_id(), value ? "ON" : "OFF", value,
+    set_json_icon_state_value(root, obj, "binary_sensor-" + obj->get_object_id_ref(), value ? "ON" : "OFF", value,
                               start_config);
     if (start_config == DETAIL_ALL) {
       if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
@@ -435,13 +458,14 @@ std::string WebServer::binary_sensor_json(binary_sensor::BinarySensor *obj, bool
 
 #ifdef USE_FAN
 void WebServer::on_fan_update(fan::Fan *obj) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->fan_json(obj, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, [](WebServer *ws, EntityBase *entity) {
+    auto *o = static_cast<fan::Fan *>(entity);
+    return ws->fan_json(o, DETAIL_STATE);
+  });
 }
 void WebServer::handle_fan_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (fan::Fan *obj : App.get_fans()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
 
     if (request->method() == HTTP_GET && match.method.empty()) {
@@ -498,7 +522,7 @@ void WebServer::handle_fan_request(AsyncWebServerRequest *request, const UrlMatc
 }
 std::string WebServer::fan_json(fan::Fan *obj, JsonDetail start_config) {
   return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "fan-" + obj->get_object_id(), obj->state ? "ON" : "OFF", obj->state,
+    set_json_icon_state_value(root, obj, "fan-" + obj->get_object_id_ref(), obj->state ? "ON" : "OFF", obj->state,
                               start_config);
     const auto traits = obj->get_traits();
     if (traits.supports_speed()) {
@@ -521,13 +545,14 @@ std::string WebServer::fan_json(fan::Fan *obj, JsonDetail start_config) {
 
 #ifdef USE_LIGHT
 void WebServer::on_light_update(light::LightState *obj) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->light_json(obj, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, [](WebServer *ws, EntityBase *entity) {
+    auto *o = static_cast<light::LightState *>(entity);
+    return ws->light_json(o, DETAIL_STATE);
+  });
 }
 void WebServer::handle_light_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (light::LightState *obj : App.get_lights()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
 
     if (request->method() == HTTP_GET && match.method.empty()) {
@@ -617,7 +642,7 @@ void WebServer::handle_light_request(AsyncWebServerRequest *request, const UrlMa
 }
 std::string WebServer::light_json(light::LightState *obj, JsonDetail start_config) {
   return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_id(root, obj, "light-" + obj->get_object_id(), start_config);
+    set_json_id(root, obj, "light-" + obj->get_object_id_ref(), start_config);
     root["state"] = obj->remote_values.is_on() ? "ON" : "OFF";
 
     light::LightJSONSchema::dump_json(*obj, root);
@@ -640,13 +665,14 @@ std::string WebServer::light_json(light::LightState *obj, JsonDetail start_confi
 
 #ifdef USE_COVER
 void WebServer::on_cover_update(cover::Cover *obj) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->cover_json(obj, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, [](WebServer *ws, EntityBase *entity) {
+    auto *o = static_cast<cover::Cover *>(entity);
+    return ws->cover_json(o, DETAIL_STATE);
+  });
 }
 void WebServer::handle_cover_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (cover::Cover *obj : App.get_covers()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
 
     if (request->method() == HTTP_GET && match.method.empty()) {
@@ -702,8 +728,8 @@ void WebServer::handle_cover_request(AsyncWebServerRequest *request, const UrlMa
 }
 std::string WebServer::cover_json(cover::Cover *obj, JsonDetail start_config) {
   return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "cover-" + obj->get_object_id(), obj->is_fully_closed() ? "CLOSED" : "OPEN",
-                              obj->position, start_config);
+    set_json_icon_state_value(root, obj, "cover-" + obj->get_object_id_ref(),
+                              obj->is_fully_closed() ? "CLOSED" : "OPEN", obj->position, start_config);
     root["current_operation"] = cover::cover_operation_to_str(obj->current_operation);
 
     if (obj->get_traits().get_supports_position())
@@ -724,13 +750,14 @@ std::string WebServer::cover_json(cover::Cover *obj, JsonDetail start_config) {
 
 #ifdef USE_NUMBER
 void WebServer::on_number_update(number::Number *obj, float state) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->number_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, [](WebServer *ws, EntityBase *entity) {
+    auto *o = static_cast<number::Number *>(entity);
+    return ws->number_json(o, o->state, DETAIL_STATE);
+  });
 }
 void WebServer::handle_number_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_numbers()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
 
     if (request->method() == HTTP_GET && match.method.empty()) {
@@ -764,7 +791,7 @@ void WebServer::handle_number_request(AsyncWebServerRequest *request, const UrlM
 
 std::string WebServer::number_json(number::Number *obj, float value, JsonDetail start_config) {
   return json::build_json([this, obj, value, start_config](JsonObject root) {
-    set_json_id(root, obj, "number-" + obj->get_object_id(), start_config);
+    set_json_id(root, obj, "number-" + obj->get_object_id_ref(), start_config);
     if (start_config == DETAIL_ALL) {
       root["min_value"] =
           value_accuracy_to_string(obj->traits.get_min_value(), step_to_accuracy_decimals(obj->traits.get_step()));
@@ -773,8 +800,8 @@ std::string WebServer::number_json(number::Number *obj, float value, JsonDetail
       root["step"] =
           value_accuracy_to_string(obj->traits.get_step(), step_to_accuracy_decimals(obj->traits.get_step()));
       root["mode"] = (int) obj->traits.get_mode();
-      if (!obj->traits.get_unit_of_measurement().empty())
-        root["uom"] = obj->traits.get_unit_of_measurement();
+      if (!obj->traits.get_unit_of_measurement_ref().empty())
+        root["uom"] = obj->traits.get_unit_of_measurement_ref();
       if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
         root["sorting_weight"] = this->sorting_entitys_[obj].weight;
         if (this->sorting_groups_.find(this->sorting_entitys_[obj].group_id) != this->sorting_groups_.end()) {
@@ -788,8 +815,8 @@ std::string WebServer::number_json(number::Number *obj, float value, JsonDetail
     } else {
       root["value"] = value_accuracy_to_string(value, step_to_accuracy_decimals(obj->traits.get_step()));
       std::string state = value_accuracy_to_string(value, step_to_accuracy_decimals(obj->traits.get_step()));
-      if (!obj->traits.get_unit_of_measurement().empty())
-        state += " " + obj->traits.get_unit_of_measurement();
+      if (!obj->traits.get_unit_of_measurement_ref().empty())
+        state += " " + obj->traits.get_unit_of_measurement_ref();
       root["state"] = state;
     }
   });
@@ -798,13 +825,14 @@ std::string WebServer::number_json(number::Number *obj, float value, JsonDetail
 
 #ifdef USE_DATETIME_DATE
 void WebServer::on_date_update(datetime::DateEntity *obj) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->date_json(obj, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, [](WebServer *ws, EntityBase *entity) {
+    auto *o = static_cast<datetime::DateEntity *>(entity);
+    return ws->date_json(o, DETAIL_STATE);
+  });
 }
 void WebServer::handle_date_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_dates()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
     if (request->method() == HTTP_GET && match.method.empty()) {
       auto detail = DETAIL_STATE;
@@ -842,7 +870,7 @@ void WebServer::handle_date_request(AsyncWebServerRequest *request, const UrlMat
 
 std::string WebServer::date_json(datetime::DateEntity *obj, JsonDetail start_config) {
   return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_id(root, obj, "date-" + obj->get_object_id(), start_config);
+    set_json_id(root, obj, "date-" + obj->get_object_id_ref(), start_config);
     std::string value = str_sprintf("%d-%02d-%02d", obj->year, obj->month, obj->day);
     root["value"] = value;
     root["state"] = value;
@@ -860,13 +888,14 @@ std::string WebServer::date_json(datetime::DateEntity *obj, JsonDetail start_con
 
 #ifdef USE_DATETIME_TIME
 void WebServer::on_time_update(datetime::TimeEntity *obj) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->time_json(obj, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, [](WebServer *ws, EntityBase *entity) {
+    auto *o = static_cast<datetime::TimeEntity *>(entity);
+    return ws->time_json(o, DETAIL_STATE);
+  });
 }
 void WebServer::handle_time_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_times()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
     if (request->method() == HTTP_GET && match.method.empty()) {
       auto detail = DETAIL_STATE;
@@ -903,7 +932,7 @@ void WebServer::handle_time_request(AsyncWebServerRequest *request, const UrlMat
 }
 std::string WebServer::time_json(datetime::TimeEntity *obj, JsonDetail start_config) {
   return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_id(root, obj, "time-" + obj->get_object_id(), start_config);
+    set_json_id(root, obj, "time-" + obj->get_object_id_ref(), start_config);
     std::string value = str_sprintf("%02d:%02d:%02d", obj->hour, obj->minute, obj->second);
     root["value"] = value;
     root["state"] = value;
@@ -921,13 +950,14 @@ std::string WebServer::time_json(datetime::TimeEntity *obj, JsonDetail start_con
 
 #ifdef USE_DATETIME_DATETIME
 void WebServer::on_datetime_update(datetime::DateTimeEntity *obj) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->datetime_json(obj, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, [](WebServer *ws, EntityBase *entity) {
+    auto *o = static_cast<datetime::DateTimeEntity *>(entity);
+    return ws->datetime_json(o, DETAIL_STATE);
+  });
 }
 void WebServer::handle_datetime_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_datetimes()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
     if (request->method() == HTTP_GET && match.method.empty()) {
       auto detail = DETAIL_STATE;
@@ -964,7 +994,7 @@ void WebServer::handle_datetime_request(AsyncWebServerRequest *request, const Ur
 }
 std::string WebServer::datetime_json(datetime::DateTimeEntity *obj, JsonDetail start_config) {
   return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_id(root, obj, "datetime-" + obj->get_object_id(), start_config);
+    set_json_id(root, obj, "datetime-" + obj->get_object_id_ref(), start_config);
     std::string value = str_sprintf("%d-%02d-%02d %02d:%02d:%02d", obj->year, obj->month, obj->day, obj->hour,
                                     obj->minute, obj->second);
     root["value"] = value;
@@ -983,13 +1013,14 @@ std::string WebServer::datetime_json(datetime::DateTimeEntity *obj, JsonDetail s
 
 #ifdef USE_TEXT
 void WebServer::on_text_update(text::Text *obj, const std::string &state) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->text_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, [](WebServer *ws, EntityBase *entity) {
+    auto *o = static_cast<text::Text *>(entity);
+    return ws->text_json(o, o->state, DETAIL_STATE);
+  });
 }
 void WebServer::handle_text_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_texts()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
 
     if (request->method() == HTTP_GET && match.method.empty()) {
@@ -1022,7 +1053,7 @@ void WebServer::handle_text_request(AsyncWebServerRequest *request, const UrlMat
 
 std::string WebServer::text_json(text::Text *obj, const std::string &value, JsonDetail start_config) {
   return json::build_json([this, obj, value, start_config](JsonObject root) {
-    set_json_id(root, obj, "text-" + obj->get_object_id(), start_config);
+    set_json_id(root, obj, "text-" + obj->get_object_id_ref(), start_config);
     root["min_length"] = obj->traits.get_min_length();
     root["max_length"] = obj->traits.get_max_length();
     root["pattern"] = obj->traits.get_pattern();
@@ -1047,13 +1078,14 @@ std::string WebServer::text_json(text::Text *obj, const std::string &value, Json
 
 #ifdef USE_SELECT
 void WebServer::on_select_update(select::Select *obj, const std::string &state, size_t index) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->select_json(obj, state, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, [](WebServer *ws, EntityBase *entity) {
+    auto *o = static_cast<select::Select *>(entity);
+    return ws->select_json(o, o->state, DETAIL_STATE);
+  });
 }
 void WebServer::handle_select_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_selects()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
 
     if (request->method() == HTTP_GET && match.method.empty()) {
@@ -1087,7 +1119,7 @@ void WebServer::handle_select_request(AsyncWebServerRequest *request, const UrlM
 }
 std::string WebServer::select_json(select::Select *obj, const std::string &value, JsonDetail start_config) {
   return json::build_json([this, obj, value, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "select-" + obj->get_object_id(), value, value, start_config);
+    set_json_icon_state_value(root, obj, "select-" + obj->get_object_id_ref(), value, value, start_config);
     if (start_config == DETAIL_ALL) {
       JsonArray opt = root.createNestedArray("option");
       for (auto &option : obj->traits.get_options()) {
@@ -1109,13 +1141,14 @@ std::string WebServer::select_json(select::Select *obj, const std::string &value
 
 #ifdef USE_CLIMATE
 void WebServer::on_climate_update(climate::Climate *obj) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->climate_json(obj, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, [](WebServer *ws, EntityBase *entity) {
+    auto *o = static_cast<climate::Climate *>(entity);
+    return ws->climate_json(o, DETAIL_STATE);
+  });
 }
 void WebServer::handle_climate_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (auto *obj : App.get_climates()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
 
     if (request->method() == HTTP_GET && match.method.empty()) {
@@ -1176,7 +1209,7 @@ void WebServer::handle_climate_request(AsyncWebServerRequest *request, const Url
 }
 std::string WebServer::climate_json(climate::Climate *obj, JsonDetail start_config) {
   return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_id(root, obj, "climate-" + obj->get_object_id(), start_config);
+    set_json_id(root, obj, "climate-" + obj->get_object_id_ref(), start_config);
     const auto traits = obj->get_traits();
     int8_t target_accuracy = traits.get_target_temperature_accuracy_decimals();
     int8_t current_accuracy = traits.get_current_temperature_accuracy_decimals();
@@ -1270,13 +1303,14 @@ std::string WebServer::climate_json(climate::Climate *obj, JsonDetail start_conf
 
 #ifdef USE_LOCK
 void WebServer::on_lock_update(lock::Lock *obj) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->lock_json(obj, obj->state, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, [](WebServer *ws, EntityBase *entity) {
+    auto *o = static_cast<lock::Lock *>(entity);
+    return ws->lock_json(o, o->state, DETAIL_STATE);
+  });
 }
 void WebServer::handle_lock_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (lock::Lock *obj : App.get_locks()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
 
     if (request->method() == HTTP_GET && match.method.empty()) {
@@ -1305,7 +1339,7 @@ void WebServer::handle_lock_request(AsyncWebServerRequest *request, const UrlMat
 }
 std::string WebServer::lock_json(lock::Lock *obj, lock::LockState value, JsonDetail start_config) {
   return json::build_json([this, obj, value, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "lock-" + obj->get_object_id(), lock::lock_state_to_string(value), value,
+    set_json_icon_state_value(root, obj, "lock-" + obj->get_object_id_ref(), lock::lock_state_to_string(value), value,
                               start_config);
     if (start_config == DETAIL_ALL) {
       if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
@@ -1321,13 +1355,14 @@ std::string WebServer::lock_json(lock::Lock *obj, lock::LockState value, JsonDet
 
 #ifdef USE_VALVE
 void WebServer::on_valve_update(valve::Valve *obj) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->valve_json(obj, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, [](WebServer *ws, EntityBase *entity) {
+    auto *o = static_cast<valve::Valve *>(entity);
+    return ws->valve_json(o, DETAIL_STATE);
+  });
 }
 void WebServer::handle_valve_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (valve::Valve *obj : App.get_valves()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
 
     if (request->method() == HTTP_GET && match.method.empty()) {
@@ -1376,8 +1411,8 @@ void WebServer::handle_valve_request(AsyncWebServerRequest *request, const UrlMa
 }
 std::string WebServer::valve_json(valve::Valve *obj, JsonDetail start_config) {
   return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_icon_state_value(root, obj, "valve-" + obj->get_object_id(), obj->is_fully_closed() ? "CLOSED" : "OPEN",
-                              obj->position, start_config);
+    set_json_icon_state_value(root, obj, "valve-" + obj->get_object_id_ref(),
+                              obj->is_fully_closed() ? "CLOSED" : "OPEN", obj->position, start_config);
     root["current_operation"] = valve::valve_operation_to_str(obj->current_operation);
 
     if (obj->get_traits().get_supports_position())
@@ -1396,13 +1431,14 @@ std::string WebServer::valve_json(valve::Valve *obj, JsonDetail start_config) {
 
 #ifdef USE_ALARM_CONTROL_PANEL
 void WebServer::on_alarm_control_panel_update(alarm_control_panel::AlarmControlPanel *obj) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->alarm_control_panel_json(obj, obj->get_state(), DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, [](WebServer *ws, EntityBase *entity) {
+    auto *o = static_cast<alarm_control_panel::AlarmControlPanel *>(entity);
+    return ws->alarm_control_panel_json(o, o->get_state(), DETAIL_STATE);
+  });
 }
 void WebServer::handle_alarm_control_panel_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (alarm_control_panel::AlarmControlPanel *obj : App.get_alarm_control_panels()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
 
     if (request->method() == HTTP_GET && match.method.empty()) {
@@ -1423,7 +1459,7 @@ std::string WebServer::alarm_control_panel_json(alarm_control_panel::AlarmContro
                                                 JsonDetail start_config) {
   return json::build_json([this, obj, value, start_config](JsonObject root) {
     char buf[16];
-    set_json_icon_state_value(root, obj, "alarm-control-panel-" + obj->get_object_id(),
+    set_json_icon_state_value(root, obj, "alarm-control-panel-" + obj->get_object_id_ref(),
                               PSTR_LOCAL(alarm_control_panel_state_to_string(value)), value, start_config);
     if (start_config == DETAIL_ALL) {
       if (this->sorting_entitys_.find(obj) != this->sorting_entitys_.end()) {
@@ -1444,7 +1480,7 @@ void WebServer::on_event(event::Event *obj, const std::string &event_type) {
 
 std::string WebServer::event_json(event::Event *obj, const std::string &event_type, JsonDetail start_config) {
   return json::build_json([obj, event_type, start_config](JsonObject root) {
-    set_json_id(root, obj, "event-" + obj->get_object_id(), start_config);
+    set_json_id(root, obj, "event-" + obj->get_object_id_ref(), start_config);
     if (!event_type.empty()) {
       root["event_type"] = event_type;
     }
@@ -1453,7 +1489,7 @@ std::string WebServer::event_json(event::Event *obj, const std::string &event_ty
       for (auto const &event_type : obj->get_event_types()) {
         event_types.add(event_type);
       }
-      root["device_class"] = obj->get_device_class();
+      root["device_class"] = obj->get_device_class_ref();
     }
   });
 }
@@ -1461,13 +1497,14 @@ std::string WebServer::event_json(event::Event *obj, const std::string &event_ty
 
 #ifdef USE_UPDATE
 void WebServer::on_update(update::UpdateEntity *obj) {
-  if (this->events_.count() == 0)
-    return;
-  this->events_.send(this->update_json(obj, DETAIL_STATE).c_str(), "state");
+  this->send_state_event_(obj, [](WebServer *ws, EntityBase *entity) {
+    auto *o = static_cast<update::UpdateEntity *>(entity);
+    return ws->update_json(o, DETAIL_STATE);
+  });
 }
 void WebServer::handle_update_request(AsyncWebServerRequest *request, const UrlMatch &match) {
   for (update::UpdateEntity *obj : App.get_updates()) {
-    if (obj->get_object_id() != match.id)
+    if (obj->get_object_id_ref() != match.id)
       continue;
 
     if (request->method() == HTTP_GET && match.method.empty()) {
@@ -1494,7 +1531,7 @@ void WebServer::handle_update_request(AsyncWebServerRequest *request, const UrlM
 }
 std::string WebServer::update_json(update::UpdateEntity *obj, JsonDetail start_config) {
   return json::build_json([this, obj, start_config](JsonObject root) {
-    set_json_id(root, obj, "update-" + obj->get_object_id(), start_config);
+    set_json_id(root, obj, "update-" + obj->get_object_id_ref(), start_config);
     root["value"] = obj->update_info.latest_version;
     switch (obj->state) {
       case update::UPDATE_STATE_NO_UPDATE:
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "list_entities.h"
+#include "state_events.h"
 
 #include "esphome/components/web_server_base/web_server_base.h"
 #ifdef USE_WEBSERVER
@@ -54,6 +55,8 @@ struct SortingGroup {
 
 enum JsonDetail { DETAIL_ALL, DETAIL_STATE };
 
+class WebServer;
+
 /** This class allows users to create a web server with their ESP nodes.
  *
  * Behind the scenes it's using AsyncWebServer to set up the server. It exposes 3 things:
@@ -115,6 +118,12 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
    * @param expose_log.
    */
   void set_expose_log(bool expose_log) { this->expose_log_ = expose_log; }
+  /** Set the minimum time between two state events of the same entity. Updates arriving within this window are
+   * merged and only the latest state is sent once the window has passed. Defaults to 0 (send every update).
+   *
+   * @param interval The coalescing window in milliseconds.
+   */
+  void set_state_coalesce_interval(uint32_t interval) { this->state_events_.set_coalesce_interval(interval); }
 
   // ========== INTERNAL METHODS ==========
   // (In most use cases you won't need these)
@@ -348,12 +357,17 @@ class WebServer : public Controller, public Component, public AsyncWebHandler {
 
  protected:
   void schedule_(std::function<void()> &&f);
+  /// Send the state of `entity` to all event source clients, or defer it while inside the coalescing window.
+  void send_state_event_(EntityBase *entity, state_json_t build) { this->state_events_.send(entity, build); }
+  /// Send the DETAIL_ALL JSON of `entity` to the clients that just connected, built again only if the state changed.
+  void send_initial_state_(EntityBase *entity, state_json_t build);
   friend ListEntitiesIterator;
   web_server_base::WebServerBase *base_;
   AsyncEventSource events_{"/events"};
   ListEntitiesIterator entities_iterator_;
   std::map<EntityBase *, SortingComponents> sorting_entitys_;
   std::map<uint64_t, SortingGroup> sorting_groups_;
+  StateEvents<AsyncEventSource, AsyncEventSourceClient> state_events_{this, &this->events_};
 
 #if USE_WEBSERVER_VERSION == 1
   const char *css_url_{nullptr};
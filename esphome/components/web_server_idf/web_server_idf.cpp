@@ -284,8 +284,14 @@ void AsyncEventSource::handleRequest(AsyncWebServerRequest *request) {
 }
 
 void AsyncEventSource::send(const char *message, const char *event, uint32_t id, uint32_t reconnect) {
+  if (this->sessions_.empty())
+    return;
+  // Encode the event once and hand the same chunk to every session
+  std::string chunk = AsyncEventSourceResponse::build_chunk(message, event, id, reconnect);
+  if (chunk.empty())
+    return;
   for (auto *ses : this->sessions_) {
-    ses->send(message, event, id, reconnect);
+    ses->send_chunk_(chunk);
   }
 }
 
@@ -318,10 +324,13 @@ void AsyncEventSourceResponse::destroy(void *ptr) {
 }
 
 void AsyncEventSourceResponse::send(const char *message, const char *event, uint32_t id, uint32_t reconnect) {
-  if (this->fd_ == 0) {
-    return;
-  }
+  std::string chunk = build_chunk(message, event, id, reconnect);
+  if (!chunk.empty())
+    this->send_chunk_(chunk);
+}
 
+std::string AsyncEventSourceResponse::build_chunk(const char *message, const char *event, uint32_t id,
+                                                  uint32_t reconnect) {
   std::string ev;
 
   if (reconnect) {
@@ -349,20 +358,23 @@ void AsyncEventSourceResponse::send(const char *message, const char *event, uint
   }
 
   if (ev.empty()) {
-    return;
+    return ev;
   }
 
   ev.append(CRLF_STR, CRLF_LEN);
 
-  // Sending chunked content prelude
+  // Chunked content prelude, content and end of chunk in a single buffer
   auto cs = str_snprintf("%x" CRLF_STR, 4 * sizeof(ev.size()) + CRLF_LEN, ev.size());
-  httpd_socket_send(this->hd_, this->fd_, cs.c_str(), cs.size(), 0);
-
-  // Sendiing content chunk
-  httpd_socket_send(this->hd_, this->fd_, ev.c_str(), ev.size(), 0);
+  ev.insert(0, cs);
+  ev.append(CRLF_STR, CRLF_LEN);
+  return ev;
+}
 
-  // Indicate end of chunk
-  httpd_socket_send(this->hd_, this->fd_, CRLF_STR, CRLF_LEN, 0);
+void AsyncEventSourceResponse::send_chunk_(const std::string &chunk) {
+  if (this->fd_ == 0) {
+    return;
+  }
+  httpd_socket_send(this->hd_, this->fd_, chunk.c_str(), chunk.size(), 0);
 }
 
 }  // namespace web_server_idf
@@ -222,9 +222,13 @@ class AsyncEventSourceResponse {
  public:
   void send(const char *message, const char *event = nullptr, uint32_t id = 0, uint32_t reconnect = 0);
 
+  /// Encode an event as a complete HTTP chunk, empty if there is nothing to send.
+  static std::string build_chunk(const char *message, const char *event, uint32_t id, uint32_t reconnect);
+
  protected:
   AsyncEventSourceResponse(const AsyncWebServerRequest *request, AsyncEventSource *server);
   static void destroy(void *p);
+  void send_chunk_(const std::string &chunk);
   AsyncEventSource *server_;
   httpd_handle_t hd_{};
   int fd_{};
@@ -252,6 +256,8 @@ class AsyncEventSource : public AsyncWebHandler {
   void send(const char *message, const char *event = nullptr, uint32_t id = 0, uint32_t reconnect = 0);
 
   size_t count() const { return this->sessions_.size(); }
+  /// Whether the client passed to onConnect is still connected, it is deleted once it disconnects.
+  bool has_client(AsyncEventSourceClient *client) const { return this->sessions_.count(client) != 0; }
 
  protected:
   std::string url_;
@@ -27,6 +27,9 @@ void Application::register_component_(Component *comp) {
 }
 void Application::setup() {
   ESP_LOGI(TAG, "Running through setup()...");
+#ifdef USE_ESP32
+  this->wake_semaphore_ = xSemaphoreCreateBinary();
+#endif
   ESP_LOGV(TAG, "Sorting components by setup priority...");
   std::stable_sort(this->components_.begin(), this->components_.end(), [](const Component *a, const Component *b) {
     return a->get_actual_setup_priority() > b->get_actual_setup_priority();
@@ -84,6 +87,10 @@ void Application::loop() {
   auto elapsed = now - this->last_loop_;
   if (elapsed >= this->loop_interval_ || HighFrequencyLoopRequester::is_high_frequency()) {
     yield();
+#ifdef USE_HOST
+    // Still check the descriptors, their owners rely on being told about new data
+    this->sleep_(0);
+#endif
   } else {
     uint32_t delay_time = this->loop_interval_ - elapsed;
     uint32_t next_schedule = this->scheduler.next_schedule_in().value_or(delay_time);
@@ -91,7 +98,7 @@ void Application::loop() {
     // otherwise interval=0 schedules result in constant looping with almost no sleep
     next_schedule = std::max(next_schedule, delay_time / 2);
     delay_time = std::min(next_schedule, delay_time);
-    delay(delay_time);
+    this->sleep_(delay_time);
   }
   this->last_loop_ = now;
 
@@ -143,6 +150,50 @@ void Application::run_safe_shutdown_hooks() {
   }
 }
 
+#ifdef USE_HOST
+void Application::register_wake_fd(int fd, std::function<void()> &&callback) {
+  this->wake_fds_.push_back({fd, POLLIN, 0});
+  this->wake_callbacks_.push_back(std::move(callback));
+}
+
+void Application::rearm_wake_fd(int fd) {
+  for (auto &pfd : this->wake_fds_) {
+    if (pfd.fd == -1 - fd)
+      pfd.fd = fd;
+  }
+}
+
+void Application::sleep_(uint32_t delay_time) {
+  int res = ::poll(this->wake_fds_.data(), this->wake_fds_.size(), delay_time);
+  if (res <= 0)
+    return;
+  for (size_t i = 0; i < this->wake_fds_.size(); i++) {
+    if (this->wake_fds_[i].revents == 0)
+      continue;
+    // poll() is level triggered, so a descriptor with unread data would end every sleep at once. It is left out,
+    // poll() skips negative descriptors, until its owner has drained it.
+    this->wake_fds_[i].fd = -1 - this->wake_fds_[i].fd;
+    this->wake_fds_[i].revents = 0;
+    this->wake_callbacks_[i]();
+  }
+}
+#elif defined(USE_ESP32)
+void Application::wake_loop() {
+  if (this->wake_semaphore_ != nullptr)
+    xSemaphoreGive(this->wake_semaphore_);
+}
+
+void Application::sleep_(uint32_t delay_time) {
+  if (this->wake_semaphore_ == nullptr) {
+    delay(delay_time);
+    return;
+  }
+  xSemaphoreTake(this->wake_semaphore_, delay_time / portTICK_PERIOD_MS);
+}
+#else
+void Application::sleep_(uint32_t delay_time) { delay(delay_time); }
+#endif
+
 void Application::calculate_looping_components_() {
   for (auto *obj : this->components_) {
     if (obj->has_overridden_loop())
@@ -9,6 +9,10 @@
 #include "esphome/core/preferences.h"
 #include "esphome/core/scheduler.h"
 
+#ifdef USE_HOST
+#include <poll.h>
+#endif
+
 #ifdef USE_BINARY_SENSOR
 #include "esphome/components/binary_sensor/binary_sensor.h"
 #endif
@@ -233,6 +237,23 @@ class Application {
 
   void schedule_dump_config() { this->dump_config_at_ = 0; }
 
+#ifdef USE_HOST
+  /** Wake up from the sleep at the end of loop() as soon as `fd` becomes readable.
+   *
+   * `callback` is called from loop() when poll() reports the descriptor as readable, so owners can skip querying an
+   * idle descriptor until then. The descriptor then no longer wakes the loop until its owner has read all its data
+   * and calls rearm_wake_fd(); until then the loop sleeps its normal interval.
+   */
+  void register_wake_fd(int fd, std::function<void()> &&callback);
+  /// Let `fd` wake the loop again, for its owner once it has read all the data that was available.
+  void rearm_wake_fd(int fd);
+#endif
+
+#ifdef USE_ESP32
+  /// Cut the sleep at the end of loop() short, for other tasks that produced work for a component (not ISR safe).
+  void wake_loop();
+#endif
+
   void feed_wdt();
 
   void reboot();
@@ -470,6 +491,9 @@ class Application {
 
   void feed_wdt_arch_();
 
+  /// Sleep for up to `delay_time` ms, returning early when woken by one of the sources above.
+  void sleep_(uint32_t delay_time);
+
   std::vector<Component *> components_{};
   std::vector<Component *> looping_components_{};
 
@@ -547,6 +571,13 @@ class Application {
   uint32_t loop_interval_{16};
   size_t dump_config_at_{SIZE_MAX};
   uint32_t app_state_{0};
+#ifdef USE_HOST
+  std::vector<pollfd> wake_fds_{};
+  std::vector<std::function<void()>> wake_callbacks_{};
+#endif
+#ifdef USE_ESP32
+  SemaphoreHandle_t wake_semaphore_{nullptr};
+#endif
 };
 
 /// Global storage of Application pointer - only one Application can exist.
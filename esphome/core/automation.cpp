@@ -0,0 +1,128 @@
+#include "esphome/core/automation.h"
+#include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+
+#include <algorithm>
+
+namespace esphome {
+
+AutomationRuntime *AutomationRuntime::get() {
+  static AutomationRuntime *runtime = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+  if (runtime == nullptr) {
+    runtime = new AutomationRuntime();  // NOLINT(cppcoreguidelines-owning-memory)
+    App.register_component(runtime);
+  }
+  return runtime;
+}
+
+void AutomationRuntime::Continuation::cancel_deadline() {
+  this->generation_++;
+  if (this->scheduled_) {
+    this->scheduled_ = false;
+    AutomationRuntime::get()->drop_timer_();
+  }
+}
+
+void AutomationRuntime::schedule(Continuation *continuation, uint32_t delay) {
+  continuation->cancel_deadline();
+  continuation->scheduled_ = true;
+  this->timers_.push_back(Timer{this->millis64_() + delay, continuation, continuation->generation_});
+  std::push_heap(this->timers_.begin(), this->timers_.end(), timer_after_);
+  this->arm_();
+}
+
+void AutomationRuntime::add_waiter(Waiter *waiter) {
+  waiter->changed_ = true;
+  if (waiter->listed_)
+    return;
+  waiter->listed_ = true;
+  this->waiters_.push_back(waiter);
+}
+
+void AutomationRuntime::loop() {
+  // Waiters added by resumed chains are appended and checked in the same pass
+  for (size_t i = 0; i < this->waiters_.size();) {
+    Waiter *waiter = this->waiters_[i];
+    if (!waiter->polled_ && !waiter->changed_) {
+      i++;
+      continue;
+    }
+    waiter->changed_ = false;
+    if (waiter->check_waiting()) {
+      i++;
+      continue;
+    }
+    waiter->listed_ = false;
+    this->waiters_[i] = this->waiters_.back();
+    this->waiters_.pop_back();
+  }
+}
+
+uint64_t AutomationRuntime::millis64_() {
+  const uint32_t now = millis();
+  if (now < this->last_millis_)
+    this->millis_major_++;
+  this->last_millis_ = now;
+  return (uint64_t(this->millis_major_) << 32) | now;
+}
+
+void AutomationRuntime::drop_timer_() {
+  this->cancelled_timers_++;
+  if (this->running_timers_ || this->cancelled_timers_ * 2 <= this->timers_.size())
+    return;
+  this->timers_.erase(std::remove_if(this->timers_.begin(), this->timers_.end(),
+                                     [](const Timer &timer) {
+                                       return timer.generation != timer.continuation->generation_;
+                                     }),
+                      this->timers_.end());
+  std::make_heap(this->timers_.begin(), this->timers_.end(), timer_after_);
+  this->cancelled_timers_ = 0;
+  this->arm_();
+}
+
+void AutomationRuntime::arm_() {
+  if (this->running_timers_)
+    return;
+  // Drop cancelled timers so they don't keep the scheduler busy
+  while (!this->timers_.empty() &&
+         this->timers_.front().generation != this->timers_.front().continuation->generation_) {
+    std::pop_heap(this->timers_.begin(), this->timers_.end(), timer_after_);
+    this->timers_.pop_back();
+    this->cancelled_timers_--;
+  }
+  if (this->timers_.empty()) {
+    if (this->armed_deadline_ != UINT64_MAX)
+      this->cancel_timeout("timers");
+    this->armed_deadline_ = UINT64_MAX;
+    return;
+  }
+  const uint64_t deadline = this->timers_.front().deadline;
+  if (deadline == this->armed_deadline_)
+    return;
+  this->armed_deadline_ = deadline;
+  const uint64_t now = this->millis64_();
+  this->set_timeout("timers", deadline > now ? uint32_t(deadline - now) : 0, [this]() { this->run_timers_(); });
+}
+
+void AutomationRuntime::run_timers_() {
+  this->armed_deadline_ = UINT64_MAX;
+  this->running_timers_ = true;
+  const uint64_t now = this->millis64_();
+  while (!this->timers_.empty() && this->timers_.front().deadline <= now) {
+    std::pop_heap(this->timers_.begin(), this->timers_.end(), timer_after_);
+    const Timer timer = this->timers_.back();
+    this->timers_.pop_back();
+    if (timer.generation == timer.continuation->generation_) {
+      // The node may be reused for a new deadline by the chain it resumes
+      timer.continuation->generation_++;
+      timer.continuation->scheduled_ = false;
+      timer.continuation->on_deadline();
+    } else {
+      this->cancelled_timers_--;
+    }
+  }
+  this->running_timers_ = false;
+  this->arm_();
+}
+
+}  // namespace esphome
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <vector>
 #include "esphome/core/component.h"
 #include "esphome/core/helpers.h"
@@ -33,6 +36,8 @@ template<typename T, typename... X> class TemplatableValue {
   TemplatableValue(F f) : type_(LAMBDA), f_(f) {}
 
   bool has_value() { return this->type_ != NONE; }
+  /// Whether the value is computed by a lambda, which may read anything and so can't be watched.
+  bool is_lambda() const { return this->type_ == LAMBDA; }
 
   T value(X... x) {
     if (this->type_ == LAMBDA) {
@@ -76,6 +81,12 @@ template<typename... Ts> class Condition {
   /// Check whether this condition passes. This condition check must be instant, and not cause any delays.
   virtual bool check(Ts... x) = 0;
 
+  /** Register a callback to be called whenever the result of check() may have changed.
+   *
+   * @return false if the result also depends on state that can't be watched, the condition must then be polled.
+   */
+  virtual bool watch(const std::function<void()> &callback) { return false; }
+
   /// Call check with a tuple of values as parameter.
   bool check_tuple(const std::tuple<Ts...> &tuple) {
     return this->check_tuple_(tuple, typename gens<sizeof...(Ts)>::type());
@@ -87,6 +98,106 @@ template<typename... Ts> class Condition {
   }
 };
 
+/// Call `callback` whenever `entity` publishes a state. Used for the entities the code generator found a lambda to
+/// read, works with any entity that has add_on_state_callback(). `callback` is stored in the state callback itself, so
+/// a small lambda fits its inline storage.
+template<typename T, typename F> void on_entity_state(T *entity, F &&callback) {
+  entity->add_on_state_callback([callback = std::forward<F>(callback)](auto &&...) mutable { callback(); });
+}
+
+/** Resumes paused action chains, so that delay and wait_until actions don't each need a Component.
+ *
+ * Delays of all automations share a single scheduler timeout for the earliest deadline. Waiting actions are only
+ * checked from the loop when one of their conditions may have changed, or on every loop if their conditions can't be
+ * watched.
+ */
+class AutomationRuntime : public Component {
+ public:
+  /// A paused action chain.
+  class Continuation {
+   public:
+    /// Called once the deadline passed to AutomationRuntime::schedule() is reached.
+    virtual void on_deadline() = 0;
+    /// Drop the pending deadline, if any.
+    void cancel_deadline();
+
+   protected:
+    friend AutomationRuntime;
+    uint32_t generation_{0};
+    bool scheduled_{false};  ///< a timer for the current generation is in the heap
+  };
+
+  /// An action with paused chains that wait for a condition.
+  class Waiter {
+   public:
+    /// Check the paused chains, return false once none are left.
+    virtual bool check_waiting() = 0;
+
+   protected:
+    friend AutomationRuntime;
+    bool polled_{true};    ///< the conditions can't be watched and are checked on every loop
+    bool changed_{true};   ///< a watched condition may have changed since the last check
+    bool listed_{false};   ///< in the list of the runtime
+  };
+
+  /// The runtime shared by all automations, registered as a component on first use.
+  static AutomationRuntime *get();
+
+  /// Call `continuation->on_deadline()` after `delay` ms, unless it is cancelled before.
+  void schedule(Continuation *continuation, uint32_t delay);
+  /// Start checking `waiter` until it has no more paused chains.
+  void add_waiter(Waiter *waiter);
+  /// Check `waiter` on the next loop, for watched conditions that changed.
+  void notify(Waiter *waiter) { waiter->changed_ = true; }
+
+  void loop() override;
+  float get_setup_priority() const override { return setup_priority::HARDWARE; }
+
+ protected:
+  struct Timer {
+    uint64_t deadline;
+    Continuation *continuation;
+    uint32_t generation;
+  };
+
+  static bool timer_after_(const Timer &a, const Timer &b) { return a.deadline > b.deadline; }
+  uint64_t millis64_();
+  void arm_();
+  void run_timers_();
+  /// Count a timer whose continuation cancelled it, they are removed once they outnumber the live ones.
+  void drop_timer_();
+
+  std::vector<Timer> timers_;  ///< heap with the earliest deadline first
+  size_t cancelled_timers_{0};  ///< timers in the heap that no longer match their continuation
+  std::vector<Waiter *> waiters_;
+  uint64_t armed_deadline_{UINT64_MAX};
+  uint32_t last_millis_{0};
+  uint32_t millis_major_{0};
+  bool running_timers_{false};
+};
+
+/// The paused chains of one action, their nodes are reused once a chain is resumed or stopped.
+template<typename T> class ContinuationPool {
+ public:
+  /// An unused node, `active` is set.
+  T *acquire() {
+    for (auto &node : this->nodes_) {
+      if (!node->active) {
+        node->active = true;
+        return node.get();
+      }
+    }
+    this->nodes_.push_back(make_unique<T>());
+    this->nodes_.back()->active = true;
+    return this->nodes_.back().get();
+  }
+  size_t size() const { return this->nodes_.size(); }
+  T *operator[](size_t i) { return this->nodes_[i].get(); }
+
+ protected:
+  std::vector<std::unique_ptr<T>> nodes_;
+};
+
 template<typename... Ts> class Automation;
 
 template<typename... Ts> class Trigger {
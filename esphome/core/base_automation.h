@@ -21,6 +21,13 @@ template<typename... Ts> class AndCondition : public Condition<Ts...> {
     return true;
   }
 
+  bool watch(const std::function<void()> &callback) override {
+    bool watched = true;
+    for (auto *condition : this->conditions_)
+      watched &= condition->watch(callback);
+    return watched;
+  }
+
  protected:
   std::vector<Condition<Ts...> *> conditions_;
 };
@@ -37,6 +44,13 @@ template<typename... Ts> class OrCondition : public Condition<Ts...> {
     return false;
   }
 
+  bool watch(const std::function<void()> &callback) override {
+    bool watched = true;
+    for (auto *condition : this->conditions_)
+      watched &= condition->watch(callback);
+    return watched;
+  }
+
  protected:
   std::vector<Condition<Ts...> *> conditions_;
 };
@@ -45,6 +59,7 @@ template<typename... Ts> class NotCondition : public Condition<Ts...> {
  public:
   explicit NotCondition(Condition<Ts...> *condition) : condition_(condition) {}
   bool check(Ts... x) override { return !this->condition_->check(x...); }
+  bool watch(const std::function<void()> &callback) override { return this->condition_->watch(callback); }
 
  protected:
   Condition<Ts...> *condition_;
@@ -62,6 +77,13 @@ template<typename... Ts> class XorCondition : public Condition<Ts...> {
     return result == 1;
   }
 
+  bool watch(const std::function<void()> &callback) override {
+    bool watched = true;
+    for (auto *condition : this->conditions_)
+      watched &= condition->watch(callback);
+    return watched;
+  }
+
  protected:
   std::vector<Condition<Ts...> *> conditions_;
 };
@@ -71,8 +93,23 @@ template<typename... Ts> class LambdaCondition : public Condition<Ts...> {
   explicit LambdaCondition(std::function<bool(Ts...)> &&f) : f_(std::move(f)) {}
   bool check(Ts... x) override { return this->f_(x...); }
 
+  /// Add an entity read by the lambda, only called if the code generator found it doesn't read anything else.
+  template<typename T> void add_dependency(T *entity) {
+    if (this->on_change_ == nullptr)
+      this->on_change_ = make_unique<CallbackManager<void()>>();
+    auto *on_change = this->on_change_.get();
+    on_entity_state(entity, [on_change]() { on_change->call(); });
+  }
+  bool watch(const std::function<void()> &callback) override {
+    if (this->on_change_ == nullptr)
+      return false;
+    this->on_change_->add(std::function<void()>(callback));
+    return true;
+  }
+
  protected:
   std::function<bool(Ts...)> f_;
+  std::unique_ptr<CallbackManager<void()>> on_change_;  ///< called when one of the dependencies publishes
 };
 
 template<typename... Ts> class ForCondition : public Condition<Ts...>, public Component {
@@ -148,23 +185,46 @@ class ProjectUpdateTrigger : public Trigger<std::string>, public Component {
 };
 #endif
 
-template<typename... Ts> class DelayAction : public Action<Ts...>, public Component {
+template<typename... Ts> class DelayAction : public Action<Ts...> {
  public:
-  explicit DelayAction() = default;
+  // Creates the runtime before the components are set up
+  explicit DelayAction() { AutomationRuntime::get(); }
 
   TEMPLATABLE_VALUE(uint32_t, delay)
 
   void play_complex(Ts... x) override {
-    auto f = std::bind(&DelayAction<Ts...>::play_next_, this, x...);
     this->num_running_++;
-    this->set_timeout(this->delay_.value(x...), f);
+    auto *pending = this->pending_.acquire();
+    pending->parent = this;
+    pending->args = std::make_tuple(x...);
+    AutomationRuntime::get()->schedule(pending, this->delay_.value(x...));
   }
-  float get_setup_priority() const override { return setup_priority::HARDWARE; }
 
   void play(Ts... x) override { /* ignore - see play_complex */
   }
 
-  void stop() override { this->cancel_timeout(""); }
+  void stop() override {
+    for (size_t i = 0; i < this->pending_.size(); i++) {
+      this->pending_[i]->cancel_deadline();
+      this->pending_[i]->active = false;
+    }
+  }
+
+ protected:
+  struct Pending : public AutomationRuntime::Continuation {
+    DelayAction *parent;
+    std::tuple<typename std::decay<Ts>::type...> args;  ///< copies, references passed to play() don't outlive it
+    bool active{false};
+
+    void on_deadline() override {
+      // The chain may reuse this node while it still reads the arguments, which are references for reference Ts
+      auto args = std::move(this->args);
+      this->active = false;
+      this->parent->play_next_tuple_(args);
+    }
+  };
+
+  ContinuationPool<Pending> pending_;
 };
 
 template<typename... Ts> class LambdaAction : public Action<Ts...> {
@@ -306,9 +366,9 @@ template<typename... Ts> class RepeatAction : public Action<Ts...> {
   std::tuple<Ts...> var_;
 };
 
-template<typename... Ts> class WaitUntilAction : public Action<Ts...>, public Component {
+template<typename... Ts> class WaitUntilAction : public Action<Ts...>, public AutomationRuntime::Waiter {
  public:
-  WaitUntilAction(Condition<Ts...> *condition) : condition_(condition) {}
+  WaitUntilAction(Condition<Ts...> *condition) : condition_(condition) { AutomationRuntime::get(); }
 
   TEMPLATABLE_VALUE(uint32_t, timeout_value)
 
@@ -321,39 +381,63 @@ template<typename... Ts> class WaitUntilAction : public Action<Ts...>, public Co
       }
       return;
     }
-    this->var_ = std::make_tuple(x...);
-
-    if (this->timeout_value_.has_value()) {
-      auto f = std::bind(&WaitUntilAction<Ts...>::play_next_, this, x...);
-      this->set_timeout("timeout", this->timeout_value_.value(x...), f);
+    if (!this->watched_) {
+      this->watched_ = true;
+      this->polled_ = !this->condition_->watch([this]() { AutomationRuntime::get()->notify(this); });
     }
 
-    this->loop();
+    auto *pending = this->pending_.acquire();
+    pending->parent = this;
+    pending->args = std::make_tuple(x...);
+    this->num_waiting_++;
+    if (this->timeout_value_.has_value())
+      AutomationRuntime::get()->schedule(pending, this->timeout_value_.value(x...));
+    AutomationRuntime::get()->add_waiter(this);
   }
 
-  void loop() override {
-    if (this->num_running_ == 0)
-      return;
-
-    if (!this->condition_->check_tuple(this->var_)) {
-      return;
+  bool check_waiting() override {
+    // Chains resumed here may wait again, the nodes they take are checked on the next loop at the latest
+    for (size_t i = 0; i < this->pending_.size(); i++) {
+      Pending *pending = this->pending_[i];
+      if (pending->active && this->condition_->check_tuple(pending->args))
+        pending->resume();
     }
-
-    this->cancel_timeout("timeout");
-
-    this->play_next_tuple_(this->var_);
+    return this->num_waiting_ != 0;
   }
 
-  float get_setup_priority() const override { return setup_priority::DATA; }
-
   void play(Ts... x) override { /* ignore - see play_complex */
   }
 
-  void stop() override { this->cancel_timeout("timeout"); }
+  void stop() override {
+    for (size_t i = 0; i < this->pending_.size(); i++) {
+      this->pending_[i]->cancel_deadline();
+      this->pending_[i]->active = false;
+    }
+    this->num_waiting_ = 0;
+  }
 
  protected:
+  struct Pending : public AutomationRuntime::Continuation {
+    WaitUntilAction *parent;
+    std::tuple<typename std::decay<Ts>::type...> args;  ///< copies, references passed to play() don't outlive it
+    bool active{false};
+
+    /// Continue the chain, either the condition passed or the timeout was reached.
+    void resume() {
+      this->cancel_deadline();
+      // The chain may reuse this node while it still reads the arguments, see DelayAction
+      auto args = std::move(this->args);
+      this->active = false;
+      this->parent->num_waiting_--;
+      this->parent->play_next_tuple_(args);
+    }
+    void on_deadline() override { this->resume(); }
+  };
+
   Condition<Ts...> *condition_;
-  std::tuple<Ts...> var_{};
+  ContinuationPool<Pending> pending_;
+  uint32_t num_waiting_{0};
+  bool watched_{false};
 };
 
 template<typename... Ts> class UpdateComponentAction : public Action<Ts...> {
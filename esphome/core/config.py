@@ -321,6 +321,19 @@ async def _add_platformio_options(pio_options):
         cg.add_platformio_option(key, val)
 
 
+@coroutine_with_priority(-1000.0)
+async def _add_callback_pool():
+    # Runs last, once every component counted its callbacks
+    if size := cg.callback_pool_size():
+        cg.add_define("ESPHOME_CALLBACK_POOL_SIZE", size)
+
+
+@coroutine_with_priority(-1000.0)
+async def _add_entity_strings():
+    # Runs last, once every entity added its strings
+    cg.add_entity_strings()
+
+
 @coroutine_with_priority(30.0)
 async def _add_automations(config):
     for conf in config.get(CONF_ON_BOOT, []):
@@ -359,6 +372,8 @@ async def to_code(config):
     )
 
     CORE.add_job(_add_automations, config)
+    CORE.add_job(_add_callback_pool)
+    CORE.add_job(_add_entity_strings)
 
     cg.add_build_flag("-fno-exceptions")
 
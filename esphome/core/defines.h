@@ -14,6 +14,9 @@
 #define ESPHOME_PROJECT_VERSION_30 "v2"
 #define ESPHOME_VARIANT "ESP32"
 
+// Sizes chosen by the code generator
+#define ESPHOME_CALLBACK_POOL_SIZE 64
+
 // Feature flags
 #define USE_ALARM_CONTROL_PANEL
 #define USE_API
@@ -36,10 +39,13 @@
 #define USE_GRAPHICAL_DISPLAY_MENU
 #define USE_HOMEASSISTANT_TIME
 #define USE_HTTP_REQUEST_OTA_WATCHDOG_TIMEOUT 8000  // NOLINT
+#define USE_I2C
 #define USE_JSON
 #define USE_LIGHT
 #define USE_LOCK
 #define USE_LOGGER
+#define USE_LOGGER_BINARY
+#define USE_LOGGER_LOG_RING
 #define USE_LVGL
 #define USE_LVGL_ANIMIMG
 #define USE_LVGL_BINARY_SENSOR
@@ -64,6 +70,7 @@
 #define USE_OTA_VERSION 1
 #define USE_OUTPUT
 #define USE_POWER_SUPPLY
+#define USE_PREFERENCES_LOG
 #define USE_QR_CODE
 #define USE_SELECT
 #define USE_SENSOR
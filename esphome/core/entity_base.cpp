@@ -27,31 +27,30 @@ bool EntityBase::is_disabled_by_default() const { return this->disabled_by_defau
 void EntityBase::set_disabled_by_default(bool disabled_by_default) { this->disabled_by_default_ = disabled_by_default; }
 
 // Entity Icon
-std::string EntityBase::get_icon() const {
-  if (this->icon_c_str_ == nullptr) {
-    return "";
-  }
-  return this->icon_c_str_;
-}
+std::string EntityBase::get_icon() const { return this->get_icon_ref().str(); }
 void EntityBase::set_icon(const char *icon) { this->icon_c_str_ = icon; }
 
 // Entity Category
 EntityCategory EntityBase::get_entity_category() const { return this->entity_category_; }
 void EntityBase::set_entity_category(EntityCategory entity_category) { this->entity_category_ = entity_category; }
 
+// Object ID of the entities named after the device, when the friendly name is only known at runtime
+static const std::string &friendly_object_id() {
+  // Set up once, the friendly name doesn't change after App.pre_setup()
+  static const std::string OBJECT_ID = str_sanitize(str_snake_case(App.get_friendly_name()));
+  return OBJECT_ID;
+}
+
 // Entity Object ID
-std::string EntityBase::get_object_id() const {
+std::string EntityBase::get_object_id() const { return this->get_object_id_ref().str(); }
+StringRef EntityBase::get_object_id_ref() const {
   // Check if `App.get_friendly_name()` is constant or dynamic.
   if (!this->has_own_name_ && App.is_name_add_mac_suffix_enabled()) {
     // `App.get_friendly_name()` is dynamic.
-    return str_sanitize(str_snake_case(App.get_friendly_name()));
-  } else {
-    // `App.get_friendly_name()` is constant.
-    if (this->object_id_c_str_ == nullptr) {
-      return "";
-    }
-    return this->object_id_c_str_;
+    return StringRef(friendly_object_id());
   }
+  // `App.get_friendly_name()` is constant.
+  return StringRef::from_maybe_nullptr(this->object_id_c_str_);
 }
 void EntityBase::set_object_id(const char *object_id) {
   this->object_id_c_str_ = object_id;
@@ -63,9 +62,8 @@ void EntityBase::calc_object_id_() {
   // Check if `App.get_friendly_name()` is constant or dynamic.
   if (!this->has_own_name_ && App.is_name_add_mac_suffix_enabled()) {
     // `App.get_friendly_name()` is dynamic.
-    const auto object_id = str_sanitize(str_snake_case(App.get_friendly_name()));
     // FNV-1 hash
-    this->object_id_hash_ = fnv1_hash(object_id);
+    this->object_id_hash_ = fnv1_hash(friendly_object_id());
   } else {
     // `App.get_friendly_name()` is constant.
     // FNV-1 hash
@@ -75,19 +73,12 @@ void EntityBase::calc_object_id_() {
 
 uint32_t EntityBase::get_object_id_hash() { return this->object_id_hash_; }
 
-std::string EntityBase_DeviceClass::get_device_class() {
-  if (this->device_class_ == nullptr) {
-    return "";
-  }
-  return this->device_class_;
-}
+std::string EntityBase_DeviceClass::get_device_class() { return this->get_device_class_ref().str(); }
 
 void EntityBase_DeviceClass::set_device_class(const char *device_class) { this->device_class_ = device_class; }
 
 std::string EntityBase_UnitOfMeasurement::get_unit_of_measurement() {
-  if (this->unit_of_measurement_ == nullptr)
-    return "";
-  return this->unit_of_measurement_;
+  return this->get_unit_of_measurement_ref().str();
 }
 void EntityBase_UnitOfMeasurement::set_unit_of_measurement(const char *unit_of_measurement) {
   this->unit_of_measurement_ = unit_of_measurement;
@@ -13,6 +13,9 @@ enum EntityCategory : uint8_t {
 };
 
 // The generic Entity base class that provides an interface common to all Entities.
+//
+// The strings of an entity point to constants generated into a table in flash, the `_ref()` getters return them
+// without copying and should be preferred over the ones returning a std::string.
 class EntityBase {
  public:
   // Get/set the name of this Entity
@@ -24,6 +27,7 @@ class EntityBase {
 
   // Get the sanitized name of this Entity as an ID.
   std::string get_object_id() const;
+  StringRef get_object_id_ref() const;
   void set_object_id(const char *object_id);
 
   // Get the unique Object ID of this Entity
@@ -45,6 +49,7 @@ class EntityBase {
 
   // Get/set this entity's icon
   std::string get_icon() const;
+  StringRef get_icon_ref() const { return StringRef::from_maybe_nullptr(this->icon_c_str_); }
   void set_icon(const char *icon);
 
  protected:
@@ -67,6 +72,8 @@ class EntityBase_DeviceClass {  // NOLINT(readability-identifier-naming)
  public:
   /// Get the device class, using the manual override if set.
   std::string get_device_class();
+  /// Get the device class without copying it.
+  StringRef get_device_class_ref() const { return StringRef::from_maybe_nullptr(this->device_class_); }
   /// Manually set the device class.
   void set_device_class(const char *device_class);
 
@@ -78,6 +85,8 @@ class EntityBase_UnitOfMeasurement {  // NOLINT(readability-identifier-naming)
  public:
   /// Get the unit of measurement, using the manual override if set.
   std::string get_unit_of_measurement();
+  /// Get the unit of measurement without copying it.
+  StringRef get_unit_of_measurement_ref() const { return StringRef::from_maybe_nullptr(this->unit_of_measurement_); }
   /// Manually set the unit of measurement.
   void set_unit_of_measurement(const char *unit_of_measurement);
 
@@ -408,14 +408,318 @@ ParseOnOffState parse_on_off(const char *str, const char *on, const char *off) {
 }
 
 std::string value_accuracy_to_string(float value, int8_t accuracy_decimals) {
+  char tmp[32];  // should be enough, but we should maybe improve this at some point.
+  size_t len = value_accuracy_to_buf(tmp, sizeof(tmp), value, accuracy_decimals);
+  return std::string(tmp, len);
+}
+
+static const uint32_t POW10_32[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+/// Copy a formatted value to the buffer of the caller, truncated like snprintf().
+static size_t copy_formatted(char *buf, size_t buf_size, const char *str, size_t len) {
+  if (buf_size == 0)
+    return 0;
+  len = std::min(len, buf_size - 1);
+  memcpy(buf, str, len);
+  buf[len] = '\0';
+  return len;
+}
+
+/// Write the decimal digits of value right-aligned, ending before end, returns the first digit.
+static char *write_digits_backwards(char *end, uint32_t value, int min_digits = 1) {
+  do {
+    *--end = char('0' + value % 10);
+    value /= 10;
+  } while (--min_digits > 0 || value != 0);
+  return end;
+}
+
+size_t value_accuracy_to_buf(char *buf, size_t buf_size, float value, int8_t accuracy_decimals) {
+  if (buf_size == 0)
+    return 0;
   if (accuracy_decimals < 0) {
     auto multiplier = powf(10.0f, accuracy_decimals);
     value = roundf(value * multiplier) / multiplier;
     accuracy_decimals = 0;
   }
-  char tmp[32];  // should be enough, but we should maybe improve this at some point.
-  snprintf(tmp, sizeof(tmp), "%.*f", accuracy_decimals, value);
-  return std::string(tmp);
+  // The value times 10^accuracy_decimals is computed exactly from the bits of the float and rounded half to even like
+  // printf(), which takes a few integer operations instead of the arbitrary precision arithmetic of printf()
+  if (accuracy_decimals > 9 || !(std::fabs(value) < 1e9f)) {
+    int len = snprintf(buf, buf_size, "%.*f", accuracy_decimals, value);
+    if (len < 0)
+      return 0;
+    return std::min<size_t>(len, buf_size - 1);
+  }
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  const uint32_t biased_exponent = (bits >> 23) & 0xFF;
+  uint64_t mantissa = bits & 0x7FFFFF;
+  int shift = 149;  // value = mantissa / 2^shift
+  if (biased_exponent != 0) {
+    mantissa |= 1 << 23;
+    shift = 150 - int(biased_exponent);
+  }
+  // At most 2^24 * 10^9 * 2^6, no overflow
+  const uint64_t scaled = mantissa * POW10_32[accuracy_decimals];
+  uint64_t units;
+  if (shift <= 0) {
+    units = scaled << -shift;
+  } else if (shift < 64) {
+    units = scaled >> shift;
+    const uint64_t rest = scaled & ((uint64_t(1) << shift) - 1);
+    const uint64_t half = uint64_t(1) << (shift - 1);
+    if (rest > half || (rest == half && (units & 1)))
+      units++;
+  } else {
+    units = shift == 64 && scaled > (uint64_t(1) << 63);
+  }
+
+  char tmp[24];
+  char *end = tmp + sizeof(tmp);
+  char *pos;
+  // Both parts are below 10^9
+  const uint32_t integer = uint32_t(units / POW10_32[accuracy_decimals]);
+  const uint32_t fraction = uint32_t(units - uint64_t(integer) * POW10_32[accuracy_decimals]);
+  if (accuracy_decimals > 0) {
+    pos = write_digits_backwards(end, fraction, accuracy_decimals);
+    *--pos = '.';
+    pos = write_digits_backwards(pos, integer);
+  } else {
+    pos = write_digits_backwards(end, integer);
+  }
+  if (std::signbit(value))
+    *--pos = '-';
+  return copy_formatted(buf, buf_size, pos, end - pos);
+}
+
+// Shortest representation of floats with the Ryu algorithm, see https://github.com/ulfjack/ryu and
+// "Ryū: fast float-to-string conversion" by Ulf Adams (PLDI 2018). The tables hold 2^k / 5^q and 5^i / 2^k.
+static const int FLOAT_POW5_INV_BITCOUNT = 59;
+static const int FLOAT_POW5_BITCOUNT = 61;
+static const uint64_t FLOAT_POW5_INV_SPLIT[31] = {
+    576460752303423489ULL, 461168601842738791ULL, 368934881474191033ULL, 295147905179352826ULL, 472236648286964522ULL,
+    377789318629571618ULL, 302231454903657294ULL, 483570327845851670ULL, 386856262276681336ULL, 309485009821345069ULL,
+    495176015714152110ULL, 396140812571321688ULL, 316912650057057351ULL, 507060240091291761ULL, 405648192073033409ULL,
+    324518553658426727ULL, 519229685853482763ULL, 415383748682786211ULL, 332306998946228969ULL, 531691198313966350ULL,
+    425352958651173080ULL, 340282366920938464ULL, 544451787073501542ULL, 435561429658801234ULL, 348449143727040987ULL,
+    557518629963265579ULL, 446014903970612463ULL, 356811923176489971ULL, 570899077082383953ULL, 456719261665907162ULL,
+    365375409332725730ULL,
+};
+static const uint64_t FLOAT_POW5_SPLIT[47] = {
+    1152921504606846976ULL, 1441151880758558720ULL, 1801439850948198400ULL, 2251799813685248000ULL,
+    1407374883553280000ULL, 1759218604441600000ULL, 2199023255552000000ULL, 1374389534720000000ULL,
+    1717986918400000000ULL, 2147483648000000000ULL, 1342177280000000000ULL, 1677721600000000000ULL,
+    2097152000000000000ULL, 1310720000000000000ULL, 1638400000000000000ULL, 2048000000000000000ULL,
+    1280000000000000000ULL, 1600000000000000000ULL, 2000000000000000000ULL, 1250000000000000000ULL,
+    1562500000000000000ULL, 1953125000000000000ULL, 1220703125000000000ULL, 1525878906250000000ULL,
+    1907348632812500000ULL, 1192092895507812500ULL, 1490116119384765625ULL, 1862645149230957031ULL,
+    1164153218269348144ULL, 1455191522836685180ULL, 1818989403545856475ULL, 2273736754432320594ULL,
+    1421085471520200371ULL, 1776356839400250464ULL, 2220446049250313080ULL, 1387778780781445675ULL,
+    1734723475976807094ULL, 2168404344971008868ULL, 1355252715606880542ULL, 1694065894508600678ULL,
+    2117582368135750847ULL, 1323488980084844279ULL, 1654361225106055349ULL, 2067951531382569187ULL,
+    1292469707114105741ULL, 1615587133892632177ULL, 2019483917365790221ULL,
+};
+
+/// ceil(log2(5^e)), or 1 for e = 0.
+static inline int32_t pow5_bits(int32_t e) { return int32_t((uint32_t(e) * 1217359) >> 19) + 1; }
+/// floor(log10(2^e))
+static inline uint32_t log10_pow2(int32_t e) { return (uint32_t(e) * 78913) >> 18; }
+/// floor(log10(5^e))
+static inline uint32_t log10_pow5(int32_t e) { return (uint32_t(e) * 732923) >> 20; }
+
+static inline bool multiple_of_pow5(uint32_t value, uint32_t p) {
+  uint32_t count = 0;
+  while (value % 5 == 0) {
+    value /= 5;
+    count++;
+  }
+  return count >= p;
+}
+static inline bool multiple_of_pow2(uint32_t value, uint32_t p) { return (value & ((1u << p) - 1)) == 0; }
+
+/// (m * factor) >> shift for shift > 32, without a 128 bit product.
+static inline uint32_t mul_shift(uint32_t m, uint64_t factor, int32_t shift) {
+  const uint64_t low = uint64_t(m) * uint32_t(factor);
+  const uint64_t high = uint64_t(m) * uint32_t(factor >> 32);
+  return uint32_t(((low >> 32) + high) >> (shift - 32));
+}
+
+/// Find the shortest decimal digits and exponent that read back as the finite, non-zero float with these fields.
+static void float_to_decimal(uint32_t ieee_mantissa, uint32_t ieee_exponent, uint32_t *digits, int32_t *exponent) {
+  int32_t e2;
+  uint32_t m2;
+  if (ieee_exponent == 0) {
+    e2 = 1 - 127 - 23 - 2;
+    m2 = ieee_mantissa;
+  } else {
+    e2 = int32_t(ieee_exponent) - 127 - 23 - 2;
+    m2 = (1u << 23) | ieee_mantissa;
+  }
+  const bool accept_bounds = (m2 & 1) == 0;
+
+  // The halfway points to the neighbouring floats, times 4 so they are integers
+  const uint32_t mv = 4 * m2;
+  const uint32_t mp = 4 * m2 + 2;
+  const uint32_t mm_shift = ieee_mantissa != 0 || ieee_exponent <= 1;
+  const uint32_t mm = 4 * m2 - 1 - mm_shift;
+
+  // Convert the interval to decimal
+  uint32_t vr, vp, vm;
+  int32_t e10;
+  bool vm_trailing_zeros = false;
+  bool vr_trailing_zeros = false;
+  uint8_t last_removed_digit = 0;
+  if (e2 >= 0) {
+    const uint32_t q = log10_pow2(e2);
+    e10 = int32_t(q);
+    const int32_t k = FLOAT_POW5_INV_BITCOUNT + pow5_bits(int32_t(q)) - 1;
+    const int32_t i = -e2 + int32_t(q) + k;
+    vr = mul_shift(mv, FLOAT_POW5_INV_SPLIT[q], i);
+    vp = mul_shift(mp, FLOAT_POW5_INV_SPLIT[q], i);
+    vm = mul_shift(mm, FLOAT_POW5_INV_SPLIT[q], i);
+    if (q != 0 && (vp - 1) / 10 <= vm / 10) {
+      // One removed digit is needed even if the loop below doesn't run
+      const int32_t l = FLOAT_POW5_INV_BITCOUNT + pow5_bits(int32_t(q - 1)) - 1;
+      last_removed_digit = uint8_t(mul_shift(mv, FLOAT_POW5_INV_SPLIT[q - 1], -e2 + int32_t(q) - 1 + l) % 10);
+    }
+    if (q <= 9) {
+      // Only one of mp, mv and mm can be a multiple of 5
+      if (mv % 5 == 0) {
+        vr_trailing_zeros = multiple_of_pow5(mv, q);
+      } else if (accept_bounds) {
+        vm_trailing_zeros = multiple_of_pow5(mm, q);
+      } else {
+        vp -= multiple_of_pow5(mp, q);
+      }
+    }
+  } else {
+    const uint32_t q = log10_pow5(-e2);
+    e10 = int32_t(q) + e2;
+    const int32_t i = -e2 - int32_t(q);
+    const int32_t k = pow5_bits(i) - FLOAT_POW5_BITCOUNT;
+    int32_t j = int32_t(q) - k;
+    vr = mul_shift(mv, FLOAT_POW5_SPLIT[i], j);
+    vp = mul_shift(mp, FLOAT_POW5_SPLIT[i], j);
+    vm = mul_shift(mm, FLOAT_POW5_SPLIT[i], j);
+    if (q != 0 && (vp - 1) / 10 <= vm / 10) {
+      j = int32_t(q) - 1 - (pow5_bits(i + 1) - FLOAT_POW5_BITCOUNT);
+      last_removed_digit = uint8_t(mul_shift(mv, FLOAT_POW5_SPLIT[i + 1], j) % 10);
+    }
+    if (q <= 1) {
+      // mv has at least two trailing zero bits, mm one if mm_shift is set and mp always one
+      vr_trailing_zeros = true;
+      if (accept_bounds) {
+        vm_trailing_zeros = mm_shift == 1;
+      } else {
+        --vp;
+      }
+    } else if (q < 31) {
+      vr_trailing_zeros = multiple_of_pow2(mv, q - 1);
+    }
+  }
+
+  // Remove digits as long as the interval still holds a shorter number
+  int32_t removed = 0;
+  if (vm_trailing_zeros || vr_trailing_zeros) {
+    while (vp / 10 > vm / 10) {
+      vm_trailing_zeros &= vm % 10 == 0;
+      vr_trailing_zeros &= last_removed_digit == 0;
+      last_removed_digit = uint8_t(vr % 10);
+      vr /= 10;
+      vp /= 10;
+      vm /= 10;
+      ++removed;
+    }
+    if (vm_trailing_zeros) {
+      while (vm % 10 == 0) {
+        vr_trailing_zeros &= last_removed_digit == 0;
+        last_removed_digit = uint8_t(vr % 10);
+        vr /= 10;
+        vp /= 10;
+        vm /= 10;
+        ++removed;
+      }
+    }
+    if (vr_trailing_zeros && last_removed_digit == 5 && vr % 2 == 0) {
+      // Round half to even if the exact value ends in 5
+      last_removed_digit = 4;
+    }
+    *digits = vr + ((vr == vm && (!accept_bounds || !vm_trailing_zeros)) || last_removed_digit >= 5);
+  } else {
+    while (vp / 10 > vm / 10) {
+      last_removed_digit = uint8_t(vr % 10);
+      vr /= 10;
+      vp /= 10;
+      vm /= 10;
+      ++removed;
+    }
+    *digits = vr + (vr == vm || last_removed_digit >= 5);
+  }
+  *exponent = e10 + removed;
+}
+
+size_t float_to_buf(char *buf, size_t buf_size, float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  const uint32_t ieee_mantissa = bits & 0x7FFFFF;
+  const uint32_t ieee_exponent = (bits >> 23) & 0xFF;
+  const bool negative = bits >> 31;
+  if (ieee_exponent == 0xFF) {
+    if (ieee_mantissa != 0)
+      return copy_formatted(buf, buf_size, "nan", 3);
+    return negative ? copy_formatted(buf, buf_size, "-inf", 4) : copy_formatted(buf, buf_size, "inf", 3);
+  }
+
+  char tmp[FLOAT_BUF_SIZE];
+  char *pos = tmp;
+  if (negative)
+    *pos++ = '-';
+  if (ieee_exponent == 0 && ieee_mantissa == 0) {
+    *pos++ = '0';
+    return copy_formatted(buf, buf_size, tmp, pos - tmp);
+  }
+  uint32_t digits;
+  int32_t exponent;
+  float_to_decimal(ieee_mantissa, ieee_exponent, &digits, &exponent);
+  char digit_buf[9];
+  char *const digit_end = digit_buf + sizeof(digit_buf);
+  const char *const digit_start = write_digits_backwards(digit_end, digits);
+  const int32_t length = int32_t(digit_end - digit_start);
+  // The value is 0.<digits> * 10^point, laid out like JavaScript numbers are
+  const int32_t point = length + exponent;
+  if (length <= point && point <= 21) {
+    memcpy(pos, digit_start, length);
+    pos += length;
+    memset(pos, '0', point - length);
+    pos += point - length;
+  } else if (0 < point && point <= 21) {
+    memcpy(pos, digit_start, point);
+    pos += point;
+    *pos++ = '.';
+    memcpy(pos, digit_start + point, length - point);
+    pos += length - point;
+  } else if (-6 < point && point <= 0) {
+    *pos++ = '0';
+    *pos++ = '.';
+    memset(pos, '0', -point);
+    pos += -point;
+    memcpy(pos, digit_start, length);
+    pos += length;
+  } else {
+    *pos++ = digit_start[0];
+    if (length > 1) {
+      *pos++ = '.';
+      memcpy(pos, digit_start + 1, length - 1);
+      pos += length - 1;
+    }
+    *pos++ = 'e';
+    *pos++ = point - 1 < 0 ? '-' : '+';
+    const int32_t exponent10 = std::abs(point - 1);
+    if (exponent10 >= 10)
+      *pos++ = char('0' + exponent10 / 10);
+    *pos++ = char('0' + exponent10 % 10);
+  }
+  return copy_formatted(buf, buf_size, tmp, pos - tmp);
 }
 
 int8_t step_to_accuracy_decimals(float step) {
@@ -750,4 +1054,43 @@ void delay_microseconds_safe(uint32_t us) {  // avoids CPU locks that could trig
     ;
 }
 
+#ifdef ESPHOME_CALLBACK_POOL_SIZE
+namespace {
+union CallbackNodeBlock {
+  CallbackNodeBlock *next_free;
+  alignas(void *) uint8_t data[CallbackNodePool::NODE_SIZE];
+};
+// Zero-initialized, so it can be used by the constructors of other globals
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+CallbackNodeBlock callback_pool[ESPHOME_CALLBACK_POOL_SIZE];
+size_t callback_pool_used = 0;                    // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+CallbackNodeBlock *callback_pool_free = nullptr;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+}  // namespace
+#endif
+
+void *CallbackNodePool::allocate() {
+#ifdef ESPHOME_CALLBACK_POOL_SIZE
+  if (callback_pool_free != nullptr) {
+    CallbackNodeBlock *block = callback_pool_free;
+    callback_pool_free = block->next_free;
+    return block;
+  }
+  if (callback_pool_used < ESPHOME_CALLBACK_POOL_SIZE)
+    return &callback_pool[callback_pool_used++];
+#endif
+  return ::operator new(NODE_SIZE);
+}
+
+void CallbackNodePool::release(void *node) {
+#ifdef ESPHOME_CALLBACK_POOL_SIZE
+  auto *block = static_cast<CallbackNodeBlock *>(node);
+  if (block >= callback_pool && block < callback_pool + ESPHOME_CALLBACK_POOL_SIZE) {
+    block->next_free = callback_pool_free;
+    callback_pool_free = block;
+    return;
+  }
+#endif
+  ::operator delete(node);
+}
+
 }  // namespace esphome
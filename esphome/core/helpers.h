@@ -4,6 +4,7 @@
 #include <cstring>
 #include <functional>
 #include <memory>
+#include <new>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -431,6 +432,18 @@ ParseOnOffState parse_on_off(const char *str, const char *on = nullptr, const ch
 
 /// Create a string from a value and an accuracy in decimals.
 std::string value_accuracy_to_string(float value, int8_t accuracy_decimals);
+/// Write a value with an accuracy in decimals to buf without allocating, returns the length (truncated to fit).
+size_t value_accuracy_to_buf(char *buf, size_t buf_size, float value, int8_t accuracy_decimals);
+
+/// Size of a buffer that holds any value written by float_to_buf().
+static constexpr size_t FLOAT_BUF_SIZE = 24;
+/** Write the shortest decimal representation that reads back as the same float to buf, returns the length (truncated
+ * to fit).
+ *
+ * The number is written like JavaScript does, so without exponent from 1e-6 up to 1e21 and as for example `1.5e+25`
+ * outside of that. Infinity and NaN are written as `inf`, `-inf` and `nan`.
+ */
+size_t float_to_buf(char *buf, size_t buf_size, float value);
 
 /// Derive accuracy in decimals from an increment step.
 int8_t step_to_accuracy_decimals(float step);
@@ -471,29 +484,179 @@ constexpr float fahrenheit_to_celsius(float value) { return (value - 32.0f) / 1.
 /// @name Utilities
 /// @{
 
+/// Default inline size of InplaceFunction, enough for a lambda capturing two pointers like `[this, obj]`.
+static constexpr size_t INPLACE_FUNCTION_SIZE = 2 * sizeof(void *);
+
+template<typename Signature, size_t Size = INPLACE_FUNCTION_SIZE> class InplaceFunction;
+
+/** Callable wrapper like std::function, that keeps callables of up to `Size` bytes inside itself instead of
+ * allocating them on the heap. Larger callables are still allocated, so any callable can be stored. It can only be
+ * moved, which allows storing move-only callables as well.
+ *
+ * Besides the callable it only holds a pointer to a static table of the operations on the type of the callable, so
+ * with the default size it is a pointer smaller than a std::function.
+ */
+template<typename R, typename... Args, size_t Size> class InplaceFunction<R(Args...), Size> {
+ public:
+  InplaceFunction() = default;
+  InplaceFunction(std::nullptr_t) {}  // NOLINT(google-explicit-constructor)
+  template<typename F, typename D = typename std::decay<F>::type,
+           enable_if_t<!std::is_same<D, InplaceFunction>::value, int> = 0>
+  InplaceFunction(F &&callable) {  // NOLINT(google-explicit-constructor)
+    this->assign_<D>(std::forward<F>(callable), std::integral_constant<bool, fits_inline<D>()>{});
+  }
+  InplaceFunction(InplaceFunction &&other) noexcept { this->move_from_(other); }
+  InplaceFunction &operator=(InplaceFunction &&other) noexcept {
+    if (this != &other) {
+      this->reset();
+      this->move_from_(other);
+    }
+    return *this;
+  }
+  InplaceFunction(const InplaceFunction &) = delete;
+  InplaceFunction &operator=(const InplaceFunction &) = delete;
+  ~InplaceFunction() { this->reset(); }
+
+  /// Whether a callable of type `F` is stored without a heap allocation.
+  template<typename F> static constexpr bool fits_inline() {
+    return sizeof(F) <= Size && alignof(F) <= alignof(void *) && std::is_nothrow_move_constructible<F>::value;
+  }
+
+  void reset() {
+    if (this->operations_ != nullptr && this->operations_->destroy != nullptr)
+      this->operations_->destroy(this->storage_);
+    this->operations_ = nullptr;
+  }
+
+  explicit operator bool() const { return this->operations_ != nullptr; }
+  R operator()(Args... args) const { return this->operations_->invoke(this->storage_, std::forward<Args>(args)...); }
+
+ protected:
+  struct Operations {
+    R (*invoke)(void *storage, Args &&...args);
+    void (*move)(void *storage, void *destination);  ///< nullptr if the storage can be copied bytewise
+    void (*destroy)(void *storage);                  ///< nullptr if there is nothing to destroy
+  };
+  template<typename D> struct Inline {
+    static R invoke(void *storage, Args &&...args) { return (*static_cast<D *>(storage))(std::forward<Args>(args)...); }
+    static void move(void *storage, void *destination) {
+      new (destination) D(std::move(*static_cast<D *>(storage)));
+      static_cast<D *>(storage)->~D();
+    }
+    static void destroy(void *storage) { static_cast<D *>(storage)->~D(); }
+    static const Operations *operations() {
+      static const Operations OPERATIONS{&invoke, std::is_trivially_copyable<D>::value ? nullptr : &move,
+                                         std::is_trivially_destructible<D>::value ? nullptr : &destroy};
+      return &OPERATIONS;
+    }
+  };
+  template<typename D> struct Allocated {
+    static R invoke(void *storage, Args &&...args) {
+      return (**static_cast<D **>(storage))(std::forward<Args>(args)...);
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    static void destroy(void *storage) { delete *static_cast<D **>(storage); }
+    static const Operations *operations() {
+      static const Operations OPERATIONS{&invoke, nullptr, &destroy};
+      return &OPERATIONS;
+    }
+  };
+
+  template<typename D, typename F> void assign_(F &&callable, std::true_type /*inline*/) {
+    new (this->storage_) D(std::forward<F>(callable));
+    this->operations_ = Inline<D>::operations();
+  }
+  template<typename D, typename F> void assign_(F &&callable, std::false_type /*inline*/) {
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    *reinterpret_cast<D **>(this->storage_) = new D(std::forward<F>(callable));
+    this->operations_ = Allocated<D>::operations();
+  }
+  void move_from_(InplaceFunction &other) {
+    if (other.operations_ != nullptr && other.operations_->move != nullptr) {
+      other.operations_->move(other.storage_, this->storage_);
+    } else {
+      memcpy(this->storage_, other.storage_, Size);
+    }
+    this->operations_ = other.operations_;
+    other.operations_ = nullptr;
+  }
+
+  const Operations *operations_{nullptr};
+  alignas(void *) mutable uint8_t storage_[Size]{};
+};
+
+/// Storage for the callbacks of all CallbackManager instances. The nodes are taken from a static pool that the code
+/// generator sizes for the callbacks registered during setup, and from the heap once that is used up.
+class CallbackNodePool {
+ public:
+  /// Size of every node, the same for all signatures.
+  static constexpr size_t NODE_SIZE = sizeof(void *) + sizeof(InplaceFunction<void()>);
+
+  static void *allocate();
+  static void release(void *node);
+};
+
 template<typename... X> class CallbackManager;
 
 /** Helper class to allow having multiple subscribers to a callback.
+ *
+ * The callbacks are kept in a singly linked list of nodes from the CallbackNodePool, so a manager without
+ * subscribers takes the size of a pointer and adding one doesn't reallocate. Callbacks added while calling are
+ * called in the same pass.
  *
  * @tparam Ts The arguments for the callbacks, wrapped in void().
  */
 template<typename... Ts> class CallbackManager<void(Ts...)> {
  public:
-  /// Add a callback to the list.
-  void add(std::function<void(Ts...)> &&callback) { this->callbacks_.push_back(std::move(callback)); }
+  CallbackManager() = default;
+  CallbackManager(CallbackManager &&other) noexcept : head_(other.head_) { other.head_ = nullptr; }
+  CallbackManager(const CallbackManager &) = delete;
+  CallbackManager &operator=(const CallbackManager &) = delete;
+  ~CallbackManager() {
+    while (this->head_ != nullptr) {
+      Node *node = this->head_;
+      this->head_ = node->next;
+      node->~Node();
+      CallbackNodePool::release(node);
+    }
+  }
+
+  /// Add a callback to the list. Lambdas capturing up to two pointers are stored without a heap allocation.
+  template<typename F> void add(F &&callback) {
+    Node *node = new (CallbackNodePool::allocate()) Node(std::forward<F>(callback));
+    Node **tail = &this->head_;
+    while (*tail != nullptr)
+      tail = &(*tail)->next;
+    *tail = node;
+  }
 
   /// Call all callbacks in this manager.
   void call(Ts... args) {
-    for (auto &cb : this->callbacks_)
-      cb(args...);
+    for (Node *node = this->head_; node != nullptr; node = node->next)
+      node->callback(args...);
+  }
+  /// Whether no callback was added, unlike size() this doesn't walk the list.
+  bool empty() const { return this->head_ == nullptr; }
+  size_t size() const {
+    size_t count = 0;
+    for (Node *node = this->head_; node != nullptr; node = node->next)
+      count++;
+    return count;
   }
-  size_t size() const { return this->callbacks_.size(); }
 
   /// Call all callbacks in this manager.
   void operator()(Ts... args) { call(args...); }
 
  protected:
-  std::vector<std::function<void(Ts...)>> callbacks_;
+  struct Node {
+    template<typename F> explicit Node(F &&callback) : callback(std::forward<F>(callback)) {}
+    Node *next{nullptr};
+    InplaceFunction<void(Ts...)> callback;
+  };
+  static_assert(sizeof(Node) <= CallbackNodePool::NODE_SIZE && alignof(Node) <= alignof(void *),
+                "callback nodes must fit into the pool");
+
+  Node *head_{nullptr};
 };
 
 /// Helper class to deduplicate items in a series of values.
@@ -14,14 +14,27 @@ from esphome.const import (
 )
 from esphome.core import CORE, ID, coroutine
 from esphome.coroutine import FakeAwaitable
-from esphome.cpp_generator import add, get_variable
+from esphome.cpp_generator import (
+    RawExpression,
+    RawStatement,
+    add,
+    add_global,
+    get_variable,
+)
 from esphome.cpp_types import App
-from esphome.helpers import sanitize, snake_case
+from esphome.helpers import cpp_string_escape, sanitize, snake_case
 from esphome.types import ConfigFragmentType, ConfigType
 from esphome.util import Registry, RegistryEntry
 
 _LOGGER = logging.getLogger(__name__)
 
+# Components adding a state callback to every entity
+CALLBACK_CONTROLLERS = ("api", "mqtt", "web_server")
+KEY_CALLBACK_COUNT = "callback_count"
+KEY_ENTITY_COUNT = "entity_count"
+KEY_ENTITY_STRINGS = "entity_strings"
+ENTITY_STRINGS = "ESPHOME_ENTITY_STRINGS"
+
 
 async def gpio_pin_expression(conf):
     """Generate an expression for the given pin option.
@@ -96,18 +109,60 @@ async def register_parented(var, value):
     add(var.set_parent(paren))
 
 
+def add_callbacks(count=1):
+    """Count callbacks added to a CallbackManager during setup, they get a node from the
+    pool sized by callback_pool_size()."""
+    CORE.data[KEY_CALLBACK_COUNT] = CORE.data.get(KEY_CALLBACK_COUNT, 0) + count
+
+
+def callback_pool_size():
+    """Number of callbacks added during setup, including those of the controllers.
+
+    Only meaningful once the code of all components has been generated.
+    """
+    controllers = sum(domain in CORE.config for domain in CALLBACK_CONTROLLERS)
+    entities = CORE.data.get(KEY_ENTITY_COUNT, 0)
+    return CORE.data.get(KEY_CALLBACK_COUNT, 0) + controllers * entities
+
+
+def entity_string(value):
+    """Get an expression for a string of entity metadata, like the name or the unit.
+
+    The strings are collected into a single constant table that holds each of them once,
+    a string that ends another one points into it instead of being added again.
+    """
+    # Offsets count the bytes of the encoded table
+    table = CORE.data.get(KEY_ENTITY_STRINGS, b"")
+    encoded = value.encode("utf-8") + b"\0"
+    offset = table.find(encoded)
+    if offset == -1:
+        offset = len(table)
+        CORE.data[KEY_ENTITY_STRINGS] = table + encoded
+    return RawExpression(f"{ENTITY_STRINGS} + {offset}")
+
+
+def add_entity_strings():
+    """Declare the table of entity_string(), once all strings have been added."""
+    if table := CORE.data.get(KEY_ENTITY_STRINGS):
+        # The literal adds the terminator of the last string
+        literal = cpp_string_escape(table[:-1])
+        add_global(RawStatement(f"static const char {ENTITY_STRINGS}[] = {literal};"))
+
+
 async def setup_entity(var, config):
     """Set up generic properties of an Entity"""
-    add(var.set_name(config[CONF_NAME]))
+    CORE.data[KEY_ENTITY_COUNT] = CORE.data.get(KEY_ENTITY_COUNT, 0) + 1
+    add(var.set_name(entity_string(config[CONF_NAME])))
     if not config[CONF_NAME]:
-        add(var.set_object_id(sanitize(snake_case(CORE.friendly_name))))
+        object_id = sanitize(snake_case(CORE.friendly_name))
     else:
-        add(var.set_object_id(sanitize(snake_case(config[CONF_NAME]))))
+        object_id = sanitize(snake_case(config[CONF_NAME]))
+    add(var.set_object_id(entity_string(object_id)))
     add(var.set_disabled_by_default(config[CONF_DISABLED_BY_DEFAULT]))
     if CONF_INTERNAL in config:
         add(var.set_internal(config[CONF_INTERNAL]))
     if CONF_ICON in config:
-        add(var.set_icon(config[CONF_ICON]))
+        add(var.set_icon(entity_string(config[CONF_ICON])))
     if CONF_ENTITY_CATEGORY in config:
         add(var.set_entity_category(config[CONF_ENTITY_CATEGORY]))
 
@@ -1,5 +1,6 @@
 """Fixtures for component tests."""
 
+import re
 import sys
 from pathlib import Path
 
@@ -12,19 +13,35 @@ import pytest
 
 from esphome.core import CORE
 from esphome.config import read_config
+from esphome.cpp_helpers import ENTITY_STRINGS, KEY_ENTITY_STRINGS
+from esphome.helpers import cpp_string_escape
 from esphome.__main__ import generate_cpp_contents
 
 
+def resolve_entity_strings(code: str) -> str:
+    """Replaces the references into the table of entity strings by the strings they
+    point to."""
+    table = CORE.data.get(KEY_ENTITY_STRINGS, b"")
+
+    def literal(match: re.Match) -> str:
+        offset = int(match.group(1))
+        return cpp_string_escape(table[offset : table.index(b"\0", offset)])
+
+    return re.sub(rf"{ENTITY_STRINGS} \+ (\d+)", literal, code)
+
+
 @pytest.fixture
 def generate_main():
-    """Generates the C++ main.cpp file and returns it in string form."""
+    """Generates the C++ main.cpp file and returns it in string form, with the entity
+    strings resolved."""
 
     def generator(path: str) -> str:
         CORE.config_path = path
         CORE.config = read_config({})
         generate_cpp_contents(CORE.config)
-        print(CORE.cpp_main_section)
-        return CORE.cpp_main_section
+        main_cpp = resolve_entity_strings(CORE.cpp_main_section)
+        print(main_cpp)
+        return main_cpp
 
     yield generator
 
@@ -9,11 +9,15 @@ not be part of a unit test suite.
 
 """
 
+import os
+import shutil
 import sys
 import pytest
 
 from pathlib import Path
 
+from host_cpp import HostCppBuilder
+
 
 here = Path(__file__).parent
 
@@ -28,3 +32,15 @@ def fixture_path() -> Path:
     Location of all fixture files.
     """
     return here / "fixtures"
+
+
+@pytest.fixture(scope="session")
+def host_cpp(tmp_path_factory):
+    """
+    Builder for host programs made of C++ sources of the tree, see host_cpp.py.
+    Tests using it are skipped without a C++ compiler.
+    """
+    compiler = shutil.which(os.environ.get("CXX", "g++")) or shutil.which("clang++")
+    if compiler is None:
+        pytest.skip("No C++ compiler available")
+    return HostCppBuilder(compiler, tmp_path_factory.mktemp("host_cpp"))
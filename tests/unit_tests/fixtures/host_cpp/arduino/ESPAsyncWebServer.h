@@ -0,0 +1,120 @@
+// Stand-in for the parts of ESPAsyncWebServer the request handlers use, requests are made up by the test.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+
+class String : public std::string {
+ public:
+  String() = default;
+  String(const char *str) : std::string(str) {}
+  String(std::string str) : std::string(std::move(str)) {}
+
+  // NOLINTNEXTLINE(readability-identifier-naming)
+  int indexOf(const char *str) const {
+    const size_t pos = this->find(str);
+    return pos == npos ? -1 : int(pos);
+  }
+};
+
+enum WebRequestMethod : uint8_t {
+  HTTP_GET = 0b01,
+  HTTP_POST = 0b10,
+};
+
+typedef std::function<size_t(uint8_t *, size_t, size_t)> AwsResponseFiller;
+
+class AsyncWebHeader {
+ public:
+  AsyncWebHeader(String value) : value_(std::move(value)) {}
+  const String &value() const { return this->value_; }
+
+ protected:
+  String value_;
+};
+
+/// A chunked response, the test pulls the body out of the filler.
+class AsyncWebServerResponse {
+ public:
+  AsyncWebServerResponse(String content_type, AwsResponseFiller filler)
+      : content_type(std::move(content_type)), filler(std::move(filler)) {}
+
+  String content_type;
+  AwsResponseFiller filler;
+};
+
+class AsyncWebServerRequest {
+ public:
+  AsyncWebServerRequest(WebRequestMethod method, String url) : method_(method), url_(std::move(url)) {}
+  ~AsyncWebServerRequest() { delete this->response; }
+
+  WebRequestMethod method() const { return this->method_; }
+  const String &url() const { return this->url_; }
+
+  bool authenticate(const char *username, const char *password) { return true; }
+  // NOLINTNEXTLINE(readability-identifier-naming)
+  void requestAuthentication() {}
+  // NOLINTNEXTLINE(readability-identifier-naming)
+  void addInterestingHeader(const char *name) {}
+  // NOLINTNEXTLINE(readability-identifier-naming)
+  void setHeader(const char *name, String value) { this->headers_.insert({name, AsyncWebHeader(std::move(value))}); }
+  // NOLINTNEXTLINE(readability-identifier-naming)
+  bool hasHeader(const char *name) const { return this->headers_.count(name) != 0; }
+  // NOLINTNEXTLINE(readability-identifier-naming)
+  const AsyncWebHeader *getHeader(const char *name) const {
+    auto it = this->headers_.find(name);
+    return it == this->headers_.end() ? nullptr : &it->second;
+  }
+
+  // NOLINTNEXTLINE(readability-identifier-naming)
+  AsyncWebServerResponse *beginChunkedResponse(const char *content_type, AwsResponseFiller filler) {
+    return new AsyncWebServerResponse(content_type, std::move(filler));
+  }
+  void send(AsyncWebServerResponse *response) { this->response = response; }
+
+  /// The response sent, owned by the request.
+  AsyncWebServerResponse *response{nullptr};
+
+ protected:
+  WebRequestMethod method_;
+  String url_;
+  std::map<std::string, AsyncWebHeader> headers_;
+};
+
+class AsyncWebHandler {
+ public:
+  virtual ~AsyncWebHandler() = default;
+  // NOLINTNEXTLINE(readability-identifier-naming)
+  virtual bool canHandle(AsyncWebServerRequest *request) { return false; }
+  // NOLINTNEXTLINE(readability-identifier-naming)
+  virtual void handleRequest(AsyncWebServerRequest *request) {}
+  // NOLINTNEXTLINE(readability-identifier-naming)
+  virtual void handleUpload(AsyncWebServerRequest *request, const String &filename, size_t index, uint8_t *data,
+                            size_t len, bool final) {}
+  // NOLINTNEXTLINE(readability-identifier-naming)
+  virtual void handleBody(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total) {}
+  // NOLINTNEXTLINE(readability-identifier-naming)
+  virtual bool isRequestHandlerTrivial() { return true; }
+};
+
+class AsyncWebServer {
+ public:
+  AsyncWebServer(uint16_t port) {}
+  void begin() {}
+  // NOLINTNEXTLINE(readability-identifier-naming)
+  void addHandler(AsyncWebHandler *handler) {}
+};
+
+class DefaultHeaders {
+ public:
+  // NOLINTNEXTLINE(readability-identifier-naming)
+  static DefaultHeaders &Instance() {
+    static DefaultHeaders headers;
+    return headers;
+  }
+  // NOLINTNEXTLINE(readability-identifier-naming)
+  void addHeader(const char *name, const char *value) {}
+};
@@ -0,0 +1,172 @@
+// Delay and wait_until resume their chains from the shared runtime, stopped chains never resume.
+
+#include "test_main.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "esphome/core/application.h"
+#include "esphome/core/automation.h"
+#include "esphome/core/base_automation.h"
+
+using namespace esphome;
+
+template<typename... Ts> class FlagCondition : public Condition<Ts...> {
+ public:
+  bool check(Ts... x) override { return this->value; }
+  bool value{false};
+};
+
+/// Makes the timer heap of the runtime readable.
+class RuntimeAccess : public AutomationRuntime {
+ public:
+  using AutomationRuntime::timers_;
+};
+
+static size_t timer_count() { return (AutomationRuntime::get()->*(&RuntimeAccess::timers_)).size(); }
+
+/// Let `ms` pass in steps of `step` ms, running the scheduler and the runtime after each.
+static void run_for(uint32_t ms, uint32_t step = 1) {
+  for (uint32_t at = 0; at < ms; at += step) {
+    test::advance_ms(step);
+    App.scheduler.call();
+    AutomationRuntime::get()->loop();
+  }
+}
+
+static int test_delay() {
+  Trigger<std::string> trigger;
+  Automation<std::string> automation(&trigger);
+  auto *delay = new DelayAction<std::string>();
+  delay->set_delay(100);
+  std::vector<std::string> done;
+  automation.add_actions({delay, new LambdaAction<std::string>([&done](std::string x) { done.push_back(x); })});
+
+  trigger.trigger("a");
+  run_for(50);
+  trigger.trigger("b");
+  run_for(49);
+  TEST_CHECK(done.empty());
+  run_for(1);
+  TEST_CHECK((done == std::vector<std::string>{"a"}));
+  run_for(50);
+  TEST_CHECK((done == std::vector<std::string>{"a", "b"}));
+  TEST_CHECK(!automation.is_running());
+
+  // Stopped chains don't resume, the automation can be triggered again right away
+  trigger.trigger("c");
+  run_for(50);
+  automation.stop();
+  trigger.trigger("d");
+  run_for(200);
+  TEST_CHECK((done == std::vector<std::string>{"a", "b", "d"}));
+  TEST_CHECK(timer_count() == 0);
+  return 0;
+}
+
+static int test_reference_args() {
+  // Arguments passed by reference are kept by the delay, the caller's string is gone when it resumes
+  Trigger<const std::string &> trigger;
+  Automation<const std::string &> automation(&trigger);
+  auto *delay = new DelayAction<const std::string &>();
+  delay->set_delay(10);
+  std::vector<std::string> done;
+  automation.add_actions(
+      {delay, new LambdaAction<const std::string &>([&done](const std::string &x) { done.push_back(x); })});
+
+  {
+    std::string arg = "a string longer than the small string buffer";
+    trigger.trigger(arg);
+    arg.assign(arg.size(), 'x');
+  }
+  run_for(10);
+  TEST_CHECK((done == std::vector<std::string>{"a string longer than the small string buffer"}));
+  return 0;
+}
+
+static int test_wait_until() {
+  FlagCondition<int> condition;
+  Trigger<int> trigger;
+  Automation<int> automation(&trigger);
+  auto *wait = new WaitUntilAction<int>(&condition);
+  wait->set_timeout_value(1000);
+  std::vector<std::pair<int, uint32_t>> done;
+  automation.add_actions({wait, new LambdaAction<int>([&done](int x) { done.emplace_back(x, millis()); })});
+
+  // Passes right away
+  condition.value = true;
+  const uint32_t start = millis();
+  trigger.trigger(1);
+  TEST_CHECK(done.size() == 1 && done[0].second == start);
+
+  // Resumes when the condition passes, before the timeout
+  condition.value = false;
+  trigger.trigger(2);
+  run_for(200);
+  TEST_CHECK(done.size() == 1);
+  condition.value = true;
+  run_for(1);
+  TEST_CHECK(done.size() == 2 && done[1].first == 2 && done[1].second == start + 201);
+
+  // Resumes at the timeout
+  condition.value = false;
+  trigger.trigger(3);
+  run_for(999);
+  TEST_CHECK(done.size() == 2);
+  run_for(1);
+  TEST_CHECK(done.size() == 3 && done[2].first == 3 && done[2].second == start + 1201);
+
+  // Neither after a stop
+  trigger.trigger(4);
+  run_for(10);
+  automation.stop();
+  condition.value = true;
+  run_for(2000);
+  TEST_CHECK(done.size() == 3);
+  TEST_CHECK(!automation.is_running());
+  TEST_CHECK(timer_count() == 0);
+  return 0;
+}
+
+static int test_cancelled_timers_removed() {
+  // A long delay keeps its timer at the front of the heap, while wait_until resolves long before its timeout
+  Trigger<> delay_trigger;
+  Automation<> delay_automation(&delay_trigger);
+  auto *delay = new DelayAction<>();
+  delay->set_delay(600000);
+  delay_automation.add_action(delay);
+  delay_trigger.trigger();
+
+  FlagCondition<> condition;
+  Trigger<> wait_trigger;
+  Automation<> wait_automation(&wait_trigger);
+  auto *wait = new WaitUntilAction<>(&condition);
+  wait->set_timeout_value(3600000);
+  int done = 0;
+  wait_automation.add_actions({wait, new LambdaAction<>([&done]() { done++; })});
+
+  size_t max_timers = 0;
+  for (int i = 0; i < 500; i++) {
+    condition.value = false;
+    wait_trigger.trigger();
+    run_for(1000, 500);
+    condition.value = true;
+    run_for(1);
+    max_timers = std::max(max_timers, timer_count());
+  }
+  TEST_CHECK(done == 500);
+  TEST_CHECK(max_timers <= 4);
+  delay_automation.stop();
+  TEST_CHECK(timer_count() == 0);
+  return 0;
+}
+
+int run_test() {
+  App.pre_setup("test", "", "", "", "", false);
+  TEST_CHECK(test_delay() == 0);
+  TEST_CHECK(test_reference_args() == 0);
+  TEST_CHECK(test_wait_until() == 0);
+  TEST_CHECK(test_cancelled_timers_removed() == 0);
+  return 0;
+}
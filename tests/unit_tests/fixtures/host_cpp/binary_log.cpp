@@ -0,0 +1,95 @@
+// Time a log call takes and the serial bytes it writes, as text and as binary records, and the formatting alone. The
+// serial output goes to a temporary file, the results are printed afterwards.
+
+#include "test_main.h"
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <unistd.h>
+
+#include "esphome/components/logger/logger.h"
+#include "esphome/core/log.h"
+
+using namespace esphome;
+using namespace esphome::logger;
+
+static const char *const SENSOR_FORMAT = "'%s': Sending state %.5f %s with %d decimals of accuracy";
+static const int CALLS = 100000;
+
+static void log_line(Logger &logger, const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  logger.log_vprintf_(ESPHOME_LOG_LEVEL_DEBUG, "sensor", 94, format, args);
+  va_end(args);
+}
+
+struct Result {
+  double ns;
+  double bytes;
+};
+
+/// Log the sensor line CALLS times to serial, with or without the format in the table of known formats.
+static Result measure(bool binary) {
+  Logger logger(115200, 512);
+  logger.set_log_level("sensor", ESPHOME_LOG_LEVEL_DEBUG);
+  static uint32_t ids[1];
+  ids[0] = log_format_id(SENSOR_FORMAT);
+  if (binary)
+    logger.set_binary_format_ids(ids, 1);
+
+  fflush(stdout);
+  const int saved = dup(STDOUT_FILENO);
+  FILE *serial = tmpfile();
+  dup2(fileno(serial), STDOUT_FILENO);
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < CALLS; i++)
+    log_line(logger, SENSOR_FORMAT, "Temperature", 20.0f + (i % 1000) / 100.0f, "°C", 1);
+  fflush(stdout);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  const long size = lseek(STDOUT_FILENO, 0, SEEK_END);
+  dup2(saved, STDOUT_FILENO);
+  close(saved);
+  fclose(serial);
+  // The host logger puts a [HH:MM:SS] timestamp in front of every line, the devices don't
+  const double bytes = double(size) / CALLS - 10;
+  return {std::chrono::duration<double, std::nano>(elapsed).count() / CALLS, bytes};
+}
+
+/// Formatting alone, vsnprintf() against encoding the record.
+static size_t format(bool binary, char *buf, size_t size, ...) {
+  va_list args;
+  va_start(args, size);
+  size_t len;
+  if (binary) {
+    len = encode_log_record(reinterpret_cast<uint8_t *>(buf), size, ESPHOME_LOG_LEVEL_DEBUG, "sensor", 94,
+                            log_format_id(SENSOR_FORMAT), SENSOR_FORMAT, args);
+  } else {
+    len = vsnprintf(buf, size, SENSOR_FORMAT, args);
+  }
+  va_end(args);
+  return len;
+}
+
+static double format_ns(bool binary) {
+  char buf[256];
+  size_t total = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < CALLS; i++)
+    total += format(binary, buf, sizeof(buf), "Temperature", 20.0f + (i % 1000) / 100.0f, "°C", 1);
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  // Keep the results alive
+  if (total == 0)
+    printf("\n");
+  return std::chrono::duration<double, std::nano>(elapsed).count() / CALLS;
+}
+
+int run_test() {
+  const Result text = measure(false);
+  const Result binary = measure(true);
+  TEST_CHECK(binary.bytes < text.bytes);
+  printf("text: %.0f ns, %.1f bytes per line\n", text.ns, text.bytes);
+  printf("binary: %.0f ns, %.1f bytes per line\n", binary.ns, binary.bytes);
+  printf("formatting only: vsnprintf %.0f ns, record %.0f ns\n", format_ns(false), format_ns(true));
+  return 0;
+}
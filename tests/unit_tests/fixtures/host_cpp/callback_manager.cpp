@@ -0,0 +1,173 @@
+// Callbacks of every size and kind of capture must be stored, called and destroyed exactly once, the nodes come from
+// the pool until it is used up. Built with the sanitizers, so leaks and use after free fail the test.
+
+#include "test_main.h"
+
+#include <array>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "esphome/core/helpers.h"
+
+using namespace esphome;
+
+static size_t heap_allocations = 0;
+
+// Count the allocations that don't come from the pool, malloc() is still checked by the sanitizers
+void *operator new(size_t size) {
+  heap_allocations++;
+  void *ptr = malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+void operator delete(void *ptr) noexcept { free(ptr); }
+void operator delete(void *ptr, size_t size) noexcept { free(ptr); }
+
+/// Counts how often it was destroyed, as a capture of a callback.
+struct Tracked {
+  explicit Tracked(int *destroyed) : destroyed(destroyed) {}
+  Tracked(Tracked &&other) noexcept : destroyed(other.destroyed) { other.destroyed = nullptr; }
+  Tracked(const Tracked &) = delete;
+  ~Tracked() {
+    if (this->destroyed != nullptr)
+      (*this->destroyed)++;
+  }
+  int *destroyed;
+};
+
+static int test_pool_exhaustion() {
+  std::vector<int> calls;
+  {
+    CallbackManager<void(int)> manager;
+    TEST_CHECK(manager.empty());
+    const size_t before = heap_allocations;
+    // The pool of the test holds four nodes, the rest come from the heap
+    for (int i = 0; i < 6; i++)
+      manager.add([&calls, i](int x) { calls.push_back(i * 10 + x); });
+    TEST_CHECK(heap_allocations - before == 2);
+    TEST_CHECK(!manager.empty() && manager.size() == 6);
+    manager.call(1);
+    TEST_CHECK((calls == std::vector<int>{1, 11, 21, 31, 41, 51}));
+  }
+  // Released nodes go back to the pool
+  CallbackManager<void()> manager;
+  const size_t before = heap_allocations;
+  int count = 0;
+  for (int i = 0; i < 4; i++)
+    manager.add([&count]() { count++; });
+  TEST_CHECK(heap_allocations == before);
+  manager();
+  TEST_CHECK(count == 4);
+  return 0;
+}
+
+static int test_move_only_capture() {
+  int destroyed = 0;
+  int sum = 0;
+  {
+    CallbackManager<void(int)> manager;
+    std::unique_ptr<int> value(new int(5));
+    manager.add([value = std::move(value), &sum](int x) { sum += *value + x; });
+    Tracked tracked(&destroyed);
+    manager.add([tracked = std::move(tracked), &sum](int x) { sum += x; });
+    manager.call(1);
+    manager.call(2);
+    TEST_CHECK(sum == 6 + 1 + 7 + 2);
+    TEST_CHECK(destroyed == 0);
+  }
+  TEST_CHECK(destroyed == 1);
+
+  // Moving the function moves the capture instead of copying its bytes
+  destroyed = 0;
+  {
+    InplaceFunction<int()> function([tracked = Tracked(&destroyed)]() { return tracked.destroyed != nullptr ? 1 : 0; });
+    InplaceFunction<int()> moved(std::move(function));
+    TEST_CHECK(!function && moved() == 1);
+    function = std::move(moved);
+    TEST_CHECK(!moved && function() == 1);
+    TEST_CHECK(destroyed == 0);
+  }
+  TEST_CHECK(destroyed == 1);
+  return 0;
+}
+
+static int test_oversized_capture() {
+  std::array<uint32_t, 16> table{};
+  for (size_t i = 0; i < table.size(); i++)
+    table[i] = i * i;
+  auto lookup = [table](size_t i) { return table[i]; };
+  static_assert(!InplaceFunction<uint32_t(size_t)>::fits_inline<decltype(lookup)>(), "must be allocated");
+
+  const size_t before = heap_allocations;
+  InplaceFunction<uint32_t(size_t)> function(lookup);
+  TEST_CHECK(heap_allocations - before == 1);
+  TEST_CHECK(function(7) == 49);
+  InplaceFunction<uint32_t(size_t)> moved(std::move(function));
+  TEST_CHECK(heap_allocations - before == 1);
+  TEST_CHECK(moved(15) == 225);
+
+  // Strings aren't nothrow movable in every standard library, but are stored either way
+  std::string text(100, 'x');
+  CallbackManager<void(std::string &)> manager;
+  manager.add([text](std::string &out) { out += text; });
+  manager.add([text, lookup](std::string &out) { out += std::to_string(lookup(3)); });
+  std::string out;
+  manager.call(out);
+  TEST_CHECK(out == text + "9");
+  return 0;
+}
+
+static int test_reentrant_add() {
+  CallbackManager<void()> manager;
+  std::vector<int> calls;
+  bool first = true;
+  manager.add([&]() {
+    calls.push_back(1);
+    if (first)
+      manager.add([&calls]() { calls.push_back(3); });
+  });
+  manager.add([&]() {
+    calls.push_back(2);
+    // Added by the last callback while calling
+    if (first)
+      manager.add([&calls]() { calls.push_back(4); });
+  });
+  // Callbacks added while calling are called in the same pass
+  manager.call();
+  TEST_CHECK((calls == std::vector<int>{1, 2, 3, 4}));
+  first = false;
+  calls.clear();
+  manager.call();
+  TEST_CHECK((calls == std::vector<int>{1, 2, 3, 4}));
+  TEST_CHECK(manager.size() == 4);
+  return 0;
+}
+
+static int test_move_manager() {
+  int destroyed = 0;
+  int calls = 0;
+  {
+    CallbackManager<void()> manager;
+    manager.add([tracked = Tracked(&destroyed), &calls]() { calls++; });
+    CallbackManager<void()> moved(std::move(manager));
+    TEST_CHECK(manager.empty() && moved.size() == 1);
+    manager.call();
+    moved.call();
+    TEST_CHECK(calls == 1);
+  }
+  TEST_CHECK(destroyed == 1);
+  return 0;
+}
+
+int run_test() {
+  TEST_CHECK(test_pool_exhaustion() == 0);
+  TEST_CHECK(test_move_only_capture() == 0);
+  TEST_CHECK(test_oversized_capture() == 0);
+  TEST_CHECK(test_reentrant_add() == 0);
+  TEST_CHECK(test_move_manager() == 0);
+  return 0;
+}
@@ -0,0 +1,177 @@
+// Frames read from the controller go through the receive ring of Canbus in order and without loss while it wraps
+// around, also when it fills up during a burst, and fire exactly the triggers whose id and mask they match, in the
+// order the triggers were configured.
+
+#include "test_main.h"
+
+#include <deque>
+#include <vector>
+
+#include "esphome/components/canbus/canbus.h"
+#include "esphome/core/application.h"
+#include "esphome/core/base_automation.h"
+
+using namespace esphome;
+using namespace esphome::canbus;
+
+// Declared by Canbus but only ever defined by the platforms
+namespace esphome {
+namespace canbus {
+bool Canbus::setup_internal() { return true; }
+Error Canbus::send_message(struct CanFrame *frame) { return ERROR_FAIL; }
+Error Canbus::read_message(struct CanFrame *frame) { return ERROR_NOMSG; }
+}  // namespace canbus
+}  // namespace esphome
+
+/// Controller holding the frames the test puts on the bus until the ring reads them.
+class FakeBus : public Canbus {
+ public:
+  /// Put a frame on the bus, its first byte is the sequence number.
+  void put(uint32_t can_id, bool extended = false) {
+    CanFrame frame{};
+    frame.can_id = can_id;
+    frame.use_extended_id = extended;
+    frame.can_data_length_code = 2;
+    frame.data[0] = uint8_t(this->sent_);
+    frame.data[1] = uint8_t(this->sent_ >> 8);
+    this->sent_++;
+    this->pending_.push_back(frame);
+  }
+  size_t pending() const { return this->pending_.size(); }
+  size_t head() const { return this->rx_head_; }
+  size_t reads{0};
+
+ protected:
+  bool setup_internal() override { return true; }
+  Error send_message(struct CanFrame *frame) override { return ERROR_OK; }
+  Error read_message(struct CanFrame *frame) override {
+    if (this->pending_.empty())
+      return ERROR_NOMSG;
+    *frame = this->pending_.front();
+    this->pending_.pop_front();
+    this->reads++;
+    return ERROR_OK;
+  }
+
+  std::deque<CanFrame> pending_;
+  uint32_t sent_{0};
+};
+
+struct Recorder;
+/// Every trigger that fired, in the order they fired.
+static std::vector<const Recorder *> firing;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+/// Trigger recording the sequence numbers of the frames it fired for, and how many frames the bus had read by then.
+struct Recorder {
+  Recorder(FakeBus *bus, uint32_t can_id, uint32_t mask, bool extended)
+      : trigger(bus, can_id, mask, extended), automation(&trigger) {
+    this->automation.add_actions({new LambdaAction<std::vector<uint8_t>, uint32_t, bool>(
+        [this, bus](std::vector<uint8_t> data, uint32_t can_id, bool rtr) {
+          this->fired.push_back(data[0] | uint32_t(data[1]) << 8);
+          this->ids.push_back(can_id);
+          this->reads.push_back(bus->reads);
+          firing.push_back(this);
+        })});
+  }
+  CanbusTrigger trigger;
+  Automation<std::vector<uint8_t>, uint32_t, bool> automation;
+  std::vector<uint32_t> fired;
+  std::vector<uint32_t> ids;
+  std::vector<size_t> reads;
+};
+
+static int test_ring() {
+  FakeBus bus;
+  // Every standard frame
+  Recorder all(&bus, 0, 0, false);
+  std::vector<uint32_t> &received = all.fired;
+
+  // A few frames per loop, the head goes around the ring many times
+  uint32_t sent = 0;
+  for (int loop = 0; loop < 200; loop++) {
+    for (int i = 0; i < loop % 7; i++, sent++)
+      bus.put(0x100);
+    bus.loop();
+    TEST_CHECK(received.size() == sent);
+  }
+  TEST_CHECK(bus.head() == sent % RX_QUEUE_SIZE && sent > 10 * RX_QUEUE_SIZE);
+
+  // A burst, more than a loop dispatches; the ring is read full before the first frame is dispatched
+  received.clear();
+  all.reads.clear();
+  const size_t first = bus.reads;
+  for (size_t i = 0; i < 3 * MAX_FRAMES_PER_LOOP; i++)
+    bus.put(0x100);
+  bus.loop();
+  TEST_CHECK(all.reads[0] - first == RX_QUEUE_SIZE);
+  TEST_CHECK(received.size() == MAX_FRAMES_PER_LOOP);
+  // The ring is refilled before every frame it dispatches, only the slot of the last one is free
+  TEST_CHECK(bus.pending() == 3 * MAX_FRAMES_PER_LOOP - MAX_FRAMES_PER_LOOP - (RX_QUEUE_SIZE - 1));
+  bus.loop();
+  bus.loop();
+  bus.loop();
+  TEST_CHECK(received.size() == 3 * MAX_FRAMES_PER_LOOP && bus.pending() == 0);
+  for (size_t i = 0; i < received.size(); i++) {
+    if (received[i] != sent + i) {
+      printf("frame %zu of the burst is %u\n", i, received[i]);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+static int test_triggers() {
+  FakeBus bus;
+  Recorder exact(&bus, 0x123, 0x7FF, false);
+  Recorder duplicate(&bus, 0x123, 0x7FF, false);
+  Recorder other(&bus, 0x124, 0x7FF, false);
+  Recorder masked(&bus, 0x120, 0x7F0, false);
+  Recorder extended(&bus, 0x123, 0x1FFFFFFF, true);
+
+  // 0x123 std, 0x12F std, 0x124 std, 0x123 ext, 0x223 std, a burst of three times the ring size
+  const uint32_t ids[] = {0x123, 0x12F, 0x124, 0x123, 0x223};
+  for (int round = 0; round < 20; round++) {
+    for (size_t i = 0; i < 5; i++)
+      bus.put(ids[i], i == 3);
+  }
+  bus.loop();
+  bus.loop();
+  TEST_CHECK(bus.pending() == 0);
+  TEST_CHECK(exact.fired.size() == 20 && duplicate.fired == exact.fired);
+  TEST_CHECK(other.fired.size() == 20 && extended.fired.size() == 20);
+  TEST_CHECK(masked.fired.size() == 60);
+  for (int round = 0; round < 20; round++) {
+    TEST_CHECK(exact.fired[round] == uint32_t(round * 5));
+    TEST_CHECK(other.fired[round] == uint32_t(round * 5 + 2));
+    TEST_CHECK(extended.fired[round] == uint32_t(round * 5 + 3));
+    TEST_CHECK(masked.fired[round * 3] == uint32_t(round * 5) && masked.ids[round * 3 + 1] == 0x12F);
+  }
+  return 0;
+}
+
+static int test_trigger_order() {
+  FakeBus bus;
+  // Masked triggers configured between, before and after the exact ones
+  Recorder first(&bus, 0x100, 0x700, false);
+  Recorder exact(&bus, 0x123, 0x7FF, false);
+  Recorder masked(&bus, 0x120, 0x7F0, false);
+  Recorder duplicate(&bus, 0x123, 0x7FF, false);
+  Recorder other(&bus, 0x124, 0x7FF, false);
+  Recorder last(&bus, 0, 0, false);
+  firing.clear();
+  bus.put(0x123);
+  bus.loop();
+  TEST_CHECK((firing == std::vector<const Recorder *>{&first, &exact, &masked, &duplicate, &last}));
+  firing.clear();
+  bus.put(0x124);
+  bus.loop();
+  TEST_CHECK((firing == std::vector<const Recorder *>{&first, &masked, &other, &last}));
+  return 0;
+}
+
+int run_test() {
+  TEST_CHECK(test_ring() == 0);
+  TEST_CHECK(test_triggers() == 0);
+  TEST_CHECK(test_trigger_order() == 0);
+  return 0;
+}
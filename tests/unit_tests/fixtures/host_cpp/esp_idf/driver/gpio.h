@@ -0,0 +1,8 @@
+// Stand-in for the ESP-IDF GPIO driver, implemented by the test driver.
+#pragma once
+
+#include "esp_err.h"
+
+typedef int gpio_num_t;
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level);
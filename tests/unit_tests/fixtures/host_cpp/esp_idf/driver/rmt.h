@@ -0,0 +1,32 @@
+// Stand-in for the ESP-IDF RMT driver, only the types the remote components use.
+#pragma once
+
+#include <cstdint>
+
+#include "esp_err.h"
+
+typedef enum {
+  RMT_CHANNEL_0,
+  RMT_CHANNEL_1,
+  RMT_CHANNEL_2,
+  RMT_CHANNEL_3,
+  RMT_CHANNEL_MAX,
+} rmt_channel_t;
+
+typedef struct {
+  union {
+    struct {
+      uint32_t duration0 : 15;
+      uint32_t level0 : 1;
+      uint32_t duration1 : 15;
+      uint32_t level1 : 1;
+    };
+    uint32_t val;
+  };
+} rmt_item32_t;
+
+typedef struct {
+  rmt_channel_t channel;
+  uint8_t clk_div;
+  uint8_t mem_block_num;
+} rmt_config_t;
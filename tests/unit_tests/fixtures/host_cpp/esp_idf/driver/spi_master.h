@@ -0,0 +1,73 @@
+// Stand-in for the ESP-IDF SPI master driver, implemented by the test driver.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "esp_err.h"
+
+typedef int spi_host_device_t;
+typedef struct FakeSpiDevice *spi_device_handle_t;
+
+#define SPI_DMA_CH_AUTO 3
+#define SPICOMMON_BUSFLAG_MASTER (1 << 0)
+#define SPICOMMON_BUSFLAG_SCLK (1 << 1)
+#define SPICOMMON_BUSFLAG_QUAD (1 << 2)
+#define SPI_DEVICE_BIT_LSBFIRST (1 << 0)
+#define SPI_DEVICE_HALFDUPLEX (1 << 1)
+#define SPI_DEVICE_NO_DUMMY (1 << 2)
+#define SPI_TRANS_MODE_QIO (1 << 0)
+#define SPI_TRANS_MODE_OCT (1 << 1)
+#define SPI_TRANS_VARIABLE_CMD (1 << 2)
+#define SPI_TRANS_VARIABLE_ADDR (1 << 3)
+#define SPI_TRANS_VARIABLE_DUMMY (1 << 4)
+#define SPI_SWAP_DATA_TX(data, len) __builtin_bswap16((uint16_t) (data) << (16 - (len)))
+
+struct spi_transaction_t {
+  uint32_t flags;
+  uint16_t cmd;
+  uint64_t addr;
+  size_t length;
+  size_t rxlength;
+  void *user;
+  const void *tx_buffer;
+  void *rx_buffer;
+};
+
+struct spi_transaction_ext_t {
+  spi_transaction_t base;
+  uint8_t command_bits;
+  uint8_t address_bits;
+  uint8_t dummy_bits;
+};
+
+typedef void (*transaction_cb_t)(spi_transaction_t *trans);
+
+struct spi_device_interface_config_t {
+  uint8_t mode;
+  int clock_speed_hz;
+  int spics_io_num;
+  uint32_t flags;
+  int queue_size;
+  transaction_cb_t pre_cb;
+  transaction_cb_t post_cb;
+};
+
+struct spi_bus_config_t {
+  int mosi_io_num, miso_io_num, sclk_io_num, quadwp_io_num, quadhd_io_num;
+  int data0_io_num, data1_io_num, data2_io_num, data3_io_num, data4_io_num, data5_io_num, data6_io_num,
+      data7_io_num;
+  int max_transfer_sz;
+  uint32_t flags;
+};
+
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t *config, int dma_chan);
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *config,
+                             spi_device_handle_t *handle);
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle);
+esp_err_t spi_device_acquire_bus(spi_device_handle_t device, TickType_t wait);
+void spi_device_release_bus(spi_device_handle_t device);
+esp_err_t spi_device_polling_start(spi_device_handle_t handle, spi_transaction_t *trans, TickType_t wait);
+esp_err_t spi_device_polling_end(spi_device_handle_t handle, TickType_t wait);
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans, TickType_t wait);
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **trans, TickType_t wait);
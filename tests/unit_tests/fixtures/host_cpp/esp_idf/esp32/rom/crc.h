@@ -0,0 +1,24 @@
+// Stand-in for the CRC routines in the ESP32 ROM, computed bit by bit.
+#pragma once
+
+#include <cstdint>
+
+inline uint16_t crc16_le(uint16_t crc, const uint8_t *buf, uint32_t len) {
+  crc = ~crc;
+  while (len-- != 0) {
+    crc ^= *buf++;
+    for (int i = 0; i < 8; i++)
+      crc = (crc & 1) ? (crc >> 1) ^ 0x8408 : crc >> 1;
+  }
+  return ~crc;
+}
+
+inline uint16_t crc16_be(uint16_t crc, const uint8_t *buf, uint32_t len) {
+  crc = ~crc;
+  while (len-- != 0) {
+    crc ^= static_cast<uint16_t>(*buf++) << 8;
+    for (int i = 0; i < 8; i++)
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+  }
+  return ~crc;
+}
@@ -0,0 +1,8 @@
+// Stand-in for the ESP-IDF eFuse fields, see esp_efuse.h.
+#pragma once
+
+#include "esp_efuse.h"
+
+static const esp_efuse_desc_t *ESP_EFUSE_MAC_CUSTOM[] = {nullptr};
+static const esp_efuse_desc_t *ESP_EFUSE_MAC_FACTORY[] = {nullptr};
+static const esp_efuse_desc_t *ESP_EFUSE_USER_DATA_MAC_CUSTOM[] = {nullptr};
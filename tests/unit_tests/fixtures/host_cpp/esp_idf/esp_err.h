@@ -0,0 +1,12 @@
+// Stand-in for the ESP-IDF error codes and FreeRTOS ticks used by the drivers.
+#pragma once
+
+#include <cstdint>
+
+typedef int esp_err_t;
+typedef uint32_t TickType_t;
+
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_TIMEOUT 0x107
+#define portMAX_DELAY ((TickType_t) 0xFFFFFFFF)
@@ -0,0 +1,10 @@
+// Stand-in for the ESP-IDF heap capabilities, everything is ordinary heap on the host.
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_SPIRAM (1 << 10)
+
+inline void *heap_caps_malloc(size_t size, uint32_t caps) { return nullptr; }
@@ -0,0 +1,2 @@
+// Stand-in for the ESP-IDF logging header, the logger of the tree is used instead.
+#pragma once
@@ -0,0 +1,10 @@
+// Stand-in for the ESP-IDF MAC address API, the host has a fixed MAC address and no eFuses.
+#pragma once
+
+#include <cstdint>
+
+#include "esp_err.h"
+
+inline esp_err_t esp_efuse_mac_get_custom(uint8_t *mac) { return ESP_FAIL; }
+inline esp_err_t esp_efuse_mac_get_default(uint8_t *mac) { return ESP_FAIL; }
+inline esp_err_t esp_base_mac_addr_set(const uint8_t *mac) { return ESP_OK; }
@@ -0,0 +1,4 @@
+// Stand-in for the ESP-IDF system API, nothing of it is used on the host.
+#pragma once
+
+#include "esp_err.h"
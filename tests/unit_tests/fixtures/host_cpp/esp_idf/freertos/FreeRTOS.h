@@ -0,0 +1,10 @@
+// Stand-in for the FreeRTOS kernel, the tests run on a single thread.
+#pragma once
+
+#include "esp_err.h"
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define portTICK_PERIOD_MS 1
+#define portDISABLE_INTERRUPTS()
+#define portENABLE_INTERRUPTS()
@@ -0,0 +1,4 @@
+// Stand-in for the FreeRTOS port macros, see FreeRTOS.h.
+#pragma once
+
+#include "FreeRTOS.h"
@@ -0,0 +1,11 @@
+// Stand-in for the FreeRTOS semaphores, the tests run on a single thread so they are always free.
+#pragma once
+
+#include "FreeRTOS.h"
+
+typedef void *SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateBinary() { return nullptr; }
+inline SemaphoreHandle_t xSemaphoreCreateMutex() { return nullptr; }
+inline int xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks) { return pdTRUE; }
+inline int xSemaphoreGive(SemaphoreHandle_t semaphore) { return pdTRUE; }
@@ -0,0 +1,189 @@
+// value_accuracy_to_buf() must write the same digits as printf("%.*f"), float_to_buf() the shortest string that
+// reads back as the same float. Prints the time per value compared to snprintf().
+
+#include "test_main.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "esphome/core/helpers.h"
+
+using namespace esphome;
+
+static float from_bits(uint32_t bits) {
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+static uint32_t to_bits(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+/// Values every sweep includes, on top of a stride through the bit patterns.
+static std::vector<float> special_values() {
+  std::vector<float> values = {0.0f, -0.0f, 0.5f, 1.5f, 2.5f, 0.125f, 0.375f, 1.0f / 3.0f, 21.45f, 99.995f,
+                               std::numeric_limits<float>::denorm_min(), std::numeric_limits<float>::min(),
+                               std::numeric_limits<float>::max(), std::numeric_limits<float>::infinity(),
+                               -std::numeric_limits<float>::infinity(), std::numeric_limits<float>::quiet_NaN()};
+  // Around the switch to snprintf() at 1e9
+  float boundary = 1e9f;
+  for (int i = 0; i < 4; i++)
+    boundary = std::nextafter(boundary, 0.0f);
+  for (int i = 0; i < 8; i++) {
+    values.push_back(boundary);
+    values.push_back(-boundary);
+    boundary = std::nextafter(boundary, INFINITY);
+  }
+  // Denormals
+  for (uint32_t bits = 1; bits < 0x800000; bits += 4099)
+    values.push_back(from_bits(bits));
+  return values;
+}
+
+static int check_accuracy(float value, int8_t decimals) {
+  char expected[64], actual[64];
+  snprintf(expected, sizeof(expected), "%.*f", decimals, value);
+  size_t len = value_accuracy_to_buf(actual, sizeof(actual), value, decimals);
+  if (len != strlen(expected) || strcmp(actual, expected) != 0) {
+    printf("bits 0x%08X with %d decimals: got '%s', expected '%s'\n", to_bits(value), decimals, actual, expected);
+    return 1;
+  }
+  return 0;
+}
+
+static int test_value_accuracy() {
+  std::vector<float> values = special_values();
+  // Positive floats below 1.1e9 and their negatives
+  for (uint32_t bits = 0; bits < 0x4E830000; bits += 7919) {
+    values.push_back(from_bits(bits));
+    values.push_back(from_bits(bits | 0x80000000));
+  }
+  for (float value : values) {
+    for (int8_t decimals = 0; decimals <= 9; decimals++)
+      TEST_CHECK(check_accuracy(value, decimals) == 0);
+  }
+
+  // Negative decimals round to tens, hundreds, ...
+  TEST_CHECK(value_accuracy_to_string(1234.5f, -2) == "1200");
+  // Truncated to the buffer, which is always terminated
+  char small[4];
+  TEST_CHECK(value_accuracy_to_buf(small, sizeof(small), 12.345f, 2) == 3);
+  TEST_CHECK(strcmp(small, "12.") == 0);
+  TEST_CHECK(value_accuracy_to_buf(small, 0, 12.345f, 2) == 0);
+  return 0;
+}
+
+/// Number of significant digits in a decimal string, without sign, leading and trailing zeros and exponent.
+static int significant_digits(const char *str) {
+  std::string digits;
+  for (const char *p = str; *p != '\0' && *p != 'e'; p++) {
+    if (*p >= '0' && *p <= '9')
+      digits += *p;
+  }
+  size_t first = digits.find_first_not_of('0');
+  if (first == std::string::npos)
+    return 1;
+  size_t last = digits.find_last_not_of('0');
+  return last - first + 1;
+}
+
+static int check_shortest(float value) {
+  char buf[FLOAT_BUF_SIZE];
+  size_t len = float_to_buf(buf, sizeof(buf), value);
+  if (len != strlen(buf) || len >= FLOAT_BUF_SIZE) {
+    printf("bits 0x%08X: bad length %zu of '%s'\n", to_bits(value), len, buf);
+    return 1;
+  }
+  if (std::isnan(value))
+    return strcmp(buf, "nan") == 0 ? 0 : 1;
+  float read = strtof(buf, nullptr);
+  if (to_bits(read) != to_bits(value)) {
+    printf("bits 0x%08X: '%s' reads back as 0x%08X\n", to_bits(value), buf, to_bits(read));
+    return 1;
+  }
+  if (std::isinf(value))
+    return 0;
+  int shortest = 1;
+  char other[32];
+  for (; shortest < 9; shortest++) {
+    snprintf(other, sizeof(other), "%.*g", shortest, value);
+    if (strtof(other, nullptr) == value)
+      break;
+  }
+  if (significant_digits(buf) > shortest) {
+    printf("bits 0x%08X: '%s' is longer than %d digits\n", to_bits(value), buf, shortest);
+    return 1;
+  }
+  return 0;
+}
+
+static int test_float_to_buf() {
+  for (float value : special_values())
+    TEST_CHECK(check_shortest(value) == 0);
+  // All exponents, both signs
+  for (uint32_t bits = 0; bits < 0x7F800000; bits += 16381) {
+    TEST_CHECK(check_shortest(from_bits(bits)) == 0);
+    TEST_CHECK(check_shortest(from_bits(bits | 0x80000000)) == 0);
+  }
+
+  char buf[FLOAT_BUF_SIZE];
+  float_to_buf(buf, sizeof(buf), 21.5f);
+  TEST_CHECK(strcmp(buf, "21.5") == 0);
+  float_to_buf(buf, sizeof(buf), 1e-7f);
+  TEST_CHECK(strcmp(buf, "1e-7") == 0);
+  float_to_buf(buf, sizeof(buf), 1.5e25f);
+  TEST_CHECK(strcmp(buf, "1.5e+25") == 0);
+  float_to_buf(buf, sizeof(buf), -0.0f);
+  TEST_CHECK(strcmp(buf, "-0") == 0);
+  float_to_buf(buf, sizeof(buf), -INFINITY);
+  TEST_CHECK(strcmp(buf, "-inf") == 0);
+  return 0;
+}
+
+template<typename F> static double ns_per_value(const std::vector<float> &values, F &&format) {
+  char buf[64];
+  size_t total = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int round = 0; round < 10; round++) {
+    for (float value : values)
+      total += format(buf, value);
+  }
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  // Keep the results alive
+  if (total == 0)
+    printf("\n");
+  return std::chrono::duration<double, std::nano>(elapsed).count() / (values.size() * 10);
+}
+
+static void benchmark() {
+  // Typical sensor values
+  std::vector<float> values;
+  for (int i = 0; i < 10000; i++)
+    values.push_back((i * 7919 % 100000) / 37.0f - 500.0f);
+  for (int decimals : {1, 2}) {
+    double ours = ns_per_value(
+        values, [decimals](char *buf, float value) { return value_accuracy_to_buf(buf, 64, value, decimals); });
+    double printf_ns = ns_per_value(
+        values, [decimals](char *buf, float value) { return (size_t) snprintf(buf, 64, "%.*f", decimals, value); });
+    printf("%%.%df: snprintf %.0f ns, value_accuracy_to_buf %.0f ns\n", decimals, printf_ns, ours);
+  }
+  double ours = ns_per_value(values, [](char *buf, float value) { return float_to_buf(buf, 64, value); });
+  double printf_ns =
+      ns_per_value(values, [](char *buf, float value) { return (size_t) snprintf(buf, 64, "%.9g", value); });
+  printf("shortest: snprintf %%.9g %.0f ns, float_to_buf %.0f ns\n", printf_ns, ours);
+}
+
+int run_test() {
+  TEST_CHECK(test_value_accuracy() == 0);
+  TEST_CHECK(test_float_to_buf() == 0);
+  benchmark();
+  return 0;
+}
@@ -0,0 +1,206 @@
+// The history of a trace keeps the average, and optionally the minimum and maximum, of the samples of every column,
+// its range follows the columns as they are overwritten. Prints the time to sample and draw 4 traces of 480 columns.
+
+#include "test_main.h"
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "esphome/components/display/display.h"
+#include "esphome/components/graph/graph.h"
+#include "esphome/components/sensor/sensor.h"
+
+using namespace esphome;
+
+/// Monochrome frame buffer that counts the pixels drawn.
+class FrameDisplay : public display::Display {
+ public:
+  FrameDisplay(int width, int height) : pixels(width * height, 0), width_(width), height_(height) {}
+  void update() override {}
+  void draw_pixel_at(int x, int y, Color color) override {
+    this->calls++;
+    if (x >= 0 && y >= 0 && x < this->width_ && y < this->height_)
+      this->pixels[y * this->width_ + x] = 1;
+  }
+  display::DisplayType get_display_type() override { return display::DISPLAY_TYPE_BINARY; }
+  void clear_pixels() { std::fill(this->pixels.begin(), this->pixels.end(), 0); }
+
+  std::vector<uint8_t> pixels;
+  size_t calls{0};
+
+ protected:
+  int get_width_internal() override { return this->width_; }
+  int get_height_internal() override { return this->height_; }
+
+  int width_;
+  int height_;
+};
+
+/// Sample with `count` samples per column of 1 s, starting at a column boundary.
+static void sample_columns(graph::HistoryData &data, const std::vector<float> &values, int count) {
+  for (float value : values) {
+    for (int i = 0; i < count; i++) {
+      test::advance_ms(1000 / count);
+      data.take_sample(value + i);
+    }
+  }
+}
+
+static int test_averages() {
+  // The first sample after init() lands in a column, the next ones in the following column
+  graph::HistoryData data;
+  data.set_update_time_ms(1000);
+  data.init(8);
+  sample_columns(data, {10, 20, 30}, 4);
+  // Samples 10..13, 20..23 and 30..33 fall into the columns ending at 1 s, 2 s and 3 s
+  TEST_CHECK(data.get_value(0) == 31.5f && data.get_value(1) == 21.5f && data.get_value(2) == 11.5f);
+  TEST_CHECK(data.get_min(0) == data.get_value(0) && data.get_max(0) == data.get_value(0));
+  TEST_CHECK(std::isnan(data.get_value(3)));
+  TEST_CHECK(data.get_recent_min() == 11.5f && data.get_recent_max() == 31.5f);
+
+  graph::HistoryData min_max;
+  min_max.set_update_time_ms(1000);
+  min_max.init(8, true);
+  sample_columns(min_max, {10, 20, 30}, 4);
+  TEST_CHECK(min_max.get_value(0) == 31.5f && min_max.get_min(0) == 30 && min_max.get_max(0) == 33);
+  TEST_CHECK(min_max.get_min(2) == 10 && min_max.get_max(2) == 13);
+  TEST_CHECK(min_max.get_recent_min() == 10 && min_max.get_recent_max() == 33);
+  return 0;
+}
+
+static int test_range_follows_columns() {
+  for (bool show_min_max : {false, true}) {
+    graph::HistoryData data;
+    data.set_update_time_ms(1000);
+    data.init(50, show_min_max);
+    uint32_t seed = 1;
+    std::vector<float> recent;
+    for (int step = 0; step < 2000; step++) {
+      seed = seed * 1103515245 + 12345;
+      // Slow drift with spikes, so extremes leave the history while others remain
+      float value = step % 13 == 0 ? NAN : step % 300 + float((seed >> 8) % 100) / 10.0f;
+      test::advance_ms(step % 7 == 0 ? 3000 : 500);
+      data.take_sample(value);
+      if (!std::isnan(value))
+        recent.push_back(value);
+      float min = NAN, max = NAN;
+      for (int i = 0; i < data.get_length(); i++) {
+        if (std::isnan(data.get_min(i)))
+          continue;
+        min = std::isnan(min) ? data.get_min(i) : std::min(min, data.get_min(i));
+        max = std::isnan(max) ? data.get_max(i) : std::max(max, data.get_max(i));
+      }
+      // Samples of the column that is not written yet can only widen the range of the columns
+      float outer_min = min, outer_max = max;
+      for (size_t i = recent.size() > 4 ? recent.size() - 4 : 0; i < recent.size(); i++) {
+        outer_min = std::isnan(outer_min) ? recent[i] : std::min(outer_min, recent[i]);
+        outer_max = std::isnan(outer_max) ? recent[i] : std::max(outer_max, recent[i]);
+      }
+      if (std::isnan(outer_min))
+        continue;
+      const float recent_min = data.get_recent_min(), recent_max = data.get_recent_max();
+      if ((!std::isnan(min) && (recent_min > min || recent_max < max)) || recent_min < outer_min ||
+          recent_max > outer_max) {
+        printf("step %d: range %f..%f, columns %f..%f\n", step, recent_min, recent_max, min, max);
+        return 1;
+      }
+    }
+  }
+  return 0;
+}
+
+struct GraphSetup {
+  explicit GraphSetup(bool show_min_max) {
+    graph.set_duration(480);
+    graph.set_width(480);
+    graph.set_height(200);
+    for (int i = 0; i < 4; i++) {
+      traces[i].set_sensor(&sensors[i]);
+      traces[i].set_line_thickness(2);
+      traces[i].set_continuous(true);
+      traces[i].set_show_min_max(show_min_max);
+      graph.add_trace(&traces[i]);
+    }
+    graph.setup();
+  }
+  /// Publish `per_column` values for every column of every trace, returns the time per publish in ns.
+  double fill(int per_column) {
+    auto start = std::chrono::steady_clock::now();
+    for (int column = 0; column < 480; column++) {
+      for (int i = 0; i < per_column; i++) {
+        test::advance_ms(1000 / per_column);
+        // A slow wave with noise on every sample
+        const float t = column + float(i) / per_column;
+        for (int s = 0; s < 4; s++)
+          sensors[s].publish_state(50.0f + 30.0f * sinf(t * 0.03f + s) + float((column * 7 + i * 13 + s) % 11) - 5.0f);
+      }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / (480 * per_column * 4);
+  }
+  /// Time to draw the graph in us.
+  double draw(FrameDisplay &display, int rounds = 20) {
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+      display.clear_pixels();
+      display.calls = 0;
+      graph.draw(&display, 0, 0, Color(255, 255, 255));
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::micro>(elapsed).count() / rounds;
+  }
+
+  sensor::Sensor sensors[4];
+  graph::GraphTrace traces[4];
+  graph::Graph graph;
+};
+
+static int test_draw() {
+  // With one sample per column the envelope is the average, both draw the same pixels
+  FrameDisplay avg_display(480, 200), min_max_display(480, 200);
+  GraphSetup avg(false), min_max(true);
+  avg.fill(1);
+  min_max.fill(1);
+  avg.draw(avg_display, 1);
+  min_max.draw(min_max_display, 1);
+  TEST_CHECK(avg_display.calls > 0);
+  TEST_CHECK(avg_display.pixels == min_max_display.pixels);
+
+  // With more, the envelope covers the spikes between columns
+  avg.fill(4);
+  min_max.fill(4);
+  avg.draw(avg_display, 1);
+  min_max.draw(min_max_display, 1);
+  size_t avg_pixels = 0, min_max_pixels = 0;
+  for (size_t i = 0; i < avg_display.pixels.size(); i++) {
+    avg_pixels += avg_display.pixels[i];
+    min_max_pixels += min_max_display.pixels[i];
+  }
+  TEST_CHECK(min_max_pixels > avg_pixels);
+  return 0;
+}
+
+static void benchmark() {
+  for (int per_column : {1, 4}) {
+    for (bool show_min_max : {false, true}) {
+      GraphSetup setup(show_min_max);
+      FrameDisplay display(480, 200);
+      setup.fill(per_column);
+      double sample_ns = setup.fill(per_column);
+      double draw_us = setup.draw(display);
+      printf("4x480, %d samples per column, %s: %.0f ns per sample, draw %.0f us with %zu pixels, %zu bytes per "
+             "column\n",
+             per_column, show_min_max ? "min/max" : "average", sample_ns, draw_us, display.calls,
+             show_min_max ? 3 * sizeof(float) : sizeof(float));
+    }
+  }
+}
+
+int run_test() {
+  TEST_CHECK(test_averages() == 0);
+  TEST_CHECK(test_range_follows_columns() == 0);
+  TEST_CHECK(test_draw() == 0);
+  benchmark();
+  return 0;
+}
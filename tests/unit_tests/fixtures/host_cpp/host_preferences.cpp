@@ -0,0 +1,190 @@
+// The host preferences must survive the process being killed at any point of a sync().
+
+#include "test_main.h"
+
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+#include "esphome/components/host/preferences.h"
+#include "esphome/core/application.h"
+
+using namespace esphome;
+
+class TestPreferences : public host::HostPreferences {
+ public:
+  using HostPreferences::end_;
+};
+
+static const uint32_t KEY_COUNT = 8;
+static const size_t VALUE_SIZE = 64;
+
+/// Give each test a fresh home directory below TMPDIR, which holds the preferences file.
+static std::string use_new_home() {
+  const char *tmp = getenv("TMPDIR");
+  std::string dir = std::string(tmp != nullptr ? tmp : "/tmp") + "/home_XXXXXX";
+  if (mkdtemp(&dir[0]) == nullptr)
+    abort();
+  setenv("HOME", dir.c_str(), 1);
+  std::string prefs = dir + "/.esphome/prefs";
+  mkdir((dir + "/.esphome").c_str(), 0755);
+  mkdir(prefs.c_str(), 0755);
+  return prefs + "/" + App.get_name() + ".prefs";
+}
+
+static std::vector<uint8_t> read_file(const std::string &path) {
+  std::vector<uint8_t> content;
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return content;
+  uint8_t chunk[4096];
+  ssize_t len;
+  while ((len = read(fd, chunk, sizeof(chunk))) > 0)
+    content.insert(content.end(), chunk, chunk + len);
+  close(fd);
+  return content;
+}
+
+static void save_generation(host::HostPreferences &prefs, uint32_t generation) {
+  uint8_t value[VALUE_SIZE];
+  for (uint32_t key = 0; key < KEY_COUNT; key++) {
+    memset(value, uint8_t(generation + key), sizeof(value));
+    memcpy(value, &generation, sizeof(generation));
+    prefs.save(key, value, sizeof(value));
+  }
+}
+
+/// Generation held by all keys, 0 if none is stored, or -1 if the keys are from different syncs.
+static int64_t load_generation(host::HostPreferences &prefs) {
+  int64_t result = 0;
+  for (uint32_t key = 0; key < KEY_COUNT; key++) {
+    uint8_t value[VALUE_SIZE];
+    if (!prefs.load(key, value, sizeof(value)))
+      return key == 0 ? 0 : -1;
+    uint32_t generation;
+    memcpy(&generation, value, sizeof(generation));
+    for (size_t i = sizeof(generation); i < sizeof(value); i++) {
+      if (value[i] != uint8_t(generation + key))
+        return -1;
+    }
+    if (key != 0 && generation != result)
+      return -1;
+    result = generation;
+  }
+  return result;
+}
+
+static int test_killed_during_sync() {
+  use_new_home();
+  int64_t generation = 0;
+  srand(1);
+  for (int round = 0; round < 100; round++) {
+    pid_t pid = fork();
+    if (pid == 0) {
+      host::HostPreferences prefs;
+      uint32_t next = load_generation(prefs);
+      while (true) {
+        save_generation(prefs, ++next);
+        prefs.sync();
+      }
+    }
+    usleep(rand() % 3000);
+    kill(pid, SIGKILL);
+    waitpid(pid, nullptr, 0);
+
+    host::HostPreferences prefs;
+    int64_t loaded = load_generation(prefs);
+    TEST_CHECK(loaded >= generation);
+    generation = loaded;
+  }
+  // Long enough for the file to be compacted a few times
+  TEST_CHECK(generation > 200);
+  return 0;
+}
+
+static int test_incomplete_batch_discarded() {
+  const std::string path = use_new_home();
+  {
+    TestPreferences prefs;
+    save_generation(prefs, 1);
+    TEST_CHECK(prefs.sync());
+    // A batch that was cut off before its commit marker
+    uint8_t record[16] = {0, 0, 0, 0, 8, 0, 1, 0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    int fd = open(path.c_str(), O_WRONLY);
+    TEST_CHECK(pwrite(fd, record, sizeof(record), prefs.end_) == (ssize_t) sizeof(record));
+    close(fd);
+  }
+  TestPreferences prefs;
+  TEST_CHECK(load_generation(prefs) == 1);
+  save_generation(prefs, 2);
+  TEST_CHECK(prefs.sync());
+  TestPreferences reopened;
+  TEST_CHECK(load_generation(reopened) == 2);
+  return 0;
+}
+
+static int test_saving_back_and_forth_writes_once() {
+  use_new_home();
+  TestPreferences prefs;
+  uint32_t value = 1;
+  prefs.save(1, reinterpret_cast<uint8_t *>(&value), sizeof(value));
+  TEST_CHECK(prefs.sync());
+  const size_t end = prefs.end_;
+  for (uint32_t next : {2, 1, 3}) {
+    value = next;
+    prefs.save(1, reinterpret_cast<uint8_t *>(&value), sizeof(value));
+  }
+  TEST_CHECK(prefs.sync());
+  // One value record of a header and 4 bytes, and the commit marker
+  TEST_CHECK(prefs.end_ - end == 12 + 8);
+  return 0;
+}
+
+static int test_legacy_file_kept_if_not_converted() {
+  const std::string path = use_new_home();
+  // Key, length and value of every preference
+  const uint8_t legacy[] = {0x34, 0x12, 0, 0, 4, 1, 2, 3, 4, 0x78, 0x56, 0, 0, 2, 5, 6};
+  int fd = open(path.c_str(), O_WRONLY | O_CREAT, 0644);
+  TEST_CHECK(write(fd, legacy, sizeof(legacy)) == (ssize_t) sizeof(legacy));
+  close(fd);
+  // The converted file can't be written next to the old one
+  const std::string temp = path + ".tmp";
+  mkdir(temp.c_str(), 0755);
+
+  uint8_t value[4];
+  {
+    host::HostPreferences prefs;
+    TEST_CHECK(prefs.load(0x1234, value, 4));
+    TEST_CHECK(value[0] == 1 && value[3] == 4);
+    value[0] = 9;
+    prefs.save(0x1234, value, 4);
+    TEST_CHECK(!prefs.sync());
+    TEST_CHECK(read_file(path) == std::vector<uint8_t>(legacy, legacy + sizeof(legacy)));
+  }
+
+  rmdir(temp.c_str());
+  {
+    host::HostPreferences prefs;
+    TEST_CHECK(prefs.load(0x5678, value, 2));
+    TEST_CHECK(value[0] == 5 && value[1] == 6);
+  }
+  host::HostPreferences prefs;
+  TEST_CHECK(prefs.load(0x1234, value, 4));
+  TEST_CHECK(value[0] == 1);
+  return 0;
+}
+
+int run_test() {
+  App.pre_setup("test", "", "", "", "", false);
+  TEST_CHECK(test_saving_back_and_forth_writes_once() == 0);
+  TEST_CHECK(test_incomplete_batch_discarded() == 0);
+  TEST_CHECK(test_legacy_file_kept_if_not_converted() == 0);
+  TEST_CHECK(test_killed_during_sync() == 0);
+  return 0;
+}
@@ -0,0 +1,167 @@
+// Queued I2C transactions run in order, reads of consecutive registers are merged into one transfer. Sensors that
+// wait for a conversion read their result through the queue.
+
+#include "test_main.h"
+
+#include <cmath>
+#include <vector>
+
+#include "esphome/components/hmc5883l/hmc5883l.h"
+#include "esphome/components/i2c/i2c_bus_mock.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/components/sht4x/sht4x.h"
+#include "esphome/core/application.h"
+
+using namespace esphome;
+
+/// Mock bus that counts the transfers it is asked for.
+class CountingBus : public i2c::MockI2CBus {
+ public:
+  i2c::ErrorCode readv(uint8_t address, i2c::ReadBuffer *buffers, size_t cnt) override {
+    this->reads.push_back(cnt);
+    return MockI2CBus::readv(address, buffers, cnt);
+  }
+  i2c::ErrorCode writev(uint8_t address, i2c::WriteBuffer *buffers, size_t cnt, bool stop) override {
+    this->writes++;
+    return MockI2CBus::writev(address, buffers, cnt, stop);
+  }
+
+  /// Number of buffers of every readv() call.
+  std::vector<size_t> reads;
+  size_t writes{0};
+};
+
+static int test_merged_and_ordered() {
+  CountingBus bus;
+  bus.add_device(0x10);
+  bus.add_device(0x20);
+  for (uint8_t reg = 0; reg < 8; reg++) {
+    bus.set_register(0x10, reg, 0x10 + reg);
+    bus.set_register(0x20, reg, 0x20 + reg);
+  }
+
+  std::vector<int> order;
+  uint8_t data[8][2]{};
+  auto read = [&](int index, uint8_t address, uint8_t reg, bool auto_increment) {
+    i2c::I2CTransaction transaction;
+    transaction.address = address;
+    transaction.header[0] = reg;
+    transaction.header_len = 1;
+    transaction.read = {data[index], 2};
+    transaction.auto_increment = auto_increment;
+    transaction.callback = [&order, index](i2c::ErrorCode err) {
+      if (err == i2c::ERROR_OK)
+        order.push_back(index);
+    };
+    bus.submit(std::move(transaction));
+  };
+  read(0, 0x10, 0, true);
+  read(1, 0x10, 2, true);   // merged with 0
+  read(2, 0x10, 4, true);   // merged with 0 and 1
+  read(3, 0x20, 6, true);   // other device
+  read(4, 0x20, 0, true);   // not the next register
+  read(5, 0x20, 2, false);  // device doesn't increment
+  read(6, 0x30, 0, true);   // no device, still called
+
+  TEST_CHECK(order.empty());
+  bus.loop();
+  TEST_CHECK((order == std::vector<int>{0, 1, 2, 3, 4, 5}));
+  TEST_CHECK((bus.reads == std::vector<size_t>{3, 1, 1, 1}));
+  TEST_CHECK(bus.writes == 5);
+  TEST_CHECK(data[2][0] == 0x14 && data[2][1] == 0x15);
+  TEST_CHECK(data[3][0] == 0x26 && data[3][1] == 0x27);
+  TEST_CHECK(data[5][0] == 0x22 && data[5][1] == 0x23);
+  return 0;
+}
+
+static int test_hmc5883l() {
+  CountingBus bus;
+  // X = 100, Z = -200, Y = 300
+  const uint8_t registers[] = {0x00, 0x64, 0xFF, 0x38, 0x01, 0x2C};
+  for (uint8_t i = 0; i < sizeof(registers); i++)
+    bus.set_register(0x1E, 0x03 + i, registers[i]);
+
+  hmc5883l::HMC5883LComponent hmc;
+  hmc.set_i2c_bus(&bus);
+  hmc.set_i2c_address(0x1E);
+  hmc.set_range(hmc5883l::HMC5883L_RANGE_130_UT);
+  sensor::Sensor x, y, z;
+  hmc.set_x_sensor(&x);
+  hmc.set_y_sensor(&y);
+  hmc.set_z_sensor(&z);
+
+  hmc.update();
+  TEST_CHECK(!x.has_state());
+  bus.loop();
+  TEST_CHECK((bus.reads == std::vector<size_t>{3}));
+  TEST_CHECK(bus.writes == 1);
+  TEST_CHECK(std::fabs(x.state - 9.2f) < 0.001f);
+  TEST_CHECK(std::fabs(z.state + 18.4f) < 0.001f);
+  TEST_CHECK(std::fabs(y.state - 27.6f) < 0.001f);
+  return 0;
+}
+
+/// Sensirion CRC-8 of a data word.
+static uint8_t sensirion_crc(uint8_t msb, uint8_t lsb) {
+  uint8_t crc = 0xFF;
+  for (uint8_t byte : {msb, lsb}) {
+    crc ^= byte;
+    for (int bit = 0; bit < 8; bit++)
+      crc = crc & 0x80 ? (crc << 1) ^ 0x31 : crc << 1;
+  }
+  return crc;
+}
+
+static int test_sht4x() {
+  CountingBus bus;
+  // The high precision command 0xFD selects the result, which wraps around to register 0x02: 25 °C and 56.5 %
+  const uint8_t result[] = {0x66, 0x66, sensirion_crc(0x66, 0x66), 0x80, 0x00, sensirion_crc(0x80, 0x00)};
+  for (uint8_t i = 0; i < sizeof(result); i++)
+    bus.set_register(0x44, uint8_t(0xFD + i), result[i]);
+
+  sht4x::SHT4XComponent sht;
+  sht.set_i2c_bus(&bus);
+  sht.set_i2c_address(0x44);
+  sht.set_precision_value(sht4x::SHT4X_PRECISION_HIGH);
+  sht.set_heater_duty_value(0.0f);
+  sensor::Sensor temperature, humidity;
+  sht.set_temp_sensor(&temperature);
+  sht.set_humidity_sensor(&humidity);
+
+  // The command is sent from the bus loop, the result read 10 ms later without waiting in between
+  sht.update();
+  TEST_CHECK(bus.writes == 0);
+  bus.loop();
+  TEST_CHECK(bus.writes == 1 && bus.reads.empty());
+  test::advance_ms(9);
+  App.scheduler.call();
+  bus.loop();
+  TEST_CHECK(bus.reads.empty());
+  test::advance_ms(1);
+  App.scheduler.call();
+  TEST_CHECK(!temperature.has_state());
+  bus.loop();
+  TEST_CHECK((bus.reads == std::vector<size_t>{1}));
+  TEST_CHECK(std::fabs(temperature.state - 25.0f) < 0.01f);
+  TEST_CHECK(std::fabs(humidity.state - 56.5f) < 0.01f);
+
+  // A corrupted word publishes nothing
+  bus.set_register(0x44, 0x02, result[5] ^ 1);
+  bus.set_register(0x44, 0x00, 0x90);
+  sht.update();
+  bus.loop();
+  test::advance_ms(10);
+  App.scheduler.call();
+  bus.loop();
+  TEST_CHECK(bus.reads.size() == 2);
+  TEST_CHECK(std::fabs(temperature.state - 25.0f) < 0.01f);
+  TEST_CHECK(std::fabs(humidity.state - 56.5f) < 0.01f);
+  return 0;
+}
+
+int run_test() {
+  TEST_CHECK(test_merged_and_ordered() == 0);
+  TEST_CHECK(test_hmc5883l() == 0);
+  TEST_CHECK(test_sht4x() == 0);
+  return 0;
+}
@@ -0,0 +1,330 @@
+// A power cut at any point of a sync() of the log preferences must leave every key with its old or its new value,
+// damaged records must not take down the rest of the store. Prints the wear of a typical workload.
+
+#include "test_main.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <vector>
+
+#include "esphome/components/preferences/log_preferences.h"
+
+using namespace esphome;
+
+/// Flash in RAM with NOR semantics, which loses power after a given number of programmed bytes.
+class RamFlash : public preferences::LogFlash {
+ public:
+  RamFlash(size_t sector_size, size_t sector_count)
+      : data(sector_size * sector_count, 0xFF), erases(sector_count, 0), sector_size_(sector_size),
+        sector_count_(sector_count) {}
+
+  size_t get_sector_size() const override { return this->sector_size_; }
+  size_t get_sector_count() const override { return this->sector_count_; }
+  bool read(size_t offset, void *data, size_t len) override {
+    if (this->cut || offset + len > this->data.size())
+      return false;
+    memcpy(data, this->data.data() + offset, len);
+    return true;
+  }
+  bool write(size_t offset, const void *data, size_t len) override {
+    if (this->cut || offset + len > this->data.size())
+      return false;
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < len; i++) {
+      if (!this->use_budget_())
+        return false;
+      uint8_t &byte = this->data[offset + i];
+      if (byte != 0xFF && bytes[i] != 0xFF)
+        this->programmed_twice = true;
+      byte &= bytes[i];
+      this->ops++;
+    }
+    return true;
+  }
+  bool erase(size_t sector) override {
+    if (this->cut || sector >= this->sector_count_)
+      return false;
+    uint8_t *begin = this->data.data() + sector * this->sector_size_;
+    if (!this->use_budget_()) {
+      // Cut in the middle of the erase, half of the sector is erased
+      std::fill(begin, begin + this->sector_size_ / 2, 0xFF);
+      return false;
+    }
+    std::fill(begin, begin + this->sector_size_, 0xFF);
+    this->erases[sector]++;
+    this->ops++;
+    return true;
+  }
+
+  /// Cut the power after `ops` more bytes written or sectors erased, negative to never cut it.
+  void cut_after(long ops) {
+    this->budget_ = ops;
+    this->cut = false;
+  }
+
+  std::vector<uint8_t> data;
+  std::vector<uint32_t> erases;
+  size_t ops{0};
+  bool cut{false};
+  bool programmed_twice{false};
+
+ protected:
+  bool use_budget_() {
+    if (this->budget_ == 0) {
+      this->cut = true;
+      return false;
+    }
+    if (this->budget_ > 0)
+      this->budget_--;
+    return true;
+  }
+
+  size_t sector_size_;
+  size_t sector_count_;
+  long budget_{-1};
+};
+
+class TestPreferences : public preferences::LogPreferences {
+ public:
+  using LogPreferences::LogPreferences;
+  using LogPreferences::count_free_sectors_;
+  using LogPreferences::index_;
+  using LogPreferences::sequences_;
+};
+
+using Values = std::map<uint32_t, std::vector<uint8_t>>;
+
+/// Value of `key` for `generation`, keys have different sizes.
+static std::vector<uint8_t> make_value(uint32_t key, uint32_t generation) {
+  std::vector<uint8_t> value(4 + key % 29);
+  for (size_t i = 0; i < value.size(); i++)
+    value[i] = uint8_t(key * 31 + generation * 7 + i);
+  return value;
+}
+
+static Values load_all(TestPreferences &prefs, const Values &expected) {
+  Values loaded;
+  for (auto &it : expected) {
+    std::vector<uint8_t> value(it.second.size());
+    if (prefs.load(it.first, value.data(), value.size()))
+      loaded[it.first] = value;
+  }
+  return loaded;
+}
+
+/// Check every key of a remounted store holds its old or its new value.
+static int check_old_or_new(RamFlash &flash, const Values &old_values, const Values &new_values) {
+  flash.cut_after(-1);
+  TestPreferences prefs(&flash);
+  TEST_CHECK(prefs.setup());
+  for (auto &it : new_values) {
+    std::vector<uint8_t> value(it.second.size());
+    const bool found = prefs.load(it.first, value.data(), value.size());
+    auto old = old_values.find(it.first);
+    if (found && value == it.second)
+      continue;
+    if (old == old_values.end() ? !found : found && value == old->second)
+      continue;
+    printf("key %u holds neither its old nor its new value\n", it.first);
+    return 1;
+  }
+  // The store keeps working after the cut
+  for (auto &it : new_values)
+    prefs.save(it.first, it.second.data(), it.second.size());
+  TEST_CHECK(prefs.sync());
+  TestPreferences remounted(&flash);
+  TEST_CHECK(load_all(remounted, new_values) == new_values);
+  TEST_CHECK(!flash.programmed_twice);
+  return 0;
+}
+
+/// Cut the power after every number of bytes the sync from `base` to `new_values` writes, check each outcome.
+static int cut_everywhere(const RamFlash &base, const Values &old_values, const Values &new_values, size_t step) {
+  RamFlash probe = base;
+  {
+    TestPreferences prefs(&probe);
+    for (auto &it : new_values)
+      prefs.save(it.first, it.second.data(), it.second.size());
+    probe.ops = 0;
+    TEST_CHECK(prefs.sync());
+  }
+  for (size_t cut = 0; cut < probe.ops; cut += step) {
+    RamFlash flash = base;
+    TestPreferences prefs(&flash);
+    TEST_CHECK(prefs.setup());
+    for (auto &it : new_values)
+      prefs.save(it.first, it.second.data(), it.second.size());
+    flash.cut_after(cut);
+    prefs.sync();
+    TEST_CHECK(flash.cut);
+    if (check_old_or_new(flash, old_values, new_values) != 0) {
+      printf("power cut after %zu of %zu ops\n", cut, probe.ops);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+static int test_torn_record() {
+  RamFlash base(1024, 8);
+  Values old_values;
+  {
+    TestPreferences prefs(&base);
+    for (uint32_t key = 1; key <= 10; key++) {
+      old_values[key] = make_value(key, 0);
+      prefs.save(key, old_values[key].data(), old_values[key].size());
+    }
+    TEST_CHECK(prefs.sync());
+  }
+  // Some keys change, one is new
+  Values new_values = old_values;
+  for (uint32_t key : {2, 5, 7, 11})
+    new_values[key] = make_value(key, 1);
+  TEST_CHECK(cut_everywhere(base, old_values, new_values, 1) == 0);
+  return 0;
+}
+
+/// Whether the sync of `values` to `flash` freed the oldest sector by copying its records still in use.
+static bool sync_compacts(RamFlash &flash, const Values &values, bool &compacted) {
+  TestPreferences prefs(&flash);
+  if (!prefs.setup())
+    return false;
+  auto oldest = prefs.sequences_.end();
+  for (auto it = prefs.sequences_.begin(); it != prefs.sequences_.end(); ++it) {
+    if (*it != 0 && (oldest == prefs.sequences_.end() || *it < *oldest))
+      oldest = it;
+  }
+  const uint32_t oldest_sequence = oldest == prefs.sequences_.end() ? 0 : *oldest;
+  for (auto &it : values)
+    prefs.save(it.first, it.second.data(), it.second.size());
+  if (!prefs.sync())
+    return false;
+  compacted = oldest_sequence != 0 && *oldest != oldest_sequence;
+  return true;
+}
+
+static int test_torn_compaction() {
+  RamFlash base(512, 6);
+  Values values;
+  // Sync changes of some keys until the next sync compacts a sector
+  for (uint32_t generation = 1;; generation++) {
+    TEST_CHECK(generation < 100);
+    Values new_values = values;
+    for (uint32_t key = 1; key <= 8; key++) {
+      if (key == 1 || key % 3 == generation % 3)
+        new_values[key] = make_value(key, generation);
+    }
+    RamFlash probe = base;
+    bool compacted = false;
+    TEST_CHECK(sync_compacts(probe, new_values, compacted));
+    if (compacted) {
+      TEST_CHECK(cut_everywhere(base, values, new_values, 1) == 0);
+      return 0;
+    }
+    base = probe;
+    values = new_values;
+  }
+}
+
+static int test_bad_crc() {
+  RamFlash flash(1024, 4);
+  const std::vector<uint8_t> a1 = make_value(1, 1), a2 = make_value(1, 2), b = make_value(2, 1),
+                             c = make_value(3, 1);
+  uint32_t a2_offset;
+  {
+    TestPreferences prefs(&flash);
+    prefs.save(1, a1.data(), a1.size());
+    prefs.save(2, b.data(), b.size());
+    TEST_CHECK(prefs.sync());
+    prefs.save(1, a2.data(), a2.size());
+    TEST_CHECK(prefs.sync());
+    prefs.save(3, c.data(), c.size());
+    TEST_CHECK(prefs.sync());
+    a2_offset = prefs.index_[1].offset;
+  }
+  // A bit flipped in the newest value of key 1
+  flash.data[a2_offset] ^= 0x01;
+
+  TestPreferences prefs(&flash);
+  TEST_CHECK(prefs.setup());
+  std::vector<uint8_t> value(a1.size());
+  // Key 1 goes back to its previous value, key 2 written before is kept
+  TEST_CHECK(prefs.load(1, value.data(), value.size()) && value == a1);
+  value.resize(b.size());
+  TEST_CHECK(prefs.load(2, value.data(), value.size()) && value == b);
+  // The damaged record ended its sector, what came after it is dropped
+  value.resize(c.size());
+  TEST_CHECK(!prefs.load(3, value.data(), value.size()));
+
+  // New records don't go behind the damaged one
+  prefs.save(3, c.data(), c.size());
+  TEST_CHECK(prefs.sync());
+  TEST_CHECK(!flash.programmed_twice);
+  TestPreferences remounted(&flash);
+  TEST_CHECK(remounted.load(3, value.data(), value.size()) && value == c);
+  return 0;
+}
+
+static int test_random_cuts() {
+  RamFlash flash(1024, 8);
+  Values stored;
+  uint32_t seed = 1;
+  auto random = [&seed](uint32_t range) {
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 8) % range;
+  };
+  int cuts = 0;
+  for (uint32_t generation = 1; generation <= 1500; generation++) {
+    TestPreferences prefs(&flash);
+    TEST_CHECK(prefs.setup());
+    Values changed = stored;
+    for (int i = 0; i < 4; i++) {
+      const uint32_t key = 1 + random(30);
+      changed[key] = make_value(key, generation);
+      prefs.save(key, changed[key].data(), changed[key].size());
+    }
+    if (random(4) == 0) {
+      flash.cut_after(random(200));
+      prefs.sync();
+      if (flash.cut) {
+        cuts++;
+        TEST_CHECK(check_old_or_new(flash, stored, changed) == 0);
+      }
+      flash.cut_after(-1);
+    } else {
+      TEST_CHECK(prefs.sync());
+    }
+    stored = changed;
+  }
+  TEST_CHECK(cuts > 100);
+  return 0;
+}
+
+static void benchmark_wear() {
+  // 300 keys on 16 sectors of 4 KiB, 30 of them change before every sync
+  RamFlash flash(4096, 16);
+  TestPreferences prefs(&flash);
+  const uint32_t syncs = 5000;
+  for (uint32_t generation = 0; generation < syncs; generation++) {
+    for (uint32_t i = 0; i < 30; i++) {
+      const uint32_t key = (generation * 30 + i * 7) % 300;
+      auto value = make_value(key, generation);
+      prefs.save(key, value.data(), value.size());
+    }
+    prefs.sync();
+  }
+  auto range = std::minmax_element(flash.erases.begin(), flash.erases.end());
+  printf("%.1f records and %.3f erases per sync, %u to %u erases per sector\n",
+         double(prefs.get_record_count()) / syncs, double(prefs.get_erase_count()) / syncs, *range.first,
+         *range.second);
+}
+
+int run_test() {
+  TEST_CHECK(test_torn_record() == 0);
+  TEST_CHECK(test_torn_compaction() == 0);
+  TEST_CHECK(test_bad_crc() == 0);
+  TEST_CHECK(test_random_cuts() == 0);
+  benchmark_wear();
+  return 0;
+}
@@ -0,0 +1,45 @@
+// String arguments with a precision are encoded up to the precision, they need no terminator.
+
+#include "test_main.h"
+
+#include <cstdarg>
+#include <cstring>
+#include <vector>
+
+#include "esphome/components/logger/log_record.h"
+
+using namespace esphome;
+
+static std::vector<uint8_t> encode(const char *format, ...) {
+  uint8_t buffer[64];
+  va_list args;
+  va_start(args, format);
+  size_t len = logger::encode_log_record(buffer, sizeof(buffer), 5, "t", 1, 2, format, args);
+  va_end(args);
+  return {buffer, buffer + len};
+}
+
+int run_test() {
+  // Header: marker, level, format id, line and tag
+  const std::vector<uint8_t> header{logger::LOG_RECORD_MARKER, 5, 2, 0, 0, 0, 1, 1, 't'};
+  // Not terminated, followed by bytes that must not end up in the record
+  const char payload[8] = {'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h'};
+
+  auto record = encode("'%.*s'", 3, payload);
+  auto expected = header;
+  // Precision as zigzag varint, then the string
+  expected.insert(expected.end(), {6, 3, 'a', 'b', 'c'});
+  TEST_CHECK(record == expected);
+
+  record = encode("%.2s %s", payload, "xy");
+  expected = header;
+  expected.insert(expected.end(), {2, 'a', 'b', 2, 'x', 'y'});
+  TEST_CHECK(record == expected);
+
+  // The precision limits, it doesn't extend shorter strings
+  record = encode("%.10s", "xy");
+  expected = header;
+  expected.insert(expected.end(), {2, 'x', 'y'});
+  TEST_CHECK(record == expected);
+  return 0;
+}
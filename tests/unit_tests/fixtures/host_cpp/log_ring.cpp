@@ -0,0 +1,235 @@
+// Messages logged through the ring must reach the consumer complete and in order for each producer, or be counted as
+// dropped when the ring is full, also while the positions wrap around. Outside the thread sanitizer the time a caller
+// spends logging is compared with and without the ring.
+
+#include "test_main.h"
+
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdarg>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "esphome/components/logger/log_ring.h"
+#include "esphome/components/logger/logger.h"
+#include "esphome/core/log.h"
+
+using namespace esphome;
+using namespace esphome::logger;
+
+/// Ring whose positions start just below the 32 bit wrap.
+class WrappingRing : public LogRing {
+ public:
+  WrappingRing(size_t slots, size_t slot_size, uint32_t start) : LogRing(slots, slot_size) {
+    for (size_t i = 0; i <= this->mask_; i++)
+      this->slots_[i].sequence.store(start + ((i - start) & this->mask_), std::memory_order_relaxed);
+    this->enqueue_pos_.store(start, std::memory_order_relaxed);
+    this->dequeue_pos_ = start;
+  }
+};
+
+static bool push(LogRing &ring, const char *text) {
+  LogRingSlot *slot = ring.acquire();
+  if (slot == nullptr)
+    return false;
+  snprintf(slot->text, ring.get_slot_size() + 1, "%s", text);
+  ring.commit(slot);
+  return true;
+}
+
+static std::string pop(LogRing &ring) {
+  LogRingSlot *slot = ring.front();
+  if (slot == nullptr)
+    return "";
+  std::string text = slot->text;
+  ring.pop();
+  return text;
+}
+
+static int test_overflow() {
+  // Rounded up to a power of two
+  LogRing ring(6, 16);
+  TEST_CHECK(ring.get_slot_count() == 8 && ring.front() == nullptr);
+  for (int i = 0; i < 8; i++)
+    TEST_CHECK(push(ring, std::to_string(i).c_str()));
+  // Full, nothing is overwritten
+  TEST_CHECK(!push(ring, "x"));
+  TEST_CHECK(pop(ring) == "0");
+  TEST_CHECK(push(ring, "8") && !push(ring, "x"));
+  for (int i = 1; i <= 8; i++)
+    TEST_CHECK(pop(ring) == std::to_string(i));
+  TEST_CHECK(ring.front() == nullptr);
+
+  // A reserved slot holds back the ones committed after it
+  LogRingSlot *first = ring.acquire();
+  TEST_CHECK(push(ring, "second"));
+  TEST_CHECK(ring.front() == nullptr);
+  snprintf(first->text, 17, "first");
+  ring.commit(first);
+  TEST_CHECK(pop(ring) == "first" && pop(ring) == "second");
+  return 0;
+}
+
+static int test_wrap_around() {
+  for (uint32_t start : {0xFFFFFFF0u, 0xFFFFFFFDu, 0x7FFFFFFEu}) {
+    WrappingRing ring(4, 16, start);
+    int next_in = 0, next_out = 0;
+    // Keep the ring between empty and full while the positions go past the wrap
+    for (int round = 0; round < 16; round++) {
+      while (push(ring, std::to_string(next_in).c_str()))
+        next_in++;
+      TEST_CHECK(next_in - next_out == 4);
+      for (int i = 0; i < 1 + round % 4; i++)
+        TEST_CHECK(pop(ring) == std::to_string(next_out++));
+    }
+    while (ring.front() != nullptr)
+      TEST_CHECK(pop(ring) == std::to_string(next_out++));
+    TEST_CHECK(next_in == next_out);
+  }
+  return 0;
+}
+
+static int test_producers() {
+  static const int PRODUCERS = 4;
+  static const int MESSAGES = 50000;
+  LogRing ring(16, 32);
+  std::atomic<int> done{0};
+  std::atomic<uint32_t> dropped{0};
+  std::vector<std::thread> producers;
+  for (int p = 0; p < PRODUCERS; p++) {
+    producers.emplace_back([&ring, &done, &dropped, p]() {
+      for (int i = 0; i < MESSAGES; i++) {
+        LogRingSlot *slot = ring.acquire();
+        if (slot == nullptr) {
+          dropped.fetch_add(1, std::memory_order_relaxed);
+          std::this_thread::yield();
+          continue;
+        }
+        snprintf(slot->text, 33, "%d:%d:%08x", p, i, i * 2654435761u);
+        slot->level = p;
+        ring.commit(slot);
+        if (i % 64 == 0)
+          std::this_thread::yield();
+      }
+      done.fetch_add(1);
+    });
+  }
+
+  // The consumer, slower now and then so the ring fills up
+  std::vector<int> next(PRODUCERS, 0);
+  uint32_t received = 0;
+  bool ok = true;
+  while (true) {
+    const bool finished = done.load() == PRODUCERS;
+    LogRingSlot *slot = ring.front();
+    if (slot == nullptr) {
+      if (finished)
+        break;
+      std::this_thread::yield();
+      continue;
+    }
+    int p, i;
+    unsigned hash;
+    if (sscanf(slot->text, "%d:%d:%08x", &p, &i, &hash) != 3 || p != slot->level || p < 0 || p >= PRODUCERS ||
+        hash != i * 2654435761u || i < next[p]) {
+      printf("corrupt or reordered message '%s' after %d\n", slot->text, p >= 0 && p < PRODUCERS ? next[p] : -1);
+      ok = false;
+    } else {
+      next[p] = i + 1;
+    }
+    ring.pop();
+    if (++received % 1000 == 0)
+      std::this_thread::sleep_for(std::chrono::microseconds(200));
+  }
+  for (auto &producer : producers)
+    producer.join();
+  TEST_CHECK(ok);
+  // Every message either arrived or was counted
+  TEST_CHECK(received + dropped.load() == uint32_t(PRODUCERS * MESSAGES));
+  TEST_CHECK(received > 0);
+  printf("%" PRIu32 " messages received, %" PRIu32 " dropped\n", received, dropped.load());
+  return 0;
+}
+
+static void log_line(Logger &logger, const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  logger.log_vprintf_(ESPHOME_LOG_LEVEL_DEBUG, "sensor", 94, format, args);
+  va_end(args);
+}
+
+static int test_logger() {
+  Logger logger(0, 128);
+  logger.set_log_level("sensor", ESPHOME_LOG_LEVEL_DEBUG);
+  logger.init_log_ring(4);
+  std::vector<std::string> messages;
+  logger.add_on_log_callback([&messages](int level, const char *tag, const char *msg) { messages.push_back(msg); });
+  // Deferred until the loop
+  log_line(logger, "value %d", 1);
+  TEST_CHECK(messages.empty());
+  logger.loop();
+  TEST_CHECK(messages.size() == 1 && messages[0].find("[D][sensor:094]: value 1") != std::string::npos);
+  // The main task makes room instead of dropping
+  for (int i = 0; i < 10; i++)
+    log_line(logger, "value %d", i);
+  TEST_CHECK(messages.size() == 9 && logger.get_log_ring_dropped() == 0);
+  logger.loop();
+  TEST_CHECK(messages.size() == 11 && messages[10].find("value 9") != std::string::npos);
+  return 0;
+}
+
+#ifndef __SANITIZE_THREAD__
+/// Time a caller spends in a log call, with three subscribers building a packet each like the API, web_server and MQTT.
+static double ns_per_call(bool ring, double *drain_ns) {
+  Logger logger(0, 256);
+  logger.set_log_level("sensor", ESPHOME_LOG_LEVEL_DEBUG);
+  if (ring)
+    logger.init_log_ring(64);
+  std::string packets[3];
+  for (auto &packet : packets) {
+    logger.add_on_log_callback([&packet](int level, const char *tag, const char *msg) {
+      packet.assign("{\"level\":");
+      packet += std::to_string(level);
+      packet += ",\"tag\":\"";
+      packet += tag;
+      packet += "\",\"message\":\"";
+      packet += msg;
+      packet += "\"}";
+    });
+  }
+  std::chrono::steady_clock::duration in_call{}, in_loop{};
+  for (int round = 0; round < 2000; round++) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 32; i++)
+      log_line(logger, "'%s': Sending state %.5f %s with %d decimals of accuracy", "Temperature", 23.45f + i, "°C", 1);
+    auto logged = std::chrono::steady_clock::now();
+    if (ring)
+      logger.loop();
+    in_call += logged - start;
+    in_loop += std::chrono::steady_clock::now() - logged;
+  }
+  *drain_ns = std::chrono::duration<double, std::nano>(in_loop).count() / (2000 * 32);
+  return std::chrono::duration<double, std::nano>(in_call).count() / (2000 * 32);
+}
+
+static void benchmark() {
+  double drain_ns;
+  const double direct = ns_per_call(false, &drain_ns);
+  const double ring = ns_per_call(true, &drain_ns);
+  printf("log call: synchronous %.0f ns, ring %.0f ns plus %.0f ns per message in loop()\n", direct, ring, drain_ns);
+}
+#endif
+
+int run_test() {
+  TEST_CHECK(test_overflow() == 0);
+  TEST_CHECK(test_wrap_around() == 0);
+  TEST_CHECK(test_producers() == 0);
+  TEST_CHECK(test_logger() == 0);
+#ifndef __SANITIZE_THREAD__
+  benchmark();
+#endif
+  return 0;
+}
@@ -0,0 +1,322 @@
+// ADUs received over Modbus TCP must only reach the devices when their PDU is long enough for its function code. The
+// server keeps at most max_connections clients and the client notices when its connect finished, over loopback sockets.
+
+#include "test_main.h"
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+#include "esphome/components/modbus_tcp/modbus_tcp.h"
+
+using namespace esphome;
+
+/// Connected socket that reads queued bytes and accepts all writes.
+class FakeSocket : public socket::Socket {
+ public:
+  explicit FakeSocket(std::deque<uint8_t> *rx) : rx_(rx) {}
+  std::unique_ptr<Socket> accept(struct sockaddr *addr, socklen_t *addrlen) override { return nullptr; }
+  int bind(const struct sockaddr *addr, socklen_t addrlen) override { return 0; }
+  int close() override { return 0; }
+  int connect(const struct sockaddr *addr, socklen_t addrlen) override { return 0; }
+  int shutdown(int how) override { return 0; }
+  int getpeername(struct sockaddr *addr, socklen_t *addrlen) override { return 0; }
+  std::string getpeername() override { return "peer"; }
+  int getsockname(struct sockaddr *addr, socklen_t *addrlen) override { return 0; }
+  std::string getsockname() override { return "local"; }
+  int getsockopt(int level, int optname, void *optval, socklen_t *optlen) override {
+    memset(optval, 0, *optlen);
+    return 0;
+  }
+  int setsockopt(int level, int optname, const void *optval, socklen_t optlen) override { return 0; }
+  int listen(int backlog) override { return 0; }
+  ssize_t read(void *buf, size_t len) override {
+    if (this->rx_->empty()) {
+      errno = EWOULDBLOCK;
+      return -1;
+    }
+    size_t count = 0;
+    for (; count < len && !this->rx_->empty(); count++) {
+      static_cast<uint8_t *>(buf)[count] = this->rx_->front();
+      this->rx_->pop_front();
+    }
+    return count;
+  }
+  ssize_t recvfrom(void *buf, size_t len, sockaddr *addr, socklen_t *addr_len) override { return -1; }
+  ssize_t readv(const struct iovec *iov, int iovcnt) override { return -1; }
+  ssize_t write(const void *buf, size_t len) override { return len; }
+  ssize_t writev(const struct iovec *iov, int iovcnt) override {
+    ssize_t total = 0;
+    for (int i = 0; i < iovcnt; i++)
+      total += iov[i].iov_len;
+    return total;
+  }
+  ssize_t sendto(const void *buf, size_t len, int flags, const struct sockaddr *to, socklen_t tolen) override {
+    return len;
+  }
+  int setblocking(bool blocking) override { return 0; }
+
+ protected:
+  std::deque<uint8_t> *rx_;
+};
+
+class RecordingDevice : public modbus::ModbusDevice {
+ public:
+  void on_modbus_data(const std::vector<uint8_t> &data) override { this->frames.push_back(data); }
+  void on_modbus_error(uint8_t function_code, uint8_t exception_code) override {
+    this->errors.push_back(exception_code);
+  }
+  void on_modbus_read_registers(uint8_t function_code, uint16_t start_address,
+                                uint16_t number_of_registers) override {
+    this->reads.push_back(number_of_registers);
+  }
+  std::vector<std::vector<uint8_t>> frames;
+  std::vector<uint8_t> errors;
+  std::vector<uint16_t> reads;
+};
+
+class TestModbusTCP : public modbus_tcp::ModbusTCP {
+ public:
+  /// Attach a connection that reads from `rx`, as if it was accepted or connected.
+  void attach(std::deque<uint8_t> *rx) {
+    this->connections_.push_back({std::unique_ptr<socket::Socket>(new FakeSocket(rx)), {}});
+    this->connected_ = true;
+  }
+  bool read_all() { return this->read_(this->connections_.front()); }
+  size_t connection_count() const { return this->connections_.size(); }
+  bool is_connected() const { return this->connected_; }
+  uint16_t server_port() {
+    struct sockaddr_in addr;
+    socklen_t len = sizeof(addr);
+    this->server_->getsockname((struct sockaddr *) &addr, &len);
+    return ntohs(addr.sin_port);
+  }
+};
+
+/// Blocking loopback socket, connected to `port` or listening on a free port if `port` is 0.
+static int loopback_socket(uint16_t port) {
+  int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+  struct sockaddr_in addr {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(port);
+  if (port != 0) {
+    if (::connect(fd, (struct sockaddr *) &addr, sizeof(addr)) != 0)
+      return -1;
+  } else if (::bind(fd, (struct sockaddr *) &addr, sizeof(addr)) != 0 || ::listen(fd, 4) != 0) {
+    return -1;
+  }
+  return fd;
+}
+
+static uint16_t local_port(int fd) {
+  struct sockaddr_in addr;
+  socklen_t len = sizeof(addr);
+  getsockname(fd, (struct sockaddr *) &addr, &len);
+  return ntohs(addr.sin_port);
+}
+
+/// Whether the server closed the connection of `fd`, without waiting for it.
+static bool closed_by_server(int fd) {
+  uint8_t byte;
+  return recv(fd, &byte, 1, MSG_DONTWAIT) == 0;
+}
+
+/// MBAP header for transaction 0 followed by `pdu`, which starts with the unit id.
+static void queue_adu(std::deque<uint8_t> &rx, const std::vector<uint8_t> &pdu) {
+  const uint8_t header[] = {0, 0, 0, 0, uint8_t(pdu.size() >> 8), uint8_t(pdu.size())};
+  rx.insert(rx.end(), header, header + sizeof(header));
+  rx.insert(rx.end(), pdu.begin(), pdu.end());
+}
+
+static int test_client() {
+  TestModbusTCP bus;
+  bus.set_role(modbus::CLIENT);
+  RecordingDevice device;
+  device.set_parent(&bus);
+  device.set_address(1);
+  bus.register_device(&device);
+  std::deque<uint8_t> rx;
+  bus.attach(&rx);
+
+  // Read response without byte count, with a byte count beyond the frame, and an exception without its code
+  queue_adu(rx, {0x01, 0x03});
+  queue_adu(rx, {0x01, 0x03, 0x04, 0x00, 0x0A});
+  bus.waiting_for_response = 1;
+  queue_adu(rx, {0x01, 0x83});
+  TEST_CHECK(bus.read_all());
+  TEST_CHECK(device.frames.empty());
+  TEST_CHECK(device.errors.empty());
+
+  // Complete frames still arrive after the dropped ones
+  queue_adu(rx, {0x01, 0x03, 0x04, 0x00, 0x0A, 0x00, 0x14});
+  TEST_CHECK(bus.read_all());
+  TEST_CHECK(device.frames.size() == 1);
+  TEST_CHECK((device.frames[0] == std::vector<uint8_t>{0x00, 0x0A, 0x00, 0x14}));
+  bus.waiting_for_response = 1;
+  queue_adu(rx, {0x01, 0x83, 0x02});
+  TEST_CHECK(bus.read_all());
+  TEST_CHECK((device.errors == std::vector<uint8_t>{0x02}));
+  return 0;
+}
+
+static int test_server() {
+  TestModbusTCP bus;
+  bus.set_role(modbus::SERVER);
+  RecordingDevice device;
+  device.set_parent(&bus);
+  device.set_address(1);
+  bus.register_device(&device);
+  std::deque<uint8_t> rx;
+  bus.attach(&rx);
+
+  // Read holding registers requests need a start address and a count
+  queue_adu(rx, {0x01, 0x03});
+  queue_adu(rx, {0x01, 0x03, 0x00, 0x10, 0x00});
+  TEST_CHECK(bus.read_all());
+  TEST_CHECK(device.reads.empty());
+
+  queue_adu(rx, {0x01, 0x04, 0x00, 0x10, 0x00, 0x02});
+  TEST_CHECK(bus.read_all());
+  TEST_CHECK((device.reads == std::vector<uint16_t>{2}));
+  return 0;
+}
+
+static int test_truncated_adu() {
+  TestModbusTCP bus;
+  bus.set_role(modbus::CLIENT);
+  RecordingDevice device;
+  device.set_parent(&bus);
+  device.set_address(1);
+  bus.register_device(&device);
+  std::deque<uint8_t> rx;
+  bus.attach(&rx);
+
+  // The MBAP length announces more than received so far, the rest arrives later
+  queue_adu(rx, {0x01, 0x03, 0x02, 0x12, 0x34});
+  std::deque<uint8_t> rest(rx.end() - 2, rx.end());
+  rx.erase(rx.end() - 2, rx.end());
+  TEST_CHECK(bus.read_all());
+  TEST_CHECK(device.frames.empty());
+  rx = rest;
+  TEST_CHECK(bus.read_all());
+  TEST_CHECK((device.frames == std::vector<std::vector<uint8_t>>{{0x12, 0x34}}));
+
+  // Lengths below unit id and function code close the connection
+  queue_adu(rx, {0x01});
+  TEST_CHECK(!bus.read_all());
+  return 0;
+}
+
+static int test_max_connections() {
+  TestModbusTCP bus;
+  bus.set_role(modbus::SERVER);
+  bus.set_port(0);
+  bus.set_max_connections(2);
+  bus.setup();
+  TEST_CHECK(!bus.is_failed());
+  const uint16_t port = bus.server_port();
+
+  int clients[3];
+  for (int &client : clients) {
+    client = loopback_socket(port);
+    TEST_CHECK(client != -1);
+  }
+  bus.loop();
+  // The third client is turned away instead of being kept without a limit
+  TEST_CHECK(bus.connection_count() == 2);
+  TEST_CHECK(!closed_by_server(clients[0]));
+  TEST_CHECK(!closed_by_server(clients[1]));
+  TEST_CHECK(closed_by_server(clients[2]));
+  close(clients[2]);
+
+  // A closed connection makes room for the next client
+  close(clients[0]);
+  bus.loop();
+  TEST_CHECK(bus.connection_count() == 1);
+  clients[0] = loopback_socket(port);
+  bus.loop();
+  TEST_CHECK(bus.connection_count() == 2);
+  TEST_CHECK(!closed_by_server(clients[0]));
+  close(clients[0]);
+  close(clients[1]);
+  return 0;
+}
+
+static int test_connect() {
+  const int listener = loopback_socket(0);
+  TEST_CHECK(listener != -1);
+  const uint16_t port = local_port(listener);
+
+  TestModbusTCP bus;
+  bus.set_role(modbus::CLIENT);
+  bus.set_host("127.0.0.1");
+  bus.set_port(port);
+  bus.setup();
+  TEST_CHECK(bus.connection_count() == 1);
+  for (int i = 0; i < 100 && !bus.is_connected(); i++) {
+    usleep(1000);
+    bus.loop();
+  }
+  TEST_CHECK(bus.is_connected());
+  TEST_CHECK(bus.connection_count() == 1);
+
+  // With the backlog of the listener full the handshake doesn't finish, which must not count as connected
+  const int full = ::socket(AF_INET, SOCK_STREAM, 0);
+  struct sockaddr_in addr {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  TEST_CHECK(::bind(full, (struct sockaddr *) &addr, sizeof(addr)) == 0 && ::listen(full, 0) == 0);
+  const uint16_t full_port = local_port(full);
+  int waiting[3];
+  for (int &fd : waiting) {
+    fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    fcntl(fd, F_SETFL, O_NONBLOCK);
+    addr.sin_port = htons(full_port);
+    ::connect(fd, (struct sockaddr *) &addr, sizeof(addr));
+  }
+  TestModbusTCP pending;
+  pending.set_role(modbus::CLIENT);
+  pending.set_host("127.0.0.1");
+  pending.set_port(full_port);
+  pending.setup();
+  for (int i = 0; i < 20; i++) {
+    usleep(1000);
+    pending.loop();
+  }
+  TEST_CHECK(pending.connection_count() == 1);
+  TEST_CHECK(!pending.is_connected());
+  for (int fd : waiting)
+    close(fd);
+  close(full);
+
+  // Nothing listens on the port anymore, the refused connect is noticed instead of waiting for the timeout
+  close(listener);
+  TestModbusTCP refused;
+  refused.set_role(modbus::CLIENT);
+  refused.set_host("127.0.0.1");
+  refused.set_port(port);
+  refused.setup();
+  for (int i = 0; i < 100 && refused.connection_count() != 0; i++) {
+    usleep(1000);
+    refused.loop();
+  }
+  TEST_CHECK(refused.connection_count() == 0);
+  TEST_CHECK(!refused.is_connected());
+  return 0;
+}
+
+int run_test() {
+  TEST_CHECK(test_client() == 0);
+  TEST_CHECK(test_server() == 0);
+  TEST_CHECK(test_truncated_adu() == 0);
+  TEST_CHECK(test_max_connections() == 0);
+  TEST_CHECK(test_connect() == 0);
+  return 0;
+}
@@ -0,0 +1,96 @@
+// Publishes waiting for a backpressured broker connection must keep only the latest message per topic in the order
+// the topics were first queued, drop new topics once the queue is full, and keep whatever a flush could not send.
+
+#include "test_main.h"
+
+#include <string>
+#include <vector>
+
+#include "esphome/components/mqtt/mqtt_publish_queue.h"
+
+using namespace esphome;
+using namespace esphome::mqtt;
+
+static bool enqueue(MQTTPublishQueue &queue, const std::string &topic, const std::string &payload,
+                    bool retain = false) {
+  return queue.enqueue(topic.c_str(), payload.data(), payload.size(), 0, retain);
+}
+
+/// Broker connection accepting `accept` more publishes, recording them as topic=payload.
+struct Broker {
+  MQTTPublishQueue::publish_t publish() {
+    return [this](const MQTTPendingPublish &pending) {
+      if (this->accept == 0)
+        return false;
+      this->accept--;
+      this->sent.push_back(pending.topic + "=" + pending.payload + (pending.retain ? " retained" : ""));
+      return true;
+    };
+  }
+  size_t accept{0};
+  std::vector<std::string> sent;
+};
+
+static int test_coalescing() {
+  MQTTPublishQueue queue;
+  queue.set_max_size(4);
+  TEST_CHECK(enqueue(queue, "a/state", "1") && enqueue(queue, "b/state", "ON"));
+  TEST_CHECK(queue.contains("a/state") && !queue.contains("c/state"));
+  // The newer message replaces the older one in its place
+  TEST_CHECK(enqueue(queue, "a/state", "2", true) && enqueue(queue, "a/state", "3", true));
+  TEST_CHECK(queue.size() == 2 && queue.get_coalesced() == 2 && queue.get_dropped() == 0);
+  Broker broker;
+  broker.accept = 10;
+  TEST_CHECK(queue.flush(broker.publish()) == 2 && queue.empty());
+  TEST_CHECK((broker.sent == std::vector<std::string>{"a/state=3 retained", "b/state=ON"}));
+  return 0;
+}
+
+static int test_overflow() {
+  MQTTPublishQueue queue;
+  // Disabled, nothing is kept
+  TEST_CHECK(!enqueue(queue, "a/state", "1") && queue.empty() && queue.get_dropped() == 1);
+  queue.set_max_size(2);
+  TEST_CHECK(enqueue(queue, "a/state", "1") && enqueue(queue, "b/state", "1"));
+  TEST_CHECK(!enqueue(queue, "c/state", "1") && queue.get_dropped() == 2);
+  // A full queue still takes the newer message for a waiting topic
+  TEST_CHECK(enqueue(queue, "b/state", "2") && queue.size() == 2 && queue.get_coalesced() == 1);
+  Broker broker;
+  broker.accept = 10;
+  queue.flush(broker.publish());
+  TEST_CHECK((broker.sent == std::vector<std::string>{"a/state=1", "b/state=2"}));
+  return 0;
+}
+
+static int test_partial_flush() {
+  MQTTPublishQueue queue;
+  queue.set_max_size(8);
+  for (int i = 0; i < 5; i++)
+    enqueue(queue, "topic/" + std::to_string(i), std::to_string(i));
+  Broker broker;
+  // Nothing sent, nothing lost
+  TEST_CHECK(queue.flush(broker.publish()) == 0 && queue.size() == 5);
+  // Stops at the first refused publish and keeps the rest in order
+  broker.accept = 2;
+  TEST_CHECK(queue.flush(broker.publish()) == 2 && queue.size() == 3);
+  TEST_CHECK(!queue.contains("topic/1") && queue.contains("topic/2"));
+  // A topic sent meanwhile goes to the back, one still waiting is replaced in its place
+  TEST_CHECK(enqueue(queue, "topic/0", "new") && enqueue(queue, "topic/3", "new"));
+  broker.accept = 10;
+  TEST_CHECK(queue.flush(broker.publish()) == 4 && queue.empty());
+  const std::vector<std::string> expected = {"topic/0=0",   "topic/1=1", "topic/2=2",
+                                             "topic/3=new", "topic/4=4", "topic/0=new"};
+  TEST_CHECK(broker.sent == expected);
+  // Cleared on disconnect
+  enqueue(queue, "topic/0", "0");
+  queue.clear();
+  TEST_CHECK(queue.empty() && !queue.contains("topic/0"));
+  return 0;
+}
+
+int run_test() {
+  TEST_CHECK(test_coalescing() == 0);
+  TEST_CHECK(test_overflow() == 0);
+  TEST_CHECK(test_partial_flush() == 0);
+  return 0;
+}
@@ -0,0 +1,296 @@
+// Temperature conversions requested by the sensors of a 1-Wire bus must be merged into one skip-ROM broadcast, calling
+// every sensor back once the longest wait is over, the devices found by a search must only be stored when they
+// changed, and the stored devices must be confirmed by addressing them instead of searching.
+
+#include "test_main.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <vector>
+
+#include "esphome/components/one_wire/one_wire_bus.h"
+#include "esphome/core/helpers.h"
+
+using namespace esphome;
+using namespace esphome::one_wire;
+
+// Defined by the platforms, the host has no interrupts
+namespace esphome {
+InterruptLock::InterruptLock() {}
+InterruptLock::~InterruptLock() {}
+}  // namespace esphome
+
+/// Preferences in memory, counting the writes.
+class MemoryPreferences : public ESPPreferences {
+ public:
+  class Backend : public ESPPreferenceBackend {
+   public:
+    Backend(MemoryPreferences *parent, uint32_t type) : parent_(parent), type_(type) {}
+    bool save(const uint8_t *data, size_t len) override {
+      this->parent_->saves++;
+      this->parent_->data[this->type_].assign(data, data + len);
+      return true;
+    }
+    bool load(uint8_t *data, size_t len) override {
+      auto it = this->parent_->data.find(this->type_);
+      if (it == this->parent_->data.end() || it->second.size() != len)
+        return false;
+      std::copy(it->second.begin(), it->second.end(), data);
+      return true;
+    }
+
+   protected:
+    MemoryPreferences *parent_;
+    uint32_t type_;
+  };
+
+  ESPPreferenceObject make_preference(size_t length, uint32_t type, bool in_flash) override {
+    this->backends_.push_back(new Backend(this, type));  // NOLINT(cppcoreguidelines-owning-memory)
+    return ESPPreferenceObject(this->backends_.back());
+  }
+  ESPPreferenceObject make_preference(size_t length, uint32_t type) override {
+    return this->make_preference(length, type, false);
+  }
+  bool sync() override { return true; }
+  bool reset() override { return true; }
+
+  std::map<uint32_t, std::vector<uint8_t>> data;
+  int saves{0};
+
+ protected:
+  std::vector<Backend *> backends_;
+};
+
+static MemoryPreferences preferences;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+namespace esphome {
+ESPPreferences *global_preferences = &preferences;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+}  // namespace esphome
+
+/// A DS18B20 address with a valid CRC.
+static uint64_t address(uint8_t serial) {
+  uint8_t rom[8] = {0x28, serial, 0x01, 0x02, 0x03, 0x04, 0x05, 0};
+  rom[7] = crc8(rom, 7);
+  uint64_t value;
+  memcpy(&value, rom, sizeof(value));
+  return value;
+}
+
+/// Bus recording the bytes written after each reset, the search finds `present`. A selected present device answers
+/// with `scratch_pad`, anything else reads as the idle bus.
+class FakeBus : public OneWireBus {
+ public:
+  bool reset() override {
+    this->resets++;
+    this->selected_ = 0;
+    this->read_ = 0;
+    if (this->present.empty() || this->fail_reset)
+      return false;
+    this->writes.emplace_back();
+    return true;
+  }
+  void write8(uint8_t val) override { this->writes.back().push_back(val); }
+  void write64(uint64_t val) override { this->selected_ = val; }
+  uint8_t read8() override {
+    if (std::find(this->present.begin(), this->present.end(), this->selected_) == this->present.end())
+      return 0xFF;
+    return this->scratch_pad[this->read_++ % this->scratch_pad.size()];
+  }
+  uint64_t read64() override { return 0; }
+
+  void loop() { this->process_conversions_(); }
+  bool load(uint32_t hash) { return this->load_devices_(hash); }
+  void save() { this->save_devices_(); }
+  bool validate() { return this->validate_devices_(); }
+
+  std::vector<uint64_t> present;
+  // 25.0625 °C at 12 bits
+  std::vector<uint8_t> scratch_pad{0x91, 0x01, 0x4B, 0x46, 0x7F, 0xFF, 0x0F, 0x10, 0};
+  bool fail_reset{false};
+  int resets{0};
+  int searches{0};
+  std::vector<std::vector<uint8_t>> writes;
+
+ protected:
+  void reset_search() override {
+    this->searches++;
+    this->next_ = 0;
+  }
+  uint64_t search_int() override { return this->next_ < this->present.size() ? this->present[this->next_++] : 0; }
+
+  size_t next_{0};
+  uint64_t selected_{0};
+  size_t read_{0};
+};
+
+/// Conversion callbacks in the order they were called, -1 for a failed conversion.
+struct Calls {
+  std::function<void(bool)> callback(int sensor) {
+    return [this, sensor](bool success) { this->order.push_back(success ? sensor : -1); };
+  }
+  std::vector<int> order;
+};
+
+static const std::vector<uint8_t> CONVERT_ALL = {0xCC, 0x44};
+
+static int test_conversion() {
+  FakeBus bus;
+  bus.present = {address(1)};
+  Calls calls;
+
+  // Three sensors with different resolutions ask before the bus gets to it, one broadcast for all of them
+  bus.request_conversion(94, calls.callback(0));
+  bus.request_conversion(750, calls.callback(1));
+  bus.request_conversion(188, calls.callback(2));
+  bus.loop();
+  TEST_CHECK(bus.writes.size() == 1 && bus.writes[0] == CONVERT_ALL);
+  test::advance_ms(500);
+  bus.loop();
+  // A request while it converts joins, no second broadcast
+  bus.request_conversion(375, calls.callback(3));
+  test::advance_ms(249);
+  bus.loop();
+  TEST_CHECK(calls.order.empty());
+  // Called back together once the longest wait is over
+  test::advance_ms(1);
+  bus.loop();
+  TEST_CHECK((calls.order == std::vector<int>{0, 1, 2, 3}));
+  TEST_CHECK(bus.writes.size() == 1 && bus.resets == 1);
+  TEST_CHECK(bus.get_last_cycle_time() == 750);
+  bus.loop();
+  TEST_CHECK(calls.order.size() == 4 && bus.resets == 1);
+
+  // A joined request needing longer extends the wait
+  calls.order.clear();
+  bus.request_conversion(94, calls.callback(0));
+  bus.loop();
+  test::advance_ms(50);
+  bus.request_conversion(750, calls.callback(1));
+  test::advance_ms(699);
+  bus.loop();
+  TEST_CHECK(calls.order.empty());
+  test::advance_ms(1);
+  bus.loop();
+  TEST_CHECK((calls.order == std::vector<int>{0, 1}) && bus.writes.size() == 2);
+
+  // A sensor asking again from its callback starts the next conversion right away
+  calls.order.clear();
+  bus.request_conversion(94, [&bus, &calls](bool success) {
+    calls.order.push_back(0);
+    bus.request_conversion(94, calls.callback(1));
+  });
+  bus.loop();
+  test::advance_ms(94);
+  bus.loop();
+  TEST_CHECK((calls.order == std::vector<int>{0}) && bus.writes.size() == 4 && bus.writes[3] == CONVERT_ALL);
+  test::advance_ms(94);
+  bus.loop();
+  TEST_CHECK((calls.order == std::vector<int>{0, 1}));
+
+  // Without devices answering the reset, every request fails at once and the next ones try again
+  calls.order.clear();
+  bus.fail_reset = true;
+  bus.request_conversion(750, calls.callback(0));
+  bus.request_conversion(750, calls.callback(1));
+  bus.loop();
+  TEST_CHECK((calls.order == std::vector<int>{-1, -1}));
+  bus.fail_reset = false;
+  bus.request_conversion(94, calls.callback(2));
+  bus.loop();
+  test::advance_ms(94);
+  bus.loop();
+  TEST_CHECK((calls.order == std::vector<int>{-1, -1, 2}) && bus.writes.size() == 5);
+  return 0;
+}
+
+static int test_device_cache() {
+  const uint32_t hash = 0x1234;
+  FakeBus first;
+  first.present = {address(1), address(2), address(3)};
+  // Nothing stored on the first boot, the search result is stored once
+  TEST_CHECK(!first.load(hash));
+  first.search();
+  TEST_CHECK(first.get_devices() == first.present);
+  first.save();
+  TEST_CHECK(preferences.saves == 1);
+  first.search();
+  first.save();
+  TEST_CHECK(preferences.saves == 1);
+
+  // The next boot has the devices before searching
+  FakeBus second;
+  TEST_CHECK(second.load(hash) && second.get_devices() == first.present);
+  // A device was replaced, the new list is stored
+  second.present = {address(1), address(4), address(3)};
+  second.search();
+  second.save();
+  TEST_CHECK(preferences.saves == 2);
+  FakeBus third;
+  TEST_CHECK(third.load(hash) && third.get_devices() == second.present);
+
+  // Too many devices to store, the stored list is left as it was
+  third.present.clear();
+  for (uint8_t i = 0; i < 17; i++)
+    third.present.push_back(address(i));
+  third.search();
+  third.save();
+  TEST_CHECK(preferences.saves == 2 && third.get_devices().size() == 17);
+  // A device with a broken CRC isn't a device
+  third.present = {address(5), address(6) ^ (uint64_t(1) << 63)};
+  third.search();
+  TEST_CHECK((third.get_devices() == std::vector<uint64_t>{address(5)}));
+  // Another bus has its own list
+  FakeBus other;
+  TEST_CHECK(!other.load(hash + 1));
+  return 0;
+}
+
+static int test_validate_devices() {
+  const uint32_t hash = 0x5678;
+  FakeBus first;
+  first.present = {address(1), address(2), address(3)};
+  TEST_CHECK(!first.load(hash));
+  first.search();
+  first.save();
+
+  // Every stored device answers with a valid scratch pad, no search needed
+  FakeBus bus;
+  bus.scratch_pad[8] = crc8(bus.scratch_pad.data(), 8);
+  bus.present = first.present;
+  TEST_CHECK(bus.load(hash) && bus.validate());
+  TEST_CHECK(bus.searches == 0 && bus.resets == 3);
+  TEST_CHECK(bus.writes.size() == 3 && bus.writes[0] == std::vector<uint8_t>({0x55, 0xBE}));
+  TEST_CHECK(bus.get_devices() == first.present);
+
+  // One of them was removed
+  bus.present = {address(1), address(3)};
+  TEST_CHECK(!bus.validate());
+  // A device answering with a broken CRC, or a shorted bus reading all zeros, doesn't count
+  bus.present = first.present;
+  bus.scratch_pad[8] ^= 1;
+  TEST_CHECK(!bus.validate());
+  bus.scratch_pad.assign(9, 0);
+  TEST_CHECK(!bus.validate());
+  TEST_CHECK(bus.searches == 0);
+
+  // Models without a scratch pad can't be confirmed this way
+  uint8_t rom[8] = {0x01, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0};
+  rom[7] = crc8(rom, 7);
+  uint64_t serial_number;
+  memcpy(&serial_number, rom, sizeof(serial_number));
+  FakeBus other;
+  other.scratch_pad[8] = crc8(other.scratch_pad.data(), 8);
+  other.present = {serial_number};
+  other.search();
+  TEST_CHECK(!other.validate());
+  return 0;
+}
+
+int run_test() {
+  TEST_CHECK(test_conversion() == 0);
+  TEST_CHECK(test_device_cache() == 0);
+  TEST_CHECK(test_validate_devices() == 0);
+  return 0;
+}
@@ -0,0 +1,115 @@
+// The exposition of the Prometheus handler must group the samples of a metric under its TYPE line, escape the label
+// values, end with `# EOF` only for OpenMetrics, and come out the same however the response is chunked.
+
+#include "test_main.h"
+
+#include <string>
+
+#include "esphome/components/binary_sensor/binary_sensor.h"
+#include "esphome/components/prometheus/prometheus_handler.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/core/application.h"
+
+using namespace esphome;
+
+// setup() isn't called, the handler is never added to a server
+namespace esphome {
+namespace web_server_base {
+void WebServerBase::add_handler(AsyncWebHandler *handler) {}
+}  // namespace web_server_base
+}  // namespace esphome
+
+class TestPrometheus : public prometheus::PrometheusHandler {
+ public:
+  TestPrometheus() : prometheus::PrometheusHandler(nullptr) {}
+  void start() { this->build_targets_(); }
+};
+
+static const char *const EXPECTED =
+    "# TYPE esphome_sensor_value gauge\n"
+    "esphome_sensor_value{id=\"temp_inside\",name=\"Temp \\\"inside\\\"\",unit=\"°C\"} 21.5\n"
+    "# TYPE esphome_sensor_failed gauge\n"
+    "esphome_sensor_failed{id=\"temp_inside\",name=\"Temp \\\"inside\\\"\"} 0\n"
+    "esphome_sensor_failed{id=\"my\\\"id\",name=\"C:\\\\dir\"} 1\n"
+    "# TYPE esphome_binary_sensor_value gauge\n"
+    "esphome_binary_sensor_value{id=\"door\",name=\"Door\\nFront\"} 1\n"
+    "# TYPE esphome_binary_sensor_failed gauge\n"
+    "esphome_binary_sensor_failed{id=\"door\",name=\"Door\\nFront\"} 0\n"
+    "esphome_binary_sensor_failed{id=\"window\",name=\"Window\"} 1\n";
+
+/// Send a scrape and pull the body out in chunks of at most `chunk` bytes.
+static std::string scrape(TestPrometheus &handler, const char *accept, size_t chunk, String *content_type,
+                          bool *split_line) {
+  AsyncWebServerRequest request(HTTP_GET, "/metrics");
+  if (accept != nullptr)
+    request.setHeader("Accept", accept);
+  if (!handler.canHandle(&request))
+    return "";
+  handler.handleRequest(&request);
+  *content_type = request.response->content_type;
+  std::string body;
+  uint8_t buf[4096];
+  size_t len;
+  while ((len = request.response->filler(buf, chunk, body.size())) != 0) {
+    body.append(reinterpret_cast<char *>(buf), len);
+    if (body.back() != '\n')
+      *split_line = true;
+  }
+  // Once everything was written, nothing follows
+  if (request.response->filler(buf, chunk, body.size()) != 0)
+    return "";
+  return body;
+}
+
+int run_test() {
+  sensor::Sensor temp, path, hidden;
+  temp.set_name("Temp \"inside\"");
+  temp.set_object_id("temp_inside");
+  temp.set_unit_of_measurement("°C");
+  temp.set_accuracy_decimals(1);
+  temp.state = 21.5f;
+  // No state, only its failed sample is written
+  path.set_name("C:\\dir");
+  path.set_object_id("path");
+  hidden.set_name("Hidden");
+  hidden.set_object_id("hidden");
+  hidden.set_internal(true);
+  hidden.state = 1.0f;
+  binary_sensor::BinarySensor door, window;
+  door.set_name("Door");
+  door.set_object_id("door");
+  door.publish_state(true);
+  window.set_name("Window");
+  window.set_object_id("window");
+  App.register_sensor(&temp);
+  App.register_sensor(&path);
+  App.register_sensor(&hidden);
+  App.register_binary_sensor(&door);
+  App.register_binary_sensor(&window);
+
+  TestPrometheus handler;
+  handler.add_label_id(&path, "my\"id");
+  handler.add_label_name(&door, "Door\nFront");
+  handler.start();
+
+  AsyncWebServerRequest post(HTTP_POST, "/metrics");
+  TEST_CHECK(!handler.canHandle(&post));
+
+  for (size_t chunk : {1, 7, 64, 4096}) {
+    String content_type;
+    bool split_line = false;
+    const std::string text = scrape(handler, nullptr, chunk, &content_type, &split_line);
+    if (text != EXPECTED) {
+      printf("chunks of %zu bytes:\n%s", chunk, text.c_str());
+      return 1;
+    }
+    TEST_CHECK(content_type.indexOf("text/plain") == 0);
+    TEST_CHECK(split_line == (chunk < 4096));
+
+    const std::string open_metrics =
+        scrape(handler, "application/openmetrics-text; version=1.0.0", chunk, &content_type, &split_line);
+    TEST_CHECK(open_metrics == std::string(EXPECTED) + "# EOF\n");
+    TEST_CHECK(content_type.indexOf("application/openmetrics-text") == 0);
+  }
+  return 0;
+}
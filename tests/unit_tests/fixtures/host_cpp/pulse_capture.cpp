@@ -0,0 +1,274 @@
+// Square waves of 1 Hz to 100 kHz fed through the interrupt handlers of pulse_width and pulse_meter, with edges at
+// fractional microseconds, must come out as their mean pulse width and rate, without losing pulses to a slow loop. The
+// sample slot must never hand out a torn sample while another thread writes it.
+
+#include "test_main.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <thread>
+
+#include "esphome/components/pulse_meter/pulse_meter_sensor.h"
+#include "esphome/components/pulse_width/pulse_width.h"
+
+using namespace esphome;
+
+/// Input pin whose level the simulation sets before calling the interrupt handler.
+class FakePin : public InternalGPIOPin {
+ public:
+  void setup() override {}
+  void pin_mode(gpio::Flags flags) override {}
+  bool digital_read() override { return this->level; }
+  void digital_write(bool value) override { this->level = value; }
+  std::string dump_summary() const override { return "fake"; }
+  void detach_interrupt() const override {}
+  ISRInternalGPIOPin to_isr() const override { return ISRInternalGPIOPin(const_cast<FakePin *>(this)); }
+  uint8_t get_pin() const override { return 4; }
+  bool is_inverted() const override { return false; }
+
+  /// Set the level, calling the interrupt handler if it was attached to this edge.
+  void set_level(bool level) {
+    this->level = level;
+    const auto edge = level ? gpio::INTERRUPT_RISING_EDGE : gpio::INTERRUPT_FALLING_EDGE;
+    if (this->handler_ != nullptr && (this->type_ == gpio::INTERRUPT_ANY_EDGE || this->type_ == edge))
+      this->handler_();
+  }
+
+  bool level{false};
+
+ protected:
+  void attach_interrupt(void (*func)(void *), void *arg, gpio::InterruptType type) const override {
+    auto *pin = const_cast<FakePin *>(this);
+    pin->handler_ = [func, arg]() { func(arg); };
+    pin->type_ = type;
+  }
+
+  std::function<void()> handler_;
+  gpio::InterruptType type_{gpio::INTERRUPT_ANY_EDGE};
+};
+
+namespace esphome {
+bool ISRInternalGPIOPin::digital_read() { return static_cast<FakePin *>(this->arg_)->level; }
+}  // namespace esphome
+
+/// Square wave on a pin, the clock of the test advances to every edge, truncated to whole microseconds.
+class SquareWave {
+ public:
+  SquareWave(FakePin *pin, double frequency, double duty) : pin_(pin), period_us_(1e6 / frequency), duty_(duty) {}
+
+  /// Run the wave for `duration_us`, calling `loop` every `loop_us`. Returns the number of rising edges.
+  uint32_t run(double duration_us, double loop_us, const std::function<void()> &loop) {
+    uint32_t rising = 0;
+    double next_loop = this->now_ + loop_us;
+    const double end = this->now_ + duration_us;
+    while (true) {
+      const double edge = this->rise_ + (this->pin_->level ? this->period_us_ * this->duty_ : this->period_us_);
+      const double next = std::min(edge, next_loop);
+      if (next > end)
+        break;
+      this->advance_to_(next);
+      if (next == next_loop) {
+        loop();
+        next_loop += loop_us;
+        continue;
+      }
+      if (!this->pin_->level) {
+        this->rise_ = edge;
+        rising++;
+      }
+      this->pin_->set_level(!this->pin_->level);
+    }
+    this->advance_to_(end);
+    return rising;
+  }
+
+ protected:
+  void advance_to_(double t) {
+    this->now_ = t;
+    const uint64_t us = uint64_t(t + 0.3);
+    if (us > this->clock_us_) {
+      test::advance_us(us - this->clock_us_);
+      this->clock_us_ = us;
+    }
+  }
+
+  FakePin *pin_;
+  double period_us_;
+  double duty_;
+  // Times in µs since the start of the simulation, the first rising edge comes after one period
+  double now_{0};
+  double rise_{0};
+  uint64_t clock_us_{0};
+};
+
+static const double FREQUENCIES[] = {1, 7, 100, 3333, 10000, 33333, 100000};
+static const double DUTIES[] = {0.1, 0.5, 0.9};
+
+class TestPulseWidth : public pulse_width::PulseWidthSensorStore {};
+
+static int test_pulse_width() {
+  double worst = 0;
+  for (double frequency : FREQUENCIES) {
+    for (double duty : DUTIES) {
+      FakePin pin;
+      TestPulseWidth store;
+      store.setup(&pin);
+      pulse_capture::PulseAnalyzer analyzer;
+      SquareWave wave(&pin, frequency, duty);
+      // Ten windows as the sensor would take them on update, at least a few pulses each
+      const double window_us = std::max(1e5, 5e6 / frequency);
+      wave.run(window_us, window_us, []() {});
+      analyzer.update(store.get_sample());
+      for (int i = 0; i < 10; i++) {
+        wave.run(window_us, window_us, []() {});
+        const pulse_capture::PulseWindow window = analyzer.update(store.get_sample());
+        const double expected = 1e6 / frequency * duty;
+        const double error = std::fabs(window.get_mean_high_us() - expected);
+        worst = std::max(worst, error);
+        // Whole microseconds, averaged over the pulses of the window
+        if (window.pulses == 0 || error > 0.5) {
+          printf("%.0f Hz, duty %.1f: mean width %f us, expected %f us\n", frequency, duty,
+                 window.get_mean_high_us(), expected);
+          return 1;
+        }
+      }
+    }
+  }
+  printf("pulse_width: worst error of the mean width %.3f us\n", worst);
+  return 0;
+}
+
+/// Two pulses of 100 and 300 µs, published as the last or the mean width.
+static int test_pulse_width_mode() {
+  for (auto mode : {pulse_width::PulseWidthSensor::MODE_LAST, pulse_width::PulseWidthSensor::MODE_MEAN}) {
+    FakePin pin;
+    pulse_width::PulseWidthSensor sensor;
+    sensor.set_pin(&pin);
+    sensor.set_mode(mode);
+    sensor.setup();
+    for (uint32_t width : {100, 300}) {
+      test::advance_us(1000);
+      pin.set_level(true);
+      test::advance_us(width);
+      pin.set_level(false);
+    }
+    sensor.update();
+    const float expected = mode == pulse_width::PulseWidthSensor::MODE_MEAN ? 200e-6f : 300e-6f;
+    TEST_CHECK(std::fabs(sensor.get_state() - expected) < 1e-9f);
+    // No pulse ended since, both report the last one
+    sensor.update();
+    TEST_CHECK(std::fabs(sensor.get_state() - 300e-6f) < 1e-9f);
+  }
+  return 0;
+}
+
+/// Slot whose write can be stopped halfway, as if the interrupt handler was still running on the other core.
+class TestSlot : public pulse_capture::PulseSampleSlot {
+ public:
+  void begin_write(uint32_t time_us) {
+    this->sequence_.store(this->sequence_.load() + 1);
+    this->time_us_.store(time_us);
+  }
+  void end_write(uint32_t pulses, uint32_t high_us) {
+    this->pulses_.store(pulses);
+    this->high_us_.store(high_us);
+    this->sequence_.store(this->sequence_.load() + 1);
+  }
+};
+
+/// A writer thread publishing samples whose fields depend on each other, the reader must only see whole ones.
+static int test_slot_threads() {
+  TestSlot half_written;
+  half_written.write(1, 3, ~1u);
+  half_written.begin_write(2);
+  std::atomic<bool> read{false};
+  pulse_capture::PulseSample result;
+  std::thread reader([&]() {
+    result = half_written.read();
+    read = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  // The reader waits for the write to finish instead of returning a mix of both samples
+  TEST_CHECK(!read);
+  half_written.end_write(6, ~2u);
+  reader.join();
+  TEST_CHECK(result.time_us == 2 && result.pulses == 6 && result.high_us == ~2u);
+
+  pulse_capture::PulseSampleSlot slot;
+  std::atomic<bool> done{false};
+  std::thread writer([&slot, &done]() {
+    for (uint32_t i = 1; i <= 2000000; i++)
+      slot.write(i, i * 3, ~i);
+    done = true;
+  });
+  uint32_t reads = 0;
+  uint32_t last = 0;
+  bool torn = false;
+  bool backwards = false;
+  while (!done) {
+    const pulse_capture::PulseSample sample = slot.read();
+    reads++;
+    if (sample.time_us == 0)
+      continue;
+    torn |= sample.pulses != sample.time_us * 3 || sample.high_us != ~sample.time_us;
+    backwards |= sample.time_us < last;
+    last = sample.time_us;
+  }
+  writer.join();
+  TEST_CHECK(!torn && !backwards && reads > 0);
+  const pulse_capture::PulseSample sample = slot.read();
+  TEST_CHECK(sample.time_us == 2000000 && sample.pulses == 6000000);
+  return 0;
+}
+
+class TestPulseMeter : public pulse_meter::PulseMeterSensor {
+ public:
+  uint32_t get_total() const { return this->total_pulses_; }
+};
+
+static int test_pulse_meter() {
+  double worst = 0;
+  for (auto mode : {pulse_meter::PulseMeterSensor::FILTER_EDGE, pulse_meter::PulseMeterSensor::FILTER_PULSE}) {
+    for (double frequency : FREQUENCIES) {
+      for (double duty : DUTIES) {
+        FakePin pin;
+        TestPulseMeter meter;
+        sensor::Sensor total;
+        meter.set_pin(&pin);
+        meter.set_filter_mode(mode);
+        meter.set_total_sensor(&total);
+        meter.setup();
+        SquareWave wave(&pin, frequency, duty);
+        // The loop runs every 16 ms, and stalls for half a second in between
+        uint32_t edges = wave.run(std::max(3e6, 20e6 / frequency), 16000, [&meter]() { meter.loop(); });
+        test::advance_ms(500);
+        edges += wave.run(std::max(2e6, 20e6 / frequency), 16000, [&meter]() { meter.loop(); });
+        meter.loop();
+        // In pulse mode a pulse is only counted once the input fell again
+        const uint32_t counted = meter.get_total();
+        if (counted > edges || edges - counted > 1) {
+          printf("mode %d, %.0f Hz, duty %.1f: counted %u of %u pulses\n", mode, frequency, duty, counted, edges);
+          return 1;
+        }
+        const double error = std::fabs(meter.get_state() / 60.0 - frequency) / frequency;
+        worst = std::max(worst, error);
+        if (error > 1e-3) {
+          printf("mode %d, %.0f Hz, duty %.1f: measured %f pulses/min\n", mode, frequency, duty, meter.get_state());
+          return 1;
+        }
+      }
+    }
+  }
+  printf("pulse_meter: worst relative rate error %.2e\n", worst);
+  return 0;
+}
+
+int run_test() {
+  TEST_CHECK(test_pulse_width() == 0);
+  TEST_CHECK(test_pulse_width_mode() == 0);
+  TEST_CHECK(test_slot_threads() == 0);
+  TEST_CHECK(test_pulse_meter() == 0);
+  return 0;
+}
@@ -0,0 +1,132 @@
+// A received frame must be decoded at most once per protocol however many listeners and dumpers ask for it.
+
+#include "test_main.h"
+
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+#include "esphome/components/remote_base/nec_protocol.h"
+#include "esphome/components/remote_base/rc5_protocol.h"
+
+using namespace esphome;
+using namespace esphome::remote_base;
+
+static const uint32_t TOLERANCE = 25;
+
+/// Encoded timings as a receiver sees them, with every mark and space off by up to `jitter` percent.
+template<typename T> static RawTimings encode(const typename T::ProtocolData &data, int jitter) {
+  RemoteTransmitData dst;
+  T().encode(&dst, data);
+  RawTimings timings = dst.get_data();
+  // The receiver sees the idle line after the frame as a long space
+  if (!timings.empty() && timings.back() < 0)
+    timings.pop_back();
+  timings.push_back(-20000);
+  for (auto &value : timings)
+    value = value * (100 + rand() % (2 * jitter + 1) - jitter) / 100;
+  return timings;
+}
+
+/// NEC counting how often the cache calls it.
+class CountingNEC : public NECProtocol {
+ public:
+  optional<NECData> decode(RemoteReceiveData src) override {
+    decodes++;
+    return NECProtocol::decode(src);
+  }
+  void dump(const NECData &data) override { dumps++; }
+
+  static int decodes;
+  static int dumps;
+};
+int CountingNEC::decodes = 0;
+int CountingNEC::dumps = 0;
+
+class TestReceiver : public RemoteReceiverBase {
+ public:
+  TestReceiver() : RemoteReceiverBase(nullptr) {}
+  void receive(const RawTimings &timings) {
+    this->temp_ = timings;
+    this->call_listeners_dumpers_();
+  }
+};
+
+class CountingTrigger : public RemoteReceiverTrigger<CountingNEC> {
+ public:
+  bool receive(const RemoteReceiveData &src) { return this->on_receive(src); }
+};
+
+class CountingBinarySensor : public RemoteReceiverBinarySensor<CountingNEC> {
+ public:
+  bool receive(const RemoteReceiveData &src) { return this->matches(src); }
+};
+
+/// Listener counting the frames it matched.
+class Counter : public RemoteReceiverListener {
+ public:
+  Counter(std::function<bool(const RemoteReceiveData &)> match) : match_(std::move(match)) {}
+  bool on_receive(RemoteReceiveData data) override {
+    if (!this->match_(data))
+      return false;
+    this->matched++;
+    return true;
+  }
+  int matched{0};
+
+ protected:
+  std::function<bool(const RemoteReceiveData &)> match_;
+};
+
+static int test_decode_once() {
+  TestReceiver receiver;
+  std::vector<CountingTrigger> triggers(10);
+  std::vector<CountingBinarySensor> sensors(10);
+  std::vector<Counter> counters;
+  for (uint16_t i = 0; i < 10; i++)
+    sensors[i].set_data({0x1234, uint16_t(0x5670 + i), 1});
+  for (size_t i = 0; i < 10; i++) {
+    counters.emplace_back([&triggers, i](const RemoteReceiveData &src) { return triggers[i].receive(src); });
+    counters.emplace_back([&sensors, i](const RemoteReceiveData &src) { return sensors[i].receive(src); });
+  }
+  for (auto &counter : counters)
+    receiver.register_listener(&counter);
+  RemoteReceiverDumper<CountingNEC> dumper;
+  receiver.register_dumper(&dumper);
+
+  // Twenty listeners and a dumper, one decode per frame
+  receiver.receive(encode<NECProtocol>({0x1234, 0x5678, 1}, 10));
+  TEST_CHECK(CountingNEC::decodes == 1 && CountingNEC::dumps == 1);
+  int matched = 0;
+  for (auto &counter : counters)
+    matched += counter.matched;
+  // Every trigger, and the one sensor with this command
+  TEST_CHECK(matched == 11);
+  TEST_CHECK(counters[2 * 8 + 1].matched == 1);
+
+  // The next frame is decoded again
+  receiver.receive(encode<NECProtocol>({0x1234, 0x5670, 1}, 10));
+  TEST_CHECK(CountingNEC::decodes == 2 && CountingNEC::dumps == 2);
+  TEST_CHECK(counters[1].matched == 1);
+
+  // A frame of another protocol is rejected once for everyone
+  receiver.receive(encode<RC5Protocol>({0x05, 0x0C}, 10));
+  TEST_CHECK(CountingNEC::decodes == 3 && CountingNEC::dumps == 2);
+  matched = 0;
+  for (auto &counter : counters)
+    matched += counter.matched;
+  TEST_CHECK(matched == 22);
+
+  // Without a receiver every call decodes
+  const RawTimings timings = encode<NECProtocol>({0x1234, 0x5678, 1}, 0);
+  const RemoteReceiveData src(timings, TOLERANCE, TOLERANCE_MODE_PERCENTAGE);
+  TEST_CHECK(triggers[0].receive(src) && triggers[1].receive(src));
+  TEST_CHECK(CountingNEC::decodes == 5);
+  return 0;
+}
+
+int run_test() {
+  srand(1);
+  TEST_CHECK(test_decode_once() == 0);
+  return 0;
+}
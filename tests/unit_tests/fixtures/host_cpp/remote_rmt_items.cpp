@@ -0,0 +1,139 @@
+// Encoding straight into RMT items must give the same items as converting the encoded timings afterwards, for any
+// clock divider and inversion, with timings too long for one item split over several.
+
+#include "test_main.h"
+
+#include <vector>
+
+#include "driver/rmt.h"
+#include "esphome/components/remote_base/nec_protocol.h"
+#include "esphome/components/remote_base/rc5_protocol.h"
+#include "esphome/components/remote_base/sony_protocol.h"
+
+using namespace esphome;
+using namespace esphome::remote_base;
+
+/// The conversion the ESP32 transmitter did on the whole frame before it was sent.
+static std::vector<rmt_item32_t> convert(const RawTimings &timings, uint32_t clock_divider, bool inverted) {
+  const uint32_t ticks_per_ten_us = 80000000u / clock_divider / 100000u;
+  std::vector<rmt_item32_t> items;
+  uint32_t rmt_i = 0;
+  rmt_item32_t rmt_item{};
+  for (int32_t val : timings) {
+    bool level = val >= 0;
+    if (!level)
+      val = -val;
+    val = static_cast<uint32_t>(val) * ticks_per_ten_us / 10;
+    do {
+      int32_t item = std::min(val, int32_t(32767));
+      val -= item;
+      if (rmt_i % 2 == 0) {
+        rmt_item.level0 = static_cast<uint32_t>(level ^ inverted);
+        rmt_item.duration0 = static_cast<uint32_t>(item);
+      } else {
+        rmt_item.level1 = static_cast<uint32_t>(level ^ inverted);
+        rmt_item.duration1 = static_cast<uint32_t>(item);
+        items.push_back(rmt_item);
+      }
+      rmt_i++;
+    } while (val != 0);
+  }
+  if (rmt_i % 2 == 1) {
+    rmt_item.level1 = 0;
+    rmt_item.duration1 = 0;
+    items.push_back(rmt_item);
+  }
+  return items;
+}
+
+static bool same(const std::vector<rmt_item32_t> &a, const std::vector<rmt_item32_t> &b) {
+  if (a.size() != b.size()) {
+    printf("%zu items instead of %zu\n", a.size(), b.size());
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); i++) {
+    if (a[i].val != b[i].val) {
+      printf("item %zu is %08x instead of %08x\n", i, a[i].val, b[i].val);
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Encode two frames into timings and the same two into items, and compare the items with the converted timings.
+template<typename T> static bool check(const typename T::ProtocolData &data, uint32_t clock_divider, bool inverted) {
+  // Some protocols alternate a toggle bit from one frame to the next
+  RemoteTransmitData first, second;
+  T().encode(&first, data);
+  T().encode(&second, data);
+
+  RemoteRMTItems items;
+  items.set_timebase(80000000u / clock_divider / 100000u, inverted);
+  RemoteTransmitData direct;
+  direct.set_rmt_items(&items);
+  T().encode(&direct, data);
+  if (!direct.get_data().empty())
+    return false;
+  if (!same(items.get_items(), convert(first.get_data(), clock_divider, inverted)))
+    return false;
+
+  // The next frame starts over, also after the first timing of an item
+  direct.reset();
+  T().encode(&direct, data);
+  if (!same(items.get_items(), convert(second.get_data(), clock_divider, inverted)))
+    return false;
+  // Raw timings given as a whole
+  direct.reset();
+  direct.set_data(first.get_data());
+  return same(items.get_items(), convert(first.get_data(), clock_divider, inverted));
+}
+
+static int test_protocols() {
+  for (uint32_t clock_divider : {40, 80, 160}) {
+    for (bool inverted : {false, true}) {
+      TEST_CHECK(check<NECProtocol>({0x1234, 0x5678, 1}, clock_divider, inverted));
+      TEST_CHECK(check<SonyProtocol>({0xA90, 12}, clock_divider, inverted));
+      // NEC ends on a mark, half of its last item is empty; RC5 alternates a toggle bit
+      TEST_CHECK(check<RC5Protocol>({0x05, 0x0C}, clock_divider, inverted));
+      TEST_CHECK(check<RC5Protocol>({0x1F, 0x3F}, clock_divider, inverted));
+    }
+  }
+  return 0;
+}
+
+static int test_long_timings() {
+  // The 110 ms space takes more than one timing of 32767 ticks at any clock divider
+  const RawTimings timings = {9000, -110000, 560, -40000, 1};
+  for (uint32_t clock_divider : {40, 80, 255}) {
+    RemoteRMTItems items;
+    items.set_timebase(80000000u / clock_divider / 100000u, false);
+    RemoteTransmitData data;
+    data.set_rmt_items(&items);
+    data.set_data(timings);
+    TEST_CHECK(same(items.get_items(), convert(timings, clock_divider, false)));
+  }
+  // 110 ms at 20 ticks per 10 us is seven timings
+  RemoteRMTItems items;
+  items.set_timebase(20, true);
+  for (int32_t value : timings)
+    items.append(value);
+  const std::vector<uint32_t> durations = {18000, 32767, 32767, 32767, 32767, 32767, 32767, 23398,
+                                           1120,  32767, 32767, 14466, 2,     0};
+  TEST_CHECK(items.get_items().size() * 2 == durations.size());
+  for (size_t i = 0; i < durations.size(); i++) {
+    const rmt_item32_t &item = items.get_items()[i / 2];
+    const uint32_t duration = i % 2 == 0 ? item.duration0 : item.duration1;
+    const uint32_t level = i % 2 == 0 ? item.level0 : item.level1;
+    TEST_CHECK(duration == durations[i]);
+    // Inverted, marks are low; the unused half of the last item stays zero
+    const uint32_t mark = i < 1 || i == 8 || i == 12;
+    TEST_CHECK(level == (i == 13 ? 0 : !mark));
+  }
+  return 0;
+}
+
+int run_test() {
+  TEST_CHECK(test_protocols() == 0);
+  TEST_CHECK(test_long_timings() == 0);
+  return 0;
+}
@@ -0,0 +1,287 @@
+// Submitted SPI transactions on ESP-IDF keep at most a queue of transfers in flight, switch the data/command pin for
+// every segment and hold the bus until all completed. Runs the ESP-IDF delegate against the fake driver below.
+
+#include "test_main.h"
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+#include "driver/gpio.h"
+#include "driver/spi_master.h"
+#include "esphome/components/spi/spi.h"
+
+using namespace esphome;
+
+/// Bytes the fake driver sent in one transfer.
+struct SentTransfer {
+  spi_device_handle_t device;
+  int dc;  ///< level of the data/command pin set by the pre-transfer callback, -1 if it wasn't set
+  std::vector<uint8_t> data;
+};
+
+struct FakeSpiDevice {
+  spi_device_interface_config_t config;
+  std::deque<spi_transaction_t *> in_flight;
+};
+
+namespace fake_idf {
+
+static spi_device_handle_t bus_owner = nullptr;
+/// Transfers the hardware finished, which spi_device_get_trans_result() returns without waiting.
+static size_t finished = 0;
+static size_t max_in_flight = 0;
+static int dc_pin = -1;
+static int dc_level = -1;
+static std::vector<SentTransfer> sent;
+/// Devices in the order they were added
+static std::vector<spi_device_handle_t> devices;
+static bool misuse = false;
+
+static void send(spi_device_handle_t device, spi_transaction_t *trans) {
+  dc_level = -1;
+  if (device->config.pre_cb != nullptr)
+    device->config.pre_cb(trans);
+  const auto *data = static_cast<const uint8_t *>(trans->tx_buffer);
+  sent.push_back({device, dc_level, std::vector<uint8_t>(data, data + trans->length / 8)});
+}
+
+}  // namespace fake_idf
+
+esp_err_t gpio_set_level(gpio_num_t gpio_num, uint32_t level) {
+  if (gpio_num == fake_idf::dc_pin)
+    fake_idf::dc_level = level;
+  return ESP_OK;
+}
+
+esp_err_t spi_bus_initialize(spi_host_device_t host, const spi_bus_config_t *config, int dma_chan) { return ESP_OK; }
+esp_err_t spi_bus_add_device(spi_host_device_t host, const spi_device_interface_config_t *config,
+                             spi_device_handle_t *handle) {
+  *handle = new FakeSpiDevice{*config, {}};
+  fake_idf::devices.push_back(*handle);
+  return ESP_OK;
+}
+esp_err_t spi_bus_remove_device(spi_device_handle_t handle) {
+  delete handle;
+  return ESP_OK;
+}
+esp_err_t spi_device_acquire_bus(spi_device_handle_t device, TickType_t wait) {
+  // Would block forever on the single task
+  if (fake_idf::bus_owner != nullptr)
+    fake_idf::misuse = true;
+  fake_idf::bus_owner = device;
+  return ESP_OK;
+}
+void spi_device_release_bus(spi_device_handle_t device) {
+  if (fake_idf::bus_owner != device || !device->in_flight.empty())
+    fake_idf::misuse = true;
+  fake_idf::bus_owner = nullptr;
+}
+esp_err_t spi_device_polling_start(spi_device_handle_t handle, spi_transaction_t *trans, TickType_t wait) {
+  if (!handle->in_flight.empty() || (fake_idf::bus_owner != nullptr && fake_idf::bus_owner != handle))
+    fake_idf::misuse = true;
+  fake_idf::send(handle, trans);
+  return ESP_OK;
+}
+esp_err_t spi_device_polling_end(spi_device_handle_t handle, TickType_t wait) { return ESP_OK; }
+esp_err_t spi_device_queue_trans(spi_device_handle_t handle, spi_transaction_t *trans, TickType_t wait) {
+  if (handle->in_flight.size() == size_t(handle->config.queue_size))
+    return ESP_ERR_TIMEOUT;
+  if (fake_idf::bus_owner != handle)
+    fake_idf::misuse = true;
+  handle->in_flight.push_back(trans);
+  fake_idf::max_in_flight = std::max(fake_idf::max_in_flight, handle->in_flight.size());
+  return ESP_OK;
+}
+esp_err_t spi_device_get_trans_result(spi_device_handle_t handle, spi_transaction_t **trans, TickType_t wait) {
+  if (handle->in_flight.empty())
+    return ESP_ERR_TIMEOUT;
+  if (fake_idf::finished == 0) {
+    if (wait == 0)
+      return ESP_ERR_TIMEOUT;
+    fake_idf::finished = 1;
+  }
+  fake_idf::finished--;
+  *trans = handle->in_flight.front();
+  handle->in_flight.pop_front();
+  fake_idf::send(handle, *trans);
+  return ESP_OK;
+}
+
+// helpers.cpp needs FreeRTOS on ESP-IDF, these are the parts the bus uses
+namespace esphome {
+Mutex::Mutex() {}
+void Mutex::lock() {}
+void Mutex::unlock() {}
+uint32_t random_uint32() { return 4; }
+bool HighFrequencyLoopRequester::is_high_frequency() { return false; }
+}  // namespace esphome
+
+class FakePin : public InternalGPIOPin {
+ public:
+  explicit FakePin(uint8_t pin) : pin_(pin) {}
+  void setup() override {}
+  void pin_mode(gpio::Flags flags) override {}
+  bool digital_read() override { return this->level; }
+  void digital_write(bool value) override {
+    if (this->level && !value)
+      this->asserted++;
+    this->level = value;
+  }
+  std::string dump_summary() const override { return "fake"; }
+  void detach_interrupt() const override {}
+  ISRInternalGPIOPin to_isr() const override { return {}; }
+  uint8_t get_pin() const override { return this->pin_; }
+  bool is_inverted() const override { return false; }
+
+  bool level{true};
+  int asserted{0};  ///< number of falling edges, the times CS was asserted
+
+ protected:
+  void attach_interrupt(void (*func)(void *), void *arg, gpio::InterruptType type) const override {}
+  uint8_t pin_;
+};
+
+using TestDevice = spi::SPIDevice<spi::BIT_ORDER_MSB_FIRST, spi::CLOCK_POLARITY_LOW, spi::CLOCK_PHASE_LEADING,
+                                  spi::DATA_RATE_40MHZ>;
+
+/// Bus with two devices sharing the data/command pin.
+struct Bus {
+  Bus() : clk(18), mosi(23), dc(5), cs_a(10), cs_b(11) {
+    fake_idf::dc_pin = 5;
+    fake_idf::sent.clear();
+    fake_idf::max_in_flight = 0;
+    fake_idf::finished = 0;
+    fake_idf::devices.clear();
+    component.set_clk(&clk);
+    component.set_mosi(&mosi);
+    component.set_interface(2);
+    component.setup();
+    a.set_spi_parent(&component);
+    a.set_cs_pin(&cs_a);
+    a.spi_setup();
+    b.set_spi_parent(&component);
+    b.set_cs_pin(&cs_b);
+    b.spi_setup();
+  }
+  ~Bus() {
+    a.spi_teardown();
+    b.spi_teardown();
+  }
+
+  FakePin clk, mosi, dc, cs_a, cs_b;
+  spi::SPIComponent component;
+  TestDevice a, b;
+};
+
+static std::vector<uint8_t> make_frame(size_t size) {
+  std::vector<uint8_t> frame(size);
+  for (size_t i = 0; i < size; i++)
+    frame[i] = uint8_t(i * 7 + i / 251);
+  return frame;
+}
+
+/// The bytes sent with each data/command level, merged in order.
+static std::vector<std::pair<int, std::vector<uint8_t>>> merge_sent() {
+  std::vector<std::pair<int, std::vector<uint8_t>>> merged;
+  for (auto &transfer : fake_idf::sent) {
+    if (merged.empty() || merged.back().first != transfer.dc)
+      merged.push_back({transfer.dc, {}});
+    merged.back().second.insert(merged.back().second.end(), transfer.data.begin(), transfer.data.end());
+  }
+  return merged;
+}
+
+static int test_queue() {
+  Bus bus;
+  // 10 transfers of at most 4092 bytes for the frame, after three short ones
+  const std::vector<uint8_t> frame = make_frame(40000);
+  spi::SPITransaction transaction(&bus.dc);
+  transaction.command(0x2A).data16(0x0000).data16(0x00EF).command(0x2C).data(frame.data(), frame.size());
+  int done = 0;
+  bus.a.submit_transaction(std::move(transaction), [&done]() { done++; });
+
+  // The queue of the driver is filled, nothing was sent yet
+  TEST_CHECK(fake_idf::max_in_flight == 8);
+  TEST_CHECK(fake_idf::sent.empty());
+  TEST_CHECK(bus.cs_a.asserted == 1 && !bus.cs_a.level);
+  bus.component.loop();
+  TEST_CHECK(done == 0 && fake_idf::sent.empty());
+
+  // Finished transfers are replaced from the loop, the callback runs once all are done
+  fake_idf::finished = 3;
+  bus.component.loop();
+  TEST_CHECK(fake_idf::sent.size() == 3 && done == 0);
+  TEST_CHECK(fake_idf::devices[0]->in_flight.size() == 8);
+  fake_idf::finished = 100;
+  bus.component.loop();
+  TEST_CHECK(fake_idf::sent.size() == 13 && done == 1);
+  TEST_CHECK(fake_idf::max_in_flight == 8);
+  TEST_CHECK(bus.cs_a.asserted == 1 && bus.cs_a.level);
+  TEST_CHECK(fake_idf::bus_owner == nullptr);
+
+  auto merged = merge_sent();
+  TEST_CHECK(merged.size() == 4);
+  TEST_CHECK(merged[0].first == 0 && merged[0].second == std::vector<uint8_t>{0x2A});
+  TEST_CHECK((merged[1].first == 1 && merged[1].second == std::vector<uint8_t>{0x00, 0x00, 0x00, 0xEF}));
+  TEST_CHECK(merged[2].first == 0 && merged[2].second == std::vector<uint8_t>{0x2C});
+  TEST_CHECK(merged[3].first == 1 && merged[3].second == frame);
+  for (auto &transfer : fake_idf::sent)
+    TEST_CHECK(transfer.data.size() <= 4092);
+  TEST_CHECK(!fake_idf::misuse);
+  return 0;
+}
+
+static int test_other_access_waits() {
+  Bus bus;
+  const std::vector<uint8_t> frame = make_frame(20000);
+  std::vector<int> order;
+  spi::SPITransaction transaction(&bus.dc);
+  transaction.command(0x2C).data(frame.data(), frame.size());
+  bus.a.submit_transaction(std::move(transaction), [&order]() { order.push_back(1); });
+  TEST_CHECK(fake_idf::sent.empty());
+
+  // A transaction of the other device on the bus first completes the pending one
+  spi::SPITransaction command(&bus.dc);
+  command.command(0x29);
+  bus.b.write_transaction(command);
+  order.push_back(2);
+  TEST_CHECK((order == std::vector<int>{1, 2}));
+  TEST_CHECK(fake_idf::sent.back().device != fake_idf::sent.front().device);
+  TEST_CHECK(fake_idf::sent.back().data == std::vector<uint8_t>{0x29});
+  TEST_CHECK(bus.cs_b.asserted == 1 && bus.cs_b.level);
+
+  // So does a plain write of the same device
+  spi::SPITransaction again(&bus.dc);
+  again.data(frame.data(), frame.size());
+  bus.a.submit_transaction(std::move(again));
+  const size_t before = fake_idf::sent.size();
+  bus.a.enable();
+  TEST_CHECK(fake_idf::sent.size() == before + 5);
+  bus.a.write_byte(0x55);
+  bus.a.disable();
+  TEST_CHECK(fake_idf::sent.back().data == std::vector<uint8_t>{0x55});
+  TEST_CHECK(!fake_idf::misuse);
+  return 0;
+}
+
+static int test_execute_blocks() {
+  Bus bus;
+  const std::vector<uint8_t> frame = make_frame(10000);
+  spi::SPITransaction transaction(&bus.dc);
+  transaction.command(0x2C).data(frame.data(), frame.size());
+  bus.a.write_transaction(transaction);
+  // Everything was sent and the bus released when it returns
+  TEST_CHECK(fake_idf::sent.size() == 4);
+  TEST_CHECK(fake_idf::bus_owner == nullptr);
+  TEST_CHECK(merge_sent()[1].second == frame);
+  TEST_CHECK(!fake_idf::misuse);
+  return 0;
+}
+
+int run_test() {
+  TEST_CHECK(test_queue() == 0);
+  TEST_CHECK(test_other_access_waits() == 0);
+  TEST_CHECK(test_execute_blocks() == 0);
+  return 0;
+}
@@ -0,0 +1,114 @@
+// The mock SPI bus of the host platform records transfers in the order they reach the bus, submitted ones complete
+// on the next loop and before any other access of their device.
+
+#include "test_main.h"
+
+#include <vector>
+
+#include "esphome/components/spi/spi.h"
+#include "esphome/components/spi/spi_mock.h"
+
+using namespace esphome;
+
+using TestDevice = spi::SPIDevice<spi::BIT_ORDER_MSB_FIRST, spi::CLOCK_POLARITY_LOW, spi::CLOCK_PHASE_LEADING,
+                                  spi::DATA_RATE_8MHZ>;
+
+struct Bus {
+  Bus() {
+    component.setup();
+    mock = static_cast<spi::MockSPIBus *>(component.get_spi_bus());
+    mock->set_record_limit(16);
+    device.set_spi_parent(&component);
+    device.spi_setup();
+  }
+  ~Bus() { device.spi_teardown(); }
+
+  spi::SPIComponent component;
+  spi::MockSPIBus *mock;
+  TestDevice device;
+};
+
+static int test_transaction() {
+  Bus bus;
+  spi::SPITransaction transaction;
+  transaction.command(0x2A).data16(0x0102).command(0x2C).data(0x03).data(0x04);
+  bus.device.write_transaction(transaction);
+
+  // One CS cycle with a segment per data/command level
+  const auto &transfers = bus.mock->get_transfers();
+  TEST_CHECK(transfers.size() == 1 && !transfers[0].queued);
+  const auto &segments = transfers[0].segments;
+  TEST_CHECK(segments.size() == 4);
+  TEST_CHECK(segments[0].dc == 0 && segments[0].data == std::vector<uint8_t>{0x2A});
+  TEST_CHECK((segments[1].dc == 1 && segments[1].data == std::vector<uint8_t>{0x01, 0x02}));
+  TEST_CHECK(segments[2].dc == 0 && segments[2].data == std::vector<uint8_t>{0x2C});
+  TEST_CHECK((segments[3].dc == 1 && segments[3].data == std::vector<uint8_t>{0x03, 0x04}));
+  TEST_CHECK(bus.mock->get_stats().transfers == 1 && bus.mock->get_stats().bytes == 6);
+  // 6 bytes at 8 MHz
+  TEST_CHECK(bus.mock->get_stats().bus_time_us == 6);
+  return 0;
+}
+
+static int test_submit_order() {
+  Bus bus;
+  std::vector<uint8_t> frame(100, 0x11);
+  std::vector<int> done;
+  spi::SPITransaction first;
+  first.command(0x2C).data(frame.data(), frame.size());
+  bus.device.submit_transaction(std::move(first), [&done]() { done.push_back(1); });
+  TEST_CHECK(bus.mock->get_transfers().empty());
+
+  // Referenced data is only read when the transaction completes, copied data right away
+  uint8_t command = 0x2C;
+  spi::SPITransaction second;
+  second.add(&command, 1, false).data(frame.data(), frame.size());
+  command = 0x00;
+  // The first one completes before the second one is submitted
+  bus.device.submit_transaction(std::move(second), [&done]() { done.push_back(2); });
+  TEST_CHECK(bus.mock->get_transfers().size() == 1 && (done == std::vector<int>{1}));
+  frame[0] = 0x22;
+  bus.component.loop();
+  TEST_CHECK((done == std::vector<int>{1, 2}));
+  const auto &transfers = bus.mock->get_transfers();
+  TEST_CHECK(transfers.size() == 2 && transfers[0].queued && transfers[1].queued);
+  TEST_CHECK(transfers[0].segments[1].data[0] == 0x11);
+  TEST_CHECK(transfers[1].segments[0].data == std::vector<uint8_t>{0x2C});
+  TEST_CHECK(transfers[1].segments[1].data[0] == 0x22);
+
+  // A plain write of the device waits for the submitted transaction
+  spi::SPITransaction third;
+  third.data(frame.data(), frame.size());
+  bus.device.submit_transaction(std::move(third));
+  bus.device.enable();
+  bus.device.write_byte(0x55);
+  bus.device.disable();
+  TEST_CHECK(transfers.size() == 4);
+  TEST_CHECK(transfers[2].queued && transfers[2].segments[0].data.size() == 100);
+  TEST_CHECK(!transfers[3].queued && transfers[3].segments[0].dc == -1);
+  TEST_CHECK(transfers[3].segments[0].data == std::vector<uint8_t>{0x55});
+  return 0;
+}
+
+static int test_record_limit() {
+  Bus bus;
+  for (uint8_t i = 0; i < 20; i++) {
+    spi::SPITransaction transaction;
+    transaction.data(i);
+    bus.device.write_transaction(transaction);
+  }
+  // Only the newest transfers are kept, the statistics count all
+  const auto &transfers = bus.mock->get_transfers();
+  TEST_CHECK(transfers.size() == 16);
+  TEST_CHECK(transfers.front().segments[0].data[0] == 4 && transfers.back().segments[0].data[0] == 19);
+  TEST_CHECK(bus.mock->get_stats().transfers == 20);
+  bus.mock->set_record_limit(0);
+  TEST_CHECK(transfers.empty());
+  return 0;
+}
+
+int run_test() {
+  TEST_CHECK(test_transaction() == 0);
+  TEST_CHECK(test_submit_order() == 0);
+  TEST_CHECK(test_record_limit() == 0);
+  return 0;
+}
@@ -0,0 +1,104 @@
+// Template entities with dependencies are evaluated after a dependency published, and only then.
+
+#include "test_main.h"
+
+#include "esphome/components/sensor/automation.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/components/template/binary_sensor/template_binary_sensor.h"
+#include "esphome/components/template/sensor/template_sensor.h"
+#include "esphome/core/application.h"
+#include "esphome/core/base_automation.h"
+
+using namespace esphome;
+
+static int test_sensor() {
+  sensor::Sensor source;
+  template_::TemplateSensor doubled;
+  int evaluations = 0, publishes = 0;
+  doubled.set_template([&]() -> optional<float> {
+    evaluations++;
+    return source.state * 2;
+  });
+  doubled.add_dependency(&source);
+  doubled.add_on_state_callback([&publishes](float state) { publishes++; });
+
+  // Several publishes before the next loop are a single update
+  source.publish_state(1.0f);
+  source.publish_state(2.0f);
+  TEST_CHECK(evaluations == 0);
+  App.scheduler.call();
+  TEST_CHECK(evaluations == 1 && publishes == 1);
+  TEST_CHECK(doubled.state == 4.0f);
+
+  App.scheduler.call();
+  TEST_CHECK(evaluations == 1);
+  source.publish_state(3.0f);
+  App.scheduler.call();
+  TEST_CHECK(evaluations == 2 && doubled.state == 6.0f);
+  return 0;
+}
+
+static int test_binary_sensor_dependency() {
+  sensor::Sensor source;
+  template_::TemplateBinarySensor high;
+  int evaluations = 0;
+  high.set_template([&]() -> optional<bool> {
+    evaluations++;
+    return source.state > 10.0f;
+  });
+  high.add_dependency(&source);
+
+  // Evaluated once at first, then only after the dependency published
+  high.loop();
+  high.loop();
+  TEST_CHECK(evaluations == 1);
+  source.publish_state(20.0f);
+  high.loop();
+  high.loop();
+  TEST_CHECK(evaluations == 2 && high.state);
+  return 0;
+}
+
+static int test_binary_sensor_condition() {
+  sensor::Sensor source;
+  template_::TemplateBinarySensor low;
+  auto *in_range = new sensor::SensorInRangeCondition<>(&source);
+  in_range->set_max(10.0f);
+  int evaluations = 0;
+  low.set_template([&]() -> optional<bool> {
+    evaluations++;
+    return in_range->check();
+  });
+  low.watch_condition(in_range);
+
+  low.loop();
+  low.loop();
+  TEST_CHECK(evaluations == 1);
+  source.publish_state(5.0f);
+  low.loop();
+  TEST_CHECK(evaluations == 2 && low.state);
+  source.publish_state(15.0f);
+  low.loop();
+  TEST_CHECK(evaluations == 3 && !low.state);
+
+  // Conditions that can't be watched are polled
+  template_::TemplateBinarySensor polled;
+  auto *lambda = new LambdaCondition<>([]() { return true; });
+  evaluations = 0;
+  polled.set_template([&]() -> optional<bool> {
+    evaluations++;
+    return lambda->check();
+  });
+  polled.watch_condition(lambda);
+  polled.loop();
+  polled.loop();
+  TEST_CHECK(evaluations == 2);
+  return 0;
+}
+
+int run_test() {
+  TEST_CHECK(test_sensor() == 0);
+  TEST_CHECK(test_binary_sensor_dependency() == 0);
+  TEST_CHECK(test_binary_sensor_condition() == 0);
+  return 0;
+}
@@ -0,0 +1,45 @@
+#include "test_main.h"
+
+#include <cstdarg>
+#include <cstdlib>
+
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+namespace test {
+
+static uint64_t now_us = 0;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void advance_us(uint32_t us) { now_us += us; }
+
+}  // namespace test
+
+namespace esphome {
+
+void yield() {}
+uint32_t millis() { return test::now_us / 1000; }
+uint32_t micros() { return test::now_us; }
+void delay(uint32_t ms) { test::advance_ms(ms); }
+void delayMicroseconds(uint32_t us) { test::advance_us(us); }
+void arch_restart() { exit(1); }
+void arch_init() {}
+void arch_feed_wdt() {}
+uint32_t arch_get_cpu_cycle_count() { return test::now_us * 1000; }
+uint32_t arch_get_cpu_freq_hz() { return 1000000000U; }
+uint8_t progmem_read_byte(const uint8_t *addr) { return *addr; }
+
+void esp_log_printf_(int level, const char *tag, int line, const char *format, ...) {  // NOLINT
+  va_list args;
+  va_start(args, format);
+  esp_log_vprintf_(level, tag, line, format, args);
+  va_end(args);
+}
+void esp_log_vprintf_(int level, const char *tag, int line, const char *format, va_list args) {  // NOLINT
+  printf("[%s:%03d] ", tag, line);
+  vprintf(format, args);
+  printf("\n");
+}
+
+}  // namespace esphome
+
+int main() { return run_test(); }
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+
+/// Implemented by each test driver, returns the exit status.
+int run_test();
+
+namespace test {
+
+/// Move the clock behind millis() and micros() forward.
+void advance_us(uint32_t us);
+inline void advance_ms(uint32_t ms) { advance_us(ms * 1000); }
+
+}  // namespace test
+
+#define TEST_CHECK(cond) \
+  do { \
+    if (!(cond)) { \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+      return 1; \
+    } \
+  } while (0)
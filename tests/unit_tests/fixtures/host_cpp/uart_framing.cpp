@@ -0,0 +1,177 @@
+// Frames must only be dispatched once their last byte has been received, and a Modbus request must wait for the
+// silence between frames without the loop blocking on it.
+
+#include "test_main.h"
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+#include "esphome/components/modbus/modbus.h"
+#include "esphome/components/uart/uart_framer.h"
+#include "esphome/core/application.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/helpers.h"
+
+using namespace esphome;
+
+/// UART that only hands out queued bytes once they are released.
+class ByteUART : public uart::UARTComponent {
+ public:
+  void write_array(const uint8_t *data, size_t len) override {}
+  bool peek_byte(uint8_t *data) override {
+    if (this->rx_.empty())
+      return false;
+    *data = this->rx_.front();
+    return true;
+  }
+  bool read_array(uint8_t *data, size_t len) override {
+    for (size_t i = 0; i < len; i++) {
+      if (this->rx_.empty())
+        return false;
+      data[i] = this->rx_.front();
+      this->rx_.pop_front();
+    }
+    this->pending_ -= std::min(this->pending_, len);
+    return true;
+  }
+  int available() override { return std::min(this->pending_, this->rx_.size()); }
+  void flush() override {}
+  void check_logger_conflict() override {}
+
+  void queue(const std::vector<uint8_t> &data) { this->rx_.insert(this->rx_.end(), data.begin(), data.end()); }
+  /// Make the next @p count queued bytes readable.
+  void release(size_t count) { this->pending_ += count; }
+
+ protected:
+  std::deque<uint8_t> rx_;
+  size_t pending_{0};
+};
+
+class RecordingDevice : public modbus::ModbusDevice {
+ public:
+  void on_modbus_data(const std::vector<uint8_t> &data) override { this->frames.push_back(data); }
+  std::vector<std::vector<uint8_t>> frames;
+};
+
+/// Device that sends a read holding registers request whenever one is marked pending.
+class PollingDevice : public RecordingDevice {
+ public:
+  bool has_pending_request() override { return this->pending; }
+  uint32_t get_pending_since() override { return 0; }
+  bool send_next_request() override {
+    this->pending = false;
+    this->sent++;
+    this->send_raw({this->address_, 0x03, 0x00, 0x00, 0x00, 0x02});
+    return true;
+  }
+  bool pending{false};
+  int sent{0};
+};
+
+class TestModbus : public modbus::Modbus {
+ public:
+  using Modbus::frame_length_;
+};
+
+static std::vector<uint8_t> with_crc(std::vector<uint8_t> frame) {
+  uint16_t crc = crc16(frame.data(), frame.size());
+  frame.push_back(crc & 0xFF);
+  frame.push_back(crc >> 8);
+  return frame;
+}
+
+static int test_modbus_byte_by_byte() {
+  ByteUART uart;
+  uart.set_baud_rate(9600);
+  TestModbus bus;
+  bus.set_uart_parent(&uart);
+  bus.set_role(modbus::CLIENT);
+  bus.set_disable_crc(false);
+  RecordingDevice device;
+  device.set_parent(&bus);
+  device.set_address(1);
+  bus.register_device(&device);
+  bus.setup();
+
+  // Read holding registers response with two registers
+  const auto response = with_crc({0x01, 0x03, 0x04, 0x00, 0x0A, 0x00, 0x14});
+  TEST_CHECK(bus.frame_length_(response.data(), 3) == 0);
+  TEST_CHECK(bus.frame_length_(response.data(), response.size() - 1) == 0);
+  TEST_CHECK(bus.frame_length_(response.data(), response.size()) == static_cast<int>(response.size()));
+
+  uart.queue(response);
+  for (size_t i = 0; i < response.size(); i++) {
+    TEST_CHECK(device.frames.empty());
+    uart.release(1);
+    bus.loop();
+    test::advance_us(1100);
+  }
+  TEST_CHECK(device.frames.size() == 1);
+  TEST_CHECK((device.frames[0] == std::vector<uint8_t>{0x00, 0x0A, 0x00, 0x14}));
+  return 0;
+}
+
+static int test_modbus_frame_gap() {
+  ByteUART uart;
+  uart.set_baud_rate(9600);
+  TestModbus bus;
+  bus.set_uart_parent(&uart);
+  bus.set_role(modbus::CLIENT);
+  bus.set_disable_crc(false);
+  PollingDevice device;
+  device.set_parent(&bus);
+  device.set_address(1);
+  bus.register_device(&device);
+  bus.setup();
+
+  device.pending = true;
+  bus.loop();
+  TEST_CHECK(device.sent == 1);
+
+  // The response ends the transaction and the next request is due at once, 4010 us of silence at 9600 baud
+  const auto response = with_crc({0x01, 0x03, 0x04, 0x00, 0x0A, 0x00, 0x14});
+  uart.queue(response);
+  uart.release(response.size());
+  device.pending = true;
+  const uint32_t start = micros();
+  bus.loop();
+  TEST_CHECK(device.frames.size() == 1);
+  // The loop returns right away instead of waiting out the gap
+  TEST_CHECK(micros() == start);
+  TEST_CHECK(device.sent == 1);
+
+  test::advance_us(3000);
+  App.scheduler.call();
+  TEST_CHECK(device.sent == 1);
+  test::advance_us(2000);
+  App.scheduler.call();
+  TEST_CHECK(device.sent == 2);
+  return 0;
+}
+
+static int test_framer_waits_for_reported_length() {
+  uart::UARTFramer framer(64);
+  uart::FrameFormat format;
+  // Like a protocol whose size is known from the first bytes, reported before the frame is complete
+  format.frame_length = [](const uint8_t *data, size_t len) { return len < 2 ? 0 : data[1]; };
+  std::vector<std::vector<uint8_t>> frames;
+  framer.add_format(std::move(format),
+                    [&frames](const uint8_t *data, size_t len) { frames.emplace_back(data, data + len); });
+
+  const std::vector<uint8_t> frame{0xAA, 6, 1, 2, 3, 4};
+  for (size_t i = 0; i < frame.size(); i++) {
+    TEST_CHECK(frames.empty());
+    framer.feed(&frame[i], 1);
+  }
+  TEST_CHECK(frames.size() == 1);
+  TEST_CHECK(frames[0] == frame);
+  return 0;
+}
+
+int run_test() {
+  TEST_CHECK(test_modbus_byte_by_byte() == 0);
+  TEST_CHECK(test_modbus_frame_gap() == 0);
+  TEST_CHECK(test_framer_waits_for_reported_length() == 0);
+  return 0;
+}
@@ -0,0 +1,179 @@
+// Time from the last byte of a frame arriving on a host UART to a component having the whole frame, with 8 byte frames
+// sent at 115200 baud over a pseudo terminal, and how often the main loop ran meanwhile. The results are printed.
+
+#include "test_main.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fcntl.h>
+#include <random>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "esphome/components/uart/uart_component_host.h"
+#include "esphome/core/application.h"
+
+using namespace esphome;
+using Clock = std::chrono::steady_clock;
+
+static const int FRAMES = 200;
+static const size_t FRAME_SIZE = 8;
+// Ten bits per byte at 115200 baud
+static const auto BYTE_TIME = std::chrono::nanoseconds(86806);
+
+/// The sending end of a pseudo terminal, writing frames at the pace of the baud rate from its own thread.
+class Sender {
+ public:
+  Sender() {
+    this->master_ = posix_openpt(O_RDWR | O_NOCTTY);
+    grantpt(this->master_);
+    unlockpt(this->master_);
+  }
+  ~Sender() { close(this->master_); }
+  const char *port() const { return ptsname(this->master_); }
+
+  void start() {
+    this->done = false;
+    this->thread_ = std::thread([this]() {
+      std::mt19937 rng(1);
+      std::uniform_int_distribution<int> gap_us(2000, 20000);
+      const uint8_t frame[FRAME_SIZE] = {0x01, 0x03, 0x00, 0x00, 0x00, 0x01, 0x84, 0x0A};
+      for (int i = 0; i < FRAMES; i++) {
+        auto next = Clock::now() + std::chrono::microseconds(gap_us(rng));
+        for (size_t j = 0; j < FRAME_SIZE; j++) {
+          std::this_thread::sleep_until(next);
+          // Taken before the write, the reader may have the byte before write() returns
+          if (j == FRAME_SIZE - 1)
+            this->last_byte.store(Clock::now().time_since_epoch().count());
+          (void) !write(this->master_, &frame[j], 1);
+          next += BYTE_TIME;
+        }
+      }
+      this->done = true;
+    });
+  }
+  void join() { this->thread_.join(); }
+
+  std::atomic<Clock::rep> last_byte{0};
+  std::atomic<bool> done{false};
+
+ protected:
+  int master_;
+  std::thread thread_;
+};
+
+enum ReadMode {
+  /// The port isn't registered with the loop, its bytes are counted with FIONREAD every loop like before.
+  READ_POLLED,
+  /// Reads whatever is available, like UARTFramer.
+  READ_ALL,
+  /// Leaves the bytes in the port until the whole frame is there.
+  READ_WHOLE_FRAME,
+};
+
+/// Component collecting the frames and the time each took from its last byte.
+class FrameReader : public Component {
+ public:
+  void loop() override {
+    this->loops++;
+    if (this->sender == nullptr)
+      return;
+    size_t available;
+    if (this->mode == READ_POLLED) {
+      int count = 0;
+      ioctl(this->fd, FIONREAD, &count);
+      available = count;
+      uint8_t buf[64];
+      if (available > 0)
+        this->received += read(this->fd, buf, std::min(available, sizeof(buf)));
+    } else {
+      available = this->uart->available();
+      if (this->mode == READ_WHOLE_FRAME && available < FRAME_SIZE)
+        return;
+      uint8_t buf[64];
+      available = std::min(available, sizeof(buf));
+      if (available > 0 && this->uart->read_array(buf, available))
+        this->received += available;
+    }
+    while (this->received >= FRAME_SIZE) {
+      this->received -= FRAME_SIZE;
+      const auto sent = Clock::time_point(Clock::duration(this->sender->last_byte.load()));
+      this->latencies_us.push_back(std::chrono::duration<double, std::micro>(Clock::now() - sent).count());
+    }
+  }
+
+  ReadMode mode{READ_POLLED};
+  uart::HostUartComponent *uart{nullptr};
+  int fd{-1};
+  Sender *sender{nullptr};
+  size_t received{0};
+  uint32_t loops{0};
+  std::vector<double> latencies_us;
+};
+
+static double thread_cpu_ms() {
+  timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+/// Print the latencies and return the number of loops per frame.
+static double measure(const char *name, FrameReader &reader, Sender &sender, ReadMode mode) {
+  reader.mode = mode;
+  reader.latencies_us.clear();
+  reader.received = 0;
+  reader.loops = 0;
+  reader.sender = &sender;
+  const double cpu_start = thread_cpu_ms();
+  sender.start();
+  while (!sender.done || reader.latencies_us.size() < FRAMES)
+    App.loop();
+  sender.join();
+  const double cpu_ms = thread_cpu_ms() - cpu_start;
+  reader.sender = nullptr;
+
+  std::vector<double> &lat = reader.latencies_us;
+  std::sort(lat.begin(), lat.end());
+  double sum = 0;
+  for (double value : lat)
+    sum += value;
+  printf("%s: latency mean %.0f us, median %.0f us, p99 %.0f us, max %.0f us; %.1f loops and %.2f ms CPU per frame\n",
+         name, sum / lat.size(), lat[lat.size() / 2], lat[lat.size() * 99 / 100], lat.back(),
+         double(reader.loops) / FRAMES, cpu_ms / FRAMES);
+  return double(reader.loops) / FRAMES;
+}
+
+int run_test() {
+  Sender polled, woken;
+  uart::HostUartComponent uart;
+  uart.set_name(woken.port());
+  uart.set_baud_rate(115200);
+  uart.set_data_bits(8);
+  uart.set_parity(uart::UART_CONFIG_PARITY_NONE);
+  uart.set_stop_bits(1);
+  FrameReader reader;
+  reader.uart = &uart;
+  App.register_component(&uart);
+  App.register_component(&reader);
+  App.setup();
+  TEST_CHECK(!uart.is_failed());
+
+  // The other port is opened like the UART component did before it was registered with the loop
+  reader.fd = open(polled.port(), O_RDWR | O_NOCTTY);
+  TEST_CHECK(reader.fd != -1);
+  termios options;
+  tcgetattr(reader.fd, &options);
+  cfmakeraw(&options);
+  tcsetattr(reader.fd, TCSANOW, &options);
+
+  measure("polled every loop", reader, polled, READ_POLLED);
+  measure("woken, reading everything", reader, woken, READ_ALL);
+  // Unread bytes don't keep waking the loop, it sleeps instead of spinning until the frame is complete
+  TEST_CHECK(measure("woken, waiting for the whole frame", reader, woken, READ_WHOLE_FRAME) < 20);
+  close(reader.fd);
+  return 0;
+}
@@ -0,0 +1,203 @@
+// Sensor values encoded by one UDP component, batched into datagrams and sent over loopback, must be decoded by
+// another, with and without encryption, rolling code and compact ids, over as many datagrams as they need.
+
+#include "test_main.h"
+
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "esphome/components/binary_sensor/binary_sensor.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/components/socket/datagram_batch.h"
+#include "esphome/components/udp/udp_component.h"
+
+using namespace esphome;
+
+// setup() isn't called, so nothing uses the preferences
+namespace esphome {
+ESPPreferences *global_preferences = nullptr;
+}  // namespace esphome
+
+/// Loopback socket the sender sends to, the test hands what it receives to the receiver.
+class Inbox {
+ public:
+  Inbox() {
+    this->fd_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in addr {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ::bind(this->fd_, (struct sockaddr *) &addr, sizeof(addr));
+    socklen_t len = sizeof(this->addr_);
+    ::getsockname(this->fd_, (struct sockaddr *) &this->addr_, &len);
+    int size = 1 << 20;
+    ::setsockopt(this->fd_, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+  }
+  ~Inbox() { ::close(this->fd_); }
+
+  const struct sockaddr_in &addr() const { return this->addr_; }
+  /// Every datagram received so far.
+  std::vector<std::vector<uint8_t>> receive() {
+    std::vector<std::vector<uint8_t>> datagrams;
+    uint8_t buf[1500];
+    ssize_t len;
+    while ((len = ::recv(this->fd_, buf, sizeof(buf), MSG_DONTWAIT)) > 0)
+      datagrams.emplace_back(buf, buf + len);
+    return datagrams;
+  }
+
+ protected:
+  int fd_;
+  struct sockaddr_in addr_ {};
+};
+
+/// UDP component set up without preferences and with its own name, so two can talk in one process.
+class TestUDP : public udp::UDPComponent {
+ public:
+  void start(const char *name, Inbox *inbox = nullptr) {
+    this->name_ = name;
+    this->header_ = {0x53, 0x45, uint8_t(strlen(name))};
+    this->header_.insert(this->header_.end(), name, name + strlen(name));
+    while (this->header_.size() & 0x3)
+      this->header_.push_back(0);
+    this->rolling_code_[1] = 1;
+    if (inbox == nullptr)
+      return;
+    this->should_send_ = true;
+    for (auto &sensor : this->sensors_)
+      sensor.id_hash = fnv1_hash(sensor.id);
+    for (auto &sensor : this->binary_sensors_)
+      sensor.id_hash = fnv1_hash(sensor.id);
+    this->batch_.init(508, socket::DEFAULT_BATCH_DEPTH);
+    this->broadcast_socket_ = socket::socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
+    struct sockaddr saddr {};
+    memcpy(&saddr, &inbox->addr(), sizeof(inbox->addr()));
+    this->sockaddrs_.push_back(saddr);
+  }
+  void send_all() { this->send_data_(true); }
+  void process(std::vector<uint8_t> datagram) { this->process_(datagram.data(), datagram.size()); }
+};
+
+static const std::vector<uint8_t> KEY = {1, 2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14, 15, 16,
+                                         17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32};
+
+struct Options {
+  bool encrypted;
+  bool rolling_code;
+  bool compact;
+};
+
+/// Sensors with long ids, so that non-compact values need several datagrams and fill the batch.
+static const size_t SENSORS = 300;
+
+static int round_trip(Options options) {
+  std::vector<std::string> ids;
+  for (size_t i = 0; i < SENSORS; i++)
+    ids.push_back("temperature_of_room_number_" + std::to_string(i));
+  std::vector<sensor::Sensor> local(SENSORS), remote(SENSORS);
+  binary_sensor::BinarySensor local_door, remote_door;
+
+  Inbox inbox;
+  TestUDP sender, receiver;
+  for (size_t i = 0; i < SENSORS; i++) {
+    sender.add_sensor(ids[i].c_str(), &local[i]);
+    receiver.add_remote_sensor("sender", ids[i].c_str(), &remote[i]);
+    local[i].state = float(i) * 0.5f - 20.0f;
+  }
+  sender.add_binary_sensor("door", &local_door);
+  receiver.add_remote_binary_sensor("sender", "door", &remote_door);
+  local_door.state = true;
+  sender.set_compact(options.compact);
+  sender.set_rolling_code_enable(options.rolling_code);
+  if (options.encrypted) {
+    sender.set_encryption_key(KEY);
+    receiver.set_provider_encryption("sender", KEY);
+  }
+  sender.start("sender", &inbox);
+  receiver.start("receiver");
+
+  sender.send_all();
+  auto datagrams = inbox.receive();
+  const size_t per_value = options.compact ? 9 : 1 + 4 + 1 + ids.back().size();
+  TEST_CHECK(datagrams.size() >= SENSORS * per_value / 508);
+  if (!options.compact)
+    TEST_CHECK(datagrams.size() > socket::DEFAULT_BATCH_DEPTH);
+  for (auto &datagram : datagrams) {
+    TEST_CHECK(datagram.size() <= 508 && datagram.size() % 4 == 0);
+    // The values are only readable without encryption
+    const bool clear = std::string(datagram.begin(), datagram.end()).find("room_number") != std::string::npos;
+    TEST_CHECK(clear == (!options.encrypted && !options.compact));
+  }
+  for (auto &datagram : datagrams)
+    receiver.process(datagram);
+  for (size_t i = 0; i < SENSORS; i++) {
+    if (!remote[i].has_state() || remote[i].state != local[i].state) {
+      printf("encrypted %d, rolling code %d, compact %d: sensor %zu is %f\n", options.encrypted, options.rolling_code,
+             options.compact, i, remote[i].state);
+      return 1;
+    }
+  }
+  TEST_CHECK(remote_door.has_state() && remote_door.state);
+
+  // Replayed datagrams are refused with a rolling code, the first of the next batch is accepted
+  local[0].state = 100.0f;
+  sender.send_all();
+  auto next = inbox.receive();
+  remote[0].publish_state(0.0f);
+  remote[SENSORS - 1].publish_state(0.0f);
+  receiver.process(datagrams[0]);
+  receiver.process(datagrams.back());
+  TEST_CHECK(remote[0].state == (options.rolling_code ? 0.0f : -20.0f));
+  TEST_CHECK(remote[SENSORS - 1].state == (options.rolling_code ? 0.0f : local[SENSORS - 1].state));
+  receiver.process(next[0]);
+  TEST_CHECK(remote[0].state == 100.0f);
+
+  // A datagram of another sender, or with the wrong key, changes nothing
+  if (options.encrypted) {
+    TestUDP stranger;
+    stranger.add_sensor(ids[0].c_str(), &local[0]);
+    stranger.set_encryption_key(std::vector<uint8_t>(32, 7));
+    Inbox other;
+    stranger.start("sender", &other);
+    local[0].state = 5.0f;
+    stranger.send_all();
+    for (auto &datagram : other.receive())
+      receiver.process(datagram);
+    TEST_CHECK(remote[0].state == 100.0f);
+  }
+  return 0;
+}
+
+static int test_batch() {
+  socket::DatagramBatch batch;
+  batch.init(12, 2);
+  TEST_CHECK(reinterpret_cast<uintptr_t>(batch.data()) % 4 == 0);
+  batch.append("abcd", 4);
+  TEST_CHECK(batch.fits(8) && !batch.fits(9));
+  batch.append(uint8_t('e'));
+  batch.close();
+  TEST_CHECK(batch.count() == 1 && !batch.full() && batch.size() == 0);
+  TEST_CHECK(reinterpret_cast<uintptr_t>(batch.data()) % 4 == 0);
+  batch.append("0123456789ab", 12);
+  batch.close();
+  TEST_CHECK(batch.full() && batch.count() == 2);
+  TEST_CHECK(batch.datagram_size(0) == 5 && memcmp(batch.datagram(0), "abcde", 5) == 0);
+  TEST_CHECK(batch.datagram_size(1) == 12 && memcmp(batch.datagram(1), "0123456789ab", 12) == 0);
+  batch.clear();
+  TEST_CHECK(batch.count() == 0 && batch.fits(12));
+  return 0;
+}
+
+int run_test() {
+  TEST_CHECK(test_batch() == 0);
+  for (bool encrypted : {false, true}) {
+    for (bool rolling_code : {false, true}) {
+      for (bool compact : {false, true})
+        TEST_CHECK(round_trip({encrypted, rolling_code, compact}) == 0);
+    }
+  }
+  return 0;
+}
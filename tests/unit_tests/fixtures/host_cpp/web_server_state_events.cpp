@@ -0,0 +1,186 @@
+// State events must be built once and reach every client, skipping updates that didn't change the JSON and merging
+// the ones inside the coalescing window. Clients that just connected get the DETAIL_ALL JSON, cached until the state
+// changes, while the clients already connected don't get it again.
+
+#include "test_main.h"
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "esphome/components/web_server/state_events.h"
+
+using namespace esphome;
+using namespace esphome::web_server;
+
+class FakeEventSource;
+
+/// An event source client recording the events it got.
+class FakeClient {
+ public:
+  void send(const char *message, const char *event) { this->events.push_back(std::string(event) + " " + message); }
+  std::vector<std::string> events;
+};
+
+class FakeEventSource {
+ public:
+  size_t count() const { return this->clients.size(); }
+  bool has_client(FakeClient *client) const { return this->clients.count(client) != 0; }
+  void send(const char *message, const char *event) {
+    this->broadcasts++;
+    for (auto *client : this->clients)
+      client->send(message, event);
+  }
+  std::set<FakeClient *> clients;
+  int broadcasts{0};
+};
+
+/// An entity whose JSON is its value, counting how often it was built.
+class FakeEntity : public EntityBase {
+ public:
+  int value{0};
+  int state_builds{0};
+  int initial_builds{0};
+};
+
+static std::string state_json(WebServer *web_server, EntityBase *entity) {
+  auto *obj = static_cast<FakeEntity *>(entity);
+  obj->state_builds++;
+  return std::to_string(obj->value);
+}
+
+static std::string initial_json(WebServer *web_server, EntityBase *entity) {
+  auto *obj = static_cast<FakeEntity *>(entity);
+  obj->initial_builds++;
+  return "all " + std::to_string(obj->value);
+}
+
+using Events = StateEvents<FakeEventSource, FakeClient>;
+
+static void update(Events &events, FakeEntity &entity, int value) {
+  entity.value = value;
+  events.send(&entity, state_json);
+}
+
+static int test_unchanged() {
+  FakeEventSource source;
+  Events events(nullptr, &source);
+  FakeEntity entity;
+  // Nobody listens, nothing is built
+  update(events, entity, 1);
+  TEST_CHECK(entity.state_builds == 0);
+
+  FakeClient a, b;
+  source.clients = {&a, &b};
+  update(events, entity, 1);
+  update(events, entity, 1);
+  update(events, entity, 2);
+  // Built for every update, sent once to both clients when it changed
+  TEST_CHECK(entity.state_builds == 3 && source.broadcasts == 2);
+  TEST_CHECK((a.events == std::vector<std::string>{"state 1", "state 2"}) && b.events == a.events);
+  return 0;
+}
+
+static int test_coalescing() {
+  FakeEventSource source;
+  FakeClient a;
+  source.clients = {&a};
+  Events events(nullptr, &source);
+  events.set_coalesce_interval(100);
+  FakeEntity first, second;
+  update(events, first, 1);
+  update(events, second, 1);
+  // Inside the window only the latest state is kept, and nothing is built yet
+  test::advance_ms(10);
+  update(events, first, 2);
+  update(events, first, 3);
+  update(events, second, 2);
+  TEST_CHECK(first.state_builds == 1 && a.events.size() == 2);
+  test::advance_ms(89);
+  events.loop();
+  TEST_CHECK(a.events.size() == 2);
+  test::advance_ms(1);
+  events.loop();
+  TEST_CHECK(first.state_builds == 2 && second.state_builds == 2);
+  // In no particular order
+  TEST_CHECK(a.events.size() == 4);
+  const std::set<std::string> merged(a.events.begin() + 2, a.events.end());
+  TEST_CHECK((merged == std::set<std::string>{"state 3", "state 2"}));
+  // Outside the window an update is sent at once
+  test::advance_ms(100);
+  update(events, first, 4);
+  TEST_CHECK(a.events.back() == "state 4");
+  return 0;
+}
+
+static int test_new_clients() {
+  FakeEventSource source;
+  FakeClient existing, first, second, gone;
+  source.clients = {&existing};
+  Events events(nullptr, &source);
+  FakeEntity entity;
+  update(events, entity, 1);
+
+  // Two clients connect before the iterator gets to the entity, one of them leaves again
+  source.clients.insert(&first);
+  events.add_new_client(&first);
+  source.clients.insert(&gone);
+  events.add_new_client(&gone);
+  source.clients.erase(&gone);
+  events.send_initial_state(&entity, initial_json);
+  events.clear_new_clients();
+  TEST_CHECK((first.events == std::vector<std::string>{"state all 1"}) && gone.events.empty());
+  // The client that was already connected doesn't get the full state again
+  TEST_CHECK((existing.events == std::vector<std::string>{"state 1"}));
+
+  // The next client shares the cached JSON while nothing changed
+  source.clients.insert(&second);
+  events.add_new_client(&second);
+  events.send_initial_state(&entity, initial_json);
+  events.clear_new_clients();
+  TEST_CHECK(entity.initial_builds == 1 && (second.events == std::vector<std::string>{"state all 1"}));
+  TEST_CHECK(first.events.size() == 1);
+
+  // A client connected, so the next update goes out even though it is the same as the last one sent
+  update(events, entity, 1);
+  TEST_CHECK(existing.events.back() == "state 1" && existing.events.size() == 2);
+  TEST_CHECK(first.events.back() == "state 1" && second.events.back() == "state 1");
+
+  // An update clears the cached full state, also when nobody is connected
+  events.add_new_client(&first);
+  events.send_initial_state(&entity, initial_json);
+  events.clear_new_clients();
+  TEST_CHECK(entity.initial_builds == 2);
+  source.clients.clear();
+  update(events, entity, 2);
+  source.clients.insert(&first);
+  events.add_new_client(&first);
+  events.send_initial_state(&entity, initial_json);
+  TEST_CHECK(entity.initial_builds == 3 && first.events.back() == "state all 2");
+  return 0;
+}
+
+static int test_broadcast() {
+  FakeEventSource source;
+  FakeClient existing, added;
+  source.clients = {&existing};
+  Events events(nullptr, &source);
+  FakeEntity entity;
+  entity.value = 5;
+  // Without knowing whether the new client is still there, everyone gets the full state
+  source.clients.insert(&added);
+  events.add_new_client(&added);
+  events.broadcast_initial_state(&entity, initial_json);
+  events.broadcast_initial_state(&entity, initial_json);
+  TEST_CHECK(entity.initial_builds == 1 && source.broadcasts == 2);
+  TEST_CHECK(existing.events.size() == 2 && added.events == existing.events && added.events[0] == "state all 5");
+  return 0;
+}
+
+int run_test() {
+  TEST_CHECK(test_unchanged() == 0);
+  TEST_CHECK(test_coalescing() == 0);
+  TEST_CHECK(test_new_clients() == 0);
+  TEST_CHECK(test_broadcast() == 0);
+  return 0;
+}
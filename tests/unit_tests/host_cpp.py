@@ -0,0 +1,96 @@
+"""Build small host programs from C++ sources of the tree.
+
+Tests that exercise runtime code compile a driver from fixtures/host_cpp together with
+the sources it needs into a native executable and check its exit status. The driver
+implements ``int run_test()``; fixtures/host_cpp/test_main.cpp provides ``main()`` and
+a manually advanced clock in place of the platform HAL.
+"""
+
+from concurrent.futures import ThreadPoolExecutor
+import hashlib
+import os
+from pathlib import Path
+import subprocess
+
+PACKAGE_ROOT = Path(__file__).parent.parent.parent
+FIXTURES = Path(__file__).parent / "fixtures" / "host_cpp"
+
+# The host platform passes USE_HOST as a build flag, all other features are in defines.h
+CXXFLAGS = ["-std=gnu++17", "-O1", "-g", "-Wall", "-Wno-unused-function", "-DUSE_HOST"]
+# Turns memory errors and undefined behaviour into test failures
+SANITIZE = ("-fsanitize=address,undefined", "-fno-sanitize-recover=all")
+
+
+class HostCppBuilder:
+    def __init__(self, compiler: str, work_dir: Path):
+        self.compiler = compiler
+        self.work_dir = work_dir
+        self._objects: dict[tuple[str, tuple[str, ...]], Path] = {}
+
+    def _include_dir(self, defines: tuple[str, ...]) -> Path:
+        """Directory with a generated esphome/core/defines.h, searched before the tree."""
+        key = hashlib.sha1("\n".join(defines).encode()).hexdigest()[:12]
+        include = self.work_dir / f"include-{key}"
+        header = include / "esphome" / "core" / "defines.h"
+        if not header.exists():
+            header.parent.mkdir(parents=True)
+            lines = ["#pragma once", '#include "esphome/core/macros.h"']
+            lines += ["#define USE_ESPHOME_HOST_MAC_ADDRESS {0x02, 0x00, 0x00, 0x00, 0x00, 0x01}"]
+            lines += [f"#define {define}" for define in defines]
+            header.write_text("\n".join(lines) + "\n")
+        return include
+
+    def _compile(
+        self, source: Path, defines: tuple[str, ...], flags: tuple[str, ...]
+    ) -> Path:
+        key = (str(source), defines, flags)
+        if key in self._objects:
+            return self._objects[key]
+        include = self._include_dir(defines)
+        digest = hashlib.sha1(repr(key).encode()).hexdigest()[:12]
+        obj = self.work_dir / f"{source.stem}-{digest}.o"
+        cmd = [self.compiler, *CXXFLAGS, *flags, f"-I{include}", f"-I{PACKAGE_ROOT}"]
+        cmd += ["-c", str(source), "-o", str(obj)]
+        result = subprocess.run(cmd, capture_output=True, text=True, check=False)
+        if result.returncode != 0:
+            raise RuntimeError(f"Compiling {source} failed:\n{result.stderr}")
+        self._objects[key] = obj
+        return obj
+
+    def build(
+        self,
+        driver: str,
+        sources: list[str],
+        defines: tuple[str, ...] = (),
+        flags: tuple[str, ...] = (),
+    ) -> Path:
+        """Link the driver in fixtures/host_cpp with the given sources of the tree.
+
+        :param driver: File name of the driver.
+        :param sources: Paths relative to the package root, e.g. ``esphome/core/helpers.cpp``.
+        :param defines: Feature flags written to defines.h.
+        :param flags: Extra compiler flags used for compiling and linking, e.g. ``SANITIZE``.
+        :return: Path of the executable.
+        """
+        defines = tuple(sorted(defines))
+        paths = [FIXTURES / driver, FIXTURES / "test_main.cpp"]
+        paths += [PACKAGE_ROOT / source for source in sources]
+        with ThreadPoolExecutor(os.cpu_count()) as pool:
+            objects = list(
+                pool.map(lambda path: self._compile(path, defines, flags), paths)
+            )
+        program = self.work_dir / Path(driver).stem
+        cmd = [self.compiler, *flags, "-o", str(program), *map(str, objects)]
+        result = subprocess.run(cmd, capture_output=True, text=True, check=False)
+        if result.returncode != 0:
+            raise RuntimeError(f"Linking {driver} failed:\n{result.stderr}")
+        return program
+
+
+def run(program: Path, *args: str) -> str:
+    """Run a test program and return its output, failing with the output on a non-zero exit status."""
+    result = subprocess.run(
+        [str(program), *args], capture_output=True, text=True, timeout=60, check=False
+    )
+    assert result.returncode == 0, result.stdout + result.stderr
+    return result.stdout
@@ -0,0 +1,154 @@
+import pytest
+
+from esphome import automation, codegen as cg
+from esphome.core import CORE, ID, Lambda
+from esphome.cpp_generator import MockObj
+
+sensor_ns = cg.esphome_ns.namespace("sensor")
+text_sensor_ns = cg.esphome_ns.namespace("text_sensor")
+globals_ns = cg.esphome_ns.namespace("globals")
+
+ENTITY_TYPES = {
+    "temperature": sensor_ns.class_("Sensor"),
+    "humidity": sensor_ns.class_("Sensor"),
+    "template_a": sensor_ns.class_("TemplateSensor", sensor_ns.class_("Sensor")),
+    "template_b": sensor_ns.class_("TemplateSensor", sensor_ns.class_("Sensor")),
+    "mode": text_sensor_ns.class_("TextSensor"),
+    "counter": globals_ns.class_("GlobalsComponent"),
+}
+
+
+@pytest.fixture(autouse=True)
+def variables(monkeypatch):
+    async def get_variable_with_full_id(id_):
+        return ID(id_.id, type=ENTITY_TYPES[id_.id]), MockObj(id_.id)
+
+    monkeypatch.setattr(cg, "get_variable_with_full_id", get_variable_with_full_id)
+    monkeypatch.setattr(CORE, "data", {})
+
+
+async def dependencies(code, owner="template_a"):
+    result = await automation.lambda_dependencies(Lambda(code), [], ID(owner))
+    return None if result is None else [str(var) for var in result]
+
+
+@pytest.mark.asyncio
+async def test_lambda_dependencies__entity_states():
+    assert await dependencies(
+        "return id(temperature).state + id(humidity)->state;"
+    ) == ["temperature", "humidity"]
+
+
+@pytest.mark.asyncio
+async def test_lambda_dependencies__each_entity_once():
+    assert await dependencies(
+        "if (!id(temperature).has_state()) return {}; return id(temperature).state * 2;"
+    ) == ["temperature"]
+
+
+@pytest.mark.asyncio
+async def test_lambda_dependencies__arrow_state():
+    assert await dependencies("return id(temperature)->state;") == ["temperature"]
+
+
+@pytest.mark.asyncio
+async def test_lambda_dependencies__state_members():
+    assert await dependencies(
+        'return id(mode).state.c_str()[0] == \'a\' && id(mode).state.size() > 2;'
+    ) == ["mode"]
+
+
+@pytest.mark.asyncio
+async def test_lambda_dependencies__locals_and_pure_functions():
+    assert await dependencies(
+        "float t = id(temperature).state; return std::max(t, 0.0f) * 1.8f + 32;"
+    ) == ["temperature"]
+
+
+@pytest.mark.asyncio
+async def test_lambda_dependencies__static_local():
+    assert (
+        await dependencies(
+            "static float last = 0; last += id(temperature).state; return last;"
+        )
+        is None
+    )
+
+
+@pytest.mark.asyncio
+async def test_lambda_dependencies__time():
+    assert await dependencies("return id(temperature).state + millis();") is None
+
+
+@pytest.mark.asyncio
+async def test_lambda_dependencies__state_method_call():
+    assert await dependencies("return id(temperature).get_state();") is None
+
+
+@pytest.mark.asyncio
+async def test_lambda_dependencies__non_entity_id():
+    assert (
+        await dependencies("return id(temperature).state + id(counter);") is None
+    )
+
+
+@pytest.mark.asyncio
+async def test_lambda_dependencies__no_entity():
+    assert await dependencies("return 42.0;") is None
+
+
+@pytest.mark.asyncio
+async def test_lambda_dependencies__id_in_string_literal():
+    assert (
+        await dependencies(
+            'auto s = std::string("id(humidity).state"); return id(temperature).state;'
+        )
+        is None
+    )
+
+
+@pytest.mark.asyncio
+async def test_lambda_dependencies__id_in_comment():
+    assert await dependencies(
+        "// was id(humidity).state\nreturn id(temperature).state;"
+    ) == ["temperature"]
+
+
+@pytest.mark.asyncio
+async def test_lambda_dependencies__self_reference():
+    assert (
+        await dependencies(
+            "return (id(template_a).state + id(temperature).state) / 2;",
+            owner="template_a",
+        )
+        is None
+    )
+
+
+@pytest.mark.asyncio
+async def test_lambda_dependencies__cycle():
+    assert await dependencies("return id(template_b).state;", owner="template_a") == [
+        "template_b"
+    ]
+    # template_a is already evaluated when template_b changes
+    assert (
+        await dependencies("return id(template_a).state + 1;", owner="template_b")
+        is None
+    )
+
+
+@pytest.mark.asyncio
+async def test_lambda_dependencies__chain():
+    assert await dependencies("return id(template_b).state;", owner="template_a") == [
+        "template_b"
+    ]
+    assert await dependencies("return id(temperature).state;", owner="template_b") == [
+        "temperature"
+    ]
+
+
+@pytest.mark.asyncio
+async def test_lambda_dependencies__without_owner():
+    code = Lambda("return id(template_a).state > 20;")
+    result = await automation.lambda_dependencies(code, [])
+    assert [str(var) for var in result] == ["template_a"]
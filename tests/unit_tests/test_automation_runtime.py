@@ -0,0 +1,16 @@
+from host_cpp import run
+
+
+def test_automation_runtime(host_cpp):
+    program = host_cpp.build(
+        "automation_runtime.cpp",
+        [
+            "esphome/core/application.cpp",
+            "esphome/core/automation.cpp",
+            "esphome/core/component.cpp",
+            "esphome/core/helpers.cpp",
+            "esphome/core/scheduler.cpp",
+            "esphome/core/util.cpp",
+        ],
+    )
+    run(program)
@@ -0,0 +1,127 @@
+import base64
+
+import pytest
+
+from esphome import binary_log
+from host_cpp import run
+
+
+@pytest.mark.parametrize(
+    "fmt, expected",
+    (
+        ("", 0x811C9DC5),
+        ("a", 0xE40C292C),
+        ("'%s': Sending state %.5f %s with %d decimals of accuracy", 0x24A8E469),
+    ),
+)
+def test_format_id(fmt, expected):
+    assert binary_log.format_id(fmt) == expected
+
+
+def test_find_format_strings():
+    source = """
+        ESP_LOGD(TAG, "'%s': Sending state %.5f", name, value);
+        ESP_LOGCONFIG(TAG, "  Baud Rate: %" PRIu32, baud);
+        ESP_LOGW(TAG, "first " "second\\n");
+        ESP_LOGVV(TAG, "\\033[0m \\"quoted\\"");
+    """
+
+    assert binary_log.find_format_strings(source) == [
+        "'%s': Sending state %.5f",
+        "first second\n",
+        '\033[0m "quoted"',
+    ]
+
+
+def test_build_format_table(tmp_path):
+    source = tmp_path / "component.cpp"
+    source.write_text('ESP_LOGD(TAG, "Value %d", x);\nESP_LOGI(TAG, "Value %d", y);\n')
+
+    assert binary_log.build_format_table([source]) == {
+        binary_log.format_id("Value %d"): "Value %d"
+    }
+
+
+# Records produced by esphome/components/logger/log_record.cpp
+SENSOR_FORMAT = "'%s': Sending state %.5f %s with %d decimals of accuracy"
+SENSOR_RECORD = bytes.fromhex(
+    "1e0569e4a8245e0673656e736f720b54656d70657261747572659a99bb4103c2b04302"
+)
+MIXED_FORMAT = "%-8s|%5u|%x|%c|%lld|%+d|%%|%.*f|%p"
+MIXED_RECORD = bytes.fromhex(
+    "1e05992c6bf70101780261622aff015aa7e8c8e997070904d00f4940b424"
+)
+
+
+@pytest.mark.parametrize(
+    "record, expected",
+    (
+        (
+            SENSOR_RECORD,
+            "\033[0;36m[D][sensor:094]: 'Temperature': Sending state 23.45000 °C"
+            " with 1 decimals of accuracy\033[0m",
+        ),
+        (
+            MIXED_RECORD,
+            "\033[0;36m[D][x:001]: ab      |   42|ff|Z|-123456789012|-5|%|3.14|0x1234\033[0m",
+        ),
+    ),
+)
+def test_decode_record(record, expected):
+    table = {
+        binary_log.format_id(SENSOR_FORMAT): SENSOR_FORMAT,
+        binary_log.format_id(MIXED_FORMAT): MIXED_FORMAT,
+    }
+
+    assert binary_log.decode_record(record, table) == expected
+
+
+def test_decode_text_record():
+    record = bytes([0x1E, 2, 0, 0, 0, 0, 5, 3]) + b"api" + bytes([5]) + b"hello"
+
+    assert binary_log.decode_record(record, {}) == "\033[0;33m[W][api:005]: hello\033[0m"
+
+
+def test_decode_truncated_record():
+    table = {binary_log.format_id(SENSOR_FORMAT): SENSOR_FORMAT}
+
+    with pytest.raises(ValueError):
+        binary_log.decode_record(SENSOR_RECORD[:-3], table)
+
+
+def test_decode_serial_line():
+    line = b"\x1e" + base64.b64encode(SENSOR_RECORD) + b"\r\n"
+    table = {binary_log.format_id(SENSOR_FORMAT): SENSOR_FORMAT}
+
+    assert binary_log.decode_serial_line(line, table) == binary_log.decode_record(
+        SENSOR_RECORD, table
+    )
+    assert binary_log.decode_serial_line(b"[D][main:001]: text\r\n", table) is None
+
+
+def test_encode_string_precision(host_cpp):
+    program = host_cpp.build(
+        "log_record.cpp",
+        ["esphome/components/logger/log_record.cpp"],
+        defines=("USE_LOGGER_BINARY",),
+    )
+    run(program)
+
+
+def test_binary_log_benchmark(host_cpp):
+    program = host_cpp.build(
+        "binary_log.cpp",
+        [
+            "esphome/components/logger/log_record.cpp",
+            "esphome/components/logger/logger.cpp",
+            "esphome/components/logger/logger_host.cpp",
+            "esphome/core/application.cpp",
+            "esphome/core/component.cpp",
+            "esphome/core/helpers.cpp",
+            "esphome/core/scheduler.cpp",
+            "esphome/core/util.cpp",
+        ],
+        defines=("USE_LOGGER_BINARY",),
+    )
+    # Time and serial bytes per line as text and as binary records, shown with -s
+    print(run(program))
@@ -0,0 +1,11 @@
+from host_cpp import SANITIZE, run
+
+
+def test_callback_manager(host_cpp):
+    program = host_cpp.build(
+        "callback_manager.cpp",
+        ["esphome/core/helpers.cpp"],
+        defines=("ESPHOME_CALLBACK_POOL_SIZE 4",),
+        flags=SANITIZE,
+    )
+    run(program)
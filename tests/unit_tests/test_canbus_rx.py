@@ -0,0 +1,17 @@
+from host_cpp import run
+
+
+def test_canbus_rx(host_cpp):
+    program = host_cpp.build(
+        "canbus_rx.cpp",
+        [
+            "esphome/components/canbus/canbus.cpp",
+            "esphome/core/application.cpp",
+            "esphome/core/automation.cpp",
+            "esphome/core/component.cpp",
+            "esphome/core/helpers.cpp",
+            "esphome/core/scheduler.cpp",
+            "esphome/core/util.cpp",
+        ],
+    )
+    run(program)
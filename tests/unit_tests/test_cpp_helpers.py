@@ -70,3 +70,41 @@ async def test_register_component__with_setup_priority(monkeypatch):
     assert add_mock.call_count == 4
     app_mock.register_component.assert_called_with(var)
     assert core_mock.component_ids == []
+
+
+def test_entity_string__deduplicates(monkeypatch):
+    core_mock = Mock(data={})
+    monkeypatch.setattr(ch, "CORE", core_mock)
+
+    name = ch.entity_string("Outside Temperature")
+    object_id = ch.entity_string("outside_temperature")
+    device_class = ch.entity_string("temperature")
+    unit = ch.entity_string("°C")
+
+    assert str(name) == "ESPHOME_ENTITY_STRINGS + 0"
+    assert str(object_id) == "ESPHOME_ENTITY_STRINGS + 20"
+    # The tail of the object id
+    assert str(device_class) == "ESPHOME_ENTITY_STRINGS + 28"
+    assert str(ch.entity_string("Outside Temperature")) == str(name)
+    # Offsets count bytes, the degree sign takes two
+    assert str(unit) == "ESPHOME_ENTITY_STRINGS + 40"
+    assert str(ch.entity_string("C")) == "ESPHOME_ENTITY_STRINGS + 42"
+
+
+def test_add_entity_strings(monkeypatch):
+    core_mock = Mock(data={})
+    monkeypatch.setattr(ch, "CORE", core_mock)
+    add_global_mock = Mock()
+    monkeypatch.setattr(ch, "add_global", add_global_mock)
+
+    ch.add_entity_strings()
+    add_global_mock.assert_not_called()
+
+    ch.entity_string("foo")
+    ch.entity_string("bar")
+    ch.add_entity_strings()
+
+    statement = add_global_mock.call_args[0][0]
+    assert str(statement) == (
+        'static const char ESPHOME_ENTITY_STRINGS[] = "foo\\000bar";'
+    )
@@ -0,0 +1,12 @@
+from host_cpp import run
+
+
+def test_float_format(host_cpp):
+    program = host_cpp.build(
+        "float_format.cpp",
+        [
+            "esphome/core/helpers.cpp",
+        ],
+    )
+    # Time per value against snprintf(), shown with -s
+    print(run(program))
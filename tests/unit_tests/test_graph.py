@@ -0,0 +1,25 @@
+from host_cpp import run
+
+
+def test_graph(host_cpp):
+    program = host_cpp.build(
+        "graph.cpp",
+        [
+            "esphome/components/display/display.cpp",
+            "esphome/components/display/rect.cpp",
+            "esphome/components/graph/graph.cpp",
+            "esphome/components/sensor/filter.cpp",
+            "esphome/components/sensor/sensor.cpp",
+            "esphome/core/application.cpp",
+            "esphome/core/color.cpp",
+            "esphome/core/component.cpp",
+            "esphome/core/entity_base.cpp",
+            "esphome/core/helpers.cpp",
+            "esphome/core/scheduler.cpp",
+            "esphome/core/time.cpp",
+            "esphome/core/util.cpp",
+        ],
+        defines=("USE_GRAPH", "USE_SENSOR"),
+    )
+    # Sample and draw times, shown with -s
+    print(run(program))
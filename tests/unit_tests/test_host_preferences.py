@@ -0,0 +1,17 @@
+from host_cpp import run
+
+
+def test_host_preferences(host_cpp, tmp_path, monkeypatch):
+    program = host_cpp.build(
+        "host_preferences.cpp",
+        [
+            "esphome/components/host/preferences.cpp",
+            "esphome/core/application.cpp",
+            "esphome/core/component.cpp",
+            "esphome/core/helpers.cpp",
+            "esphome/core/scheduler.cpp",
+            "esphome/core/util.cpp",
+        ],
+    )
+    monkeypatch.setenv("TMPDIR", str(tmp_path))
+    run(program)
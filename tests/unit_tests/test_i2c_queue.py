@@ -0,0 +1,25 @@
+from host_cpp import run
+
+
+def test_i2c_queue(host_cpp):
+    program = host_cpp.build(
+        "i2c_queue.cpp",
+        [
+            "esphome/components/hmc5883l/hmc5883l.cpp",
+            "esphome/components/i2c/i2c.cpp",
+            "esphome/components/i2c/i2c_bus.cpp",
+            "esphome/components/i2c/i2c_bus_mock.cpp",
+            "esphome/components/sensirion_common/i2c_sensirion.cpp",
+            "esphome/components/sensor/filter.cpp",
+            "esphome/components/sensor/sensor.cpp",
+            "esphome/components/sht4x/sht4x.cpp",
+            "esphome/core/application.cpp",
+            "esphome/core/component.cpp",
+            "esphome/core/entity_base.cpp",
+            "esphome/core/helpers.cpp",
+            "esphome/core/scheduler.cpp",
+            "esphome/core/util.cpp",
+        ],
+        defines=("USE_I2C", "USE_SENSOR"),
+    )
+    run(program)
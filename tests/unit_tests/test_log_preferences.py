@@ -0,0 +1,13 @@
+from host_cpp import run
+
+
+def test_log_preferences(host_cpp):
+    program = host_cpp.build(
+        "log_preferences.cpp",
+        [
+            "esphome/components/preferences/log_preferences.cpp",
+            "esphome/core/helpers.cpp",
+        ],
+    )
+    # Wear of a typical workload, shown with -s
+    print(run(program))
@@ -0,0 +1,34 @@
+from host_cpp import run
+
+LOG_RING_SOURCES = [
+    "esphome/components/logger/log_ring.cpp",
+    "esphome/components/logger/logger.cpp",
+    "esphome/components/logger/logger_host.cpp",
+    "esphome/core/application.cpp",
+    "esphome/core/component.cpp",
+    "esphome/core/helpers.cpp",
+    "esphome/core/scheduler.cpp",
+    "esphome/core/util.cpp",
+]
+
+
+def test_log_ring(host_cpp):
+    # Concurrent producers under the thread sanitizer
+    program = host_cpp.build(
+        "log_ring.cpp",
+        LOG_RING_SOURCES,
+        defines=("USE_LOGGER_LOG_RING",),
+        flags=("-pthread", "-fsanitize=thread"),
+    )
+    run(program)
+
+
+def test_log_ring_benchmark(host_cpp):
+    program = host_cpp.build(
+        "log_ring.cpp",
+        LOG_RING_SOURCES,
+        defines=("USE_LOGGER_LOG_RING",),
+        flags=("-pthread",),
+    )
+    # Time in a log call with and without the ring, shown with -s
+    print(run(program))
@@ -0,0 +1,23 @@
+from host_cpp import run
+
+
+def test_short_frames_dropped(host_cpp):
+    program = host_cpp.build(
+        "modbus_tcp.cpp",
+        [
+            "esphome/components/modbus/modbus.cpp",
+            "esphome/components/modbus_tcp/modbus_tcp.cpp",
+            "esphome/components/socket/bsd_sockets_impl.cpp",
+            "esphome/components/socket/socket.cpp",
+            "esphome/components/uart/uart.cpp",
+            "esphome/components/uart/uart_component.cpp",
+            "esphome/components/uart/uart_framer.cpp",
+            "esphome/core/application.cpp",
+            "esphome/core/component.cpp",
+            "esphome/core/helpers.cpp",
+            "esphome/core/scheduler.cpp",
+            "esphome/core/util.cpp",
+        ],
+        defines=("USE_SOCKET_IMPL_BSD_SOCKETS",),
+    )
+    run(program)
@@ -0,0 +1,10 @@
+from host_cpp import run
+
+
+def test_mqtt_publish_queue(host_cpp):
+    program = host_cpp.build(
+        "mqtt_publish_queue.cpp",
+        ["esphome/components/mqtt/mqtt_publish_queue.cpp"],
+        defines=("USE_MQTT",),
+    )
+    run(program)
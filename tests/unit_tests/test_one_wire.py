@@ -0,0 +1,12 @@
+from host_cpp import run
+
+
+def test_one_wire_conversion(host_cpp):
+    program = host_cpp.build(
+        "one_wire_conversion.cpp",
+        [
+            "esphome/components/one_wire/one_wire_bus.cpp",
+            "esphome/core/helpers.cpp",
+        ],
+    )
+    run(program)
@@ -0,0 +1,24 @@
+from host_cpp import FIXTURES, run
+
+
+def test_prometheus(host_cpp):
+    program = host_cpp.build(
+        "prometheus.cpp",
+        [
+            "esphome/components/binary_sensor/binary_sensor.cpp",
+            "esphome/components/binary_sensor/filter.cpp",
+            "esphome/components/prometheus/prometheus_handler.cpp",
+            "esphome/components/sensor/filter.cpp",
+            "esphome/components/sensor/sensor.cpp",
+            "esphome/core/application.cpp",
+            "esphome/core/component.cpp",
+            "esphome/core/entity_base.cpp",
+            "esphome/core/helpers.cpp",
+            "esphome/core/scheduler.cpp",
+            "esphome/core/util.cpp",
+        ],
+        defines=("USE_ARDUINO", "USE_BINARY_SENSOR", "USE_NETWORK", "USE_SENSOR"),
+        # The handler as built with the Arduino web server, which sends the response in chunks
+        flags=(f"-I{FIXTURES / 'arduino'}",),
+    )
+    run(program)
@@ -0,0 +1,24 @@
+from host_cpp import run
+
+
+def test_pulse_capture(host_cpp):
+    program = host_cpp.build(
+        "pulse_capture.cpp",
+        [
+            "esphome/components/pulse_capture/pulse_capture.cpp",
+            "esphome/components/pulse_meter/pulse_meter_sensor.cpp",
+            "esphome/components/pulse_width/pulse_width.cpp",
+            "esphome/components/sensor/filter.cpp",
+            "esphome/components/sensor/sensor.cpp",
+            "esphome/core/application.cpp",
+            "esphome/core/component.cpp",
+            "esphome/core/entity_base.cpp",
+            "esphome/core/helpers.cpp",
+            "esphome/core/scheduler.cpp",
+            "esphome/core/util.cpp",
+        ],
+        defines=("USE_SENSOR",),
+        flags=("-pthread",),
+    )
+    # Worst errors of the simulation, shown with -s
+    print(run(program))
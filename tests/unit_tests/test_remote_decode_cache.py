@@ -0,0 +1,22 @@
+from host_cpp import run
+
+
+def test_remote_decode_cache(host_cpp):
+    program = host_cpp.build(
+        "remote_decode_cache.cpp",
+        [
+            "esphome/components/binary_sensor/binary_sensor.cpp",
+            "esphome/components/binary_sensor/filter.cpp",
+            "esphome/components/remote_base/nec_protocol.cpp",
+            "esphome/components/remote_base/rc5_protocol.cpp",
+            "esphome/components/remote_base/remote_base.cpp",
+            "esphome/core/application.cpp",
+            "esphome/core/component.cpp",
+            "esphome/core/entity_base.cpp",
+            "esphome/core/helpers.cpp",
+            "esphome/core/scheduler.cpp",
+            "esphome/core/util.cpp",
+        ],
+        defines=("USE_BINARY_SENSOR",),
+    )
+    run(program)
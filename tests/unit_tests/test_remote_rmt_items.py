@@ -0,0 +1,25 @@
+from host_cpp import FIXTURES, run
+
+
+def test_remote_rmt_items(host_cpp):
+    # The ESP32 item buffer built for the host, against the stand-in RMT types in fixtures/host_cpp/esp_idf
+    program = host_cpp.build(
+        "remote_rmt_items.cpp",
+        [
+            "esphome/components/binary_sensor/binary_sensor.cpp",
+            "esphome/components/binary_sensor/filter.cpp",
+            "esphome/components/remote_base/nec_protocol.cpp",
+            "esphome/components/remote_base/rc5_protocol.cpp",
+            "esphome/components/remote_base/remote_base.cpp",
+            "esphome/components/remote_base/sony_protocol.cpp",
+            "esphome/core/application.cpp",
+            "esphome/core/component.cpp",
+            "esphome/core/entity_base.cpp",
+            "esphome/core/helpers.cpp",
+            "esphome/core/scheduler.cpp",
+            "esphome/core/util.cpp",
+        ],
+        defines=("USE_BINARY_SENSOR", "USE_ESP32", "USE_ESP_IDF"),
+        flags=(f"-I{FIXTURES / 'esp_idf'}",),
+    )
+    run(program)
@@ -0,0 +1,32 @@
+from host_cpp import FIXTURES, run
+
+SPI_SOURCES = [
+    "esphome/components/spi/spi.cpp",
+    "esphome/core/application.cpp",
+    "esphome/core/component.cpp",
+    "esphome/core/scheduler.cpp",
+    "esphome/core/util.cpp",
+]
+
+
+def test_spi_esp_idf_queue(host_cpp):
+    # The ESP-IDF delegate built for the host, against the fake driver in fixtures/host_cpp/esp_idf
+    program = host_cpp.build(
+        "spi_esp_idf_queue.cpp",
+        ["esphome/components/spi/spi_esp_idf.cpp", *SPI_SOURCES],
+        defines=("USE_ESP_IDF",),
+        flags=("-UUSE_HOST", f"-I{FIXTURES / 'esp_idf'}"),
+    )
+    run(program)
+
+
+def test_spi_mock(host_cpp):
+    program = host_cpp.build(
+        "spi_mock.cpp",
+        [
+            "esphome/components/spi/spi_mock.cpp",
+            "esphome/core/helpers.cpp",
+            *SPI_SOURCES,
+        ],
+    )
+    run(program)
@@ -0,0 +1,24 @@
+from host_cpp import run
+
+
+def test_template_reactive(host_cpp):
+    program = host_cpp.build(
+        "template_reactive.cpp",
+        [
+            "esphome/components/binary_sensor/binary_sensor.cpp",
+            "esphome/components/binary_sensor/filter.cpp",
+            "esphome/components/sensor/filter.cpp",
+            "esphome/components/sensor/sensor.cpp",
+            "esphome/components/template/binary_sensor/template_binary_sensor.cpp",
+            "esphome/components/template/sensor/template_sensor.cpp",
+            "esphome/core/application.cpp",
+            "esphome/core/automation.cpp",
+            "esphome/core/component.cpp",
+            "esphome/core/entity_base.cpp",
+            "esphome/core/helpers.cpp",
+            "esphome/core/scheduler.cpp",
+            "esphome/core/util.cpp",
+        ],
+        defines=("USE_BINARY_SENSOR", "USE_SENSOR"),
+    )
+    run(program)
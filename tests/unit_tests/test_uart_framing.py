@@ -0,0 +1,19 @@
+from host_cpp import run
+
+
+def test_frames_dispatched_only_when_complete(host_cpp):
+    program = host_cpp.build(
+        "uart_framing.cpp",
+        [
+            "esphome/components/modbus/modbus.cpp",
+            "esphome/components/uart/uart.cpp",
+            "esphome/components/uart/uart_component.cpp",
+            "esphome/components/uart/uart_framer.cpp",
+            "esphome/core/application.cpp",
+            "esphome/core/component.cpp",
+            "esphome/core/helpers.cpp",
+            "esphome/core/scheduler.cpp",
+            "esphome/core/util.cpp",
+        ],
+    )
+    run(program)
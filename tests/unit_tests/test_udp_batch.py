@@ -0,0 +1,31 @@
+from host_cpp import run
+
+
+def test_udp_batch(host_cpp):
+    program = host_cpp.build(
+        "udp_batch.cpp",
+        [
+            "esphome/components/binary_sensor/binary_sensor.cpp",
+            "esphome/components/binary_sensor/filter.cpp",
+            "esphome/components/network/util.cpp",
+            "esphome/components/sensor/filter.cpp",
+            "esphome/components/sensor/sensor.cpp",
+            "esphome/components/socket/bsd_sockets_impl.cpp",
+            "esphome/components/socket/datagram_batch.cpp",
+            "esphome/components/socket/socket.cpp",
+            "esphome/components/udp/udp_component.cpp",
+            "esphome/core/application.cpp",
+            "esphome/core/component.cpp",
+            "esphome/core/entity_base.cpp",
+            "esphome/core/helpers.cpp",
+            "esphome/core/scheduler.cpp",
+            "esphome/core/util.cpp",
+        ],
+        defines=(
+            "USE_BINARY_SENSOR",
+            "USE_NETWORK",
+            "USE_SENSOR",
+            "USE_SOCKET_IMPL_BSD_SOCKETS",
+        ),
+    )
+    run(program)
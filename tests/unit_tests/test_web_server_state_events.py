@@ -0,0 +1,10 @@
+from host_cpp import run
+
+
+def test_web_server_state_events(host_cpp):
+    program = host_cpp.build(
+        "web_server_state_events.cpp",
+        [],
+        defines=("USE_WEBSERVER",),
+    )
+    run(program)